@@ -52,6 +52,16 @@ public:
      * this texture does not have a valid size.
      */
     virtual std::size_t getHeight() const = 0;
+
+    /**
+     * \brief
+     * Render passes storing the GL texture number of this texture call these
+     * while they hold on to the number. Textures which can be released to save
+     * memory must stay loaded as long as such a reference exists. The default
+     * implementation does nothing.
+     */
+    virtual void addPassReference() {}
+    virtual void removePassReference() {}
 };
 typedef std::shared_ptr<Texture> TexturePtr;
 
@@ -28,7 +28,13 @@ public:
     // Perform an automatic save, unconditionally. This will run the save algorithms
     // for the currently loaded map, regardless whether it is due for a save or not.
     // Call the "runAutosaveCheck" method to see if an autosave is overdue.
+    // The map files are written by a background task, the scene state is captured
+    // before this method returns. Call waitForPendingSave() to block until the files are on disk.
     virtual void performAutosave() = 0;
+
+    // Blocks until a save started by performAutosave() has been written to disk.
+    // Returns immediately if there is no save in progress.
+    virtual void waitForPendingSave() = 0;
 };
 
 constexpr const char* const RKEY_AUTOSAVE_SNAPSHOTS_ENABLED = "user/ui/map/autoSaveSnapshots";
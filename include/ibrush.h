@@ -12,6 +12,7 @@
 class Plane3;
 
 const std::string RKEY_ENABLE_TEXTURE_LOCK("user/ui/brush/textureLock");
+const std::string RKEY_BRUSH_TRANSFORM_PREVIEW("user/ui/brush/transformPreview");
 
 namespace brush
 {
@@ -183,6 +184,9 @@ public:
 
 	virtual const Plane3& getPlane3() const = 0;
 
+	// Replaces the plane of this face, the owning brush will re-evaluate its windings
+	virtual void setPlane3(const Plane3& plane) = 0;
+
 	/**
 	 * The matrix used to project world coordinates to U/V space, after the winding vertices
      * have been transformed to this face's axis base system.
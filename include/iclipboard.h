@@ -1,11 +1,29 @@
 #pragma once
 
 #include <string>
+#include <memory>
 #include "imodule.h"
 
 namespace radiant
 {
 
+/**
+ * Clipboard data that is placed on the system clipboard without
+ * converting it to text right away. The text representation is only
+ * generated when it's actually requested, either through IClipboard::getString()
+ * or by another application pasting the clipboard contents.
+ */
+class IClipboardContent
+{
+public:
+    using Ptr = std::shared_ptr<IClipboardContent>;
+
+    virtual ~IClipboardContent() {}
+
+    /// Return the text representation of this content
+    virtual std::string getString() = 0;
+};
+
 /**
  * Interface to DarkRadiant's clipboard which is able to 
  * store and retrieve a string from and to the system clipboard.
@@ -26,6 +44,17 @@ public:
     /// Copy the given string to the system clipboard
     virtual void setString(const std::string& str) = 0;
 
+    /// Place the given content on the system clipboard, its text
+    /// representation is generated on demand
+    virtual void setContent(const IClipboardContent::Ptr& content) = 0;
+
+    /// Return the content object passed to setContent() as long as the system
+    /// clipboard is still holding it. Returns an empty pointer if the clipboard
+    /// contents have been replaced since by this application. Replacements by
+    /// another application are only detected when the editor window is
+    /// activated again, until then the previous content object is returned.
+    virtual IClipboardContent::Ptr getContent() = 0;
+
     // A signal that is emitted when the contents of the system clipboard changes
     virtual sigc::signal<void>& signal_clipboardContentChanged() = 0;
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <sigc++/signal.h>
 #include "imodule.h"
 #include "ifilesystem.h"
@@ -15,6 +16,20 @@ namespace decl
 // including whitespace and comments but exluding the outermost brace pair
 struct DeclarationBlockSyntax : game::IResource
 {
+    // Blocks handed out by the parser are immutable and shared between
+    // the decl manager and the declarations, to avoid copying the contents
+    using Ptr = std::shared_ptr<const DeclarationBlockSyntax>;
+
+    // The mod and the VFS info of the file a block is located in.
+    // Immutable, all blocks parsed from the same file share a single instance.
+    struct FileOrigin
+    {
+        using Ptr = std::shared_ptr<const FileOrigin>;
+
+        std::string modName;
+        vfs::FileInfo fileInfo;
+    };
+
     // The type name of this block (e.g. "table")
     std::string typeName;
 
@@ -24,18 +39,61 @@ struct DeclarationBlockSyntax : game::IResource
     // The block contents (excluding braces)
     std::string contents;
 
+    // The file this syntax has been defined in, never empty
+    FileOrigin::Ptr origin = getEmptyOrigin();
+
     // The mod this syntax has been defined in
-    std::string modName;
+    std::string getModName() const override
+    {
+        return origin->modName;
+    }
 
     // The VFS info of the file this syntax is located
-    vfs::FileInfo fileInfo;
+    const vfs::FileInfo& getFileInfo() const
+    {
+        return origin->fileInfo;
+    }
 
-    std::string getModName() const override
+    // The setters replace the origin of this block, leaving the shared instance untouched
+    void setModName(const std::string& modName)
+    {
+        origin = std::make_shared<FileOrigin>(FileOrigin{ modName, origin->fileInfo });
+    }
+
+    void setFileInfo(const vfs::FileInfo& fileInfo)
     {
-        return modName;
+        origin = std::make_shared<FileOrigin>(FileOrigin{ origin->modName, fileInfo });
+    }
+
+    static const FileOrigin::Ptr& getEmptyOrigin()
+    {
+        static const FileOrigin::Ptr _emptyOrigin = std::make_shared<FileOrigin>();
+        return _emptyOrigin;
     }
 };
 
+// Memory held by the declaration blocks, see the ShowDeclMemoryStats command
+struct DeclarationMemoryStatistics
+{
+    std::size_t numDeclarations = 0;
+
+    // Blocks and file origins shared by several decls are counted once
+    std::size_t numBlocks = 0;
+    std::size_t numFileOrigins = 0;
+
+    // Heap memory of the block contents
+    std::size_t contentBytes = 0;
+
+    // Memory of the block structures, their type names and names
+    std::size_t blockBytes = 0;
+
+    // Memory of the file origins (mod names and file info)
+    std::size_t fileOriginBytes = 0;
+
+    // Memory the file origins would take if every block held its own copy
+    std::size_t unsharedFileOriginBytes = 0;
+};
+
 // Common interface shared by all the declarations supported by a certain game type
 class IDeclaration :
     public game::IResource
@@ -72,6 +130,9 @@ public:
     // Implementations are free to either (re-)parse immediately or deferred.
     virtual void setBlockSyntax(const DeclarationBlockSyntax& block) = 0;
 
+    // Set the block contents of this declaration, sharing the given block instead of copying it
+    virtual void setBlockSyntax(const DeclarationBlockSyntax::Ptr& block) = 0;
+
     // Returns the mod-relative path to the file this decl has been declared in
     virtual std::string getDeclFilePath() const = 0;
 
@@ -177,6 +238,10 @@ public:
     //      just like in case #2
     virtual void saveDeclaration(const IDeclaration::Ptr& decl) = 0;
 
+    // Returns the memory held by the declaration blocks of all types,
+    // including the unrecognised ones
+    virtual DeclarationMemoryStatistics getMemoryStatistics() = 0;
+
     // Signal emitted right before decls are being reloaded
     virtual sigc::signal<void>& signal_DeclsReloading(Type type) = 0;
 
@@ -111,6 +111,14 @@ public:
      */
     virtual ImagePtr imageFromVFS(const std::string& vfsPath) const = 0;
 
+    /**
+     * \brief
+     * Returns the VFS path of the file imageFromVFS() would load for the given
+     * image path, including any prefix and the file extension. Returns an empty
+     * string if no matching file exists.
+     */
+    virtual std::string findImageInVFS(const std::string& vfsPath) const = 0;
+
     /**
      * \brief
      * Load an image from a filesystem path.
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "imodule.h"
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace jobs
+{
+
+/**
+ * A group of tasks executed by the job system's worker pool.
+ *
+ * Tasks added to a group are started as soon as a worker is available,
+ * unless the group depends on other groups: in this case the tasks are
+ * held back until all of these groups have finished.
+ *
+ * Tasks must not block on anything that is not synchronised through the
+ * job system. A task waiting for another group should use IJobGroup::wait(),
+ * which executes that group's pending tasks on the waiting thread instead
+ * of occupying a worker without doing anything.
+ */
+class IJobGroup
+{
+public:
+    using Ptr = std::shared_ptr<IJobGroup>;
+
+    virtual ~IJobGroup() {}
+
+    // The name of this group, used to identify its tasks in the timing statistics
+    virtual const std::string& getName() const = 0;
+
+    // Adds a task to this group. Tasks added after cancel() has been called are discarded.
+    virtual void run(const std::function<void()>& task) = 0;
+
+    // Holds back the tasks of this group until the given group has finished.
+    // Should be called before adding the tasks that depend on the other group,
+    // but after the other group's tasks have been added: a dependency on a group
+    // that is finished at the time of this call (e.g. because it's empty) has no effect.
+    virtual void addDependency(const Ptr& other) = 0;
+
+    // Returns true if all tasks of this group are done (or have been cancelled).
+    virtual bool isFinished() const = 0;
+
+    // Blocks until all tasks of this group are done. While waiting, the calling
+    // thread executes the group's pending tasks itself. If one of the tasks threw
+    // an exception, the first one is rethrown by this method.
+    virtual void wait() = 0;
+
+    // Discards all tasks that have not been started yet. Running tasks are not
+    // interrupted, they can poll isCancelled() to stop early.
+    virtual void cancel() = 0;
+
+    virtual bool isCancelled() const = 0;
+
+    // The given function will be invoked on the main thread once this group has finished
+    // (immediately queued if the group is finished already). See IJobSystem::processMainThreadTasks().
+    virtual void continueOnMainThread(const std::function<void()>& continuation) = 0;
+};
+
+/**
+ * Timing information about the tasks run by the job system,
+ * aggregated for all tasks of groups sharing the same name.
+ */
+struct TaskStatistics
+{
+    std::size_t numTasks = 0;
+
+    // Accumulated time the tasks have been waiting in the queue
+    double totalQueueTimeMsec = 0;
+
+    // Accumulated and maximum execution time of the tasks
+    double totalRunTimeMsec = 0;
+    double maxRunTimeMsec = 0;
+};
+
+/**
+ * Central thread pool running the background work of all modules,
+ * to avoid oversubscribing the CPU by every module starting its own threads.
+ * The pool consists of a fixed number of workers, each of them owning a task
+ * queue. Idle workers steal tasks from the other workers' queues.
+ */
+class IJobSystem :
+    public RegisterableModule
+{
+public:
+    virtual ~IJobSystem() {}
+
+    // Creates a new, empty task group
+    virtual IJobGroup::Ptr createGroup(const std::string& name) = 0;
+
+    // The number of worker threads in the pool
+    virtual std::size_t getNumWorkers() const = 0;
+
+    // Queues the given function to be invoked on the main thread
+    virtual void postToMainThread(const std::function<void()>& func) = 0;
+
+    // Runs all functions that have been queued for the main thread so far.
+    // Must be called from the main thread.
+    virtual void processMainThreadTasks() = 0;
+
+    // Sets the function used to notify the main thread about newly queued functions,
+    // which should eventually call processMainThreadTasks() in the main thread's event loop.
+    // Without a dispatcher, the main thread needs to invoke processMainThreadTasks() on its own.
+    virtual void setMainThreadDispatcher(const std::function<void(const std::function<void()>&)>& dispatcher) = 0;
+
+    // Invokes the given functor with the timing statistics of each task group name
+    virtual void foreachTaskStatistics(const std::function<void(const std::string&, const TaskStatistics&)>& functor) = 0;
+};
+
+// Runs the given function as task of the given group, the returned future receives its result
+template<typename Func>
+std::future<std::invoke_result_t<Func>> runWithResult(const IJobGroup::Ptr& group, Func&& func)
+{
+    auto task = std::make_shared<std::packaged_task<std::invoke_result_t<Func>()>>(std::forward<Func>(func));
+    auto result = task->get_future();
+
+    group->run([task]() { (*task)(); });
+
+    return result;
+}
+
+}
+
+constexpr const char* const MODULE_JOBSYSTEM("JobSystem");
+
+inline jobs::IJobSystem& GlobalJobSystem()
+{
+    static module::InstanceReference<jobs::IJobSystem> _reference(MODULE_JOBSYSTEM);
+    return _reference;
+}
@@ -4,6 +4,7 @@
 #include <string>
 #include <functional>
 #include "imodule.h"
+#include "scene/LayerList.h"
 #include <sigc++/signal.h>
 
 namespace scene
@@ -12,9 +13,6 @@ namespace scene
 class INode;
 typedef std::shared_ptr<INode> INodePtr;
 
-// A list of named layers
-typedef std::set<int> LayerList;
-
 /**
  * greebo: Interface of a Layered object.
  */
@@ -171,6 +169,22 @@ public:
 	 */
 	virtual bool updateNodeVisibility(const INodePtr& node) = 0;
 
+	/**
+	 * Layered scene nodes register themselves with the layer manager of the
+	 * scene they're inserted into, such that it can keep track of the members
+	 * of each layer. These are called by the nodes themselves, client code
+	 * doesn't need to invoke them.
+	 */
+	virtual void registerNode(INode& node) = 0;
+	virtual void unregisterNode(INode& node) = 0;
+
+	/**
+	 * Called by a registered node after its layer memberships changed.
+	 * The visibility of the node is updated on the next membership or
+	 * layer visibility change processed by the layer manager.
+	 */
+	virtual void onNodeLayersChanged(INode& node) = 0;
+
 	/**
 	 * greebo: Sets the selection status of the entire layer.
 	 *
@@ -40,6 +40,10 @@ struct PatchMesh
 
     /// Geometry with normals and texture coordinates
 	std::vector<VertexNT> vertices;
+
+    /// Tangent and bitangent of each vertex, derived from the texture coordinates
+	std::vector<Vector3> tangents;
+	std::vector<Vector3> bitangents;
 };
 
 struct PatchRenderIndices
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "imodule.h"
+#include <ostream>
+
+namespace profiling
+{
+
+/**
+ * Zone profiler recording the time spent in named scopes, per thread.
+ *
+ * Recording is off by default and can be toggled at runtime, the recorded
+ * zones can be exported in the Chrome trace event format (to be opened
+ * in chrome://tracing or https://ui.perfetto.dev).
+ *
+ * Code should not call beginZone/endZone directly, but use the
+ * PROFILE_ZONE macro below, which does nothing but checking the
+ * enabled flag while the profiler is inactive.
+ */
+class IProfiler :
+    public RegisterableModule
+{
+public:
+    virtual ~IProfiler() {}
+
+    virtual bool isEnabled() const = 0;
+
+    // Starts or stops recording zones. Recorded zones are kept when stopping.
+    virtual void setEnabled(bool enabled) = 0;
+
+    // Opens a zone on the calling thread. The name must have static storage
+    // duration (a string literal), only the pointer is stored.
+    virtual void beginZone(const char* name) = 0;
+
+    // Closes the zone opened last on the calling thread
+    virtual void endZone() = 0;
+
+    // Discards all recorded zones
+    virtual void clear() = 0;
+
+    // Writes all recorded zones as Chrome trace event JSON to the given stream
+    virtual void exportChromeTrace(std::ostream& stream) = 0;
+};
+
+// Records the lifetime of this object as zone, if the profiler is enabled
+class ScopedZone
+{
+private:
+    IProfiler* _profiler;
+
+public:
+    ScopedZone(IProfiler& profiler, const char* name) :
+        _profiler(nullptr)
+    {
+        if (profiler.isEnabled())
+        {
+            _profiler = &profiler;
+            _profiler->beginZone(name);
+        }
+    }
+
+    ScopedZone(const ScopedZone& other) = delete;
+    ScopedZone& operator=(const ScopedZone& other) = delete;
+
+    ~ScopedZone()
+    {
+        if (_profiler != nullptr)
+        {
+            _profiler->endZone();
+        }
+    }
+};
+
+}
+
+constexpr const char* const MODULE_PROFILER("Profiler");
+
+// The profiler doesn't need to be initialised to be used, it's
+// enough for the module to be registered (it's part of the core binary)
+inline profiling::IProfiler& GlobalProfiler()
+{
+    static module::InstanceReference<profiling::IProfiler> _reference(MODULE_PROFILER);
+    return _reference;
+}
+
+#define PROFILE_ZONE_CONCAT_INNER(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b) PROFILE_ZONE_CONCAT_INNER(a, b)
+
+// Records the rest of the enclosing scope as zone with the given (string literal) name
+#define PROFILE_ZONE(name) profiling::ScopedZone PROFILE_ZONE_CONCAT(_profileZone, __LINE__)(GlobalProfiler(), name)
@@ -3,6 +3,7 @@
 #include <cstddef>
 #include "imodule.h"
 #include <memory>
+#include <vector>
 #include <sigc++/signal.h>
 #include "imanipulator.h"
 
@@ -63,6 +64,23 @@ namespace selection
 namespace selection
 {
 
+/**
+ * The selection changes accumulated during a selection transaction.
+ * Nodes that have been selected and deselected again (or vice versa)
+ * during the transaction are not listed.
+ */
+struct SelectionChangeSet
+{
+    // Nodes that have been selected
+    std::vector<scene::INodePtr> selected;
+
+    // Nodes that have been deselected
+    std::vector<scene::INodePtr> deselected;
+
+    // Nodes whose component selection changed (e.g. the brush of a selected face)
+    std::vector<scene::INodePtr> componentsChanged;
+};
+
 class SelectionSystem :
 	public RegisterableModule
 {
@@ -87,6 +105,30 @@ public:
 		 * @isComponent: is TRUE if the changed selectable is a component (like a FaceInstance, VertexInstance).
 		 */
 		virtual void selectionChanged(const scene::INodePtr& node, bool isComponent) = 0;
+
+		/**
+		 * Called once at the end of a selection transaction, instead of selectionChanged()
+		 * for every single node. The default implementation forwards each change to
+		 * selectionChanged(), observers that are rescanning the whole selection anyway
+		 * should override this.
+		 */
+		virtual void selectionBatchChanged(const SelectionChangeSet& changes)
+		{
+			for (const auto& node : changes.selected)
+			{
+				selectionChanged(node, false);
+			}
+
+			for (const auto& node : changes.deselected)
+			{
+				selectionChanged(node, false);
+			}
+
+			for (const auto& node : changes.componentsChanged)
+			{
+				selectionChanged(node, true);
+			}
+		}
 	};
 
 	virtual void addObserver(Observer* observer) = 0;
@@ -202,6 +244,17 @@ public:
     /// Signal emitted when the selection is changed
     virtual SelectionChangedSignal signal_selectionChanged() const = 0;
 
+    /**
+     * Starts a selection transaction. Until the matching endTransaction() call
+     * the selection changes are only accumulated. When the outermost transaction
+     * is finished, the selection changed signal is emitted once and the observers
+     * receive a single batched notification. Transactions can be nested.
+     *
+     * Use the SelectionTransaction class instead of calling this directly.
+     */
+    virtual void beginTransaction() = 0;
+    virtual void endTransaction() = 0;
+
 	virtual const Matrix4& getPivot2World() = 0;
     virtual void pivotChanged() = 0;
 
@@ -254,3 +307,34 @@ inline selection::SelectionSystem& GlobalSelectionSystem()
 	static module::InstanceReference<selection::SelectionSystem> _reference(MODULE_SELECTIONSYSTEM);
 	return _reference;
 }
+
+namespace selection
+{
+
+/**
+ * Scoped selection transaction, the accumulated selection changes are
+ * delivered when the outermost instance goes out of scope.
+ */
+class SelectionTransaction
+{
+private:
+    SelectionSystem& _selectionSystem;
+
+public:
+    SelectionTransaction(SelectionSystem& selectionSystem = GlobalSelectionSystem()) :
+        _selectionSystem(selectionSystem)
+    {
+        _selectionSystem.beginTransaction();
+    }
+
+    ~SelectionTransaction()
+    {
+        _selectionSystem.endTransaction();
+    }
+
+    // Noncopyable
+    SelectionTransaction(const SelectionTransaction& other) = delete;
+    SelectionTransaction& operator=(const SelectionTransaction& other) = delete;
+};
+
+}
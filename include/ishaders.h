@@ -529,6 +529,30 @@ public:
 
 constexpr const char* const MODULE_SHADERSYSTEM = "MaterialManager";
 
+namespace shaders
+{
+
+// Memory budget (in MB) for the loaded textures, 0 disables the limit
+constexpr const char* const RKEY_TEXTURE_MEMORY_BUDGET = "user/ui/textures/memoryBudget";
+
+// Residency information about the textures loaded by the material manager
+struct TextureMemoryStatistics
+{
+    std::size_t numTextures = 0;
+    std::size_t numResident = 0;
+
+    // Textures used by realised shaders, these are never released
+    std::size_t numPinned = 0;
+
+    // Estimated texture memory of the resident textures, including mipmaps
+    std::size_t residentBytes = 0;
+
+    std::size_t numEvictions = 0;
+    std::size_t numReloads = 0;
+};
+
+}
+
 /**
  * \brief
  * Interface for the material manager.
@@ -645,6 +669,16 @@ public:
 
     // Reload the textures used by the active shaders
     virtual void reloadImages() = 0;
+
+    /**
+     * Called by the render system at the start of every frame, with the GL context
+     * being current. Textures that have not been used recently are released if the
+     * texture memory exceeds its budget, they are reloaded when used again.
+     */
+    virtual void startFrame() = 0;
+
+    // Returns the current texture residency counters
+    virtual shaders::TextureMemoryStatistics getTextureMemoryStatistics() = 0;
 };
 
 inline IMaterialManager& GlobalMaterialManager()
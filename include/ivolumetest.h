@@ -23,6 +23,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #define INCLUDED_CULLABLE_H
 
 #include "VolumeIntersectionValue.h"
+#include "math/AABBBatch.h"
 
 template<typename Element> class BasicVector3;
 typedef BasicVector3<double> Vector3;
@@ -50,6 +51,17 @@ public:
   /// \brief Returns the intersection of \p aabb transformed by \p localToWorld and volume.
   virtual VolumeIntersectionValue TestAABB(const AABB& aabb, const Matrix4& localToWorld) const = 0;
 
+  /// \brief Writes the intersection of every box in \p boxes and volume to \p results.
+  /// The default implementation calls TestAABB() for each box, volumes with a faster
+  /// way to classify many boxes at once should override this.
+  virtual void TestAABBs(const AABBBatch& boxes, VolumeIntersectionValue* results) const
+  {
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+    {
+      results[i] = TestAABB(boxes.get(i));
+    }
+  }
+
   virtual bool fill() const = 0;
 
   virtual const Matrix4& GetViewProjection() const = 0;
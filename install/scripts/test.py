@@ -477,3 +477,35 @@ print(GlobalLayerManager.layerIsVisible(1))
 
 GlobalLayerManager.setSelected(0, True)
 GlobalLayerManager.moveSelectionToLayer(1)
+
+# Test the BulkData interface (requires numpy)
+class NodeCollector(dr.SelectionVisitor) :
+	def __init__(self):
+		dr.SelectionVisitor.__init__(self)
+		self.nodes = []
+
+	def visit(self, node):
+		self.nodes.append(node)
+
+collector = NodeCollector()
+GlobalSelectionSystem.foreachSelected(collector)
+
+planes, faceCounts = GlobalBulkData.getFacePlanes(collector.nodes)
+print('Selection has {0} brush faces'.format(planes.shape[0]))
+
+# Move all selected brush faces 8 units outwards, as a single undo step
+planes[:, 3] += 8
+GlobalBulkData.setFacePlanes(collector.nodes, planes)
+
+shaders = GlobalBulkData.getFaceShaders(collector.nodes)
+GlobalBulkData.setFaceShaders(collector.nodes, ['textures/common/caulk'] * len(shaders))
+
+controls, dimensions = GlobalBulkData.getControlGrids(collector.nodes)
+controls[:, 2] += 16
+GlobalBulkData.setControlGrids(collector.nodes, controls)
+
+keyValuesPerNode = GlobalBulkData.getKeyValues(collector.nodes)
+print(keyValuesPerNode)
+
+# Non-entity nodes must not receive any key values
+GlobalBulkData.setKeyValues(collector.nodes, [{'bulk_test': '1'} if 'classname' in kv else {} for kv in keyValuesPerNode])
@@ -6,6 +6,7 @@
 #include <memory>
 #include "util/Noncopyable.h"
 #include "debugging/gl.h"
+#include "image/PixelKernels.h"
 
 namespace image
 {
@@ -73,10 +74,23 @@ public:
             format = GL_RG8;
         }
 
-        // Download image and set up mipmaps and filtering
-        glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
-        gluBuild2DMipmaps(GL_TEXTURE_2D, GL_RGBA, static_cast<GLint>(getWidth()),
-                          static_cast<GLint>(getHeight()), GL_RGBA, GL_UNSIGNED_BYTE, getPixels());
+        // Download the image along with our own mipmap chain, the reduced
+        // levels are generated on multiple threads
+        auto mipmaps = generateMipChain(getPixels(), getWidth(), getHeight());
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(mipmaps.size()));
+
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, static_cast<GLsizei>(getWidth()),
+                     static_cast<GLsizei>(getHeight()), 0, GL_RGBA, GL_UNSIGNED_BYTE, getPixels());
+
+        for (std::size_t level = 0; level < mipmaps.size(); ++level)
+        {
+            const auto& mipmap = mipmaps[level];
+
+            glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level + 1), GL_RGBA, static_cast<GLsizei>(mipmap.width),
+                         static_cast<GLsizei>(mipmap.height), 0, GL_RGBA, GL_UNSIGNED_BYTE, mipmap.pixels.data());
+        }
 
         // Un-bind the texture
 		glBindTexture(GL_TEXTURE_2D, 0);
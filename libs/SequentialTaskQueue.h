@@ -3,14 +3,14 @@
 #include <mutex>
 #include <list>
 #include <functional>
-#include <future>
+#include "ijobsystem.h"
 
 namespace util
 {
 
 /**
  * Queueing helper, allowing to run queued tasks one after the other,
- * each of which will be run asynchronously (by means of std::async).
+ * each of which will be run asynchronously (as task of the job system).
  * No task will be started before a previous one is completed.
  *
  * Destroying this object will remove all unstarted tasks from the queue,
@@ -22,9 +22,10 @@ private:
     mutable std::mutex _queueLock;
     std::list<std::function<void()>> _queue;
 
-    mutable std::recursive_mutex _currentLock;
-    std::future<void> _current;
-    std::future<void> _finished;
+    // True while a task of this queue is scheduled or running
+    bool _taskActive = false;
+
+    jobs::IJobGroup::Ptr _tasks;
 
 public:
     ~SequentialTaskQueue()
@@ -38,13 +39,15 @@ public:
     {
         {
             std::lock_guard<std::mutex> lock(_queueLock);
+
             _queue.push_front(task);
-        }
 
-        if (isIdle())
-        {
-            startNextTask();
+            if (_taskActive) return;
+
+            _taskActive = true;
         }
+
+        startNextTask();
     }
 
     // Removes all tasks that have not been processed yet
@@ -56,66 +59,77 @@ public:
         _queue.clear();
     }
 
-    // Clears the queue. This might block waiting for any currently 
+    // Clears the queue. This might block waiting for any currently
     // active task to finish
     void clear()
     {
         clearPendingTasks();
 
-        _current = std::future<void>();
-        _finished = std::future<void>();
-    }
-
-private:
-    bool isIdle() const
-    {
-        std::lock_guard<std::recursive_mutex> lock(_currentLock);
-        return !_current.valid() || _current.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
-    }
+        jobs::IJobGroup::Ptr tasks;
 
-    std::function<void()> dequeueOne()
-    {
-        std::lock_guard<std::mutex> lock(_queueLock);
-
-        if (_queue.empty())
         {
-            return std::function<void()>();
+            std::lock_guard<std::mutex> lock(_queueLock);
+            tasks = _tasks;
         }
 
-        // No active task, dispatch a new one
-        auto frontOfQueue = _queue.front();
-        _queue.pop_front();
-
-        return frontOfQueue;
+        if (tasks)
+        {
+            tasks->wait();
+        }
     }
 
+private:
     void startNextTask()
     {
-        auto task = dequeueOne();
+        jobs::IJobGroup::Ptr tasks;
 
-        if (!task)
         {
-            return;
+            std::lock_guard<std::mutex> lock(_queueLock);
+
+            if (!_tasks)
+            {
+                _tasks = GlobalJobSystem().createGroup("SequentialTaskQueue");
+            }
+
+            tasks = _tasks;
         }
 
-        // Wrap the given task in our own lambda to start the next task right afterwards
-        std::lock_guard<std::recursive_mutex> lock(_currentLock);
-        _current = std::async(std::launch::async, [this, task]()
+        // The task is taken from the queue when it's about to run
+        tasks->run([this]()
         {
-            task();
+            std::function<void()> task;
+
+            {
+                std::lock_guard<std::mutex> lock(_queueLock);
 
+                if (_queue.empty())
+                {
+                    _taskActive = false;
+                    return;
+                }
+
+                task = _queue.front();
+                _queue.pop_front();
+            }
+
+            try
             {
-                // Move our own task to the finished lane, 
-                // to avoid blocking when assigning a new future
-                std::lock_guard<std::recursive_mutex> lock(_currentLock);
-                _finished = std::move(_current);
-
-                // _current is now empty, so we can start a new task
-                // We still hold the _currentLock such that no other thread will
-                // check the _current future in isIdle in the meantime.
-                // Since the mutex is recursive, this thread can assign to _current
-                startNextTask();
+                task();
             }
+            catch (...)
+            {} // a failing task must not stop the queue
+
+            {
+                std::lock_guard<std::mutex> lock(_queueLock);
+
+                if (_queue.empty())
+                {
+                    _taskActive = false;
+                    return;
+                }
+            }
+
+            startNextTask();
         });
     }
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include "ideclmanager.h"
 #include "parser/DefTokeniser.h"
 
@@ -33,8 +34,9 @@ private:
 
     std::size_t _parseStamp;
 
-    // The raw unparsed definition block
-    DeclarationBlockSyntax _declBlock;
+    // The raw unparsed definition block, possibly shared with other decls.
+    // It's never changed in place, see modifyBlock().
+    DeclarationBlockSyntax::Ptr _declBlock;
 
     bool _parsed;
     std::string _parseErrors;
@@ -47,6 +49,7 @@ protected:
         _originalName(name),
         _type(type),
         _parseStamp(0),
+        _declBlock(getEmptyBlock()),
         _parsed(false)
     {}
 
@@ -61,7 +64,7 @@ public:
     void setDeclName(const std::string& newName) override
     {
         _name = newName;
-        _declBlock.name = newName;
+        modifyBlock([&](DeclarationBlockSyntax& block) { block.name = newName; });
     }
 
     const std::string& getOriginalDeclName() const final
@@ -81,34 +84,39 @@ public:
 
     const DeclarationBlockSyntax& getBlockSyntax() override
     {
-        return _declBlock;
+        return *_declBlock;
     }
 
     void setBlockSyntax(const DeclarationBlockSyntax& block) final
     {
-        _declBlock = block;
+        setBlockSyntax(std::make_shared<DeclarationBlockSyntax>(block));
+    }
+
+    void setBlockSyntax(const DeclarationBlockSyntax::Ptr& block) final
+    {
+        _declBlock = block ? block : getEmptyBlock();
 
         // Reset the parsed flag and notify the subclasses
         _parsed = false;
 
-        onSyntaxBlockAssigned(_declBlock);
+        onSyntaxBlockAssigned(*_declBlock);
 
         _changedSignal.emit();
     }
 
     std::string getModName() const final
     {
-        return _declBlock.getModName();
+        return _declBlock->getModName();
     }
 
     std::string getDeclFilePath() const final
     {
-        return _declBlock.fileInfo.fullPath();
+        return _declBlock->getFileInfo().fullPath();
     }
 
     void setFileInfo(const vfs::FileInfo& fileInfo) override
     {
-        _declBlock.fileInfo = fileInfo;
+        modifyBlock([&](DeclarationBlockSyntax& block) { block.setFileInfo(fileInfo); });
     }
 
     std::size_t getParseStamp() const final
@@ -145,6 +153,12 @@ protected:
         return "{}()";
     }
 
+    // Returns true if the attached syntax block has already been processed by ensureParsed()
+    bool isParsed() const
+    {
+        return _parsed;
+    }
+
     // Subclasses should call this to ensure the attached syntax block has been processed.
     // In case the block needs parsing, the parseFromTokens() method will be invoked,
     // followed by an onParseFinished() call (the latter of which is invoked regardless
@@ -203,7 +217,23 @@ protected:
     // parseFromTokens() will not forced to be called afterwards.
     void assignSyntaxBlockContents(const std::string& newSyntax)
     {
-        _declBlock.contents = newSyntax;
+        modifyBlock([&](DeclarationBlockSyntax& block) { block.contents = newSyntax; });
+    }
+
+private:
+    // Replaces the attached block with a modified copy, leaving the shared original untouched
+    void modifyBlock(const std::function<void(DeclarationBlockSyntax&)>& modifier)
+    {
+        auto block = std::make_shared<DeclarationBlockSyntax>(*_declBlock);
+        modifier(*block);
+
+        _declBlock = std::move(block);
+    }
+
+    static const DeclarationBlockSyntax::Ptr& getEmptyBlock()
+    {
+        static const DeclarationBlockSyntax::Ptr _emptyBlock = std::make_shared<DeclarationBlockSyntax>();
+        return _emptyBlock;
     }
 };
 
@@ -0,0 +1,449 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include "util/ParallelFor.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define IMAGE_KERNELS_SSE2
+#endif
+
+/**
+ * Pixel processing kernels used to prepare 8-bit RGB(A) images for upload:
+ * bilinear resampling, gamma table lookups and 2:1 mipmap reduction.
+ *
+ * All kernels operate on a range of output rows, such that the callers can
+ * distribute the rows across threads using util::parallelFor. Input and output
+ * buffers must not overlap unless noted otherwise.
+ */
+namespace image
+{
+
+namespace kernels
+{
+
+// Below this amount of pixels per batch it's not worth spawning a thread
+constexpr std::size_t MinPixelsPerBatch = 64 * 1024;
+
+// Returns the minimum amount of rows per batch for an image with the given width
+inline std::size_t getMinRowsPerBatch(std::size_t width)
+{
+    return std::max<std::size_t>(MinPixelsPerBatch / std::max<std::size_t>(width, 1), 1);
+}
+
+// Horizontally interpolates one source line into a line of outWidth pixels,
+// using 16.16 fixed point steps. Supports 3 and 4 bytes per pixel.
+inline void lerpLine(const uint8_t* in, uint8_t* out, std::size_t inWidth, std::size_t outWidth, int bytesPerPixel)
+{
+    auto fstep = static_cast<std::size_t>(inWidth * 65536.0f / outWidth);
+    auto endx = inWidth - 1;
+
+    for (std::size_t j = 0, f = 0; j < outWidth; ++j, f += fstep)
+    {
+        auto xi = f >> 16;
+        const auto* src = in + xi * bytesPerPixel;
+
+        if (xi < endx)
+        {
+            auto lerp = static_cast<int>(f & 0xFFFF);
+
+            for (int c = 0; c < bytesPerPixel; ++c)
+            {
+                *out++ = static_cast<uint8_t>((((src[c + bytesPerPixel] - src[c]) * lerp) >> 16) + src[c]);
+            }
+        }
+        else // last pixel of the line has no pixel to lerp to
+        {
+            for (int c = 0; c < bytesPerPixel; ++c)
+            {
+                *out++ = src[c];
+            }
+        }
+    }
+}
+
+// Vertically interpolates between the two given lines: out = row1 + ((row2 - row1) * lerp) >> 16
+// The lerp factor is a 16 bit fixed point value in the range [0..65535]
+inline void lerpRows(const uint8_t* row1, const uint8_t* row2, uint8_t* out, std::size_t numBytes, int lerp)
+{
+    std::size_t i = 0;
+
+#ifdef IMAGE_KERNELS_SSE2
+    // _mm_mulhi_epi16 treats the factor as signed, so for factors >= 0x8000
+    // the product is off by exactly one multiple of the difference, add it back
+    const auto factor = _mm_set1_epi16(static_cast<int16_t>(static_cast<uint16_t>(lerp)));
+    const auto correct = lerp >= 0x8000;
+    const auto zero = _mm_setzero_si128();
+
+    for (; i + 16 <= numBytes; i += 16)
+    {
+        auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + i));
+        auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row2 + i));
+
+        auto aLo = _mm_unpacklo_epi8(a, zero);
+        auto aHi = _mm_unpackhi_epi8(a, zero);
+        auto dLo = _mm_sub_epi16(_mm_unpacklo_epi8(b, zero), aLo);
+        auto dHi = _mm_sub_epi16(_mm_unpackhi_epi8(b, zero), aHi);
+
+        auto mLo = _mm_mulhi_epi16(dLo, factor);
+        auto mHi = _mm_mulhi_epi16(dHi, factor);
+
+        if (correct)
+        {
+            mLo = _mm_add_epi16(mLo, dLo);
+            mHi = _mm_add_epi16(mHi, dHi);
+        }
+
+        auto result = _mm_packus_epi16(_mm_add_epi16(mLo, aLo), _mm_add_epi16(mHi, aHi));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), result);
+    }
+#endif
+
+    for (; i < numBytes; ++i)
+    {
+        out[i] = static_cast<uint8_t>((((row2[i] - row1[i]) * lerp) >> 16) + row1[i]);
+    }
+}
+
+/**
+ * Bilinearly resamples the rows [rowBegin..rowEnd) of the output image.
+ * Supports 3 and 4 bytes per pixel. Each invocation uses its own scratch
+ * lines, so disjoint row ranges can be processed concurrently.
+ */
+inline void resampleRows(const uint8_t* in, std::size_t inWidth, std::size_t inHeight,
+    uint8_t* out, std::size_t outWidth, std::size_t outHeight, int bytesPerPixel,
+    std::size_t rowBegin, std::size_t rowEnd)
+{
+    auto inStride = inWidth * bytesPerPixel;
+    auto outStride = outWidth * bytesPerPixel;
+    auto fstep = static_cast<std::size_t>(inHeight * 65536.0f / outHeight);
+    auto endy = inHeight - 1;
+
+    std::vector<uint8_t> row1(outStride);
+    std::vector<uint8_t> row2(outStride);
+
+    // The source line currently held in row1 (row2 holds the one below it)
+    std::size_t cachedLine = 0;
+    bool haveCachedLine = false;
+
+    for (auto i = rowBegin; i < rowEnd; ++i)
+    {
+        auto f = i * fstep;
+        auto yi = f >> 16;
+        auto* outRow = out + i * outStride;
+
+        if (!haveCachedLine || yi != cachedLine)
+        {
+            if (haveCachedLine && yi == cachedLine + 1)
+            {
+                row1.swap(row2);
+            }
+            else
+            {
+                lerpLine(in + yi * inStride, row1.data(), inWidth, outWidth, bytesPerPixel);
+            }
+
+            if (yi < endy)
+            {
+                lerpLine(in + (yi + 1) * inStride, row2.data(), inWidth, outWidth, bytesPerPixel);
+            }
+
+            cachedLine = yi;
+            haveCachedLine = true;
+        }
+
+        if (yi < endy)
+        {
+            lerpRows(row1.data(), row2.data(), outRow, outStride, static_cast<int>(f & 0xFFFF));
+        }
+        else
+        {
+            std::memcpy(outRow, row1.data(), outStride);
+        }
+    }
+}
+
+// Resamples the whole image, distributing the output rows across threads
+inline void resample(const uint8_t* in, std::size_t inWidth, std::size_t inHeight,
+    uint8_t* out, std::size_t outWidth, std::size_t outHeight, int bytesPerPixel)
+{
+    util::parallelFor(outHeight, getMinRowsPerBatch(outWidth), [&](std::size_t begin, std::size_t end)
+    {
+        resampleRows(in, inWidth, inHeight, out, outWidth, outHeight, bytesPerPixel, begin, end);
+    });
+}
+
+// Replaces the RGB components of every RGBA pixel in the range with the value in the given table
+inline void applyGammaTable(uint8_t* pixels, std::size_t numPixels, const uint8_t table[256])
+{
+    util::parallelFor(numPixels, MinPixelsPerBatch, [&](std::size_t begin, std::size_t end)
+    {
+        for (auto* p = pixels + begin * 4, *last = pixels + end * 4; p < last; p += 4)
+        {
+            p[0] = table[p[0]];
+            p[1] = table[p[1]];
+            p[2] = table[p[2]];
+        }
+    });
+}
+
+// Returns the dimension of a mip level following the given one
+inline std::size_t getReducedSize(std::size_t size, bool reduce)
+{
+    return reduce ? std::max<std::size_t>(size >> 1, 1) : size;
+}
+
+/**
+ * Box-filters the output rows [rowBegin..rowEnd) of a 2:1 reduction of the given
+ * RGBA image. Each axis can be reduced separately, an axis is only reduced
+ * if it is larger than 1 pixel. Odd trailing rows and columns are dropped.
+ */
+inline void boxReduceRows(const uint8_t* in, std::size_t width, std::size_t height,
+    uint8_t* out, bool reduceWidth, bool reduceHeight, std::size_t rowBegin, std::size_t rowEnd)
+{
+    reduceWidth = reduceWidth && width > 1;
+    reduceHeight = reduceHeight && height > 1;
+
+    auto outWidth = getReducedSize(width, reduceWidth);
+    auto inStride = width * 4;
+    auto xStep = reduceWidth ? 2u : 1u;
+    auto xNext = reduceWidth ? 4u : 0u;
+
+    for (auto y = rowBegin; y < rowEnd; ++y)
+    {
+        const auto* top = in + (reduceHeight ? y * 2 : y) * inStride;
+        const auto* bottom = reduceHeight ? top + inStride : top;
+        auto* dest = out + y * outWidth * 4;
+        std::size_t x = 0;
+
+#ifdef IMAGE_KERNELS_SSE2
+        if (reduceWidth && reduceHeight)
+        {
+            const auto zero = _mm_setzero_si128();
+
+            // Four source pixels per line are reduced to two output pixels
+            for (; x + 2 <= outWidth; x += 2)
+            {
+                auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(top + x * 8));
+                auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + x * 8));
+
+                auto sumLo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+                auto sumHi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+
+                sumLo = _mm_add_epi16(sumLo, _mm_srli_si128(sumLo, 8));
+                sumHi = _mm_add_epi16(sumHi, _mm_srli_si128(sumHi, 8));
+
+                auto result = _mm_srli_epi16(_mm_unpacklo_epi64(sumLo, sumHi), 2);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(dest + x * 4), _mm_packus_epi16(result, zero));
+            }
+        }
+#endif
+
+        for (; x < outWidth; ++x)
+        {
+            const auto* t = top + x * xStep * 4;
+            const auto* b = bottom + x * xStep * 4;
+
+            for (int c = 0; c < 4; ++c)
+            {
+                dest[x * 4 + c] = static_cast<uint8_t>((t[c] + t[c + xNext] + b[c] + b[c + xNext]) >> 2);
+            }
+        }
+    }
+}
+
+// Box-filters the whole image into the output buffer, which must not overlap the input
+inline void boxReduce(const uint8_t* in, std::size_t width, std::size_t height,
+    uint8_t* out, bool reduceWidth, bool reduceHeight)
+{
+    auto outWidth = getReducedSize(width, reduceWidth && width > 1);
+    auto outHeight = getReducedSize(height, reduceHeight && height > 1);
+
+    util::parallelFor(outHeight, getMinRowsPerBatch(outWidth), [&](std::size_t begin, std::size_t end)
+    {
+        boxReduceRows(in, width, height, out, reduceWidth, reduceHeight, begin, end);
+    });
+}
+
+// Filter taps used for the Kaiser-windowed sinc reduction
+constexpr int KaiserRadius = 4;
+constexpr double KaiserAlpha = 4.0;
+
+// Zeroth order modified Bessel function of the first kind
+inline double besselI0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    auto halfX = x * 0.5;
+
+    for (int k = 1; k < 32; ++k)
+    {
+        term *= (halfX / k) * (halfX / k);
+        sum += term;
+
+        if (term < sum * 1e-12) break;
+    }
+
+    return sum;
+}
+
+// Returns the normalised weights of the 2:1 Kaiser filter, sampled at the
+// source pixel centres around the output pixel centre (2 * KaiserRadius taps)
+inline std::vector<float> getKaiserWeights()
+{
+    std::vector<float> weights(KaiserRadius * 2);
+
+    double total = 0;
+    auto denominator = besselI0(KaiserAlpha);
+
+    for (int i = 0; i < KaiserRadius * 2; ++i)
+    {
+        // Distance from the output pixel centre, measured in output pixels
+        auto x = (i - KaiserRadius + 0.5) * 0.5;
+        auto t = x / (KaiserRadius * 0.5);
+        auto window = besselI0(KaiserAlpha * std::sqrt(std::max(1.0 - t * t, 0.0))) / denominator;
+        auto sinc = x == 0 ? 1.0 : std::sin(3.14159265358979323846 * x) / (3.14159265358979323846 * x);
+
+        weights[i] = static_cast<float>(window * sinc);
+        total += weights[i];
+    }
+
+    for (auto& weight : weights)
+    {
+        weight = static_cast<float>(weight / total);
+    }
+
+    return weights;
+}
+
+/**
+ * Reduces the given RGBA image 2:1 along both axes (axes with size 1 are left alone)
+ * using a separable Kaiser-windowed sinc filter, which preserves more detail in the
+ * smaller mipmaps than the box filter. Edge pixels are clamped.
+ */
+inline void kaiserReduce(const uint8_t* in, std::size_t width, std::size_t height, uint8_t* out)
+{
+    static const auto weights = getKaiserWeights();
+
+    auto outWidth = getReducedSize(width, width > 1);
+    auto outHeight = getReducedSize(height, height > 1);
+
+    auto clampIndex = [](std::ptrdiff_t i, std::size_t size)
+    {
+        return static_cast<std::size_t>(std::min<std::ptrdiff_t>(std::max<std::ptrdiff_t>(i, 0), size - 1));
+    };
+
+    // Horizontal pass into a floating point buffer (outWidth x height)
+    std::vector<float> temp(outWidth * height * 4);
+
+    util::parallelFor(height, getMinRowsPerBatch(width), [&](std::size_t begin, std::size_t end)
+    {
+        for (auto y = begin; y < end; ++y)
+        {
+            const auto* src = in + y * width * 4;
+            auto* dest = temp.data() + y * outWidth * 4;
+
+            for (std::size_t x = 0; x < outWidth; ++x)
+            {
+                float sum[4] = { 0, 0, 0, 0 };
+
+                for (int tap = 0; tap < KaiserRadius * 2; ++tap)
+                {
+                    auto sx = width > 1 ? clampIndex(static_cast<std::ptrdiff_t>(x * 2) + tap - KaiserRadius + 1, width) : 0;
+                    auto weight = width > 1 ? weights[tap] : 1.0f / (KaiserRadius * 2);
+
+                    for (int c = 0; c < 4; ++c)
+                    {
+                        sum[c] += src[sx * 4 + c] * weight;
+                    }
+                }
+
+                std::copy(sum, sum + 4, dest + x * 4);
+            }
+        }
+    });
+
+    // Vertical pass into the output
+    util::parallelFor(outHeight, getMinRowsPerBatch(outWidth), [&](std::size_t begin, std::size_t end)
+    {
+        for (auto y = begin; y < end; ++y)
+        {
+            auto* dest = out + y * outWidth * 4;
+
+            for (std::size_t x = 0; x < outWidth * 4; ++x)
+            {
+                float sum = 0;
+
+                for (int tap = 0; tap < KaiserRadius * 2; ++tap)
+                {
+                    auto sy = height > 1 ? clampIndex(static_cast<std::ptrdiff_t>(y * 2) + tap - KaiserRadius + 1, height) : 0;
+                    auto weight = height > 1 ? weights[tap] : 1.0f / (KaiserRadius * 2);
+
+                    sum += temp[sy * outWidth * 4 + x] * weight;
+                }
+
+                dest[x] = static_cast<uint8_t>(std::min(std::max(sum + 0.5f, 0.0f), 255.0f));
+            }
+        }
+    });
+}
+
+} // namespace
+
+enum class MipFilter
+{
+    Box,
+    Kaiser,
+};
+
+// A single reduced level of a mipmap chain (RGBA pixels)
+struct MipLevel
+{
+    std::size_t width;
+    std::size_t height;
+    std::vector<uint8_t> pixels;
+};
+
+/**
+ * Generates the full chain of mipmaps for the given RGBA image, down to 1x1.
+ * The returned vector starts with mip level 1, the input image itself is level 0.
+ */
+inline std::vector<MipLevel> generateMipChain(const uint8_t* pixels, std::size_t width, std::size_t height,
+    MipFilter filter = MipFilter::Box)
+{
+    std::vector<MipLevel> levels;
+
+    const auto* source = pixels;
+
+    while (width > 1 || height > 1)
+    {
+        MipLevel level;
+        level.width = kernels::getReducedSize(width, width > 1);
+        level.height = kernels::getReducedSize(height, height > 1);
+        level.pixels.resize(level.width * level.height * 4);
+
+        if (filter == MipFilter::Kaiser)
+        {
+            kernels::kaiserReduce(source, width, height, level.pixels.data());
+        }
+        else
+        {
+            kernels::boxReduce(source, width, height, level.pixels.data(), true, true);
+        }
+
+        width = level.width;
+        height = level.height;
+
+        levels.emplace_back(std::move(level));
+        source = levels.back().pixels.data();
+    }
+
+    return levels;
+}
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+#include "math/AABB.h"
+
+/**
+ * A set of AABBs stored as structure of arrays, every origin and extents
+ * component lives in its own contiguous array. This is the input layout of
+ * the batched intersection tests, see Frustum::testIntersection(), which
+ * classify several boxes per instruction.
+ *
+ * The batch is meant to be cleared and refilled, the arrays keep their
+ * capacity between uses.
+ */
+class AABBBatch
+{
+public:
+    std::vector<double> originX;
+    std::vector<double> originY;
+    std::vector<double> originZ;
+
+    std::vector<double> extentsX;
+    std::vector<double> extentsY;
+    std::vector<double> extentsZ;
+
+    std::size_t size() const
+    {
+        return originX.size();
+    }
+
+    bool empty() const
+    {
+        return originX.empty();
+    }
+
+    void clear()
+    {
+        originX.clear();
+        originY.clear();
+        originZ.clear();
+        extentsX.clear();
+        extentsY.clear();
+        extentsZ.clear();
+    }
+
+    void add(const AABB& aabb)
+    {
+        originX.push_back(aabb.origin.x());
+        originY.push_back(aabb.origin.y());
+        originZ.push_back(aabb.origin.z());
+        extentsX.push_back(aabb.extents.x());
+        extentsY.push_back(aabb.extents.y());
+        extentsZ.push_back(aabb.extents.z());
+    }
+
+    AABB get(std::size_t index) const
+    {
+        return AABB(
+            Vector3(originX[index], originY[index], originZ[index]),
+            Vector3(extentsX[index], extentsY[index], extentsZ[index])
+        );
+    }
+};
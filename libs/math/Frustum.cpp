@@ -1,6 +1,13 @@
 #include "Frustum.h"
 
 #include "AABB.h"
+#include "AABBBatch.h"
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FRUSTUM_BATCH_SSE2
+#endif
 
 // Normalise all planes in frustum
 void Frustum::normalisePlanes()
@@ -140,6 +147,73 @@ VolumeIntersectionValue Frustum::testIntersection(const AABB& aabb) const
     return result;
 }
 
+void Frustum::testIntersection(const AABBBatch& boxes, VolumeIntersectionValue* results) const
+{
+    std::size_t count = boxes.size();
+    std::size_t i = 0;
+
+#ifdef FRUSTUM_BATCH_SSE2
+    const Plane3* planes[] = { &right, &left, &bottom, &top, &back, &front };
+
+    // The operations are performed in the same order as in AABB::classifyPlane
+    // such that the results are bit-identical to the scalar test.
+    // A box is outside as soon as it's outside one of the planes, it is
+    // inside if it's inside all of them, and partially inside otherwise.
+    for (; i + 2 <= count; i += 2)
+    {
+        auto originX = _mm_loadu_pd(boxes.originX.data() + i);
+        auto originY = _mm_loadu_pd(boxes.originY.data() + i);
+        auto originZ = _mm_loadu_pd(boxes.originZ.data() + i);
+        auto extentsX = _mm_loadu_pd(boxes.extentsX.data() + i);
+        auto extentsY = _mm_loadu_pd(boxes.extentsY.data() + i);
+        auto extentsZ = _mm_loadu_pd(boxes.extentsZ.data() + i);
+
+        auto zero = _mm_setzero_pd();
+        auto outside = _mm_setzero_pd();
+        auto inside = _mm_cmpeq_pd(zero, zero); // all bits set
+
+        for (auto plane : planes)
+        {
+            const auto& normal = plane->normal();
+
+            auto normalX = _mm_set1_pd(normal.x());
+            auto normalY = _mm_set1_pd(normal.y());
+            auto normalZ = _mm_set1_pd(normal.z());
+            auto dist = _mm_set1_pd(plane->dist());
+
+            auto originDot = _mm_add_pd(_mm_add_pd(
+                _mm_mul_pd(normalX, originX), _mm_mul_pd(normalY, originY)),
+                _mm_mul_pd(normalZ, originZ));
+
+            auto extentsDot = _mm_add_pd(_mm_add_pd(
+                _mm_mul_pd(_mm_set1_pd(fabs(normal.x())), extentsX),
+                _mm_mul_pd(_mm_set1_pd(fabs(normal.y())), extentsY)),
+                _mm_mul_pd(_mm_set1_pd(fabs(normal.z())), extentsZ));
+
+            outside = _mm_or_pd(outside,
+                _mm_cmplt_pd(_mm_sub_pd(_mm_add_pd(originDot, extentsDot), dist), zero));
+            inside = _mm_and_pd(inside,
+                _mm_cmpge_pd(_mm_sub_pd(_mm_sub_pd(originDot, extentsDot), dist), zero));
+        }
+
+        auto outsideBits = _mm_movemask_pd(outside);
+        auto insideBits = _mm_movemask_pd(inside);
+
+        for (int lane = 0; lane < 2; ++lane)
+        {
+            results[i + lane] = (outsideBits & (1 << lane)) ? VOLUME_OUTSIDE :
+                (insideBits & (1 << lane)) ? VOLUME_INSIDE : VOLUME_PARTIAL;
+        }
+    }
+#endif
+
+    // Remaining boxes (or all of them without SSE2)
+    for (; i < count; ++i)
+    {
+        results[i] = testIntersection(boxes.get(i));
+    }
+}
+
 VolumeIntersectionValue Frustum::testIntersection(const AABB& aabb, const Matrix4& localToWorld) const
 {
 	AABB aabb_world(aabb);
@@ -12,6 +12,7 @@
 #include "VolumeIntersectionValue.h"
 
 class AABB;
+class AABBBatch;
 class Plane3;
 
 /**
@@ -63,6 +64,14 @@ public:
     /// Test the intersection of this frustum with a transformed AABB.
     VolumeIntersectionValue testIntersection(const AABB& aabb, const Matrix4& localToWorld) const;
 
+    /**
+     * Test the intersection of this frustum with every AABB of the given batch,
+     * writing one classification per box to the results array (which must be
+     * large enough). The results are the same as the ones of the single-box
+     * testIntersection(), the boxes are just classified in pairs using SSE2.
+     */
+    void testIntersection(const AABBBatch& boxes, VolumeIntersectionValue* results) const;
+
     /// Enum representing the corner points of each end plane
     enum Corner
     {
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include "ParseException.h"
+
+namespace parser
+{
+
+/**
+ * Lightweight tokeniser for large, mostly numeric text files like
+ * AAS files or pointfiles. It works on a buffer held in memory and returns
+ * tokens as views into that buffer, numbers are converted in place without
+ * allocating a string per token.
+ *
+ * Tokens are separated by whitespace, the characters {}() are returned
+ * as tokens of their own. C and C++ style comments are skipped. There's
+ * no support for quoted strings, use the DefTokeniser for these.
+ *
+ * The reader doesn't touch any shared state, it can be used on a worker
+ * thread. All methods throw a ParseException on unexpected input.
+ */
+class NumericTextReader
+{
+private:
+    const char* _pos;
+    const char* _end;
+
+    // Numbers are copied here for the C conversion functions needing a terminator
+    static constexpr std::size_t MaxNumberLength = 64;
+
+public:
+    // The buffer needs to stay alive as long as this reader is in use
+    explicit NumericTextReader(std::string_view buffer) :
+        _pos(buffer.data()),
+        _end(buffer.data() + buffer.size())
+    {}
+
+    bool hasMoreTokens()
+    {
+        skipWhitespaceAndComments();
+        return _pos < _end;
+    }
+
+    // Returns the next token without consuming it
+    std::string_view peek()
+    {
+        auto pos = _pos;
+        auto token = nextToken();
+        _pos = pos;
+
+        return token;
+    }
+
+    std::string_view nextToken()
+    {
+        if (!hasMoreTokens())
+        {
+            throw ParseException("NumericTextReader: no more tokens");
+        }
+
+        auto start = _pos;
+
+        if (isKeptDelimiter(*_pos))
+        {
+            return std::string_view(start, ++_pos - start);
+        }
+
+        while (_pos < _end && !isWhitespace(*_pos) && !isKeptDelimiter(*_pos))
+        {
+            ++_pos;
+        }
+
+        return std::string_view(start, _pos - start);
+    }
+
+    void assertNextToken(std::string_view expected)
+    {
+        auto token = nextToken();
+
+        if (token != expected)
+        {
+            throw ParseException("NumericTextReader: Assertion failed: Required \"" +
+                std::string(expected) + "\", found \"" + std::string(token) + "\"");
+        }
+    }
+
+    // Reads the next token as integer of the given type, the whole token needs to be numeric
+    template<typename IntegerType>
+    IntegerType nextInteger()
+    {
+        auto token = nextToken();
+
+        IntegerType value = 0;
+        auto result = std::from_chars(token.data(), token.data() + token.size(), value);
+
+        if (result.ec != std::errc() || result.ptr != token.data() + token.size())
+        {
+            throw ParseException("NumericTextReader: Expected an integer, found \"" + std::string(token) + "\"");
+        }
+
+        return value;
+    }
+
+    double nextDouble()
+    {
+        char buffer[MaxNumberLength];
+        auto length = copyNumberToken(buffer);
+
+        char* end = nullptr;
+        auto value = std::strtod(buffer, &end);
+
+        if (end != buffer + length)
+        {
+            throw ParseException("NumericTextReader: Expected a number, found \"" + std::string(buffer) + "\"");
+        }
+
+        return value;
+    }
+
+    float nextFloat()
+    {
+        char buffer[MaxNumberLength];
+        auto length = copyNumberToken(buffer);
+
+        char* end = nullptr;
+        auto value = std::strtof(buffer, &end);
+
+        if (end != buffer + length)
+        {
+            throw ParseException("NumericTextReader: Expected a number, found \"" + std::string(buffer) + "\"");
+        }
+
+        return value;
+    }
+
+    // Returns the next block including its surrounding braces, nested blocks are included
+    std::string_view nextBlock()
+    {
+        skipWhitespaceAndComments();
+
+        auto start = _pos;
+        skipBlock();
+
+        return std::string_view(start, _pos - start);
+    }
+
+    // Consumes the next block, including all nested blocks
+    void skipBlock()
+    {
+        assertNextToken("{");
+
+        for (std::size_t depth = 1; depth > 0;)
+        {
+            auto token = nextToken();
+
+            if (token == "{")
+            {
+                ++depth;
+            }
+            else if (token == "}")
+            {
+                --depth;
+            }
+        }
+    }
+
+private:
+    static bool isWhitespace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v';
+    }
+
+    static bool isKeptDelimiter(char c)
+    {
+        return c == '{' || c == '}' || c == '(' || c == ')';
+    }
+
+    void skipWhitespaceAndComments()
+    {
+        while (_pos < _end)
+        {
+            if (isWhitespace(*_pos))
+            {
+                ++_pos;
+            }
+            else if (*_pos == '/' && _pos + 1 < _end && _pos[1] == '/')
+            {
+                while (_pos < _end && *_pos != '\n') ++_pos;
+            }
+            else if (*_pos == '/' && _pos + 1 < _end && _pos[1] == '*')
+            {
+                _pos += 2;
+
+                while (_pos < _end && !(*_pos == '*' && _pos + 1 < _end && _pos[1] == '/')) ++_pos;
+
+                _pos = _pos < _end ? _pos + 2 : _end;
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+
+    // Copies the next token to the given buffer and null-terminates it, returns its length
+    std::size_t copyNumberToken(char (&buffer)[MaxNumberLength])
+    {
+        auto token = nextToken();
+
+        if (token.size() >= MaxNumberLength)
+        {
+            throw ParseException("NumericTextReader: Number too long: \"" + std::string(token) + "\"");
+        }
+
+        std::memcpy(buffer, token.data(), token.size());
+        buffer[token.size()] = '\0';
+
+        return token.size();
+    }
+};
+
+}
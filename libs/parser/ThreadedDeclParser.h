@@ -3,6 +3,7 @@
 #include "ifilesystem.h"
 #include "itextstream.h"
 #include "idecltypes.h"
+#include "iprofiler.h"
 #include "debugging/ScopedDebugTimer.h"
 #include "parser/ParseException.h"
 #include "parser/ThreadedDefLoader.h"
@@ -28,7 +29,7 @@ protected:
     // Construct a parser traversing all files matching the given extension in the given VFS path
     // Subclasses need to implement the parse(std::istream) overload for this scenario
     ThreadedDeclParser(decl::Type declType, const std::string& baseDir, const std::string& extension, std::size_t depth = 1) :
-        ThreadedDefLoader<ReturnType>(std::bind(&ThreadedDeclParser::doParse, this)),
+        ThreadedDefLoader<ReturnType>(std::bind(&ThreadedDeclParser::doParse, this), "Parse " + decl::getTypeName(declType)),
         _baseDir(baseDir),
         _extension(extension),
         _depth(depth),
@@ -76,6 +77,7 @@ protected:
     void processFiles()
     {
         ScopedDebugTimer timer("[DeclParser] Parsed " + decl::getTypeName(_declType) + " declarations");
+        PROFILE_ZONE("ThreadedDeclParser::processFiles");
 
         // Accumulate all the files and sort them before calling the protected parse() method
         std::vector<vfs::FileInfo> _incomingFiles;
@@ -3,14 +3,16 @@
 #include <future>
 #include <functional>
 #include <algorithm>
+#include <mutex>
 #include <sigc++/signal.h>
 #include <vector>
+#include "ijobsystem.h"
 
 namespace parser
 {
 
 /**
- * Helper class used to asynchronically parse/load def files in a separate thread.
+ * Helper class used to asynchronically parse/load def files as task of the job system.
  *
  * The worker thread itself is ensured to be called in a thread-safe 
  * way (to prevent the worker from being invoked twice). Subsequent calls to 
@@ -31,15 +33,23 @@ private:
     LoadFunction _loadFunc;
     FinishedSignal _finishedSignal;
 
+    // The name of the job groups, identifying this loader in the job statistics
+    std::string _name;
+
     std::shared_future<ReturnType> _result;
-    std::shared_future<void> _finisher;
+
+    // Runs the load function, followed by the group emitting the finished signal
+    jobs::IJobGroup::Ptr _loader;
+    jobs::IJobGroup::Ptr _finisher;
+
     std::mutex _mutex;
 
     bool _loadingStarted;
 
 public:
-    ThreadedDefLoader(const LoadFunction& loadFunc) :
+    ThreadedDefLoader(const LoadFunction& loadFunc, const std::string& name) :
         _loadFunc(loadFunc),
+        _name(name),
         _loadingStarted(false)
     {}
     
@@ -70,33 +80,35 @@ public:
     ReturnType get()
     {
         // Make sure we already started the loader
-        ensureLoaderStarted();
+        auto loader = ensureLoaderStarted();
+
+        // Help running the loader if no worker has picked it up yet
+        loader->wait();
 
         // Wait for the result or return if it's already done.
         return _result.get();
     }
 
     // Resets the state of the loader to the state it had after construction.
-    // If a background thread has been started, this will block and wait for it to finish.
+    // If a background task has been started, this will block and wait for it to finish.
     void reset()
     {
         std::lock_guard<std::mutex> lock(_mutex);
 
-        // Wait for any running thread to finish
+        // Wait for any running task to finish
         if (_loadingStarted)
         {
+            _loader->wait();
+            _finisher->wait();
+
             if (_result.valid())
             {
                 _result.get();
             }
 
-            if (_finisher.valid())
-            {
-                _finisher.get();
-            }
-
             _result = std::shared_future<ReturnType>();
-            _finisher = std::shared_future<void>();
+            _loader.reset();
+            _finisher.reset();
 
             _loadingStarted = false;
         }
@@ -108,36 +120,24 @@ public:
     }
 
 private:
-    struct FinishSignalEmitter
-    {
-        FinishedSignal& _signal;
-        std::shared_future<void>& _targetFuture;
-
-        FinishSignalEmitter(FinishedSignal& signal, std::shared_future<void>& targetFuture) :
-            _signal(signal),
-            _targetFuture(targetFuture)
-        {}
-
-        ~FinishSignalEmitter()
-        {
-            _targetFuture = std::async(std::launch::async, std::bind(&FinishedSignal::emit, _signal));
-        }
-    };
-
-    void ensureLoaderStarted()
+    jobs::IJobGroup::Ptr ensureLoaderStarted()
     {
         std::lock_guard<std::mutex> lock(_mutex);
 
         if (!_loadingStarted)
         {
             _loadingStarted = true;
-            _result = std::async(std::launch::async, [&]()
-            {
-                // When going out of scope, this instance invokes the finished signal in a separate thread
-                FinishSignalEmitter finisher(_finishedSignal, _finisher);
-                return _loadFunc();
-            });
+
+            _loader = GlobalJobSystem().createGroup(_name);
+            _result = jobs::runWithResult(_loader, [this]() { return _loadFunc(); }).share();
+
+            // The finished signal is emitted by a separate task once the loader is done
+            _finisher = GlobalJobSystem().createGroup(_name + " finished signal");
+            _finisher->addDependency(_loader);
+            _finisher->run([this]() { _finishedSignal.emit(); });
         }
+
+        return _loader;
     }
 };
 
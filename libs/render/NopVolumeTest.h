@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+
 #include "ivolumetest.h"
 #include "math/Matrix4.h"
 
@@ -58,6 +60,11 @@ public:
 		return VOLUME_INSIDE;
 	}
 
+	void TestAABBs(const AABBBatch& boxes, VolumeIntersectionValue* results) const
+	{
+		std::fill(results, results + boxes.size(), VOLUME_INSIDE);
+	}
+
 	virtual bool fill() const
 	{ 
 		return true;
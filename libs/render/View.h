@@ -148,6 +148,14 @@ public:
 		return _frustum.testIntersection(aabb, localToWorld);
 	}
 
+	void TestAABBs(const AABBBatch& boxes, VolumeIntersectionValue* results) const override
+	{
+#ifdef DEBUG_CULLING
+		const_cast<View*>(this)->_count_bboxs += static_cast<int>(boxes.size());
+#endif
+		_frustum.testIntersection(boxes, results);
+	}
+
 	const Matrix4& GetViewProjection() const override
 	{
 		return _viewproj;
@@ -0,0 +1,129 @@
+#include "LayerList.h"
+
+#include <algorithm>
+#include <bitset>
+
+namespace scene
+{
+
+namespace
+{
+    constexpr std::size_t BitsPerWord = 64;
+
+    std::size_t countBits(std::uint64_t word)
+    {
+        return std::bitset<BitsPerWord>(word).count();
+    }
+
+    // Index of the lowest set bit, the word must not be zero
+    int countTrailingZeros(std::uint64_t word)
+    {
+        // All bits below the lowest set one
+        return static_cast<int>(countBits((word & (~word + 1)) - 1));
+    }
+}
+
+LayerList::LayerList(std::initializer_list<int> layerIds)
+{
+    for (auto id : layerIds)
+    {
+        insert(id);
+    }
+}
+
+std::size_t LayerList::size() const
+{
+    std::size_t result = 0;
+
+    for (auto word : _words)
+    {
+        result += countBits(word);
+    }
+
+    return result;
+}
+
+std::size_t LayerList::count(int layerId) const
+{
+    if (layerId < 0) return 0;
+
+    auto wordIndex = static_cast<std::size_t>(layerId) / BitsPerWord;
+
+    if (wordIndex >= _words.size()) return 0;
+
+    return (_words[wordIndex] >> (layerId % BitsPerWord)) & 1;
+}
+
+void LayerList::insert(int layerId)
+{
+    if (layerId < 0) return;
+
+    auto wordIndex = static_cast<std::size_t>(layerId) / BitsPerWord;
+
+    if (wordIndex >= _words.size())
+    {
+        _words.resize(wordIndex + 1);
+    }
+
+    _words[wordIndex] |= std::uint64_t(1) << (layerId % BitsPerWord);
+}
+
+void LayerList::insert(const LayerList& other)
+{
+    if (_words.size() < other._words.size())
+    {
+        _words.resize(other._words.size());
+    }
+
+    for (std::size_t i = 0; i < other._words.size(); ++i)
+    {
+        _words[i] |= other._words[i];
+    }
+}
+
+std::size_t LayerList::erase(int layerId)
+{
+    if (count(layerId) == 0) return 0;
+
+    _words[static_cast<std::size_t>(layerId) / BitsPerWord] &= ~(std::uint64_t(1) << (layerId % BitsPerWord));
+
+    while (!_words.empty() && _words.back() == 0)
+    {
+        _words.pop_back();
+    }
+
+    return 1;
+}
+
+bool LayerList::intersects(const LayerList& other) const
+{
+    auto commonWords = std::min(_words.size(), other._words.size());
+
+    for (std::size_t i = 0; i < commonWords; ++i)
+    {
+        if ((_words[i] & other._words[i]) != 0) return true;
+    }
+
+    return false;
+}
+
+int LayerList::findNext(int layerId) const
+{
+    auto wordIndex = static_cast<std::size_t>(layerId) / BitsPerWord;
+
+    if (wordIndex >= _words.size()) return -1;
+
+    // Mask out the bits below the start ID in its own word
+    auto word = _words[wordIndex] & (~std::uint64_t(0) << (layerId % BitsPerWord));
+
+    while (word == 0)
+    {
+        if (++wordIndex == _words.size()) return -1;
+
+        word = _words[wordIndex];
+    }
+
+    return static_cast<int>(wordIndex * BitsPerWord) + countTrailingZeros(word);
+}
+
+}
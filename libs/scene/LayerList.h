@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+namespace scene
+{
+
+/**
+ * The set of layer IDs a node is a member of, stored as a bitset.
+ * Iterating over it yields the IDs in ascending order.
+ * Negative IDs are not valid layer IDs and are ignored.
+ */
+class LayerList
+{
+private:
+    // One bit per layer ID, never has any trailing zero words
+    std::vector<std::uint64_t> _words;
+
+public:
+    class const_iterator
+    {
+    private:
+        const LayerList* _list;
+        int _id;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = int;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const int*;
+        using reference = const int&;
+
+        const_iterator(const LayerList* list, int id) :
+            _list(list),
+            _id(id)
+        {}
+
+        const int& operator*() const
+        {
+            return _id;
+        }
+
+        const_iterator& operator++()
+        {
+            _id = _list->findNext(_id + 1);
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            auto previous = *this;
+            ++(*this);
+            return previous;
+        }
+
+        bool operator==(const const_iterator& other) const
+        {
+            return _id == other._id;
+        }
+
+        bool operator!=(const const_iterator& other) const
+        {
+            return _id != other._id;
+        }
+    };
+
+    typedef const_iterator iterator;
+    typedef int value_type;
+
+    LayerList() = default;
+    LayerList(std::initializer_list<int> layerIds);
+
+    bool empty() const
+    {
+        return _words.empty();
+    }
+
+    std::size_t size() const;
+
+    std::size_t count(int layerId) const;
+
+    const_iterator find(int layerId) const
+    {
+        return count(layerId) > 0 ? const_iterator(this, layerId) : end();
+    }
+
+    void insert(int layerId);
+
+    template<typename InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    {
+        for (; first != last; ++first)
+        {
+            insert(*first);
+        }
+    }
+
+    // Adds all IDs of the other list to this one
+    void insert(const LayerList& other);
+
+    // Returns the number of removed elements (0 or 1)
+    std::size_t erase(int layerId);
+
+    void clear()
+    {
+        _words.clear();
+    }
+
+    // Returns true if the two lists share at least one layer ID
+    bool intersects(const LayerList& other) const;
+
+    const_iterator begin() const
+    {
+        return const_iterator(this, findNext(0));
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, -1);
+    }
+
+    bool operator==(const LayerList& other) const
+    {
+        return _words == other._words;
+    }
+
+    bool operator!=(const LayerList& other) const
+    {
+        return _words != other._words;
+    }
+
+private:
+    // Returns the lowest contained ID >= the given one, or -1 if there is none
+    int findNext(int layerId) const;
+};
+
+}
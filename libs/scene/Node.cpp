@@ -126,27 +126,32 @@ bool Node::excluded() const
 
 void Node::addToLayer(int layerId)
 {
+	if (_layers.count(layerId) > 0) return;
+
 	_layers.insert(layerId);
+	onLayersChanged();
 }
 
 void Node::moveToLayer(int layerId)
 {
+	if (_layers.size() == 1 && _layers.count(layerId) > 0) return;
+
 	_layers.clear();
 	_layers.insert(layerId);
+	onLayersChanged();
 }
 
 void Node::removeFromLayer(int layerId)
 {
 	// Look up the layer ID and remove it from the list
-	LayerList::iterator found = _layers.find(layerId);
-
-	if (found != _layers.end()) {
-		_layers.erase(found);
-
+	if (_layers.erase(layerId) > 0)
+	{
 		// greebo: Make sure that every node is at least member of layer 0
 		if (_layers.empty()) {
 			_layers.insert(0);
 		}
+
+		onLayersChanged();
 	}
 }
 
@@ -157,12 +162,26 @@ const LayerList& Node::getLayers() const
 
 void Node::assignToLayers(const LayerList& newLayers)
 {
-	if (!newLayers.empty())
+	if (!newLayers.empty() && newLayers != _layers)
     {
         _layers = newLayers;
+        onLayersChanged();
     }
 }
 
+void Node::onLayersChanged()
+{
+	if (!_instantiated) return;
+
+	// The layer manager is resolved through the root, nodes can move between scenes
+	auto root = getRootNode();
+
+	if (root)
+	{
+		root->getLayerManager().onNodeLayersChanged(*this);
+	}
+}
+
 void Node::addChildNode(const INodePtr& node)
 {
 	// Add the node to the TraversableNodeSet, this triggers an
@@ -295,6 +314,12 @@ void Node::onInsertIntoScene(IMapRootNode& root)
 {
 	_instantiated = true;
 
+	// Let the layer manager keep track of the layer members, the root itself is not layered
+	if (getNodeType() != Type::MapRoot && supportsStateFlag(eLayered))
+	{
+		root.getLayerManager().registerNode(*this);
+	}
+
     // The node was 100% not visible before, check if it is now
     if (visible())
     {
@@ -308,6 +333,11 @@ void Node::onRemoveFromScene(IMapRootNode& root)
 {
     disconnectUndoSystem(root.getUndoSystem());
 
+    if (getNodeType() != Type::MapRoot && supportsStateFlag(eLayered))
+    {
+        root.getLayerManager().unregisterNode(*this);
+    }
+
     bool wasVisible = visible();
 
 	_instantiated = false;
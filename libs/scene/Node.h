@@ -226,6 +226,8 @@ protected:
 	virtual void removeAllChildNodes();
 
 private:
+    void onLayersChanged();
+
     void connectUndoSystem(IUndoSystem& undoSystem);
     void disconnectUndoSystem(IUndoSystem& undoSystem);
 
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <vector>
+#include <iterator>
 #include "math/Vector3.h"
+#include "parser/NumericTextReader.h"
 
 namespace map
 {
@@ -21,12 +24,24 @@ public:
     /// Construct a PointTrace to read point data from the given stream
     explicit PointTrace(std::istream& stream)
     {
-        // Point file consists of one point per line, with three components
-        double x, y, z;
-        while (stream >> x >> y >> z)
+        std::string buffer{ std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>() };
+        parser::NumericTextReader reader(buffer);
+
+        // Point file consists of one point per line, with three components.
+        // Parsing stops at the first incomplete or invalid point.
+        try
         {
-            _points.push_back(Vector3(x, y, z));
+            while (reader.hasMoreTokens())
+            {
+                auto x = reader.nextDouble();
+                auto y = reader.nextDouble();
+                auto z = reader.nextDouble();
+
+                _points.push_back(Vector3(x, y, z));
+            }
         }
+        catch (const parser::ParseException&)
+        {}
     }
 
     /// Return points parsed
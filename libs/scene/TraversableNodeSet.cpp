@@ -1,78 +1,34 @@
 #include "TraversableNodeSet.h"
 
 #include "debugging/debugging.h"
-#include <algorithm>
+#include <vector>
 #include "LayerValidityCheckWalker.h"
-#include "BasicUndoMemento.h"
 #include "Node.h"
 
 namespace scene
 {
 
-// An ObserverFunctor does something with the given owner and a given child <node>
-struct ObserverFunctor {
-    virtual ~ObserverFunctor() {}
-	virtual void operator() (Node& owner, const INodePtr& node) = 0;
-};
-
-// This calls onChildRemoved() on the given <observer>
-struct ObserverEraseFunctor :
-	public ObserverFunctor
-{
-	void operator() (Node& owner, const INodePtr& node)
-	{
-		owner.onChildRemoved(node);
-	}
-};
-
-/** greebo: This iterator is required by the std::set_difference algorithm and
- * is used to call	owning node's onChildAdded() or onChildRemoved()
- * as soon as the assignment operator is invoked by the set_difference algorithm.
- *
- * Note: The operator++ is part of the algorithm requirement, its implementation 
- * is used to trigger the observer call.
+/**
+ * The undo memento of a TraversableNodeSet, recording the children
+ * that have been inserted or removed during a single undo operation.
  */
-class ObserverOutputIterator
+class TraversableNodeSet::ChangeJournal final :
+	public IUndoMemento
 {
-protected:
-	Node* _owner;
-	ObserverFunctor& _functor;
 public:
-	typedef std::output_iterator_tag iterator_category;
-	typedef void difference_type;
-	typedef void value_type;
-	typedef void pointer;
-	typedef void reference;
-
-	ObserverOutputIterator(Node& owner, ObserverFunctor& functor) :
-		_owner(&owner),
-		_functor(functor)
-	{}
-
-	// This function is invoked by the std::set_difference algorithm
-	ObserverOutputIterator& operator=(const INodePtr& node)
+	struct Change
 	{
-		// Pass the call to the functor
-		_functor(*_owner, node);
-		return *this;
-	}
+		bool inserted;
+		INodePtr node;
 
-	// Assignment operator, as needed by VC++ 2010's STL implementation
-	ObserverOutputIterator& operator=(const ObserverOutputIterator& other)
-	{
-		// Pass the call to the functor
-		_owner = other._owner;
-		_functor = other._functor;
-		return *this;
-	}
+		// The child following a removed node, empty if it was the last one
+		INodePtr successor;
+	};
 
-	ObserverOutputIterator& operator*() { return *this; }
-	ObserverOutputIterator& operator++() { return *this; }
-	ObserverOutputIterator& operator++(int) { return *this; }
+	// The changes in the order they happened
+	std::vector<Change> changes;
 };
 
-typedef undo::BasicUndoMemento<TraversableNodeSet::NodeList> UndoListMemento;
-
 // Default constructor, creates an empty set
 TraversableNodeSet::TraversableNodeSet(Node& owner) :
 	_owner(owner),
@@ -91,7 +47,7 @@ void TraversableNodeSet::append(const INodePtr& node)
 	undoSave();
 
 	// Insert the child node at the end of the list
-	_children.push_back(node);
+	insertChild(_children.end(), node);
 
 	// Notify the owner (note: this usually triggers instantiation of the node)
 	_owner.onChildAdded(node);
@@ -103,7 +59,7 @@ void TraversableNodeSet::prepend(const INodePtr& node)
 	undoSave();
 
 	// Insert the child node at the front of the list
-	_children.push_front(node);
+	insertChild(_children.begin(), node);
 
 	// Notify the owner (note: this usually triggers instantiation of the node)
 	_owner.onChildAdded(node);
@@ -116,20 +72,27 @@ void TraversableNodeSet::erase(const INodePtr& node)
 	// Notify the Observer before actually removing the node
 	_owner.onChildRemoved(node);
 
-	// Lookup the node and remove it from the list
-	NodeList::iterator i = std::find(_children.begin(), _children.end(), node);
-
-    if (i != _children.end())
-	{
-        _children.erase(i);
-    }
+	removeChild(node);
 }
 
 void TraversableNodeSet::clear()
 {
 	undoSave();
 	notifyEraseAll();
-	_children.clear();
+
+	if (!_journal)
+	{
+		_children.clear();
+		_childIndex.clear();
+		return;
+	}
+
+	// Remove the nodes one by one to record them in the journal
+	while (!_children.empty())
+	{
+		auto node = _children.front();
+		removeChild(node);
+	}
 }
 
 void TraversableNodeSet::traverse(NodeVisitor& visitor) const
@@ -179,65 +142,121 @@ void TraversableNodeSet::connectUndoSystem(IUndoSystem& undoSystem)
 void TraversableNodeSet::disconnectUndoSystem(IUndoSystem& undoSystem)
 {
     _undoStateSaver = nullptr;
+    _journal.reset();
     undoSystem.releaseStateSaver(*this);
 }
 
 void TraversableNodeSet::undoSave()
 {
-    if (_undoStateSaver != nullptr)
+    if (_undoStateSaver != nullptr && _undoStateSaver->getUndoSystem().operationStarted())
 	{
+		// This will call exportState() if this is the first change in this operation,
+		// which creates a new journal. Otherwise the journal of this operation is kept.
 		_undoStateSaver->saveState();
 	}
+	else
+	{
+		// Changes outside of an undoable operation are not recorded
+		_journal.reset();
+	}
+}
+
+void TraversableNodeSet::insertChild(NodeList::iterator position, const INodePtr& node)
+{
+	_childIndex[node.get()] = _children.insert(position, node);
+
+	if (_journal)
+	{
+		_journal->changes.push_back({ true, node, INodePtr() });
+	}
+}
+
+bool TraversableNodeSet::removeChild(const INodePtr& node)
+{
+	auto found = _childIndex.find(node.get());
+
+	if (found == _childIndex.end())
+	{
+		return false;
+	}
+
+	auto position = found->second;
+	_childIndex.erase(found);
+
+	if (_journal)
+	{
+		auto successor = std::next(position);
+		_journal->changes.push_back({ false, node, successor != _children.end() ? *successor : INodePtr() });
+	}
+
+	_children.erase(position);
+	return true;
 }
 
 IUndoMementoPtr TraversableNodeSet::exportState() const
 {
-	// Copy the current list of children and return the UndoMemento
-	return IUndoMementoPtr(new UndoListMemento(_children));
+	// Start a new journal, the changes following this call will be recorded in there
+	_journal = std::make_shared<ChangeJournal>();
+	return _journal;
 }
 
 void TraversableNodeSet::importState(const IUndoMementoPtr& state)
 {
+	// Reverting the changes is recorded in the journal of the redo (or undo) operation
 	undoSave();
 
-	// Import the child set from the state
-	const auto& other = std::static_pointer_cast<UndoListMemento>(state)->data();
-
-	// Copy the current container into a temporary one for later comparison
-	std::vector<INodePtr> before_sorted(_children.begin(), _children.end());
-	std::vector<INodePtr> after_sorted(other.begin(), other.end());
-
-	// greebo: Now sort these, the set_difference algorithm requires the sets to be sorted
-	std::sort(before_sorted.begin(), before_sorted.end());
-	std::sort(after_sorted.begin(), after_sorted.end());
-
-	// Import the state, overwriting the current set
-	_children = other;
-
-	// Now, handle the difference of <before> and <after>
-	// The owning node needs to know about all nodes which are removed in <after>, these are
-	// instantly removed from the scenegraph
-	ObserverEraseFunctor eraseFunctor;
-
-	// greebo: Now find all the nodes that exist in <_children>, but not in <other> and
-	// call the EraseFunctor for each of them (the iterator calls onChildRemoved() on the owning node).
-	std::set_difference(
-		before_sorted.begin(), before_sorted.end(),
-		after_sorted.begin(), after_sorted.end(),
-		ObserverOutputIterator(_owner, eraseFunctor)
-	);
-
-    // greebo: Next step is to find all nodes existing in <other>, but not in <_children>,
-    // to ultimately call onChildAdded() for each of them.
-    // A special treatment is necessary for insertions of new nodes, as calling onChildAdded
-    // right away might lead to double-insertions into the scenegraph (in case the same node
-    // has not been removed from another node yet - a race condition during undo).
-    // Therefore, collect all nodes that need to be added and process them in onOperationRestored().
-    std::set_difference(
-        after_sorted.begin(), after_sorted.end(),
-        before_sorted.begin(), before_sorted.end(),
-        std::back_inserter(_undoInsertBuffer)
-    );
+	const auto& changes = std::static_pointer_cast<ChangeJournal>(state)->changes;
+
+	// Keep track of the net change of each touched node, nodes that are
+	// removed and re-inserted again don't need to be notified
+	std::vector<INodePtr> touchedNodes;
+	std::unordered_map<INode*, int> netChange;
+
+	// Revert the changes in reverse order, this way the successor
+	// of any removed node is present at the time it is re-inserted
+	for (auto change = changes.rbegin(); change != changes.rend(); ++change)
+	{
+		if (change->inserted)
+		{
+			if (!removeChild(change->node)) continue;
+		}
+		else
+		{
+			if (_childIndex.count(change->node.get()) > 0) continue;
+
+			auto successor = change->successor ? _childIndex.find(change->successor.get()) : _childIndex.end();
+			insertChild(successor != _childIndex.end() ? successor->second : _children.end(), change->node);
+		}
+
+		auto [entry, inserted] = netChange.try_emplace(change->node.get(), 0);
+
+		if (inserted)
+		{
+			touchedNodes.push_back(change->node);
+		}
+
+		entry->second += change->inserted ? -1 : +1;
+	}
+
+	for (const auto& node : touchedNodes)
+	{
+		auto change = netChange[node.get()];
+
+		// The owning node needs to know about all nodes which have been removed,
+		// these are instantly removed from the scenegraph
+		if (change < 0)
+		{
+			_owner.onChildRemoved(node);
+		}
+		// greebo: A special treatment is necessary for insertions of new nodes, as calling
+		// onChildAdded right away might lead to double-insertions into the scenegraph (in case
+		// the same node has not been removed from another node yet - a race condition during undo).
+		// Therefore, collect all nodes that need to be added and process them in onOperationRestored().
+		else if (change > 0)
+		{
+			_undoInsertBuffer.push_back(node);
+		}
+	}
 }
 
 void TraversableNodeSet::onOperationRestored()
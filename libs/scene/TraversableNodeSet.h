@@ -3,6 +3,7 @@
 #include "inode.h"
 #include "iundo.h"
 #include <list>
+#include <unordered_map>
 #include "util/Noncopyable.h"
 
 namespace scene
@@ -17,7 +18,10 @@ class Node;
  * The TraversableNodeSet is also reporting any changes to the UndoSystem, that's what the
  * onInsertIntoScene(root) methods are for. An UndoMemento is submitted to the UndoSystem as soon
  * as any child nodes are removed or inserted. When the user hits Undo, the UndoSystem sends back
- * the memento and asks the TraversableNodeSet to overwrite its current children with the saved state.
+ * the memento and asks the TraversableNodeSet to revert the changes recorded in it.
+ *
+ * The mementos don't contain a copy of all children, they only record the nodes that have been
+ * inserted or removed during an operation, along with their position in the list.
  */
 class TraversableNodeSet final :
 	public IUndoable,
@@ -30,6 +34,9 @@ public:
 private:
 	NodeList _children;
 
+	// Position of each child in the list, for constant-time removal
+	std::unordered_map<INode*, NodeList::iterator> _childIndex;
+
 	// The owning node which gets notified upon insertion/deletion of child nodes
 	Node& _owner;
 
@@ -38,6 +45,10 @@ private:
 	// A list collecting nodes for insertion in postUndo/postRedo
 	NodeList _undoInsertBuffer;
 
+	// The memento of the current undo operation, the changes are recorded in there
+	class ChangeJournal;
+	mutable std::shared_ptr<ChangeJournal> _journal;
+
 public:
 	// Default constructor, creates an empty set
 	TraversableNodeSet(Node& owner);
@@ -96,6 +107,13 @@ private:
 	// Sends the current state to the undosystem
 	void undoSave();
 
+	// Inserts the node before the given position, updating the index and the undo journal
+	void insertChild(NodeList::iterator position, const INodePtr& node);
+
+	// Removes the child from the list, updating the index and the undo journal.
+	// Returns false if the node is not a child of this set.
+	bool removeChild(const INodePtr& node);
+
 	// Calls the owning node for each node in the undo insert buffer,
 	// this is called right after an undo operation
 	void processInsertBuffer();
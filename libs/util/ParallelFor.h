@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include "ijobsystem.h"
+
+namespace util
+{
+
+/**
+ * Splits the index range [0..count) into contiguous batches and invokes
+ * the given functor for each batch, distributing the batches across the
+ * workers of the job system. The calling thread takes the first batch
+ * itself and helps with the remaining ones until all batches are done.
+ *
+ * The functor signature is void(std::size_t begin, std::size_t end).
+ * Batches smaller than minBatchSize are not split any further, so small
+ * workloads run on the calling thread without any threading overhead.
+ * The functor must not touch data shared between batches unless it is
+ * synchronised.
+ */
+template<typename BatchFunc>
+void parallelFor(std::size_t count, std::size_t minBatchSize, const BatchFunc& func)
+{
+    if (count == 0) return;
+
+    auto& jobSystem = GlobalJobSystem();
+
+    auto numThreads = jobSystem.getNumWorkers() + 1;
+    auto numBatches = std::min(numThreads, std::max<std::size_t>(count / std::max<std::size_t>(minBatchSize, 1), 1));
+
+    if (numBatches <= 1)
+    {
+        func(0, count);
+        return;
+    }
+
+    auto batchSize = (count + numBatches - 1) / numBatches;
+
+    auto batches = jobSystem.createGroup("parallelFor");
+
+    for (auto begin = batchSize; begin < count; begin += batchSize)
+    {
+        auto end = std::min(begin + batchSize, count);
+        batches->run([&func, begin, end]() { func(begin, end); });
+    }
+
+    try
+    {
+        func(0, std::min(batchSize, count));
+    }
+    catch (...)
+    {
+        // The other batches are referencing the functor, let them finish before leaving
+        batches->cancel();
+
+        try
+        {
+            batches->wait();
+        }
+        catch (...)
+        {} // the first batch's exception is passed on
+
+        throw;
+    }
+
+    batches->wait(); // propagates exceptions thrown by the batches
+}
+
+}
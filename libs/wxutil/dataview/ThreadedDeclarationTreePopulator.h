@@ -72,7 +72,7 @@ public:
         {
             ThrowIfCancellationRequested();
 
-            if (decl->getBlockSyntax().fileInfo.visibility == vfs::Visibility::HIDDEN)
+            if (decl->getBlockSyntax().getFileInfo().visibility == vfs::Visibility::HIDDEN)
             {
                 return; // skip hidden declarations
             }
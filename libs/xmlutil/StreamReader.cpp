@@ -0,0 +1,131 @@
+#include "StreamReader.h"
+
+#include <libxml/xmlreader.h>
+
+namespace xml
+{
+
+namespace
+{
+    int readFromStream(void* context, char* buffer, int length)
+    {
+        auto& stream = *static_cast<std::istream*>(context);
+
+        stream.read(buffer, length);
+
+        return static_cast<int>(stream.gcount());
+    }
+
+    int closeStream(void* context)
+    {
+        return 0; // the stream is owned by the caller
+    }
+}
+
+StreamReader::StreamReader(std::istream& stream) :
+    _reader(xmlReaderForIO(readFromStream, closeStream, &stream, "stream", nullptr, XML_PARSE_NOBLANKS)),
+    _owner(static_cast<xmlDocPtr>(nullptr)),
+    _nodePending(false)
+{
+    if (_reader == nullptr)
+    {
+        throw ParseError("Could not create XML reader");
+    }
+}
+
+StreamReader::~StreamReader()
+{
+    xmlFreeTextReader(_reader);
+}
+
+bool StreamReader::next()
+{
+    while (true)
+    {
+        auto result = _nodePending ? 1 : xmlTextReaderRead(_reader);
+        _nodePending = false;
+
+        if (result < 0)
+        {
+            throw ParseError("XML parse error");
+        }
+
+        if (result == 0)
+        {
+            return false;
+        }
+
+        if (isStartElement() || isEndElement())
+        {
+            return true;
+        }
+    }
+}
+
+void StreamReader::skipSubtree()
+{
+    auto result = xmlTextReaderNext(_reader);
+
+    if (result < 0)
+    {
+        throw ParseError("XML parse error");
+    }
+
+    _nodePending = result == 1;
+}
+
+bool StreamReader::isStartElement() const
+{
+    return xmlTextReaderNodeType(_reader) == XML_READER_TYPE_ELEMENT;
+}
+
+bool StreamReader::isEndElement() const
+{
+    return xmlTextReaderNodeType(_reader) == XML_READER_TYPE_END_ELEMENT;
+}
+
+bool StreamReader::isEmptyElement() const
+{
+    return xmlTextReaderIsEmptyElement(_reader) == 1;
+}
+
+int StreamReader::getDepth() const
+{
+    return xmlTextReaderDepth(_reader);
+}
+
+std::string StreamReader::getName() const
+{
+    auto name = xmlTextReaderConstName(_reader);
+
+    return name != nullptr ? reinterpret_cast<const char*>(name) : std::string();
+}
+
+std::string StreamReader::getAttributeValue(const std::string& key) const
+{
+    auto value = xmlTextReaderGetAttribute(_reader, reinterpret_cast<const xmlChar*>(key.c_str()));
+
+    if (value == nullptr)
+    {
+        return std::string();
+    }
+
+    std::string result(reinterpret_cast<const char*>(value));
+    xmlFree(value);
+
+    return result;
+}
+
+Node StreamReader::expand()
+{
+    auto node = xmlTextReaderExpand(_reader);
+
+    if (node == nullptr)
+    {
+        throw ParseError("XML parse error");
+    }
+
+    return Node(&_owner, node);
+}
+
+}
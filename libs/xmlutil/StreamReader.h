@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Document.h"
+
+#include <istream>
+#include <stdexcept>
+#include <string>
+
+typedef struct _xmlTextReader xmlTextReader;
+typedef xmlTextReader *xmlTextReaderPtr;
+
+namespace xml
+{
+
+/**
+ * Pull parser reading an XML document from a stream without building the
+ * whole document tree in memory. The reader advances from element to element
+ * in document order. The current element can be expanded to a Node to inspect
+ * its subtree, the memory of that subtree is released once the reader moved on.
+ */
+class StreamReader
+{
+public:
+    // Thrown when the stream doesn't contain well-formed XML
+    class ParseError :
+        public std::runtime_error
+    {
+    public:
+        ParseError(const std::string& what) :
+            std::runtime_error(what)
+        {}
+    };
+
+private:
+    xmlTextReaderPtr _reader;
+
+    // Owner of the expanded Nodes (the nodes themselves belong to the reader)
+    Document _owner;
+
+    // True if the reader has been moved to an unvisited node by skipSubtree()
+    bool _nodePending;
+
+public:
+    // The stream needs to stay alive as long as this reader is in use
+    StreamReader(std::istream& stream);
+
+    StreamReader(const StreamReader& other) = delete;
+    StreamReader& operator=(const StreamReader& other) = delete;
+
+    ~StreamReader();
+
+    // Advances to the next start or end tag, returns false at the end of the document
+    bool next();
+
+    // Moves past the current element and all its children. The next call to next()
+    // returns the tag following the element's end tag.
+    void skipSubtree();
+
+    // True if the reader is positioned at a start tag (including empty elements like <tag/>)
+    bool isStartElement() const;
+
+    // True if the reader is positioned at an end tag
+    bool isEndElement() const;
+
+    // True if the current element is an empty element like <tag/> which has no end tag
+    bool isEmptyElement() const;
+
+    // The nesting level of the current element, the top-level element is at depth 0
+    int getDepth() const;
+
+    // The name of the current element
+    std::string getName() const;
+
+    // Return the value of the given attribute of the current element, or an empty string
+    std::string getAttributeValue(const std::string& key) const;
+
+    // Reads the current element including all its children and returns it as Node.
+    // The returned Node is only valid until the reader is advanced.
+    Node expand();
+};
+
+}
@@ -0,0 +1,81 @@
+#include "StreamWriter.h"
+
+#include <stdexcept>
+#include <libxml/xmlwriter.h>
+
+namespace xml
+{
+
+namespace
+{
+    int writeToStream(void* context, const char* buffer, int length)
+    {
+        auto& stream = *static_cast<std::ostream*>(context);
+
+        stream.write(buffer, length);
+
+        return stream.good() ? length : -1;
+    }
+
+    int closeStream(void* context)
+    {
+        return 0; // the stream is owned by the caller
+    }
+}
+
+StreamWriter::StreamWriter(std::ostream& stream) :
+    _writer(nullptr)
+{
+    auto output = xmlOutputBufferCreateIO(writeToStream, closeStream, &stream, nullptr);
+
+    if (output == nullptr)
+    {
+        throw std::runtime_error("Could not create XML output buffer");
+    }
+
+    // The writer takes ownership of the output buffer
+    _writer = xmlNewTextWriter(output);
+
+    if (_writer == nullptr)
+    {
+        xmlOutputBufferClose(output);
+        throw std::runtime_error("Could not create XML writer");
+    }
+
+    xmlTextWriterSetIndent(_writer, 1);
+    xmlTextWriterSetIndentString(_writer, BAD_CAST "  ");
+    xmlTextWriterStartDocument(_writer, nullptr, "utf-8", nullptr);
+}
+
+StreamWriter::~StreamWriter()
+{
+    finish();
+}
+
+void StreamWriter::startElement(const std::string& name)
+{
+    xmlTextWriterStartElement(_writer, BAD_CAST name.c_str());
+}
+
+void StreamWriter::writeAttribute(const std::string& key, const std::string& value)
+{
+    xmlTextWriterWriteAttribute(_writer, BAD_CAST key.c_str(), BAD_CAST value.c_str());
+}
+
+void StreamWriter::endElement()
+{
+    xmlTextWriterEndElement(_writer);
+}
+
+void StreamWriter::finish()
+{
+    if (_writer == nullptr) return;
+
+    // Closes all open elements and flushes the output
+    xmlTextWriterEndDocument(_writer);
+    xmlFreeTextWriter(_writer);
+
+    _writer = nullptr;
+}
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+
+typedef struct _xmlTextWriter xmlTextWriter;
+typedef xmlTextWriter *xmlTextWriterPtr;
+
+namespace xml
+{
+
+/**
+ * Writes an XML document to a stream element by element, without building
+ * the document tree in memory. The output is indented like the one of
+ * Document::saveToString(). The written data is passed on to the stream in
+ * chunks, as soon as the internal buffer is full.
+ */
+class StreamWriter
+{
+private:
+    xmlTextWriterPtr _writer;
+
+public:
+    // Writes the XML declaration. The stream needs to stay alive as long as this writer is in use.
+    StreamWriter(std::ostream& stream);
+
+    StreamWriter(const StreamWriter& other) = delete;
+    StreamWriter& operator=(const StreamWriter& other) = delete;
+
+    // Calls finish() if this hasn't been done yet
+    ~StreamWriter();
+
+    // Opens a new element as child of the currently open one
+    void startElement(const std::string& name);
+
+    // Adds an attribute to the element opened last, no child elements may have been written yet
+    void writeAttribute(const std::string& key, const std::string& value);
+
+    // Closes the element opened last
+    void endElement();
+
+    // Closes all open elements and passes the remaining data to the stream.
+    // The writer must not be used afterwards.
+    void finish();
+};
+
+}
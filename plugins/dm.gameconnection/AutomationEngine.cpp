@@ -13,9 +13,6 @@ namespace gameconn
 
 namespace
 {
-    const char* const DEFAULT_HOST = "localhost";
-    const int DEFAULT_PORT = 3879;
-
     inline std::string seqnoPreamble(std::size_t seq) {
         return fmt::format("seqno {0}\n", seq);
     }
@@ -58,7 +55,7 @@ bool AutomationEngine::connect()
     if (
         !connection->Initialize() ||
         !connection->SetNonblocking() ||
-        !connection->Open(DEFAULT_HOST, DEFAULT_PORT))
+        !connection->Open(DEFAULT_AUTOMATION_HOST, DEFAULT_AUTOMATION_PORT))
     {
         return false;
     }
@@ -20,6 +20,10 @@ public:
 // Bitmask with all tag bits set.
 static const int TAGMASK_ALL = -1;
 
+// Where the game listens for automation connections (see com_automation in TDM).
+static const char* const DEFAULT_AUTOMATION_HOST = "localhost";
+static const int DEFAULT_AUTOMATION_PORT = 3879;
+
 // Putting this to wait-list of multistep procedure
 // results in waking up on next think (suitable for polling).
 static const int SEQNO_WAIT_POLL = -10000;
@@ -90,6 +94,9 @@ public:
 
     // Return true iff any request or multistep procedure matching the given mask is not finished yet.
     // Note: tagMask is a bitmask, so pass (1<<tag) in order to wait for one tag only.
+    // Asynchronous updates (camera, map diffs) are only sent while no request is in progress,
+    // so there is never more than one of them on its way to the game: this is what keeps
+    // a slow game from being flooded, newer data is merged on our side in the meantime.
     bool areTagsInProgress(int tagMask = TAGMASK_ALL);
     // Wait for all active requests and multistep procedures matching the given mask to finish.
     // Throws DisconnectException if it cannot be done due to lost connection.
@@ -0,0 +1,155 @@
+#include "ChangeJournal.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace gameconn
+{
+
+ChangeJournal::ChangeJournal(Clock::duration quietPeriod, Clock::duration maxDelay,
+                             Clock::duration retryDelay, Clock::duration maxRetryDelay) :
+    _quietPeriod(quietPeriod),
+    _maxDelay(maxDelay),
+    _retryDelay(retryDelay),
+    _maxRetryDelay(maxRetryDelay)
+{}
+
+void ChangeJournal::record(const std::string& entityName, const DiffStatus& change, Clock::time_point now)
+{
+    if (_pendingChanges.empty())
+    {
+        _firstPendingChange = now;
+    }
+
+    _lastPendingChange = now;
+
+    DiffStatus& status = _pendingChanges[entityName];
+    status = status.combine(change);
+
+    ++_statistics.recordedChanges;
+}
+
+bool ChangeJournal::hasPendingChanges() const
+{
+    return !_pendingChanges.empty();
+}
+
+const DiffEntityStatuses& ChangeJournal::getPendingChanges() const
+{
+    return _pendingChanges;
+}
+
+bool ChangeJournal::isBatchInFlight() const
+{
+    return _batchInFlight;
+}
+
+bool ChangeJournal::isBatchDue(Clock::time_point now) const
+{
+    if (_batchInFlight || _pendingChanges.empty())
+    {
+        return false;
+    }
+
+    if (_consecutiveFailures > 0 && now < _nextRetry)
+    {
+        return false;
+    }
+
+    return now - _lastPendingChange >= _quietPeriod || now - _firstPendingChange >= _maxDelay;
+}
+
+const DiffEntityStatuses& ChangeJournal::beginBatch()
+{
+    assert(!_batchInFlight);
+
+    _batch.swap(_pendingChanges);
+    _pendingChanges.clear();
+
+    _firstBatchChange = _firstPendingChange;
+    _batchInFlight = true;
+
+    return _batch;
+}
+
+void ChangeJournal::commitBatch(Clock::time_point now)
+{
+    // The batch might have been dropped by clear() in the meantime
+    if (!_batchInFlight) return;
+
+    auto latency = now - _firstBatchChange;
+
+    ++_statistics.sentBatches;
+    _statistics.sentEntities += _batch.size();
+    _statistics.totalLatency += latency;
+    _statistics.maxLatency = std::max(_statistics.maxLatency, latency);
+
+    _batch.clear();
+    _batchInFlight = false;
+    _consecutiveFailures = 0;
+}
+
+void ChangeJournal::abortBatch(Clock::time_point now)
+{
+    if (!_batchInFlight) return;
+
+    ++_statistics.failedBatches;
+
+    // Don't hammer a game which keeps rejecting the diff, double the delay each time
+    auto delay = _retryDelay;
+
+    for (std::size_t i = 0; i < _consecutiveFailures && delay < _maxRetryDelay; ++i)
+    {
+        delay *= 2;
+    }
+
+    ++_consecutiveFailures;
+    _nextRetry = now + std::min(delay, _maxRetryDelay);
+
+    // The changes of the failed batch happened before the pending ones
+    for (auto& [name, status] : _batch)
+    {
+        auto later = _pendingChanges.find(name);
+
+        if (later != _pendingChanges.end())
+        {
+            status = status.combine(later->second);
+        }
+    }
+
+    for (const auto& [name, status] : _pendingChanges)
+    {
+        _batch.emplace(name, status);
+    }
+
+    if (_pendingChanges.empty())
+    {
+        _lastPendingChange = _firstBatchChange;
+    }
+
+    _pendingChanges.swap(_batch);
+    _batch.clear();
+
+    _firstPendingChange = _firstBatchChange;
+    _batchInFlight = false;
+}
+
+void ChangeJournal::clear()
+{
+    _pendingChanges.clear();
+    _batch.clear();
+    _batchInFlight = false;
+    _consecutiveFailures = 0;
+}
+
+const ChangeJournal::Statistics& ChangeJournal::getStatistics() const
+{
+    return _statistics;
+}
+
+void ChangeJournal::resetStatistics()
+{
+    _statistics = Statistics();
+}
+
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <chrono>
+#include "DiffStatus.h"
+
+namespace gameconn
+{
+
+/**
+ * Private for GameConnection class: do not use directly!
+ * Collects the entity changes for the "update map" feature and decides when they are sent.
+ *
+ * Changes of the same entity are merged into one status, and nothing is sent before
+ * the map has been quiet for a while (or the oldest change has waited long enough).
+ * During a drag operation this results in a few diffs instead of one per think.
+ *
+ * At most one batch of changes is on its way to the game. Changes recorded meanwhile
+ * are collected for the next batch, which is sent once the game acknowledged the
+ * previous one. Failed batches are merged back in front of the newer changes, and
+ * are retried after a delay which doubles with every consecutive failure.
+ */
+class ChangeJournal
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Statistics
+    {
+        // Number of entity changes recorded (before merging)
+        std::size_t recordedChanges = 0;
+        // Number of acknowledged batches and the entities they contained
+        std::size_t sentBatches = 0;
+        std::size_t sentEntities = 0;
+        // Number of batches the game failed to apply
+        std::size_t failedBatches = 0;
+        // Time from the first change in a batch to its acknowledgement
+        Clock::duration totalLatency = Clock::duration::zero();
+        Clock::duration maxLatency = Clock::duration::zero();
+    };
+
+    ChangeJournal(Clock::duration quietPeriod = std::chrono::milliseconds(200),
+                  Clock::duration maxDelay = std::chrono::milliseconds(500),
+                  Clock::duration retryDelay = std::chrono::seconds(1),
+                  Clock::duration maxRetryDelay = std::chrono::seconds(30));
+
+    // Adds a change of the named entity, merging it with any pending change of it
+    void record(const std::string& entityName, const DiffStatus& change, Clock::time_point now = Clock::now());
+
+    // Returns true if there are changes not yet handed out in a batch
+    bool hasPendingChanges() const;
+
+    // Returns the changes not yet handed out in a batch
+    const DiffEntityStatuses& getPendingChanges() const;
+
+    // Returns true if beginBatch() has been called without commitBatch() or abortBatch()
+    bool isBatchInFlight() const;
+
+    // Returns true if the pending changes should be sent now: nothing in flight,
+    // no failure backoff running, and the changes settled or waited for the max delay
+    bool isBatchDue(Clock::time_point now = Clock::now()) const;
+
+    // Moves all pending changes to the in-flight batch and returns it.
+    // The reference stays valid until the batch is committed or aborted.
+    const DiffEntityStatuses& beginBatch();
+
+    // The game applied the in-flight batch
+    void commitBatch(Clock::time_point now = Clock::now());
+
+    // The game failed to apply the in-flight batch, its changes will be sent again
+    // once the retry delay has passed
+    void abortBatch(Clock::time_point now = Clock::now());
+
+    // Forgets all changes, including the ones in flight
+    // (the game has been brought in sync by other means)
+    void clear();
+
+    const Statistics& getStatistics() const;
+    void resetStatistics();
+
+private:
+    Clock::duration _quietPeriod;
+    Clock::duration _maxDelay;
+    Clock::duration _retryDelay;
+    Clock::duration _maxRetryDelay;
+
+    DiffEntityStatuses _pendingChanges;
+    Clock::time_point _firstPendingChange;
+    Clock::time_point _lastPendingChange;
+
+    DiffEntityStatuses _batch;
+    Clock::time_point _firstBatchChange;
+    bool _batchInFlight = false;
+
+    // Number of batches failed in a row, and when the next attempt may start
+    std::size_t _consecutiveFailures = 0;
+    Clock::time_point _nextRetry;
+
+    Statistics _statistics;
+};
+
+}
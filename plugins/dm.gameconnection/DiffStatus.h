@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cassert>
+#include <cstdlib>
 #include <map>
+#include <string>
 
 namespace gameconn
 {
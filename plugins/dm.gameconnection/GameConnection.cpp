@@ -2,6 +2,7 @@
 #include "DiffStatus.h"
 #include "DiffDoom3MapWriter.h"
 #include "AutomationEngine.h"
+#include "LoopbackGame.h"
 
 #include "i18n.h"
 #include "igame.h"
@@ -10,6 +11,7 @@
 #include "imap.h"
 #include "ientity.h"
 #include "iselection.h"
+#include "itextstream.h"
 #include "ui/iuserinterface.h"
 #include "ui/imenumanager.h"
 #include "ui/imainframe.h"
@@ -43,6 +45,8 @@ namespace
     constexpr int TAG_CAMERA = 6;
     //multistep procedure for TDM game start/restart
     constexpr int TAG_RESTART = 7;
+    //automatic "update map" diffs, executed asynchronously
+    constexpr int TAG_HOTRELOAD = 8;
 
     inline std::string messagePreamble(const std::string& type) {
         return fmt::format("message \"{}\"\n", type);
@@ -70,10 +74,9 @@ std::string GameConnection::executeGenericRequest(const std::string& request)
 
 bool GameConnection::sendAnyPendingAsync()
 {
-    if (_mapObserver.getChanges().size() && _updateMapAlways) {
-        //note: this is blocking
-        doUpdateMap();
-        return true;
+    if (_updateMapAlways && _mapObserver.getJournal().isBatchDue()) {
+        if (sendPendingMapUpdate())
+            return true;
     }
     return sendPendingCameraUpdate();
 }
@@ -775,23 +778,49 @@ std::string saveMapDiff(const DiffEntityStatuses& entityStatuses)
     return outStream.str();
 }
 
+void GameConnection::finishMapUpdate(const std::string& response)
+{
+    auto& journal = _mapObserver.getJournal();
+
+    if (response.find("HotReload: SUCCESS") != std::string::npos) {
+        //success: drop the batch, so that we don't reapply it next time
+        journal.commitBatch();
+    }
+    else {
+        //failure: keep the changes for the next update
+        journal.abortBatch();
+    }
+}
+
+bool GameConnection::sendPendingMapUpdate()
+{
+    auto& journal = _mapObserver.getJournal();
+    std::string diff = saveMapDiff(journal.beginBatch());
+
+    _engine->executeRequestAsync(TAG_HOTRELOAD, actionPreamble("reloadmap-diff") + "content:\n" + diff,
+        [this](int seqno) {
+            finishMapUpdate(_engine->getResponse(seqno));
+        }
+    );
+
+    return true;
+}
+
 void GameConnection::doUpdateMap()
 {
     try {
         if (!_engine->isAlive())
             return; //no connection, don't even try
 
+        //automatic update in progress: it must be applied before the newer changes
+        _engine->waitForTags(1 << TAG_HOTRELOAD);
+
         // Get map diff
-        std::string diff = saveMapDiff(_mapObserver.getChanges());
-        if (diff.empty()) {
-            return; //TODO: fail
-        }
+        auto& journal = _mapObserver.getJournal();
+        std::string diff = saveMapDiff(journal.beginBatch());
 
         std::string response = executeGenericRequest(actionPreamble("reloadmap-diff") + "content:\n" + diff);
-        if (response.find("HotReload: SUCCESS") != std::string::npos) {
-            //success: clear current diff, so that we don't reapply it next time
-            _mapObserver.clear();
-        }
+        finishMapUpdate(response);
     }
     catch (const DisconnectException&) {
         //disconnected: will be handled during next think
@@ -799,6 +828,58 @@ void GameConnection::doUpdateMap()
     }
 }
 
+bool GameConnection::startLoopbackGame(int responseDelayMsec)
+{
+    if (_loopbackGame && _loopbackGame->isRunning())
+        return true;
+
+    _loopbackGame.reset(new LoopbackGame(DEFAULT_AUTOMATION_PORT, std::chrono::milliseconds(responseDelayMsec)));
+
+    if (!_loopbackGame->start()) {
+        _loopbackGame.reset();
+        radiant::NotificationMessage::SendError(
+            fmt::format(_("Cannot listen on port {0}, is the game running already?"), DEFAULT_AUTOMATION_PORT));
+        return false;
+    }
+
+    _mapObserver.getJournal().resetStatistics();
+
+    rMessage() << "GameConnection: loopback game listening on port " << DEFAULT_AUTOMATION_PORT << std::endl;
+    return true;
+}
+
+void GameConnection::stopLoopbackGame()
+{
+    if (!_loopbackGame)
+        return;
+
+    //the loopback is going away, don't keep talking to it
+    disconnect(true);
+    _loopbackGame->stop();
+
+    auto loopback = _loopbackGame->getStatistics();
+    const auto& journal = _mapObserver.getJournal().getStatistics();
+
+    using std::chrono::duration_cast;
+    using std::chrono::milliseconds;
+
+    rMessage() << "GameConnection: loopback game stopped" << std::endl
+        << "  Requests received: " << loopback.requests << " (" << loopback.mapDiffs << " map diffs, "
+        << loopback.bytesReceived << " bytes)" << std::endl
+        << "  Responses sent: " << loopback.bytesSent << " bytes" << std::endl
+        << "  Entity changes recorded: " << journal.recordedChanges << std::endl
+        << "  Update batches sent: " << journal.sentBatches << " (" << journal.sentEntities << " entities, "
+        << journal.failedBatches << " failed)" << std::endl;
+
+    if (journal.sentBatches > 0) {
+        rMessage() << "  Update latency: "
+            << duration_cast<milliseconds>(journal.totalLatency / journal.sentBatches).count() << " ms average, "
+            << duration_cast<milliseconds>(journal.maxLatency).count() << " ms max" << std::endl;
+    }
+
+    _loopbackGame.reset();
+}
+
 //-------------------------------------------------------------
 
 const std::string& GameConnection::getName() const
@@ -897,6 +978,18 @@ void GameConnection::initialiseModule(const IApplicationContext& ctx)
     GlobalCommandSystem().addCommand("GameConnectionPauseGame",
                                      [this](const cmd::ArgumentList&) { togglePauseGame(); });
 
+    // Local stand-in for the game, for testing
+    GlobalCommandSystem().addCommand(
+        "GameConnectionStartLoopback",
+        [this](const cmd::ArgumentList& args)
+        {
+            startLoopbackGame(args.empty() ? 0 : args[0].getInt());
+        },
+        { cmd::ARGTYPE_INT | cmd::ARGTYPE_OPTIONAL }
+    );
+    GlobalCommandSystem().addCommand("GameConnectionStopLoopback",
+                                     [this](const cmd::ArgumentList&) { stopLoopbackGame(); });
+
     // Toolbar button(s)
     GlobalMainFrame().signal_MainFrameConstructed().connect(
         sigc::mem_fun(this, &GameConnection::addToolbarItems)
@@ -906,6 +999,7 @@ void GameConnection::initialiseModule(const IApplicationContext& ctx)
 void GameConnection::shutdownModule()
 {
     disconnect(true);
+    _loopbackGame.reset();
 }
 
 void GameConnection::addToolbarItems()
@@ -14,6 +14,7 @@ namespace gameconn
 
 class MessageTcp;
 class AutomationEngine;
+class LoopbackGame;
 
 /**
  * stgatilov: This is TheDarkMod-only system for connecting to game process via socket.
@@ -72,12 +73,19 @@ public:
     // or b) since the observer was enabled; are sent as a diff.
     // The game applies the diff on top of its current map state and hot reloads entities.
     void doUpdateMap();
-    // Enable/disable mode: doUpdateMap after every entity change.
-    // Note: the update is postponed to next think, so that mass changes go as one diff.
+    // Enable/disable mode: send map updates automatically after entity changes.
+    // Note: changes are collected until the map is quiet for a moment, so that mass changes
+    // (e.g. dragging entities around) go as few diffs. Only one diff is sent at a time.
     void setAlwaysUpdateMapEnabled(bool on);
     // Returns true iff the mode for update map after every change is enabled.
     bool isAlwaysUpdateMapEnabled() const;
 
+    // Start/stop a local stand-in for the game, which acknowledges all requests.
+    // Allows testing the connection and measuring hot reload throughput without TDM.
+    // The game's responses can be delayed by the given amount of milliseconds.
+    bool startLoopbackGame(int responseDelayMsec = 0);
+    void stopLoopbackGame();
+
     // Toggle game pause status: pause if it is live / unpause if it is paused.
     // Note: there is no way to learn if game is paused right now.
     void togglePauseGame();
@@ -126,6 +134,9 @@ private:
     // True when restartGame procedure is executed.
     bool _restartInProgress = false;
 
+    // Local stand-in for the game, only exists when started by command.
+    std::unique_ptr<LoopbackGame> _loopbackGame;
+
     // IEventPtrs corresponding to activatable menu options.
     IEventPtr _event_toggleCameraSync;
     IEventPtr _event_backSyncCamera;
@@ -168,6 +179,11 @@ private:
     // Enable notarget/god/noclip to allow player to fly around without problems.
     void enableGhostMode();
 
+    // Send the changes collected by the map observer asynchronously as one batch.
+    bool sendPendingMapUpdate();
+    // Marks the map update batch as applied or failed, depending on the game's response.
+    void finishMapUpdate(const std::string& response);
+
     // Save map using DarkRadiant command if there are any pending modifications.
     void saveMapIfNeeded();
     // Callback called on map saving, loading and unloading.
@@ -0,0 +1,170 @@
+#include "LoopbackGame.h"
+
+#include <cstdio>
+#include <deque>
+#include <vector>
+
+#include "MessageTcp.h"
+#include "clsocket/ActiveSocket.h"
+#include "clsocket/PassiveSocket.h"
+
+#include <fmt/format.h>
+
+namespace gameconn
+{
+
+namespace
+{
+    // How long the server thread sleeps when there's nothing to do
+    constexpr std::chrono::milliseconds IDLE_INTERVAL(1);
+
+    // The address the game is binding to as well
+    const char* const LOOPBACK_ADDRESS = "127.0.0.1";
+}
+
+LoopbackGame::LoopbackGame(int port, std::chrono::milliseconds responseDelay) :
+    _port(port),
+    _responseDelay(responseDelay),
+    _stopRequested(false)
+{}
+
+LoopbackGame::~LoopbackGame()
+{
+    stop();
+}
+
+bool LoopbackGame::start()
+{
+    if (isRunning())
+        return true;
+
+    _listener.reset(new CPassiveSocket());
+
+    if (!_listener->Initialize() ||
+        !_listener->Listen(LOOPBACK_ADDRESS, static_cast<uint16>(_port)) ||
+        !_listener->SetNonblocking())
+    {
+        _listener.reset();
+        return false;
+    }
+
+    _stopRequested = false;
+    _thread = std::thread(&LoopbackGame::run, this);
+
+    return true;
+}
+
+void LoopbackGame::stop()
+{
+    if (!_thread.joinable())
+        return;
+
+    _stopRequested = true;
+    _thread.join();
+
+    _listener->Close();
+    _listener.reset();
+}
+
+bool LoopbackGame::isRunning() const
+{
+    return _thread.joinable();
+}
+
+LoopbackGame::Statistics LoopbackGame::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(_statisticsLock);
+    return _statistics;
+}
+
+std::string LoopbackGame::processRequest(const std::string& request)
+{
+    // Only the hot reload reply is checked by DarkRadiant,
+    // all other requests are acknowledged with an empty response
+    if (request.find("action \"reloadmap-diff\"") != std::string::npos)
+    {
+        std::lock_guard<std::mutex> lock(_statisticsLock);
+        ++_statistics.mapDiffs;
+
+        return "HotReload: SUCCESS\n";
+    }
+
+    return "";
+}
+
+void LoopbackGame::run()
+{
+    struct PendingResponse
+    {
+        std::chrono::steady_clock::time_point due;
+        std::string text;
+    };
+
+    std::unique_ptr<MessageTcp> client;
+    std::deque<PendingResponse> responses;
+    std::vector<char> message;
+
+    while (!_stopRequested)
+    {
+        if (client && !client->isAlive())
+        {
+            // DarkRadiant disconnected, wait for the next connection
+            client.reset();
+            responses.clear();
+        }
+
+        if (!client)
+        {
+            std::unique_ptr<CActiveSocket> connection(_listener->Accept());
+
+            if (connection && connection->SetNonblocking())
+            {
+                client.reset(new MessageTcp());
+                client->init(std::move(connection));
+
+                std::lock_guard<std::mutex> lock(_statisticsLock);
+                ++_statistics.connections;
+            }
+        }
+
+        if (client)
+        {
+            while (client->readMessage(message))
+            {
+                std::string request(message.begin(), message.end());
+
+                int seqno = 0, lineLen = 0;
+                if (sscanf(request.c_str(), "seqno %d\n%n", &seqno, &lineLen) != 1)
+                    continue;
+
+                auto response = fmt::format("response {0}\n", seqno) + processRequest(request.substr(lineLen));
+                responses.push_back({ std::chrono::steady_clock::now() + _responseDelay, std::move(response) });
+
+                std::lock_guard<std::mutex> lock(_statisticsLock);
+                ++_statistics.requests;
+                _statistics.bytesReceived += request.size();
+            }
+
+            auto now = std::chrono::steady_clock::now();
+
+            while (!responses.empty() && responses.front().due <= now)
+            {
+                const auto& text = responses.front().text;
+                client->writeMessage(text.data(), static_cast<int>(text.size()));
+
+                {
+                    std::lock_guard<std::mutex> lock(_statisticsLock);
+                    _statistics.bytesSent += text.size();
+                }
+
+                responses.pop_front();
+            }
+
+            client->think();
+        }
+
+        std::this_thread::sleep_for(IDLE_INTERVAL);
+    }
+}
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "AutomationEngine.h"
+
+class CPassiveSocket;
+
+namespace gameconn
+{
+
+/**
+ * Stand-in for the automation server of TheDarkMod, listening on the local host.
+ *
+ * It speaks the same framed protocol as the game and acknowledges every request,
+ * reporting success for hot reload diffs. This allows testing the game connection
+ * (and measuring its throughput and latency) without running the game.
+ * The server runs on its own thread, so blocking requests keep working.
+ */
+class LoopbackGame
+{
+public:
+    struct Statistics
+    {
+        std::size_t connections = 0;
+        std::size_t requests = 0;
+        std::size_t mapDiffs = 0;
+        std::size_t bytesReceived = 0;
+        std::size_t bytesSent = 0;
+    };
+
+    // The response to each request is held back by the given delay,
+    // to simulate the time the game spends on applying it
+    LoopbackGame(int port = DEFAULT_AUTOMATION_PORT,
+                 std::chrono::milliseconds responseDelay = std::chrono::milliseconds(0));
+    ~LoopbackGame();
+
+    // Starts listening, returns false if the port is not available
+    // (e.g. because the game is running already)
+    bool start();
+
+    // Closes the connection and stops the server thread
+    void stop();
+
+    bool isRunning() const;
+
+    Statistics getStatistics() const;
+
+private:
+    void run();
+
+    // Returns the response text (without preamble) for the given request
+    std::string processRequest(const std::string& request);
+
+    int _port;
+    std::chrono::milliseconds _responseDelay;
+
+    std::unique_ptr<CPassiveSocket> _listener;
+    std::thread _thread;
+    std::atomic<bool> _stopRequested;
+
+    mutable std::mutex _statisticsLock;
+    Statistics _statistics;
+};
+
+}
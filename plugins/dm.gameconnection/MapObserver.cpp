@@ -139,7 +139,7 @@ void MapObserver::setEnabled(bool enable) {
             disableEntityObservers(entityNodes);
         }
         assert(_entityObservers.empty());
-        _entityChanges.clear();
+        _journal.clear();
     }
 }
 
@@ -148,7 +148,7 @@ bool MapObserver::isEnabled() const {
 }
 
 void MapObserver::clear() {
-    _entityChanges.clear();
+    _journal.clear();
 }
 
 MapObserver::~MapObserver() {
@@ -156,12 +156,11 @@ MapObserver::~MapObserver() {
 }
 
 void MapObserver::entityUpdated(const std::string& name, const DiffStatus& diff) {
-    DiffStatus& status = _entityChanges[name];
-    status = status.combine(diff);
+    _journal.record(name, diff);
 }
 
-const DiffEntityStatuses& MapObserver::getChanges() const {
-    return _entityChanges;
+ChangeJournal& MapObserver::getJournal() {
+    return _journal;
 }
 
 }
@@ -3,7 +3,7 @@
 #include "icommandsystem.h"
 #include "iscenegraph.h"
 #include "ientity.h"
-#include "DiffStatus.h"
+#include "ChangeJournal.h"
 
 namespace gameconn
 {
@@ -28,8 +28,8 @@ public:
     //(clears list of pending changes)
     void clear();
 
-    //returns pending entity change since last clear (or since enabled)
-    const DiffEntityStatuses& getChanges() const;
+    //returns the journal of entity changes since last clear (or since enabled)
+    ChangeJournal& getJournal();
 
 private:
     //receives events about entity changes
@@ -42,8 +42,8 @@ private:
     std::unique_ptr<scene::Graph::Observer> _sceneObserver;
     //observers put on every entity on scene
     std::map<IEntityNode*, Entity::Observer*> _entityObservers;		//note: values owned
-    //set of entities with changes since last clear
-    DiffEntityStatuses _entityChanges;
+    //entities with changes since last clear
+    ChangeJournal _journal;
 
     //internal classes can call private methods
     friend class MapObserver_EntityObserver;
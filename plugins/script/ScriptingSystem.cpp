@@ -17,6 +17,7 @@
 #include "interfaces/EClassInterface.h"
 #include "interfaces/SelectionInterface.h"
 #include "interfaces/BrushInterface.h"
+#include "interfaces/BulkDataInterface.h"
 #include "interfaces/PatchInterface.h"
 #include "interfaces/EntityInterface.h"
 #include "interfaces/MapInterface.h"
@@ -312,6 +313,7 @@ void ScriptingSystem::initialiseModule(const IApplicationContext& ctx)
 	addInterface("GlobalEntityClassManager", std::make_shared<EClassManagerInterface>());
 	addInterface("GlobalSelectionSystem", std::make_shared<SelectionInterface>());
 	addInterface("Brush", std::make_shared<BrushInterface>());
+	addInterface("BulkData", std::make_shared<BulkDataInterface>());
 	addInterface("Patch", std::make_shared<PatchInterface>());
 	addInterface("Entity", std::make_shared<EntityInterface>());
 	addInterface("Radiant", std::make_shared<RadiantInterface>());
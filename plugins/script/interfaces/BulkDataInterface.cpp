@@ -0,0 +1,354 @@
+#include "BulkDataInterface.h"
+
+#include <functional>
+#include <stdexcept>
+#include <fmt/format.h>
+
+#include "ibrush.h"
+#include "ientity.h"
+#include "ipatch.h"
+#include "iundo.h"
+
+#include "SceneGraphInterface.h"
+
+namespace script
+{
+
+namespace
+{
+
+// Holds on to the nodes passed from Python for the duration of a bulk operation
+template<typename ElementType>
+struct ResolvedNodes
+{
+	std::vector<scene::INodePtr> nodes;
+
+	// Pointer to the brush, patch or entity of each node, nullptr for nodes of other types
+	std::vector<ElementType*> elements;
+};
+
+template<typename ElementType>
+ResolvedNodes<ElementType> resolveNodes(const py::iterable& nodes,
+	const std::function<ElementType*(const scene::INodePtr&)>& getElement)
+{
+	ResolvedNodes<ElementType> result;
+
+	for (const auto& item : nodes)
+	{
+		scene::INodePtr node = item.cast<const ScriptSceneNode&>();
+
+		result.nodes.push_back(node);
+		result.elements.push_back(node ? getElement(node) : nullptr);
+	}
+
+	return result;
+}
+
+ResolvedNodes<IBrush> resolveBrushes(const py::iterable& nodes)
+{
+	return resolveNodes<IBrush>(nodes, Node_getIBrush);
+}
+
+ResolvedNodes<IPatch> resolvePatches(const py::iterable& nodes)
+{
+	return resolveNodes<IPatch>(nodes, Node_getIPatch);
+}
+
+ResolvedNodes<Entity> resolveEntities(const py::iterable& nodes)
+{
+	return resolveNodes<Entity>(nodes, Node_getEntity);
+}
+
+std::size_t countFaces(const ResolvedNodes<IBrush>& brushes)
+{
+	std::size_t numFaces = 0;
+
+	for (auto brush : brushes.elements)
+	{
+		numFaces += brush != nullptr ? brush->getNumFaces() : 0;
+	}
+
+	return numFaces;
+}
+
+std::size_t countControls(const ResolvedNodes<IPatch>& patches)
+{
+	std::size_t numControls = 0;
+
+	for (auto patch : patches.elements)
+	{
+		numControls += patch != nullptr ? patch->getWidth() * patch->getHeight() : 0;
+	}
+
+	return numControls;
+}
+
+// Throws if the given array is not of the shape (numRows, numColumns)
+void checkShape(const BulkDataInterface::DoubleArray& array, std::size_t numRows, std::size_t numColumns)
+{
+	if (array.ndim() != 2 ||
+		static_cast<std::size_t>(array.shape(0)) != numRows ||
+		static_cast<std::size_t>(array.shape(1)) != numColumns)
+	{
+		throw std::invalid_argument(fmt::format("Expected an array of shape ({0}, {1})", numRows, numColumns));
+	}
+}
+
+// Throws if the number of given items doesn't match the node count
+void checkSize(const py::sequence& sequence, std::size_t expectedSize)
+{
+	if (sequence.size() != expectedSize)
+	{
+		throw std::invalid_argument(fmt::format("Expected {0} elements, got {1}", expectedSize, sequence.size()));
+	}
+}
+
+}
+
+py::tuple BulkDataInterface::getFacePlanes(const py::iterable& nodes)
+{
+	auto brushes = resolveBrushes(nodes);
+
+	py::array_t<double> planes(std::vector<py::ssize_t>{ static_cast<py::ssize_t>(countFaces(brushes)), 4 });
+	py::array_t<std::size_t> faceCounts(std::vector<py::ssize_t>{ static_cast<py::ssize_t>(brushes.elements.size()) });
+
+	auto planeData = planes.mutable_unchecked<2>();
+	auto countData = faceCounts.mutable_unchecked<1>();
+
+	py::ssize_t row = 0;
+
+	for (std::size_t i = 0; i < brushes.elements.size(); ++i)
+	{
+		auto brush = brushes.elements[i];
+		countData(i) = brush != nullptr ? brush->getNumFaces() : 0;
+
+		for (std::size_t face = 0; face < countData(i); ++face, ++row)
+		{
+			const auto& plane = brush->getFace(face).getPlane3();
+
+			planeData(row, 0) = plane.normal().x();
+			planeData(row, 1) = plane.normal().y();
+			planeData(row, 2) = plane.normal().z();
+			planeData(row, 3) = plane.dist();
+		}
+	}
+
+	return py::make_tuple(planes, faceCounts);
+}
+
+void BulkDataInterface::setFacePlanes(const py::iterable& nodes, const DoubleArray& planes)
+{
+	auto brushes = resolveBrushes(nodes);
+
+	checkShape(planes, countFaces(brushes), 4);
+
+	auto planeData = planes.unchecked<2>();
+	py::ssize_t row = 0;
+
+	UndoableCommand cmd("setFacePlanes");
+
+	for (auto brush : brushes.elements)
+	{
+		if (brush == nullptr) continue;
+
+		for (std::size_t face = 0; face < brush->getNumFaces(); ++face, ++row)
+		{
+			brush->getFace(face).setPlane3(
+				Plane3(planeData(row, 0), planeData(row, 1), planeData(row, 2), planeData(row, 3))
+			);
+		}
+	}
+}
+
+py::list BulkDataInterface::getFaceShaders(const py::iterable& nodes)
+{
+	auto brushes = resolveBrushes(nodes);
+
+	py::list shaders(countFaces(brushes));
+	std::size_t index = 0;
+
+	for (auto brush : brushes.elements)
+	{
+		if (brush == nullptr) continue;
+
+		for (std::size_t face = 0; face < brush->getNumFaces(); ++face)
+		{
+			shaders[index++] = py::str(brush->getFace(face).getShader());
+		}
+	}
+
+	return shaders;
+}
+
+void BulkDataInterface::setFaceShaders(const py::iterable& nodes, const py::sequence& shaders)
+{
+	auto brushes = resolveBrushes(nodes);
+
+	checkSize(shaders, countFaces(brushes));
+
+	std::vector<std::string> names;
+
+	for (const auto& shader : shaders)
+	{
+		names.push_back(shader.cast<std::string>());
+	}
+
+	std::size_t index = 0;
+
+	UndoableCommand cmd("setFaceShaders");
+
+	for (auto brush : brushes.elements)
+	{
+		if (brush == nullptr) continue;
+
+		for (std::size_t face = 0; face < brush->getNumFaces(); ++face)
+		{
+			brush->getFace(face).setShader(names[index++]);
+		}
+	}
+}
+
+py::tuple BulkDataInterface::getControlGrids(const py::iterable& nodes)
+{
+	auto patches = resolvePatches(nodes);
+
+	py::array_t<double> controls(std::vector<py::ssize_t>{ static_cast<py::ssize_t>(countControls(patches)), 5 });
+	py::array_t<std::size_t> dimensions(std::vector<py::ssize_t>{ static_cast<py::ssize_t>(patches.elements.size()), 2 });
+
+	auto controlData = controls.mutable_unchecked<2>();
+	auto dimensionData = dimensions.mutable_unchecked<2>();
+
+	py::ssize_t row = 0;
+
+	for (std::size_t i = 0; i < patches.elements.size(); ++i)
+	{
+		auto patch = patches.elements[i];
+
+		dimensionData(i, 0) = patch != nullptr ? patch->getHeight() : 0;
+		dimensionData(i, 1) = patch != nullptr ? patch->getWidth() : 0;
+
+		for (std::size_t r = 0; r < dimensionData(i, 0); ++r)
+		{
+			for (std::size_t c = 0; c < dimensionData(i, 1); ++c, ++row)
+			{
+				const auto& ctrl = patch->ctrlAt(r, c);
+
+				controlData(row, 0) = ctrl.vertex.x();
+				controlData(row, 1) = ctrl.vertex.y();
+				controlData(row, 2) = ctrl.vertex.z();
+				controlData(row, 3) = ctrl.texcoord.x();
+				controlData(row, 4) = ctrl.texcoord.y();
+			}
+		}
+	}
+
+	return py::make_tuple(controls, dimensions);
+}
+
+void BulkDataInterface::setControlGrids(const py::iterable& nodes, const DoubleArray& controls)
+{
+	auto patches = resolvePatches(nodes);
+
+	checkShape(controls, countControls(patches), 5);
+
+	auto controlData = controls.unchecked<2>();
+	py::ssize_t row = 0;
+
+	UndoableCommand cmd("setControlGrids");
+
+	for (auto patch : patches.elements)
+	{
+		if (patch == nullptr) continue;
+
+		patch->undoSave();
+
+		for (std::size_t r = 0; r < patch->getHeight(); ++r)
+		{
+			for (std::size_t c = 0; c < patch->getWidth(); ++c, ++row)
+			{
+				auto& ctrl = patch->ctrlAt(r, c);
+
+				ctrl.vertex = Vector3(controlData(row, 0), controlData(row, 1), controlData(row, 2));
+				ctrl.texcoord = Vector2(controlData(row, 3), controlData(row, 4));
+			}
+		}
+
+		patch->controlPointsChanged();
+	}
+}
+
+py::list BulkDataInterface::getKeyValues(const py::iterable& nodes)
+{
+	auto entities = resolveEntities(nodes);
+
+	py::list result(entities.elements.size());
+
+	for (std::size_t i = 0; i < entities.elements.size(); ++i)
+	{
+		py::dict keyValues;
+
+		if (auto entity = entities.elements[i]; entity != nullptr)
+		{
+			entity->forEachKeyValue([&](const std::string& key, const std::string& value)
+			{
+				keyValues[py::str(key)] = py::str(value);
+			});
+		}
+
+		result[i] = keyValues;
+	}
+
+	return result;
+}
+
+void BulkDataInterface::setKeyValues(const py::iterable& nodes, const py::sequence& keyValues)
+{
+	auto entities = resolveEntities(nodes);
+
+	checkSize(keyValues, entities.elements.size());
+
+	// Convert and check everything before touching the first entity
+	std::vector<std::vector<std::pair<std::string, std::string>>> pairsPerNode(entities.elements.size());
+
+	for (std::size_t i = 0; i < entities.elements.size(); ++i)
+	{
+		for (const auto& pair : keyValues[i].cast<py::dict>())
+		{
+			pairsPerNode[i].emplace_back(pair.first.cast<std::string>(), pair.second.cast<std::string>());
+		}
+
+		if (entities.elements[i] == nullptr && !pairsPerNode[i].empty())
+		{
+			throw std::invalid_argument(fmt::format("Node {0} is not an entity", i));
+		}
+	}
+
+	UndoableCommand cmd("setKeyValues");
+
+	for (std::size_t i = 0; i < entities.elements.size(); ++i)
+	{
+		for (const auto& [key, value] : pairsPerNode[i])
+		{
+			entities.elements[i]->setKeyValue(key, value);
+		}
+	}
+}
+
+void BulkDataInterface::registerInterface(py::module& scope, py::dict& globals)
+{
+	py::class_<BulkDataInterface> bulkData(scope, "BulkData");
+
+	bulkData.def("getFacePlanes", &BulkDataInterface::getFacePlanes);
+	bulkData.def("setFacePlanes", &BulkDataInterface::setFacePlanes);
+	bulkData.def("getFaceShaders", &BulkDataInterface::getFaceShaders);
+	bulkData.def("setFaceShaders", &BulkDataInterface::setFaceShaders);
+	bulkData.def("getControlGrids", &BulkDataInterface::getControlGrids);
+	bulkData.def("setControlGrids", &BulkDataInterface::setControlGrids);
+	bulkData.def("getKeyValues", &BulkDataInterface::getKeyValues);
+	bulkData.def("setKeyValues", &BulkDataInterface::setKeyValues);
+
+	// Now point the Python variable "GlobalBulkData" to this instance
+	globals["GlobalBulkData"] = this;
+}
+
+} // namespace script
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "iscript.h"
+#include "iscriptinterface.h"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+namespace script
+{
+
+/**
+ * Bulk accessors for the geometry and spawnargs of many scene nodes at once,
+ * exposed to Python as GlobalBulkData.
+ *
+ * Numeric data is exchanged through numpy arrays (float64, C order) which are
+ * filled in place, without creating a Python object per face or control point.
+ * Each setter is applied as a single undoable operation. Nodes of the wrong
+ * type are skipped by the getters (reported with zero elements) and must not
+ * receive any data in the setters.
+ */
+class BulkDataInterface :
+	public IScriptInterface
+{
+public:
+	using DoubleArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+	// Returns a tuple (planes, faceCounts): the planes of all faces of the given brushes
+	// as (numFaces, 4) array holding normal x, y, z and distance, and the number of
+	// faces of each node as (numNodes,) array
+	py::tuple getFacePlanes(const py::iterable& nodes);
+
+	// Assigns the given (numFaces, 4) plane array to the faces of the given brushes,
+	// the face count of every brush must match the one returned by getFacePlanes
+	void setFacePlanes(const py::iterable& nodes, const DoubleArray& planes);
+
+	// Returns the material names of all faces of the given brushes as flat list
+	py::list getFaceShaders(const py::iterable& nodes);
+
+	// Assigns the material names (one per face) to the faces of the given brushes
+	void setFaceShaders(const py::iterable& nodes, const py::sequence& shaders);
+
+	// Returns a tuple (controls, dimensions): the control points of the given patches
+	// as (numControls, 5) array holding x, y, z, u, v (row by row), and the height and
+	// width of each patch as (numNodes, 2) array
+	py::tuple getControlGrids(const py::iterable& nodes);
+
+	// Assigns the (numControls, 5) control array to the given patches, the dimensions
+	// of the patches are not changed and must match the ones returned by getControlGrids
+	void setControlGrids(const py::iterable& nodes, const DoubleArray& controls);
+
+	// Returns the spawnargs of each given entity as list of dicts
+	py::list getKeyValues(const py::iterable& nodes);
+
+	// Applies the given list of dicts (one per node) to the given entities,
+	// an empty value removes the key
+	void setKeyValues(const py::iterable& nodes, const py::sequence& keyValues);
+
+	// IScriptInterface implementation
+	void registerInterface(py::module& scope, py::dict& globals) override;
+};
+
+} // namespace script
@@ -79,7 +79,7 @@ void DeclarationManagerInterface::registerInterface(py::module& scope, py::dict&
         .def_readwrite("typeName", &decl::DeclarationBlockSyntax::typeName)
         .def_readwrite("name", &decl::DeclarationBlockSyntax::name)
         .def_readwrite("contents", &decl::DeclarationBlockSyntax::contents)
-        .def_readwrite("modName", &decl::DeclarationBlockSyntax::modName);
+        .def_property("modName", &decl::DeclarationBlockSyntax::getModName, &decl::DeclarationBlockSyntax::setModName);
 
     declaration.def(py::init<const decl::IDeclaration::Ptr&>());
     declaration.def("isNull", &ScriptDeclaration::isNull);
@@ -53,7 +53,7 @@ ArchiveFilePtr openSoundFile(const std::string& fileName)
 SoundManager::SoundManager()
 {
     decl::DeclarationBlockSyntax defaultBlock;
-    defaultBlock.fileInfo = vfs::FileInfo("sound/", "_autogenerated_by_darkradiant_.sndshd", vfs::Visibility::HIDDEN);
+    defaultBlock.setFileInfo(vfs::FileInfo("sound/", "_autogenerated_by_darkradiant_.sndshd", vfs::Visibility::HIDDEN));
 
     _emptyShader = std::make_unique<SoundShader>("");
     _emptyShader->setBlockSyntax(defaultBlock);
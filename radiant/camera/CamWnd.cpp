@@ -5,6 +5,7 @@
 #include "icolourscheme.h"
 #include "itextstream.h"
 #include "icameraview.h"
+#include "iprofiler.h"
 #include "ui/imainframe.h"
 
 #include <functional>
@@ -695,6 +696,8 @@ void CamWnd::drawGrid()
 
 void CamWnd::Cam_Draw()
 {
+    PROFILE_ZONE("CamWnd::draw");
+
     wxSize glSize = _wxGLWidget->GetSize();
 
     if (_camera->getDeviceWidth() != glSize.GetWidth() || _camera->getDeviceHeight() != glSize.GetHeight())
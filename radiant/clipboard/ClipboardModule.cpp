@@ -21,10 +21,59 @@ namespace
 
         return hash;
     }
+
+    // Private format marking the clipboard data placed by setContent()
+    const wxDataFormat& getContentFormat()
+    {
+        static wxDataFormat format("application/x-darkradiant-clipboard-content");
+        return format;
+    }
+
+    // Text data object converting the content to text only when the
+    // clipboard data is actually requested by an application
+    class DeferredTextDataObject :
+        public wxTextDataObject
+    {
+    private:
+        radiant::IClipboardContent::Ptr _content;
+
+        mutable wxString _text;
+        mutable bool _textGenerated;
+
+    public:
+        DeferredTextDataObject(const radiant::IClipboardContent::Ptr& content) :
+            _content(content),
+            _textGenerated(false)
+        {}
+
+        size_t GetTextLength() const override
+        {
+            return GetText().length() + 1;
+        }
+
+        wxString GetText() const override
+        {
+            if (!_textGenerated)
+            {
+                _text = _content->getString();
+                _textGenerated = true;
+            }
+
+            return _text;
+        }
+    };
 }
 
 std::string ClipboardModule::getString()
 {
+    // Our own content doesn't need to take the detour through the system clipboard
+    auto content = getContent();
+
+    if (content)
+    {
+        return content->getString();
+    }
+
 	std::string returnValue;
 
 	if (wxTheClipboard->Open())
@@ -50,6 +99,7 @@ void ClipboardModule::setString(const std::string& str)
 		wxTheClipboard->SetData(new wxTextDataObject(str));
 		wxTheClipboard->Close();
 
+        _content.reset();
         _contentHash = getContentHash(str);
 
         // Contents changed signal
@@ -57,6 +107,49 @@ void ClipboardModule::setString(const std::string& str)
 	}
 }
 
+void ClipboardModule::setContent(const radiant::IClipboardContent::Ptr& content)
+{
+    if (wxTheClipboard->Open())
+    {
+        // The text is offered alongside a marker format which is used to
+        // check whether the clipboard still holds our data
+        auto data = new wxDataObjectComposite;
+        data->Add(new DeferredTextDataObject(content), true);
+
+        auto marker = new wxCustomDataObject(getContentFormat());
+        marker->SetData(1, "1");
+        data->Add(marker);
+
+        // This data objects are held by the clipboard, so do not delete them in the app.
+        wxTheClipboard->SetData(data);
+        wxTheClipboard->Close();
+
+        _content = content;
+        _contentHash.clear();
+
+        // Contents changed signal
+        _sigContentsChanged.emit();
+    }
+}
+
+radiant::IClipboardContent::Ptr ClipboardModule::getContent()
+{
+    return _content;
+}
+
+bool ClipboardModule::isContentOnClipboard()
+{
+    bool contentIsPresent = false;
+
+    if (wxTheClipboard->Open())
+    {
+        contentIsPresent = wxTheClipboard->IsSupported(getContentFormat());
+        wxTheClipboard->Close();
+    }
+
+    return contentIsPresent;
+}
+
 sigc::signal<void>& ClipboardModule::signal_clipboardContentChanged()
 {
     return _sigContentsChanged;
@@ -77,16 +170,44 @@ const StringSet& ClipboardModule::getDependencies() const
 void ClipboardModule::initialiseModule(const IApplicationContext& ctx)
 {
     wxTheApp->Bind(wxEVT_ACTIVATE_APP, &ClipboardModule::onAppActivated, this);
+
+    module::GlobalModuleRegistry().signal_modulesUninitialising().connect(
+        sigc::mem_fun(this, &ClipboardModule::onModulesUninitialising)
+    );
 }
 
 void ClipboardModule::shutdownModule()
 {
     wxTheApp->Unbind(wxEVT_ACTIVATE_APP, &ClipboardModule::onAppActivated, this);
+
+    _content.reset();
+}
+
+void ClipboardModule::onModulesUninitialising()
+{
+    // The content refers to objects of other modules, which are about to be
+    // unloaded. Replace it by its text while these are still available.
+    if (_content)
+    {
+        setString(_content->getString());
+
+        // Hand the text over to the system, such that it's still
+        // available after the application has been closed
+        wxTheClipboard->Flush();
+    }
 }
 
 void ClipboardModule::onAppActivated(wxActivateEvent& ev)
 {
-    if (ev.GetActive())
+    // Another application might have taken over the clipboard in the meantime
+    if (ev.GetActive() && _content && !isContentOnClipboard())
+    {
+        _content.reset();
+    }
+
+    // As long as our own content is on the clipboard there's nothing to check,
+    // converting the content to text just for calculating the hash is avoided
+    if (ev.GetActive() && !_content)
     {
         // Inspect the clipboard when the main window regains focus
         // and fire the event if the contents changed
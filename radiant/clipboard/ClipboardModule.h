@@ -14,9 +14,16 @@ private:
     sigc::signal<void> _sigContentsChanged;
     std::string _contentHash;
 
+    // The content passed to setContent(), as long as it's on the system clipboard.
+    // Other applications can only take over the clipboard while we're in the
+    // background, this is checked when the application is activated again.
+    radiant::IClipboardContent::Ptr _content;
+
 public:
 	std::string getString() override;
 	void setString(const std::string& str) override;
+    void setContent(const radiant::IClipboardContent::Ptr& content) override;
+    radiant::IClipboardContent::Ptr getContent() override;
     virtual sigc::signal<void>& signal_clipboardContentChanged() override;
 
 	const std::string& getName() const override;
@@ -26,6 +33,10 @@ public:
 
 private:
     void onAppActivated(wxActivateEvent& ev);
+    void onModulesUninitialising();
+
+    // Returns true if the system clipboard still holds the data placed by setContent()
+    bool isContentOnClipboard();
 };
 
 }
@@ -19,6 +19,7 @@
 #include "ishaders.h"
 #include "ieditstopwatch.h"
 #include "icounter.h"
+#include "ijobsystem.h"
 #include "icameraview.h"
 
 #include "wxutil/menu/CommandMenuItem.h"
@@ -127,6 +128,7 @@ const StringSet& UserInterfaceModule::getDependencies() const
         MODULE_EDITING_STOPWATCH,
         MODULE_COUNTER,
         MODULE_CLIPPER,
+        MODULE_JOBSYSTEM,
     };
 
 	return _dependencies;
@@ -234,6 +236,12 @@ void UserInterfaceModule::initialiseModule(const IApplicationContext& ctx)
 
 	wxTheApp->Bind(DISPATCH_EVENT, &UserInterfaceModule::onDispatchEvent, this);
 
+    // Continuations of background tasks are delivered through the wx event loop
+    GlobalJobSystem().setMainThreadDispatcher([this](const std::function<void()>& func)
+    {
+        dispatch(func);
+    });
+
     _mapEditModeChangedConn = GlobalMapModule().signal_editModeChanged().connect(
         sigc::ptr_fun(&MapMergePanel::OnMapEditModeChanged)
     );
@@ -290,6 +298,8 @@ void UserInterfaceModule::shutdownModule()
     _userControls.clear();
     _autosaveTimer.reset();
 
+    GlobalJobSystem().setMainThreadDispatcher({});
+
 	wxTheApp->Unbind(DISPATCH_EVENT, &UserInterfaceModule::onDispatchEvent, this);
 
 	GlobalRadiantCore().getMessageBus().removeListener(_execFailedListener);
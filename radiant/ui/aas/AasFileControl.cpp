@@ -4,6 +4,7 @@
 #include "iarchive.h"
 #include "ui/imainframe.h"
 #include "ifilesystem.h"
+#include "itextstream.h"
 
 #include <wx/event.h>
 #include <wx/button.h>
@@ -21,7 +22,8 @@ AasFileControl::AasFileControl(wxWindow* parent, const map::AasFileInfo& info) :
     _refreshButton(nullptr),
     _buttonHBox(nullptr),
     _updateActive(nullptr),
-    _info(info)
+    _info(info),
+    _loadTarget(std::make_shared<AasFileControl*>(this))
 {
     // Create the main toggle
 	_toggle = new wxToggleButton(parent, wxID_ANY, info.type.fileExtension);
@@ -41,6 +43,23 @@ AasFileControl::AasFileControl(wxWindow* parent, const map::AasFileInfo& info) :
 
 AasFileControl::~AasFileControl()
 {
+    // Let a running load finish, its result will be dropped
+    _loadTarget.reset();
+
+    if (_loadTask)
+    {
+        _loadTask->cancel();
+
+        try
+        {
+            _loadTask->wait();
+        }
+        catch (const std::exception& ex)
+        {
+            rWarning() << "Failed to load AAS file " << _info.absolutePath << ": " << ex.what() << std::endl;
+        }
+    }
+
     // Detach before destruction
     if (_toggle->GetValue())
     {
@@ -66,24 +85,61 @@ void AasFileControl::update()
 
 void AasFileControl::ensureAasFileLoaded()
 {
-    if (_aasFile) return;
+    // Nothing to do if the file is already there or on its way
+    if (_aasFile || _loadTask) return;
+
+    std::weak_ptr<AasFileControl*> weakTarget = _loadTarget;
+    auto path = _info.absolutePath;
+    auto result = std::make_shared<map::IAasFilePtr>();
 
-    ArchiveTextFilePtr file = GlobalFileSystem().openTextFileInAbsolutePath(_info.absolutePath);
+    _loadTask = GlobalJobSystem().createGroup("AasFileLoader");
 
-    if (file)
+    _loadTask->run([result, path]()
     {
-        std::istream stream(&file->getInputStream());
-        map::IAasFileLoaderPtr loader = GlobalAasFileManager().getLoaderForStream(stream);
+        ArchiveTextFilePtr file = GlobalFileSystem().openTextFileInAbsolutePath(path);
 
-        if (loader && loader->canLoad(stream))
+        if (file)
         {
-            stream.seekg(0, std::ios_base::beg);
+            std::istream stream(&file->getInputStream());
+            map::IAasFileLoaderPtr loader = GlobalAasFileManager().getLoaderForStream(stream);
 
-            _aasFile = loader->loadFromStream(stream);
+            if (loader && loader->canLoad(stream))
+            {
+                stream.seekg(0, std::ios_base::beg);
 
-            // Construct a renderable to attach to the rendersystem
-            _renderable.setAasFile(_aasFile);
+                *result = loader->loadFromStream(stream);
+            }
         }
+    });
+
+    // Hand the result over to the main thread
+    _loadTask->continueOnMainThread([weakTarget, result]()
+    {
+        if (auto target = weakTarget.lock())
+        {
+            (*target)->onAasFileLoaded(*result);
+        }
+    });
+}
+
+void AasFileControl::onAasFileLoaded(const map::IAasFilePtr& aasFile)
+{
+    auto loadTask = std::move(_loadTask);
+    loadTask->wait();
+
+    _aasFile = aasFile;
+
+    if (!_aasFile)
+    {
+        rWarning() << "Could not load AAS file " << _info.absolutePath << std::endl;
+        return;
+    }
+
+    // Construct a renderable to attach to the rendersystem
+    if (_toggle->GetValue())
+    {
+        _renderable.setAasFile(_aasFile);
+        GlobalMainFrame().updateAllWindows();
     }
 }
 
@@ -91,10 +147,11 @@ void AasFileControl::onToggle(wxCommandEvent& ev)
 {
     if (_toggle->GetValue())
     {
-        ensureAasFileLoaded();
-
+        // The renderable receives the file as soon as it's loaded
         _renderable.setAasFile(_aasFile);
         GlobalRenderSystem().attachRenderable(_renderable);
+
+        ensureAasFileLoaded();
     }
     else
     {
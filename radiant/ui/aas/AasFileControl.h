@@ -3,6 +3,7 @@
 #include <wx/event.h>
 #include <memory>
 #include "iaasfile.h"
+#include "ijobsystem.h"
 #include "RenderableAasFile.h"
 
 class wxWindow;
@@ -37,6 +38,13 @@ private:
     // The AAS file reference (can be empty)
     map::IAasFilePtr _aasFile;
 
+    // Large AAS files are parsed on a worker thread, the result
+    // is handed over to this control on the main thread
+    jobs::IJobGroup::Ptr _loadTask;
+
+    // Expired by the destructor, such that a pending result is discarded
+    std::shared_ptr<AasFileControl*> _loadTarget;
+
     // The renderable that is attached to the rendersystem when active
     map::RenderableAasFile _renderable;
 
@@ -54,6 +62,7 @@ public:
 
 private:
     void ensureAasFileLoaded();
+    void onAasFileLoaded(const map::IAasFilePtr& aasFile);
 
 	void onToggle(wxCommandEvent& ev);
 	void onRefresh(wxCommandEvent& ev);
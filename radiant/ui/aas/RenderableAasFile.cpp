@@ -37,6 +37,10 @@ void RenderableAasFile::onHideDistantAreasChanged()
     _hideDistanceSquared = registry::getValue<float>(RKEY_AAS_AREA_HIDE_DISTANCE);
     _hideDistanceSquared *= _hideDistanceSquared;
 
+    // Start over, the next frame is going to evaluate the distances again
+    _areaWithinDistance.assign(_areas.size(), false);
+    _visibleAreas.clear();
+
     if (!_hideDistantAreas)
     {
         _visibleAreas = _areas;
@@ -67,43 +71,65 @@ void RenderableAasFile::onPreRender(const VolumeTest& volume)
         _textRenderer = renderSystem->captureTextRenderer(IGLFont::Style::Sans, 14);
     }
 
+    // Only the area numbers within the view are passed to the text renderer
+    if (_renderNumbers)
+    {
+        volume.TestAABBs(_areaBatch, _areaIntersections.data());
+    }
+
     if (_hideDistantAreas)
     {
         // Get the camera position for distance clipping
         auto invModelView = volume.GetModelview().getFullInverse();
         auto viewPos = invModelView.tCol().getProjected();
 
-        _visibleAreas.clear();
-
-        for (const auto& area : _areas)
+        // The area geometry lives in a single slot, which is only
+        // re-uploaded when an area moved into or out of the distance
+        if (updateAreasWithinDistance(viewPos))
         {
-            if ((area.getOrigin() - viewPos).getLengthSquared() > _hideDistanceSquared)
-            {
-                continue;
-            }
-
-            _visibleAreas.push_back(area);
+            _renderableAreas.queueUpdate();
         }
+    }
+
+    for (auto& [areaNum, text] : _renderableNumbers)
+    {
+        text.setVisible(_renderNumbers && _areaIntersections[areaNum] != VOLUME_OUTSIDE &&
+            (!_hideDistantAreas || _areaWithinDistance[areaNum]));
+        text.update(_textRenderer);
+    }
+
+    _renderableAreas.update(_normalShader);
+}
+
+bool RenderableAasFile::updateAreasWithinDistance(const Vector3& viewPos)
+{
+    bool changed = false;
 
-        for (auto& [areaNum, text] : _renderableNumbers)
+    for (std::size_t i = 0; i < _areas.size(); ++i)
+    {
+        bool withinDistance = (_areas[i].getOrigin() - viewPos).getLengthSquared() <= _hideDistanceSquared;
+
+        if (_areaWithinDistance[i] != withinDistance)
         {
-            text.setVisible(_renderNumbers && 
-                (_aasFile->getArea(areaNum).center - viewPos).getLengthSquared() <= _hideDistanceSquared);
-            text.update(_textRenderer);
+            _areaWithinDistance[i] = withinDistance;
+            changed = true;
         }
-
-        _renderableAreas.queueUpdate();
     }
-    else
+
+    if (changed)
     {
-        for (auto& [_, text] : _renderableNumbers)
+        _visibleAreas.clear();
+
+        for (std::size_t i = 0; i < _areas.size(); ++i)
         {
-            text.setVisible(_renderNumbers);
-            text.update(_textRenderer);
+            if (_areaWithinDistance[i])
+            {
+                _visibleAreas.push_back(_areas[i]);
+            }
         }
     }
 
-    _renderableAreas.update(_normalShader);
+    return changed;
 }
 
 std::size_t RenderableAasFile::getHighlightFlags()
@@ -134,6 +160,7 @@ void RenderableAasFile::prepare()
 void RenderableAasFile::constructRenderables()
 {
     _areas.clear();
+    _areaBatch.clear();
     _renderableNumbers.clear();
 
 	for (std::size_t areaNum = 0; areaNum < _aasFile->getNumAreas(); ++areaNum)
@@ -141,11 +168,16 @@ void RenderableAasFile::constructRenderables()
 		const IAasFile::Area& area = _aasFile->getArea(static_cast<int>(areaNum));
 
 		_areas.push_back(area.bounds);
+        _areaBatch.add(area.bounds);
 
         // Allocate a new RenderableNumber for each area
         _renderableNumbers.try_emplace(areaNum, string::to_string(areaNum), area.center, Vector4(1, 1, 1, 1));
 	}
 
+    _areaWithinDistance.assign(_areas.size(), false);
+    _areaIntersections.assign(_areas.size(), VOLUME_INSIDE);
+    _visibleAreas.clear();
+
     if (!_hideDistantAreas)
     {
         _visibleAreas = _areas;
@@ -160,6 +192,9 @@ void RenderableAasFile::clear()
     _renderableAreas.clear();
     _areas.clear();
     _visibleAreas.clear();
+    _areaWithinDistance.clear();
+    _areaBatch.clear();
+    _areaIntersections.clear();
     _renderableNumbers.clear();
     _normalShader.reset();
     _textRenderer.reset();
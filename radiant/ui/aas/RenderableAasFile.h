@@ -6,6 +6,7 @@
 #include "irenderable.h"
 #include "irender.h"
 #include "iaasfile.h"
+#include "math/AABBBatch.h"
 
 #include "render/RenderableBoundingBoxes.h"
 #include "render/StaticRenderableText.h"
@@ -32,6 +33,14 @@ private:
     std::vector<AABB> _areas;
     std::vector<AABB> _visibleAreas;
 
+    // Result of the distance check per area, the visible area
+    // geometry is only re-uploaded when any of these flags changes
+    std::vector<bool> _areaWithinDistance;
+
+    // Area bounds used to cull the area numbers against the view
+    AABBBatch _areaBatch;
+    std::vector<VolumeIntersectionValue> _areaIntersections;
+
 	bool _renderNumbers;
 	bool _hideDistantAreas;
 	float _hideDistanceSquared;
@@ -56,6 +65,7 @@ public:
 private:
 	void prepare();
 	void constructRenderables();
+    bool updateAreasWithinDistance(const Vector3& viewPos);
     void onHideDistantAreasChanged();
     void onShowAreaNumbersChanged();
 };
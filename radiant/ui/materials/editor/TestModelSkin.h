@@ -46,7 +46,7 @@ public:
 
         decl::DeclarationBlockSyntax syntax;
 
-        syntax.modName = "None";
+        syntax.setModName("None");
         syntax.typeName = "skin";
         syntax.name = getSkinName();
 
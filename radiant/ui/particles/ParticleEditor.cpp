@@ -1016,7 +1016,7 @@ void ParticleEditor::updateWidgetsFromParticle()
     auto origDef = GlobalParticlesManager().getDefByName(origName);
 
     fs::path outFile = GlobalGameManager().getModPath();
-    outFile /= origDef->getBlockSyntax().fileInfo.fullPath();
+    outFile /= origDef->getBlockSyntax().getFileInfo().fullPath();
 
 	findNamedObject<wxStaticText>(this, "ParticleEditorSaveNote")->SetLabelMarkup(
 		fmt::format(_("Note: changes will be written to the file <i>{0}</i>"), outFile.string()));
@@ -250,6 +250,15 @@ void PatchInspector::selectionChanged(const scene::INodePtr& node, bool isCompon
 	}
 }
 
+void PatchInspector::selectionBatchChanged(const selection::SelectionChangeSet& changes)
+{
+	// Rescan once for the whole batch
+	if (!changes.selected.empty() || !changes.deselected.empty())
+	{
+		rescanSelection();
+	}
+}
+
 void PatchInspector::clearVertexChooser()
 {
 	_updateActive = true;
@@ -611,7 +611,7 @@ void SkinEditor::discardChanges()
     // Stop editing on all columns
     _remappingList->CancelEditing();
 
-    if (_skin->isModified() && _skin->getBlockSyntax().fileInfo.name.empty())
+    if (_skin->isModified() && _skin->getBlockSyntax().getFileInfo().name.empty())
     {
         // This decl has been created but not saved yet, discarding it means removing it
         try
@@ -637,7 +637,7 @@ void SkinEditor::deleteSkin()
 {
     if (!_skin) return;
 
-    auto fileInfo = _skin->getBlockSyntax().fileInfo.isEmpty() ? _("") : " " + _skin->getBlockSyntax().fileInfo.fullPath();
+    auto fileInfo = _skin->getBlockSyntax().getFileInfo().isEmpty() ? _("") : " " + _skin->getBlockSyntax().getFileInfo().fullPath();
 
     if (wxutil::Messagebox::Show(_("Confirm Removal"),
         fmt::format(_("The selected skin {0} will be removed,\nincluding its source text in the .skin file{1}.\n"
@@ -779,7 +779,7 @@ void SkinEditor::onAddModelToSkin(wxCommandEvent& ev)
 
 bool SkinEditor::skinHasBeenNewlyCreated()
 {
-    return _skin && _skin->getBlockSyntax().fileInfo.fullPath().empty();
+    return _skin && _skin->getBlockSyntax().getFileInfo().fullPath().empty();
 }
 
 void SkinEditor::onRemoveModelFromSkin(wxCommandEvent& ev)
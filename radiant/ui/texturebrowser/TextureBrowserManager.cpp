@@ -1,5 +1,6 @@
 #include "TextureBrowserManager.h"
 #include "TextureBrowserPanel.h"
+#include "TextureThumbnailCache.h"
 
 #include <list>
 #include <sigc++/functors/mem_fun.h>
@@ -47,6 +48,9 @@ public:
 TextureBrowserManager::TextureBrowserManager()
 {}
 
+TextureBrowserManager::~TextureBrowserManager()
+{}
+
 std::string TextureBrowserManager::getSelectedShader()
 {
     if (_browsers.empty()) return "";
@@ -80,6 +84,11 @@ void TextureBrowserManager::updateAllWindows()
     }
 }
 
+TextureThumbnailCache& TextureBrowserManager::getThumbnailCache()
+{
+    return *_thumbnailCache;
+}
+
 void TextureBrowserManager::registerPreferencePage()
 {
     // Add a page to the given group
@@ -97,6 +106,7 @@ void TextureBrowserManager::registerPreferencePage()
     page.appendCheckBox(_("Texture scrollbar"), RKEY_TEXTURE_SHOW_SCROLLBAR);
     page.appendEntry(_("Mousewheel Increment"), RKEY_TEXTURE_MOUSE_WHEEL_INCR);
     page.appendSpinner(_("Max shadername length"), RKEY_TEXTURE_MAX_NAME_LENGTH, 4, 100, 1);
+    page.appendSpinner(_("Thumbnail memory budget (MB)"), RKEY_TEXTURE_THUMBNAIL_MEMORY, 8, 4096, 0);
 
     page.appendCheckBox(_("Show Texture Filter"), RKEY_TEXTURE_SHOW_FILTER);
     page.appendCheckBox(_("Show \"Other Materials\""), RKEY_TEXTURES_SHOW_OTHER_MATERIALS);
@@ -133,6 +143,8 @@ void TextureBrowserManager::initialiseModule(const IApplicationContext& ctx)
 
     registerPreferencePage();
 
+    _thumbnailCache = std::make_unique<TextureThumbnailCache>(ctx.getSettingsPath() + "thumbnails/");
+
     _shaderClipboardConn = GlobalShaderClipboard().signal_sourceChanged().connect(
         sigc::mem_fun(this, &TextureBrowserManager::onShaderClipboardSourceChanged)
     );
@@ -154,6 +166,7 @@ void TextureBrowserManager::shutdownModule()
 {
     GlobalUserInterface().unregisterControl(UserControl::TextureBrowser);
     _shaderClipboardConn.disconnect();
+    _thumbnailCache.reset();
 }
 
 void TextureBrowserManager::onShaderClipboardSourceChanged()
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <set>
+#include <memory>
 #include <sigc++/connection.h>
 #include "imodule.h"
 
@@ -8,6 +9,7 @@ namespace ui
 {
 
 class TextureBrowserPanel;
+class TextureThumbnailCache;
 
 constexpr const char* const RKEY_TEXTURES_HIDE_UNUSED = "user/ui/textures/browser/hideUnused";
 constexpr const char* const RKEY_TEXTURES_SHOW_FAVOURITES_ONLY = "user/ui/textures/browser/showFavouritesOnly";
@@ -21,6 +23,7 @@ constexpr const char* const RKEY_TEXTURE_MOUSE_WHEEL_INCR = "user/ui/textures/br
 constexpr const char* const RKEY_TEXTURE_SHOW_FILTER = "user/ui/textures/browser/showFilter";
 constexpr const char* const RKEY_TEXTURE_CONTEXTMENU_EPSILON = "user/ui/textures/browser/contextMenuMouseEpsilon";
 constexpr const char* const RKEY_TEXTURE_MAX_NAME_LENGTH = "user/ui/textures/browser/maxShadernameLength";
+constexpr const char* const RKEY_TEXTURE_THUMBNAIL_MEMORY = "user/ui/textures/browser/thumbnailMemoryBudget";
 
 class TextureBrowserManager :
     public RegisterableModule
@@ -29,8 +32,12 @@ private:
     std::set<TextureBrowserPanel*> _browsers;
     sigc::connection _shaderClipboardConn;
 
+    // Thumbnails shared by all texture browsers
+    std::unique_ptr<TextureThumbnailCache> _thumbnailCache;
+
 public:
     TextureBrowserManager();
+    ~TextureBrowserManager();
 
     // Use the currently selected shader (kind of legacy method)
     std::string getSelectedShader();
@@ -42,6 +49,8 @@ public:
     // Sends an queueUpdate() call to all registered browsers
     void updateAllWindows();
 
+    TextureThumbnailCache& getThumbnailCache();
+
     static TextureBrowserManager& Instance();
 
     // RegisterableModule
@@ -32,6 +32,7 @@
 #include "debugging/gl.h"
 #include "ui/mediabrowser/FocusMaterialRequest.h"
 #include "TextureBrowserManager.h"
+#include "TextureThumbnailCache.h"
 
 namespace ui
 {
@@ -49,6 +50,25 @@ namespace
 
     constexpr int VIEWPORT_BORDER = 12;
     constexpr int TILE_BORDER = 2;
+
+    TextureThumbnailCache& getThumbnailCache()
+    {
+        return TextureBrowserManager::Instance().getThumbnailCache();
+    }
+
+    // Returns the path of the material's editor image if it can be shown as thumbnail,
+    // or an empty string if the tile needs to display the full editor texture
+    std::string getThumbnailImagePath(const MaterialPtr& material)
+    {
+        auto expression = material->getEditorImageExpression();
+
+        if (!expression || expression->isCubeMap()) return {};
+
+        auto path = expression->getExpressionString();
+
+        // Image functions like addnormals() need to be evaluated by the material system
+        return path.find('(') == std::string::npos ? path : std::string();
+    }
 }
 
 class TextureThumbnailBrowser::TextureTile
@@ -60,23 +80,57 @@ public:
     Vector2i position;
     MaterialPtr material;
 
+    // The image shown as thumbnail, empty if the full-size editor image is used
+    std::string imagePath;
+
+    // False if the tile has been laid out before the image size was known
+    bool hasImageSize = true;
+
     TextureTile(TextureThumbnailBrowser& owner) :
         _owner(owner)
     {}
 
-    void render(bool drawName)
+    // Returns true if the tile is within the visible area, extended by the given margin
+    bool isWithinRange(int margin)
     {
-        TexturePtr texture = material->getEditorImage();
-        if (!texture) return;
+        return position.y() - size.y() - FONT_HEIGHT() < _owner.getOriginY() + margin &&
+            position.y() > _owner.getOriginY() - _owner.getViewportHeight() - margin;
+    }
 
+    void render(bool drawName)
+    {
         // Is this texture visible?
-        if ((position.y() - size.y() - FONT_HEIGHT() < _owner.getOriginY()) &&
-            (position.y() > _owner.getOriginY() - _owner.getViewportHeight()))
+        if (!isWithinRange(0)) return;
+
+        if (imagePath.empty())
         {
+            TexturePtr texture = material->getEditorImage();
+            if (!texture) return;
+
             drawBorder();
             drawTextureQuad(texture->getGLTexNum());
-            if (drawName)
-                drawTextureName();
+        }
+        else if (auto thumbnail = getThumbnailCache().bindThumbnail(imagePath); thumbnail)
+        {
+            drawBorder();
+            drawTextureQuad(thumbnail->getGLTexNum());
+        }
+        else
+        {
+            // Thumbnail is still loading
+            drawBorder();
+        }
+
+        if (drawName)
+            drawTextureName();
+    }
+
+    // Queues the thumbnail of this tile if it's close to the visible area
+    void prefetch()
+    {
+        if (!imagePath.empty() && !isWithinRange(0) && isWithinRange(_owner.getViewportHeight()))
+        {
+            getThumbnailCache().requestThumbnail(imagePath);
         }
     }
 
@@ -213,6 +267,7 @@ TextureThumbnailBrowser::TextureThumbnailBrowser(wxWindow* parent, bool showTool
     _showTextureFilter(registry::getValue<bool>(RKEY_TEXTURE_SHOW_FILTER)),
     _showTextureScrollbar(registry::getValue<bool>(RKEY_TEXTURE_SHOW_SCROLLBAR)),
     _showNamesKey(RKEY_TEXTURES_SHOW_NAMES),
+    _thumbnailMemoryKey(RKEY_TEXTURE_THUMBNAIL_MEMORY),
     _textureScale(50),
     _useUniformScale(registry::getValue<bool>(RKEY_TEXTURE_USE_UNIFORM_SCALE)),
     _uniformTextureSize(registry::getValue<int>(RKEY_TEXTURE_UNIFORM_SIZE)),
@@ -230,6 +285,10 @@ TextureThumbnailBrowser::TextureThumbnailBrowser(wxWindow* parent, bool showTool
 
     loadScaleFromRegistry();
 
+    getThumbnailCache().signal_thumbnailsLoaded().connect(
+        sigc::mem_fun(this, &TextureThumbnailBrowser::onThumbnailsLoaded)
+    );
+
     _shader = texdef_name_default();
 
     _shaderLabel = new wxutil::IconTextMenuItem(_("No shader"), TEXTURE_ICON);
@@ -420,14 +479,14 @@ void TextureThumbnailBrowser::keyChanged()
 }
 
 // Return the display width of a texture in the texture browser
-int TextureThumbnailBrowser::getTextureWidth(const Texture& tex) const
+int TextureThumbnailBrowser::getTextureWidth(std::size_t width, std::size_t height) const
 {
     if (!_useUniformScale)
     {
         // Don't use uniform scale
-        return static_cast<int>(tex.getWidth() * (static_cast<float>(_textureScale) / 100));
+        return static_cast<int>(width * (static_cast<float>(_textureScale) / 100));
     }
-    else if (tex.getWidth() >= tex.getHeight())
+    else if (width >= height)
     {
         // Texture is square, or wider than it is tall
         return _uniformTextureSize;
@@ -436,19 +495,19 @@ int TextureThumbnailBrowser::getTextureWidth(const Texture& tex) const
     {
         // Otherwise, preserve the texture's aspect ratio
         return static_cast<int>(_uniformTextureSize *
-            (static_cast<float>(tex.getWidth()) / tex.getHeight())
+            (static_cast<float>(width) / height)
         );
     }
 }
 
-int TextureThumbnailBrowser::getTextureHeight(const Texture& tex) const
+int TextureThumbnailBrowser::getTextureHeight(std::size_t width, std::size_t height) const
 {
     if (!_useUniformScale)
     {
         // Don't use uniform scale
-        return static_cast<int>(tex.getHeight() * (static_cast<float>(_textureScale) / 100));
+        return static_cast<int>(height * (static_cast<float>(_textureScale) / 100));
     }
-    else if (tex.getHeight() >= tex.getWidth())
+    else if (height >= width)
     {
         // Texture is square, or taller than it is wide
         return _uniformTextureSize;
@@ -458,7 +517,7 @@ int TextureThumbnailBrowser::getTextureHeight(const Texture& tex) const
         // Otherwise, preserve the texture's aspect ratio
         return static_cast<int>(
             _uniformTextureSize
-            * (static_cast<float>(tex.getHeight()) / tex.getWidth())
+            * (static_cast<float>(height) / width)
         );
     }
 }
@@ -519,12 +578,12 @@ TextureThumbnailBrowser::CurrentPosition::CurrentPosition()
 : origin(VIEWPORT_BORDER, -VIEWPORT_BORDER), rowAdvance(0)
 { }
 
-Vector2i TextureThumbnailBrowser::getNextPositionForTexture(const Texture& tex)
+Vector2i TextureThumbnailBrowser::getNextPositionForTexture(std::size_t width, std::size_t height)
 {
     auto& currentPos = *_currentPopulationPosition;
 
-    int nWidth = getTextureWidth(tex);
-    int nHeight = getTextureHeight(tex);
+    int nWidth = getTextureWidth(width, height);
+    int nHeight = getTextureHeight(width, height);
 
     // Wrap to the next row if there is not enough horizontal space for this
     // texture
@@ -605,12 +664,35 @@ void TextureThumbnailBrowser::createTileForMaterial(const MaterialPtr& material)
     auto& tile = *_tiles.back();
 
     tile.material = material;
+    tile.imagePath = getThumbnailImagePath(material);
 
-    Texture& texture = *tile.material->getEditorImage();
+    auto& thumbnails = getThumbnailCache();
+
+    if (!tile.imagePath.empty() &&
+        thumbnails.getStatus(tile.imagePath) == TextureThumbnailCache::Status::Unavailable)
+    {
+        tile.imagePath.clear(); // no thumbnail possible, show the full-size image
+    }
 
-    tile.position = getNextPositionForTexture(texture);
-    tile.size.x() = getTextureWidth(texture);
-    tile.size.y() = getTextureHeight(texture);
+    std::size_t width = TextureThumbnailCache::ThumbnailSize;
+    std::size_t height = TextureThumbnailCache::ThumbnailSize;
+
+    if (tile.imagePath.empty())
+    {
+        Texture& texture = *tile.material->getEditorImage();
+        width = texture.getWidth();
+        height = texture.getHeight();
+    }
+    else
+    {
+        // Lay out unknown images as square, they are re-arranged once their size is known.
+        // Their thumbnails are only loaded when they get close to the visible area.
+        tile.hasImageSize = thumbnails.getImageSize(tile.imagePath, width, height);
+    }
+
+    tile.position = getNextPositionForTexture(width, height);
+    tile.size.x() = getTextureWidth(width, height);
+    tile.size.y() = getTextureHeight(width, height);
 
     _entireSpaceHeight = std::max(
         _entireSpaceHeight,
@@ -734,11 +816,20 @@ void TextureThumbnailBrowser::draw()
     glEnable (GL_TEXTURE_2D);
 	glPolygonMode (GL_FRONT_AND_BACK, GL_FILL);
 
+    // The most recently requested thumbnails are loaded first,
+    // so queue the ones around the visible area before the visible ones
+    for (const auto& tile : _tiles)
+    {
+        tile->prefetch();
+    }
+
     for (const auto& tile : _tiles)
     {
         tile->render(_showNamesKey.get());
     }
 
+    getThumbnailCache().finishDraw(static_cast<std::size_t>(_thumbnailMemoryKey.get()) * 1024 * 1024);
+
 	debug::assertNoGlErrors();
 
     // reset the current texture
@@ -934,6 +1025,28 @@ void TextureThumbnailBrowser::onGLMouseButtonRelease(wxMouseEvent& ev)
     }
 }
 
+void TextureThumbnailBrowser::onThumbnailsLoaded()
+{
+    auto& thumbnails = getThumbnailCache();
+
+    for (const auto& tile : _tiles)
+    {
+        if (tile->imagePath.empty()) continue;
+
+        std::size_t width, height;
+
+        // Re-arrange the tiles if an image size is different from what has been assumed
+        if ((!tile->hasImageSize && thumbnails.getImageSize(tile->imagePath, width, height)) ||
+            thumbnails.getStatus(tile->imagePath) == TextureThumbnailCache::Status::Unavailable)
+        {
+            queueUpdate();
+            break;
+        }
+    }
+
+    queueDraw();
+}
+
 void TextureThumbnailBrowser::onIdle()
 {
     if (_updateNeeded)
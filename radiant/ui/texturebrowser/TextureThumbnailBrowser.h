@@ -91,6 +91,7 @@ class TextureThumbnailBrowser :
     bool _showTextureScrollbar;
     
     registry::CachedKey<bool> _showNamesKey;
+    registry::CachedKey<int> _thumbnailMemoryKey;
     int _textureScale;
     bool _useUniformScale;
 
@@ -160,13 +161,13 @@ private:
     // Repopulates the texture tiles
     void refreshTiles();
 
-    // Return the display width/height of a texture in the texture browser
-    int getTextureWidth(const Texture& tex) const;
-    int getTextureHeight(const Texture& tex) const;
+    // Return the display width/height of a texture with the given image size
+    int getTextureWidth(std::size_t width, std::size_t height) const;
+    int getTextureHeight(std::size_t width, std::size_t height) const;
 
-    // Get a new position for the given texture, and advance the CurrentPosition
+    // Get a new position for a texture of the given size, and advance the CurrentPosition
     // state object.
-    Vector2i getNextPositionForTexture(const Texture& texture);
+    Vector2i getNextPositionForTexture(std::size_t width, std::size_t height);
 
     bool checkSeekInMediaBrowser(); // sensitivity check
     void onSeekInMediaBrowser();
@@ -188,6 +189,9 @@ private:
 
     void updateScroll();
 
+    // Invoked when thumbnails finished loading in the background
+    void onThumbnailsLoaded();
+
     /**
      * Callback run when filter text was changed.
      */
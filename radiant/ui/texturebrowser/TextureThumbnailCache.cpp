@@ -0,0 +1,519 @@
+#include "TextureThumbnailCache.h"
+
+#include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <fmt/format.h>
+
+#include "itextstream.h"
+#include "ifilesystem.h"
+#include "ui/iuserinterface.h"
+
+#include "os/fs.h"
+#include "os/path.h"
+#include "string/case_conv.h"
+#include "stream/utils.h"
+#include "stream/FileInputStream.h"
+#include "BasicTexture2D.h"
+#include "image/PixelKernels.h"
+#include "debugging/gl.h"
+
+namespace ui
+{
+
+namespace
+{
+    constexpr uint32_t CacheFileMagic = 0x4E485444; // "DTHN"
+    constexpr uint32_t CacheFileVersion = 1;
+
+    // Thumbnails not drawn within this amount of draw calls may be released
+    constexpr std::size_t ReleaseGracePeriod = 8;
+
+    // Returns the amount of bytes per 4x4 block for the given compressed format, or 0 if unknown
+    std::size_t getCompressedBlockSize(GLenum format)
+    {
+        switch (format)
+        {
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+            return 8;
+        case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+        case GL_COMPRESSED_RG_RGTC2:
+            return 16;
+        default:
+            return 0;
+        }
+    }
+
+    std::size_t getLevelDataSize(GLenum format, std::size_t width, std::size_t height)
+    {
+        if (format == GL_RGBA)
+        {
+            return width * height * 4;
+        }
+
+        return ((width + 3) / 4) * ((height + 3) / 4) * getCompressedBlockSize(format);
+    }
+
+    // Returns the modification time of the given VFS file, or the one of its containing PK4
+    int64_t getFileTimestamp(const std::string& vfsPath)
+    {
+        auto info = GlobalFileSystem().getFileInfo(vfsPath);
+        auto archivePath = info.getArchivePath();
+
+        if (archivePath.empty()) return 0;
+
+        try
+        {
+            auto path = info.getIsPhysicalFile() ? fs::path(archivePath) / vfsPath : fs::path(archivePath);
+            return static_cast<int64_t>(fs::last_write_time(path).time_since_epoch().count());
+        }
+        catch (const fs::filesystem_error& ex)
+        {
+            rWarning() << "Cannot determine modification time of " << vfsPath << ": " << ex.what() << std::endl;
+            return 0;
+        }
+    }
+}
+
+std::size_t TextureThumbnail::getDataSize() const
+{
+    std::size_t size = 0;
+
+    for (const auto& level : levels)
+    {
+        size += level.data.size();
+    }
+
+    return size;
+}
+
+TextureThumbnailCache::TextureThumbnailCache(const std::string& cachePath) :
+    _cachePath(os::standardPathWithSlash(cachePath)),
+    _self(std::make_shared<TextureThumbnailCache*>(this)),
+    _drawCount(0),
+    _residentBytes(0)
+{}
+
+TextureThumbnailCache::~TextureThumbnailCache()
+{
+    // Block until the current worker task is done, the rest is discarded
+    _loader.clear();
+}
+
+TextureThumbnailCache::Status TextureThumbnailCache::requestThumbnail(const std::string& imagePath)
+{
+    auto& entry = _entries[imagePath];
+
+    if (entry.status == Status::Pending && !entry.queued)
+    {
+        entry.queued = true;
+        loadThumbnailAsync(imagePath);
+    }
+
+    return entry.status;
+}
+
+TextureThumbnailCache::Status TextureThumbnailCache::getStatus(const std::string& imagePath) const
+{
+    auto found = _entries.find(imagePath);
+
+    return found != _entries.end() ? found->second.status : Status::Pending;
+}
+
+bool TextureThumbnailCache::getImageSize(const std::string& imagePath, std::size_t& width, std::size_t& height) const
+{
+    auto found = _entries.find(imagePath);
+
+    if (found == _entries.end() || found->second.imageWidth == 0 || found->second.imageHeight == 0)
+    {
+        return false;
+    }
+
+    width = found->second.imageWidth;
+    height = found->second.imageHeight;
+
+    return true;
+}
+
+TexturePtr TextureThumbnailCache::bindThumbnail(const std::string& imagePath)
+{
+    if (requestThumbnail(imagePath) != Status::Available)
+    {
+        return TexturePtr();
+    }
+
+    auto& entry = _entries[imagePath];
+    entry.lastUsed = _drawCount;
+
+    if (entry.texture)
+    {
+        return entry.texture;
+    }
+
+    const auto& thumbnail = *entry.thumbnail;
+
+    GLuint textureNum;
+    glGenTextures(1, &textureNum);
+    glBindTexture(GL_TEXTURE_2D, textureNum);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(thumbnail.levels.size() - 1));
+
+    for (std::size_t i = 0; i < thumbnail.levels.size(); ++i)
+    {
+        const auto& level = thumbnail.levels[i];
+
+        if (thumbnail.format == GL_RGBA)
+        {
+            glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), GL_RGBA8, static_cast<GLsizei>(level.width),
+                static_cast<GLsizei>(level.height), 0, GL_RGBA, GL_UNSIGNED_BYTE, level.data.data());
+        }
+        else
+        {
+            glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), thumbnail.format,
+                static_cast<GLsizei>(level.width), static_cast<GLsizei>(level.height), 0,
+                static_cast<GLsizei>(level.data.size()), level.data.data());
+        }
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    debug::assertNoGlErrors();
+
+    auto texture = std::make_shared<BasicTexture2D>(textureNum, imagePath);
+    texture->setWidth(thumbnail.levels.front().width);
+    texture->setHeight(thumbnail.levels.front().height);
+
+    entry.texture = texture;
+
+    return entry.texture;
+}
+
+void TextureThumbnailCache::finishDraw(std::size_t budgetBytes)
+{
+    ++_drawCount;
+
+    if (_residentBytes <= budgetBytes) return;
+
+    // Collect the thumbnails that have not been drawn recently, least recently used first
+    std::vector<std::pair<std::size_t, std::map<std::string, Entry>::iterator>> candidates;
+
+    for (auto i = _entries.begin(); i != _entries.end(); ++i)
+    {
+        if (i->second.thumbnail && i->second.lastUsed + ReleaseGracePeriod < _drawCount)
+        {
+            candidates.emplace_back(i->second.lastUsed, i);
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b)
+    {
+        return a.first < b.first;
+    });
+
+    for (const auto& [_, i] : candidates)
+    {
+        if (_residentBytes <= budgetBytes) break;
+
+        auto& entry = i->second;
+
+        _residentBytes -= entry.thumbnail->getDataSize();
+
+        // Keep the image size for the tile layout, the data can be reloaded from disk
+        entry.thumbnail.reset();
+        entry.texture.reset();
+        entry.status = Status::Pending;
+        entry.queued = false;
+    }
+}
+
+sigc::signal<void>& TextureThumbnailCache::signal_thumbnailsLoaded()
+{
+    return _sigThumbnailsLoaded;
+}
+
+std::shared_ptr<TextureThumbnail> TextureThumbnailCache::CreateThumbnail(const Image& image)
+{
+    auto thumbnail = std::make_shared<TextureThumbnail>();
+
+    thumbnail->imageWidth = image.getWidth();
+    thumbnail->imageHeight = image.getHeight();
+    thumbnail->format = image.getGLFormat();
+
+    if (thumbnail->imageWidth == 0 || thumbnail->imageHeight == 0)
+    {
+        return {};
+    }
+
+    if (!image.isPrecompressed())
+    {
+        if (thumbnail->format != GL_RGBA) return {};
+
+        // Scale the image down to fit into the thumbnail size, keeping its aspect ratio
+        auto scale = std::min(1.0, static_cast<double>(ThumbnailSize) /
+            std::max(thumbnail->imageWidth, thumbnail->imageHeight));
+
+        TextureThumbnail::Level level;
+        level.width = std::max<std::size_t>(static_cast<std::size_t>(std::lround(thumbnail->imageWidth * scale)), 1);
+        level.height = std::max<std::size_t>(static_cast<std::size_t>(std::lround(thumbnail->imageHeight * scale)), 1);
+        level.data.resize(level.width * level.height * 4);
+
+        if (level.width == thumbnail->imageWidth && level.height == thumbnail->imageHeight)
+        {
+            std::copy(image.getPixels(), image.getPixels() + level.data.size(), level.data.begin());
+        }
+        else
+        {
+            image::kernels::resample(image.getPixels(), thumbnail->imageWidth, thumbnail->imageHeight,
+                level.data.data(), level.width, level.height, 4);
+        }
+
+        auto mipmaps = image::generateMipChain(level.data.data(), level.width, level.height);
+
+        thumbnail->levels.emplace_back(std::move(level));
+
+        for (auto& mipmap : mipmaps)
+        {
+            thumbnail->levels.push_back({ mipmap.width, mipmap.height, std::move(mipmap.pixels) });
+        }
+
+        return thumbnail;
+    }
+
+    // Compressed images can't be resampled, take over the mip levels fitting into the thumbnail size
+    if (getCompressedBlockSize(thumbnail->format) == 0) return {};
+
+    const auto* pixels = image.getPixels();
+
+    for (std::size_t i = 0; i < image.getLevels(); ++i)
+    {
+        auto width = image.getWidth(i);
+        auto height = image.getHeight(i);
+        auto size = getLevelDataSize(thumbnail->format, width, height);
+
+        if (std::max(width, height) <= ThumbnailSize)
+        {
+            thumbnail->levels.push_back({ width, height, std::vector<uint8_t>(pixels, pixels + size) });
+        }
+
+        pixels += size;
+    }
+
+    // Images without small enough mipmaps are loaded at full size by the browser
+    return !thumbnail->levels.empty() ? thumbnail : std::shared_ptr<TextureThumbnail>();
+}
+
+void TextureThumbnailCache::loadThumbnailAsync(const std::string& imagePath)
+{
+    std::weak_ptr<TextureThumbnailCache*> weakSelf = _self;
+
+    _loader.enqueue([this, imagePath, weakSelf]()
+    {
+        std::shared_ptr<TextureThumbnail> thumbnail;
+
+        try
+        {
+            thumbnail = loadThumbnail(imagePath);
+        }
+        catch (const std::exception& ex)
+        {
+            rWarning() << "Failed to create thumbnail for " << imagePath << ": " << ex.what() << std::endl;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_resultLock);
+            _results.emplace_back(imagePath, thumbnail);
+        }
+
+        GlobalUserInterface().dispatch([weakSelf]()
+        {
+            if (auto self = weakSelf.lock(); self)
+            {
+                (*self)->processResults();
+            }
+        });
+    });
+}
+
+std::shared_ptr<TextureThumbnail> TextureThumbnailCache::loadThumbnail(const std::string& imagePath)
+{
+    auto imageFile = GlobalImageLoader().findImageInVFS(imagePath);
+
+    if (imageFile.empty()) return {};
+
+    auto timestamp = getFileTimestamp(imageFile);
+    auto cacheFile = getCacheFilename(imagePath);
+
+    if (auto thumbnail = readCacheFile(cacheFile, imagePath, timestamp); thumbnail)
+    {
+        return thumbnail;
+    }
+
+    auto image = GlobalImageLoader().imageFromVFS(imagePath);
+
+    if (!image) return {};
+
+    auto thumbnail = CreateThumbnail(*image);
+
+    if (thumbnail)
+    {
+        writeCacheFile(cacheFile, imagePath, timestamp, *thumbnail);
+    }
+
+    return thumbnail;
+}
+
+std::string TextureThumbnailCache::getCacheFilename(const std::string& imagePath) const
+{
+    // The image path is stored in the file too, name collisions are detected when reading
+    return _cachePath + fmt::format("{0:016x}.thumb", std::hash<std::string>()(string::to_lower_copy(imagePath)));
+}
+
+std::shared_ptr<TextureThumbnail> TextureThumbnailCache::readCacheFile(const std::string& filename,
+    const std::string& imagePath, int64_t timestamp) const
+{
+    stream::FileInputStream file(filename);
+
+    if (file.failed()) return {};
+
+    if (stream::readLittleEndian<uint32_t>(file) != CacheFileMagic ||
+        stream::readLittleEndian<uint32_t>(file) != CacheFileVersion)
+    {
+        return {};
+    }
+
+    std::string storedPath(stream::readLittleEndian<uint32_t>(file), '\0');
+
+    if (storedPath.size() != imagePath.size() ||
+        file.read(reinterpret_cast<InputStream::byte_type*>(storedPath.data()), storedPath.size()) != storedPath.size() ||
+        storedPath != imagePath ||
+        stream::readLittleEndian<int64_t>(file) != timestamp)
+    {
+        return {}; // different image or outdated
+    }
+
+    auto thumbnail = std::make_shared<TextureThumbnail>();
+
+    thumbnail->imageWidth = stream::readLittleEndian<uint32_t>(file);
+    thumbnail->imageHeight = stream::readLittleEndian<uint32_t>(file);
+    thumbnail->format = stream::readLittleEndian<uint32_t>(file);
+
+    auto numLevels = stream::readLittleEndian<uint32_t>(file);
+
+    if (thumbnail->format != GL_RGBA && getCompressedBlockSize(thumbnail->format) == 0)
+    {
+        return {};
+    }
+
+    for (uint32_t i = 0; i < numLevels; ++i)
+    {
+        TextureThumbnail::Level level;
+        level.width = stream::readLittleEndian<uint32_t>(file);
+        level.height = stream::readLittleEndian<uint32_t>(file);
+
+        if (level.width == 0 || level.height == 0 || level.width > ThumbnailSize || level.height > ThumbnailSize)
+        {
+            return {};
+        }
+
+        level.data.resize(getLevelDataSize(thumbnail->format, level.width, level.height));
+
+        if (file.read(level.data.data(), level.data.size()) != level.data.size())
+        {
+            return {};
+        }
+
+        thumbnail->levels.emplace_back(std::move(level));
+    }
+
+    return !thumbnail->levels.empty() ? thumbnail : std::shared_ptr<TextureThumbnail>();
+}
+
+void TextureThumbnailCache::writeCacheFile(const std::string& filename, const std::string& imagePath,
+    int64_t timestamp, const TextureThumbnail& thumbnail) const
+{
+    try
+    {
+        fs::create_directories(_cachePath);
+
+        // Write to a temporary file first, such that there's never a partially written thumbnail
+        auto tempFilename = filename + ".tmp";
+
+        {
+            std::ofstream stream(tempFilename, std::ios::binary);
+
+            if (!stream.good())
+            {
+                rWarning() << "Cannot write thumbnail file " << tempFilename << std::endl;
+                return;
+            }
+
+            stream::writeLittleEndian<uint32_t>(stream, CacheFileMagic);
+            stream::writeLittleEndian<uint32_t>(stream, CacheFileVersion);
+            stream::writeLittleEndian<uint32_t>(stream, static_cast<uint32_t>(imagePath.size()));
+            stream.write(imagePath.data(), imagePath.size());
+            stream::writeLittleEndian<int64_t>(stream, timestamp);
+            stream::writeLittleEndian<uint32_t>(stream, static_cast<uint32_t>(thumbnail.imageWidth));
+            stream::writeLittleEndian<uint32_t>(stream, static_cast<uint32_t>(thumbnail.imageHeight));
+            stream::writeLittleEndian<uint32_t>(stream, static_cast<uint32_t>(thumbnail.format));
+            stream::writeLittleEndian<uint32_t>(stream, static_cast<uint32_t>(thumbnail.levels.size()));
+
+            for (const auto& level : thumbnail.levels)
+            {
+                stream::writeLittleEndian<uint32_t>(stream, static_cast<uint32_t>(level.width));
+                stream::writeLittleEndian<uint32_t>(stream, static_cast<uint32_t>(level.height));
+                stream.write(reinterpret_cast<const char*>(level.data.data()), level.data.size());
+            }
+        }
+
+        fs::rename(tempFilename, filename);
+    }
+    catch (const fs::filesystem_error& ex)
+    {
+        rWarning() << "Failed to store thumbnail of " << imagePath << ": " << ex.what() << std::endl;
+    }
+}
+
+void TextureThumbnailCache::processResults()
+{
+    std::vector<std::pair<std::string, std::shared_ptr<TextureThumbnail>>> results;
+
+    {
+        std::lock_guard<std::mutex> lock(_resultLock);
+        results.swap(_results);
+    }
+
+    if (results.empty()) return;
+
+    for (auto& [imagePath, thumbnail] : results)
+    {
+        auto& entry = _entries[imagePath];
+
+        entry.queued = false;
+
+        if (entry.thumbnail)
+        {
+            continue; // already loaded
+        }
+
+        if (!thumbnail)
+        {
+            entry.status = Status::Unavailable;
+            continue;
+        }
+
+        entry.status = Status::Available;
+        entry.imageWidth = thumbnail->imageWidth;
+        entry.imageHeight = thumbnail->imageHeight;
+        entry.thumbnail = std::move(thumbnail);
+
+        _residentBytes += entry.thumbnail->getDataSize();
+    }
+
+    _sigThumbnailsLoaded.emit();
+}
+
+} // namespace
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "igl.h"
+#include "iimage.h"
+#include "Texture.h"
+
+#include <map>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <string>
+#include <sigc++/signal.h>
+#include "SequentialTaskQueue.h"
+
+namespace ui
+{
+
+/**
+ * Downscaled version of an editor image, consisting of a few small mip levels.
+ * The size of the full image is stored too, the texture browser needs it to
+ * lay out the tiles.
+ */
+struct TextureThumbnail
+{
+    std::size_t imageWidth = 0;
+    std::size_t imageHeight = 0;
+
+    // Either GL_RGBA or one of the compressed formats taken over from DDS files
+    GLenum format = GL_RGBA;
+
+    struct Level
+    {
+        std::size_t width;
+        std::size_t height;
+        std::vector<uint8_t> data;
+    };
+
+    // Largest level first
+    std::vector<Level> levels;
+
+    std::size_t getDataSize() const;
+};
+
+/**
+ * Provides small thumbnail textures for the editor images shown in the
+ * texture browsers, such that opening a large folder doesn't need to load
+ * and upload all the images at full resolution.
+ *
+ * Thumbnails are generated on a worker thread and stored on disk in the
+ * user's settings folder, keyed by image path and the modification time of
+ * the image file. Any cached thumbnail is re-used as long as the image file
+ * is not changed.
+ *
+ * All public methods need to be called from the UI thread.
+ */
+class TextureThumbnailCache
+{
+public:
+    // Largest dimension of a generated thumbnail
+    static constexpr std::size_t ThumbnailSize = 128;
+
+    enum class Status
+    {
+        Pending,     // Thumbnail is being loaded
+        Available,   // Thumbnail can be bound
+        Unavailable, // Image can't be loaded or turned into a thumbnail
+    };
+
+private:
+    struct Entry
+    {
+        Status status = Status::Pending;
+        bool queued = false;
+
+        // Full image dimensions, kept after the thumbnail has been released
+        std::size_t imageWidth = 0;
+        std::size_t imageHeight = 0;
+
+        std::shared_ptr<TextureThumbnail> thumbnail;
+        TexturePtr texture;
+
+        // Draw counter value at the time of the last bindTexture() call
+        std::size_t lastUsed = 0;
+    };
+
+    // Thumbnails on disk are stored in this folder
+    std::string _cachePath;
+
+    std::map<std::string, Entry> _entries;
+
+    // Results of the worker, waiting to be picked up by the UI thread
+    std::mutex _resultLock;
+    std::vector<std::pair<std::string, std::shared_ptr<TextureThumbnail>>> _results;
+
+    util::SequentialTaskQueue _loader;
+
+    // Used by the worker to check whether this instance is still alive
+    std::shared_ptr<TextureThumbnailCache*> _self;
+
+    std::size_t _drawCount;
+    std::size_t _residentBytes;
+
+    sigc::signal<void> _sigThumbnailsLoaded;
+
+public:
+    TextureThumbnailCache(const std::string& cachePath);
+    ~TextureThumbnailCache();
+
+    // Returns the status of the given image, queueing it for loading if necessary
+    Status requestThumbnail(const std::string& imagePath);
+
+    // Returns the status of the given image without queueing anything
+    Status getStatus(const std::string& imagePath) const;
+
+    // Retrieves the full image size of the given image, returns false if it's not known yet
+    bool getImageSize(const std::string& imagePath, std::size_t& width, std::size_t& height) const;
+
+    // Returns the GL texture of the given image's thumbnail, uploading it if necessary.
+    // Returns an empty pointer if the thumbnail is not available (yet).
+    TexturePtr bindThumbnail(const std::string& imagePath);
+
+    // To be called when the browser finished drawing. Releases the thumbnails
+    // that haven't been used recently until their memory is below the given budget.
+    void finishDraw(std::size_t budgetBytes);
+
+    // Emitted on the UI thread when one or more thumbnails finished loading
+    sigc::signal<void>& signal_thumbnailsLoaded();
+
+    // Generates the thumbnail of the given image, returns an empty pointer if
+    // the image format is not supported.
+    static std::shared_ptr<TextureThumbnail> CreateThumbnail(const Image& image);
+
+private:
+    void loadThumbnailAsync(const std::string& imagePath);
+
+    // Worker thread methods
+    std::shared_ptr<TextureThumbnail> loadThumbnail(const std::string& imagePath);
+    std::string getCacheFilename(const std::string& imagePath) const;
+    std::shared_ptr<TextureThumbnail> readCacheFile(const std::string& filename,
+        const std::string& imagePath, int64_t timestamp) const;
+    void writeCacheFile(const std::string& filename, const std::string& imagePath,
+        int64_t timestamp, const TextureThumbnail& thumbnail) const;
+
+    void processResults();
+};
+
+} // namespace
@@ -9,6 +9,7 @@
 #include "ientity.h"
 #include "igrid.h"
 #include "iregion.h"
+#include "iprofiler.h"
 #include "ui/istatusbarmanager.h"
 
 #include "wxutil/MouseButton.h"
@@ -1410,6 +1411,8 @@ void XYWnd::updateModelview() {
 
 void XYWnd::draw()
 {
+    PROFILE_ZONE("XYWnd::draw");
+
     ensureFont();
 
     // clear
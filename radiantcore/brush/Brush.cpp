@@ -231,9 +231,17 @@ BrushSplitType Brush::classifyPlane(const Plane3& plane) const
 }
 
 void Brush::evaluateBRep() const {
+    // Apply any pending transformation first, this is changing the face planes.
+    // Doing this while building the windings would flag the B-rep as changed again.
+    const_cast<Brush*>(this)->evaluateTransform();
+
     if(m_planeChanged) {
         m_planeChanged = false;
-        const_cast<Brush*>(this)->buildBRep();
+
+        if (!const_cast<Brush*>(this)->buildTransformPreview())
+        {
+            const_cast<Brush*>(this)->buildBRep();
+        }
     }
 }
 
@@ -252,6 +260,125 @@ void Brush::evaluateTransform()
     }
 }
 
+void Brush::beginTransformPreview()
+{
+    // The captured geometry needs to be untransformed, which it isn't
+    // if there's an unevaluated transformation around
+    if (_transformPreviewBase || m_transformChanged) return;
+
+    evaluateBRep();
+
+    _transformPreviewBase = std::make_unique<TransformPreviewBase>();
+    _transformPreviewBase->faces.reserve(m_faces.size());
+    _transformPreviewBase->windings.reserve(m_faces.size());
+
+    for (const auto& face : m_faces)
+    {
+        _transformPreviewBase->faces.push_back(face.get());
+        _transformPreviewBase->windings.push_back(face->getWinding());
+    }
+
+    _transformPreviewBase->uniqueVertexPoints = _uniqueVertexPoints;
+    _transformPreviewBase->uniqueEdgePoints = _uniqueEdgePoints;
+}
+
+void Brush::endTransformPreview(bool rebuild)
+{
+    if (!_transformPreviewBase) return;
+
+    _transformPreviewBase.reset();
+
+    if (rebuild)
+    {
+        // Replace the preview windings with the ones calculated from the face planes
+        m_planeChanged = true;
+        evaluateBRep();
+    }
+}
+
+bool Brush::isTransformPreviewActive() const
+{
+    return static_cast<bool>(_transformPreviewBase);
+}
+
+bool Brush::buildTransformPreview()
+{
+    if (!_transformPreviewBase) return false;
+
+    Matrix4 transform;
+
+    // Only transformations of the whole brush are supported
+    if (!_owner.getPendingPrimitiveTransform(transform))
+    {
+        return false;
+    }
+
+    // The transformation must neither be degenerate nor mirror the geometry,
+    // this would change the vertex order of the windings
+    auto determinant = transform.xCol3().cross(transform.yCol3()).dot(transform.zCol3());
+
+    if (determinant < 1e-6)
+    {
+        return false;
+    }
+
+    const auto& base = *_transformPreviewBase;
+
+    if (base.faces.size() != m_faces.size())
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < m_faces.size(); ++i)
+    {
+        if (base.faces[i] != m_faces[i].get())
+        {
+            return false;
+        }
+    }
+
+    m_aabb_local = AABB();
+
+    for (std::size_t i = 0; i < m_faces.size(); ++i)
+    {
+        auto& face = *m_faces[i];
+        auto& winding = face.getWinding();
+
+        winding = base.windings[i];
+
+        if (!winding.empty())
+        {
+            for (auto& vertex : winding)
+            {
+                vertex.vertex = transform.transformPoint(vertex.vertex);
+                m_aabb_local.includePoint(vertex.vertex);
+            }
+
+            face.emitTextureCoordinates();
+        }
+
+        face.updateWinding();
+    }
+
+    for (std::size_t i = 0; i < _uniqueVertexPoints.size() && i < base.uniqueVertexPoints.size(); ++i)
+    {
+        _uniqueVertexPoints[i] = transform.transformPoint(base.uniqueVertexPoints[i]);
+    }
+
+    for (std::size_t i = 0; i < _uniqueEdgePoints.size() && i < base.uniqueEdgePoints.size(); ++i)
+    {
+        _uniqueEdgePoints[i] = transform.transformPoint(base.uniqueEdgePoints[i]);
+    }
+
+    for (std::size_t i = 0; i < _faceCentroidPoints.size(); ++i)
+    {
+        m_faces[i]->construct_centroid();
+        _faceCentroidPoints[i] = m_faces[i]->centroid();
+    }
+
+    return true;
+}
+
 void Brush::aabbChanged()
 {
     _owner.boundsChanged();
@@ -138,6 +138,19 @@ private:
 	mutable bool m_transformChanged; // transform evaluation required
 	// ----
 
+	// The untransformed geometry, captured when a transformation of the whole brush
+	// starts. While that transformation is pending, the windings are derived from this
+	// instead of rebuilding the B-rep from the transformed planes.
+	struct TransformPreviewBase
+	{
+		// The faces the windings belong to, to detect changes of the face list
+		std::vector<const Face*> faces;
+		std::vector<Winding> windings;
+		std::vector<Vector3> uniqueVertexPoints;
+		std::vector<Vector3> uniqueEdgePoints;
+	};
+	std::unique_ptr<TransformPreviewBase> _transformPreviewBase;
+
 	DetailFlag _detailFlag;
 
 public:
@@ -219,6 +232,16 @@ public:
     void transformChanged();
     void evaluateTransform();
 
+	// Captures the current, untransformed geometry to be used as base for the
+	// transformation that is about to start. Does nothing if the geometry is not up to date.
+	void beginTransformPreview();
+
+	// Discards the captured geometry. If rebuild is true and a preview was active, the
+	// B-rep is rebuilt from the transformed face planes right away.
+	void endTransformPreview(bool rebuild);
+
+	bool isTransformPreviewActive() const;
+
 	void aabbChanged();
 
 	const AABB& localAABB() const override;
@@ -341,6 +364,10 @@ private:
 
 	/// \brief Constructs the face windings and updates anything that depends on them.
 	void buildBRep();
+
+	// Derives the face windings by applying the pending transformation to the captured
+	// base geometry. Returns false if this is not possible, the B-rep needs to be built then.
+	bool buildTransformPreview();
 }; // class Brush
 
 typedef std::vector<Brush*> BrushVector;
@@ -36,6 +36,9 @@ void BrushModuleImpl::constructPreferences()
 
 	// The checkbox to enable/disable the texture lock option
 	page.appendCheckBox(_("Enable Texture Lock (for Brushes)"), "user/ui/brush/textureLock");
+
+	// Brushes being moved or rotated can transform their existing windings instead of re-calculating them
+	page.appendCheckBox(_("Fast Preview of Brush Transformations"), RKEY_BRUSH_TRANSFORM_PREVIEW);
 }
 
 void BrushModuleImpl::construct()
@@ -53,6 +56,7 @@ void BrushModuleImpl::destroy()
 void BrushModuleImpl::keyChanged()
 {
 	_textureLockEnabled = registry::getValue<bool>(RKEY_ENABLE_TEXTURE_LOCK);
+	_transformPreviewEnabled = registry::getValue<bool>(RKEY_BRUSH_TRANSFORM_PREVIEW);
 }
 
 bool BrushModuleImpl::textureLockEnabled() const {
@@ -68,6 +72,11 @@ void BrushModuleImpl::toggleTextureLock() {
 	setTextureLock(!textureLockEnabled());
 }
 
+bool BrushModuleImpl::transformPreviewEnabled() const
+{
+	return _transformPreviewEnabled;
+}
+
 // ------------ BrushCreator implementation --------------------------------------------
 
 scene::INodePtr BrushModuleImpl::createBrush()
@@ -113,10 +122,14 @@ void BrushModuleImpl::initialiseModule(const IApplicationContext& ctx) {
 	_settings.reset(new BrushSettings);
 
 	_textureLockEnabled = registry::getValue<bool>(RKEY_ENABLE_TEXTURE_LOCK);
+	_transformPreviewEnabled = registry::getValue<bool>(RKEY_BRUSH_TRANSFORM_PREVIEW);
 
 	GlobalRegistry().signalForKey(RKEY_ENABLE_TEXTURE_LOCK).connect(
 		sigc::mem_fun(this, &BrushModuleImpl::keyChanged)
 	);
+	GlobalRegistry().signalForKey(RKEY_BRUSH_TRANSFORM_PREVIEW).connect(
+		sigc::mem_fun(this, &BrushModuleImpl::keyChanged)
+	);
 
 	// add the preference settings
 	constructPreferences();
@@ -16,6 +16,7 @@ class BrushModuleImpl :
 {
 private:
 	bool _textureLockEnabled;
+	bool _transformPreviewEnabled;
 
 	std::unique_ptr<BrushSettings> _settings;
 
@@ -56,6 +57,9 @@ public:
 	// Switches the texture lock on/off
 	void toggleTextureLock();
 
+	// returns true if brushes should skip rebuilding their geometry while being manipulated
+	bool transformPreviewEnabled() const;
+
 	// RegisterableModule implementation
 	virtual const std::string& getName() const override;
 	virtual const StringSet& getDependencies() const override;
@@ -5,6 +5,7 @@
 #include "iclipper.h"
 #include "imap.h"
 #include "math/Hash.h"
+#include "BrushModule.h"
 #include <functional>
 
 BrushNode::BrushNode() :
@@ -547,6 +548,17 @@ void BrushNode::evaluateTransform()
 	}
 }
 
+bool BrushNode::getPendingPrimitiveTransform(Matrix4& transform) const
+{
+    if (getType() != TRANSFORM_PRIMITIVE || getTransformationType() == NoTransform)
+    {
+        return false;
+    }
+
+    transform = calculateTransform();
+    return true;
+}
+
 bool BrushNode::getIntersection(const Ray& ray, Vector3& intersection)
 {
 	return _brush.getIntersection(ray, intersection);
@@ -614,6 +626,17 @@ void BrushNode::onPostRedo()
 
 void BrushNode::_onTransformationChanged()
 {
+    if (getTransformationType() == NoTransform)
+    {
+        _brush.endTransformPreview(false);
+    }
+    else if (getType() == TRANSFORM_PRIMITIVE && GlobalBrush().transformPreviewEnabled())
+    {
+        // Capture the untransformed geometry before it's invalidated below,
+        // the windings will be derived from it while the transformation is pending
+        _brush.beginTransformPreview();
+    }
+
     _brush.transformChanged();
 
     _renderableVertices.queueUpdate();
@@ -622,6 +645,10 @@ void BrushNode::_onTransformationChanged()
 
 void BrushNode::_applyTransformation()
 {
+    // Make sure the windings used for the texture lock calculations
+    // are the ones calculated from the transformed face planes
+    _brush.endTransformPreview(true);
+
 	_brush.revertTransform();
 	evaluateTransform();
 	_brush.freezeTransform();
@@ -143,6 +143,10 @@ public:
 
 	void evaluateTransform();
 
+	// Returns true if a transformation of the whole brush is pending,
+	// the matrix of that transformation is written to the given argument
+	bool getPendingPrimitiveTransform(Matrix4& transform) const;
+
 	// Traceable implementation
 	bool getIntersection(const Ray& ray, Vector3& intersection) override;
 
@@ -718,6 +718,14 @@ const Plane3& Face::getPlane3() const
     return m_plane.getPlane();
 }
 
+void Face::setPlane3(const Plane3& plane)
+{
+    undoSave();
+
+    m_plane.setPlane(plane);
+    planeChanged();
+}
+
 FacePlane& Face::getPlane() {
     return m_plane;
 }
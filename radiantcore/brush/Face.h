@@ -196,6 +196,7 @@ public:
 
 	// Returns the Doom 3 plane
 	const Plane3& getPlane3() const override;
+	void setPlane3(const Plane3& plane) override;
 
 	FacePlane& getPlane();
 	const FacePlane& getPlane() const;
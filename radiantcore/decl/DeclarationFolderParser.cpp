@@ -9,19 +9,18 @@ namespace decl
 
 namespace
 {
-    DeclarationBlockSyntax createBlock(const parser::DefBlockSyntax& block,
-        const vfs::FileInfo& fileInfo, const std::string& modName)
+    DeclarationBlockSyntax::Ptr createBlock(const parser::DefBlockSyntax& block,
+        const DeclarationBlockSyntax::FileOrigin::Ptr& origin)
     {
-        DeclarationBlockSyntax syntax;
+        auto syntax = std::make_shared<DeclarationBlockSyntax>();
 
         const auto& nameSyntax = block.getName();
         const auto& typeSyntax = block.getType();
 
-        syntax.typeName = typeSyntax ? typeSyntax->getToken().value : "";
-        syntax.name = nameSyntax ? nameSyntax->getToken().value : "";
-        syntax.contents = block.getBlockContents();
-        syntax.modName = modName;
-        syntax.fileInfo = fileInfo;
+        syntax->typeName = typeSyntax ? typeSyntax->getToken().value : "";
+        syntax->name = nameSyntax ? nameSyntax->getToken().value : "";
+        syntax->contents = block.getBlockContents();
+        syntax->origin = origin;
 
         return syntax;
     }
@@ -43,6 +42,10 @@ void DeclarationFolderParser::parse(std::istream& stream, const vfs::FileInfo& f
 
     auto syntaxTree = parser.parse();
 
+    // All blocks of this file share the same origin instead of copying the names
+    auto origin = std::make_shared<DeclarationBlockSyntax::FileOrigin>(
+        DeclarationBlockSyntax::FileOrigin{ modDir, fileInfo });
+
     for (const auto& node : syntaxTree->getRoot()->getChildren())
     {
         if (node->getType() != parser::DefSyntaxNode::Type::DeclBlock)
@@ -53,10 +56,10 @@ void DeclarationFolderParser::parse(std::istream& stream, const vfs::FileInfo& f
         const auto& blockNode = static_cast<const parser::DefBlockSyntax&>(*node);
 
         // Convert the incoming block to a DeclarationBlockSyntax
-        auto blockSyntax = createBlock(blockNode, fileInfo, modDir);
+        auto blockSyntax = createBlock(blockNode, origin);
 
         // Move the block in the correct bucket
-        auto declType = determineBlockType(blockSyntax);
+        auto declType = determineBlockType(*blockSyntax);
         auto& blockList = _parsedBlocks.try_emplace(declType).first->second;
         blockList.emplace_back(std::move(blockSyntax));
     }
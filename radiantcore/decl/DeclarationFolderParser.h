@@ -12,7 +12,7 @@ namespace decl
 
 class DeclarationManager;
 
-using ParseResult = std::map<Type, std::vector<DeclarationBlockSyntax>>;
+using ParseResult = std::map<Type, std::vector<DeclarationBlockSyntax::Ptr>>;
 
 // Threaded parser processing all files in the configured decl folder
 // Submits all parsed declarations to the IDeclarationManager when finished
@@ -1,5 +1,5 @@
-#include <future>
 #include <fstream>
+#include <set>
 
 #include "i18n.h"
 #include "DeclarationManager.h"
@@ -9,6 +9,7 @@
 #include "DeclarationFolderParser.h"
 #include "parser/DefBlockSyntaxParser.h"
 #include "ifilesystem.h"
+#include "iprofiler.h"
 #include "module/StaticModule.h"
 #include "string/trim.h"
 #include "os/path.h"
@@ -126,12 +127,12 @@ IDeclaration::Ptr DeclarationManager::findOrCreateDeclaration(Type type, const s
         }
 
         // Construct the default block
-        DeclarationBlockSyntax syntax;
+        auto syntax = std::make_shared<DeclarationBlockSyntax>();
 
-        syntax.typeName = getTypenameByType(type);
-        syntax.name = name;
+        syntax->typeName = getTypenameByType(type);
+        syntax->name = name;
         // Derive the mod name from the path it can be written to
-        syntax.modName = game::current::getModPath(game::current::getWriteableGameResourcePath());
+        syntax->setModName(game::current::getModPath(game::current::getWriteableGameResourcePath()));
 
         returnValue = createOrUpdateDeclaration(type, syntax);
 
@@ -234,7 +235,7 @@ void DeclarationManager::reloadDeclarations()
 
                     // Clear name and file info
                     syntax.contents.clear();
-                    syntax.fileInfo = vfs::FileInfo();
+                    syntax.setFileInfo(vfs::FileInfo());
 
                     decl->setBlockSyntax(syntax);
                 }
@@ -274,14 +275,20 @@ void DeclarationManager::waitForTypedParsersToFinish()
 
         if (!parsersToFinish.empty())
         {
-            // Add the task to the list, we need to wait for it when shutting down the module
-            // Move the collected parsers to the async lambda and clear it there
-            _parserCleanupTasks.emplace_back(std::make_shared<std::shared_future<void>>(
-                std::async(std::launch::async, [parsers = std::move(parsersToFinish)]() mutable
-                {
-                    // Without locking anything, just let all parsers finish their work
-                    parsers.clear();
-                })));
+            if (!_parserCleanupTasks)
+            {
+                _parserCleanupTasks = GlobalJobSystem().createGroup("DeclParserCleanup");
+            }
+
+            // Add the task to the group, we need to wait for it when shutting down the module
+            // Move the collected parsers to the task and clear it there
+            auto parsers = std::make_shared<std::vector<std::unique_ptr<DeclarationFolderParser>>>(std::move(parsersToFinish));
+
+            _parserCleanupTasks->run([parsers]()
+            {
+                // Without locking anything, just let all parsers finish their work
+                parsers->clear();
+            });
         }
     }
 
@@ -291,32 +298,17 @@ void DeclarationManager::waitForTypedParsersToFinish()
 
 void DeclarationManager::waitForCleanupTasksToFinish()
 {
-    while (true)
-    {
-        // Find the next cleanup task, but don't remove it from the list
-        // Other threads might check the same list and get the impression there's nothing to wait for
-        std::shared_ptr<std::shared_future<void>> task;
-
-        {
-            // Pick the next task to wait for
-            std::lock_guard declLock(_declarationAndCreatorLock);
-
-            if (_parserCleanupTasks.empty()) break; // Done
+    jobs::IJobGroup::Ptr tasks;
 
-            for (const auto& candidate : _parserCleanupTasks)
-            {
-                if (candidate && candidate->valid() &&
-                    candidate->wait_for(std::chrono::milliseconds(0)) != std::future_status::ready)
-                {
-                    task = candidate;
-                    break;
-                }
-            }
-
-            if (!task) return;
-        }
+    {
+        std::lock_guard declLock(_declarationAndCreatorLock);
+        tasks = _parserCleanupTasks;
+    }
 
-        task->get(); // wait for this task, then enter the next round
+    // Don't hold the lock while waiting, the parsers need it to deliver their results
+    if (tasks)
+    {
+        tasks->wait();
     }
 }
 
@@ -327,22 +319,28 @@ void DeclarationManager::waitForSignalInvokersToFinish()
         // Pick the next task to wait for
         auto declLock = std::make_unique<std::lock_guard<std::recursive_mutex>>(_declarationAndCreatorLock);
 
-        // No cleanup task found, check the tasks in the declaration structures
-        std::future<void> signalInvoker;
+        // Check the tasks in the declaration structures
+        jobs::IJobGroup::Ptr tasks;
 
         for (auto& [_, decl] : _declarationsByType)
         {
-            if (decl.signalInvoker.valid())
+            if (decl.signalInvoker)
+            {
+                tasks = std::move(decl.signalInvoker);
+                break;
+            }
+
+            if (decl.parserFinisher)
             {
-                signalInvoker = std::move(decl.signalInvoker);
+                tasks = std::move(decl.parserFinisher);
                 break;
             }
         }
 
-        if (signalInvoker.valid())
+        if (tasks)
         {
             declLock.reset();
-            signalInvoker.get();
+            tasks->wait();
             continue;
         }
 
@@ -396,7 +394,7 @@ void DeclarationManager::removeDeclaration(Type type, const std::string& name)
             syntax.name.clear();
             syntax.typeName.clear();
             syntax.contents.clear();
-            syntax.fileInfo = vfs::FileInfo();
+            syntax.setFileInfo(vfs::FileInfo());
             decl->second->setBlockSyntax(syntax);
 
             decls.erase(decl);
@@ -480,21 +478,21 @@ void DeclarationManager::removeDeclarationFromFile(const IDeclaration::Ptr& decl
     const auto& syntax = decl->getBlockSyntax();
 
     // Nothing to do if the decl hasn't been saved
-    if (syntax.fileInfo.name.empty()) return;
+    if (syntax.getFileInfo().name.empty()) return;
 
-    if (!syntax.fileInfo.getIsPhysicalFile())
+    if (!syntax.getFileInfo().getIsPhysicalFile())
     {
         throw std::logic_error("Only declarations stored in physical files can be removed.");
     }
 
-    auto fullPath = GlobalFileSystem().findFile(syntax.fileInfo.fullPath());
+    auto fullPath = GlobalFileSystem().findFile(syntax.getFileInfo().fullPath());
 
     if (fullPath.empty() || !fs::exists(fullPath))
     {
         return;
     }
 
-    fullPath += syntax.fileInfo.fullPath();
+    fullPath += syntax.getFileInfo().fullPath();
 
     // Load the syntax tree from the existing file
     std::ifstream existingFile(fullPath);
@@ -623,7 +621,7 @@ void DeclarationManager::saveDeclaration(const IDeclaration::Ptr& decl)
     const auto& syntax = decl->getBlockSyntax();
 
     // Check filename for emptiness
-    if (syntax.fileInfo.name.empty())
+    if (syntax.getFileInfo().name.empty())
     {
         throw std::invalid_argument("The file name of the decl is empty.");
     }
@@ -631,7 +629,7 @@ void DeclarationManager::saveDeclaration(const IDeclaration::Ptr& decl)
     // All parsers need to have finished
     waitForTypedParsersToFinish();
 
-    std::string relativePath = syntax.fileInfo.fullPath();
+    std::string relativePath = syntax.getFileInfo().fullPath();
 
     fs::path targetPath = game::current::getWriteableGameResourcePath();
 
@@ -639,7 +637,7 @@ void DeclarationManager::saveDeclaration(const IDeclaration::Ptr& decl)
     targetPath /= os::getDirectory(relativePath);
     fs::create_directories(targetPath);
 
-    auto targetFile = targetPath / os::getFilename(syntax.fileInfo.name);
+    auto targetFile = targetPath / os::getFilename(syntax.getFileInfo().name);
 
     // Make sure the physical file exists and is inheriting its contents from the VFS (if necessary)
     ensureTargetFileExists(targetFile.string(), relativePath);
@@ -770,10 +768,12 @@ void DeclarationManager::onParserFinished(Type parserType, ParseResult& parsedBl
         // it might have already been moved out in doWithDeclarationLock()
         if (decls->second.parser)
         {
-            // Move the parser reference from the dictionary as capture to the lambda
-            // Then let the unique_ptr in the lambda go out of scope to finish off the thread
-            // Lambda is mutable to make the unique_ptr member non-const
-            decls->second.parserFinisher = std::async(std::launch::async, [p = std::move(decls->second.parser)]() mutable
+            // Move the parser reference from the dictionary as capture to the task
+            // Then let the pointer in the task go out of scope to finish off the parser
+            std::shared_ptr<DeclarationFolderParser> parser(std::move(decls->second.parser));
+
+            decls->second.parserFinisher = createFinisherGroup("DeclParserFinisher", decls->second.parserFinisher);
+            decls->second.parserFinisher->run([p = std::move(parser)]() mutable
             {
                 p.reset();
             });
@@ -783,7 +783,8 @@ void DeclarationManager::onParserFinished(Type parserType, ParseResult& parsedBl
         // In the regular threaded scenario, the signal should fire on a separate thread
         if (!_reparseInProgress)
         {
-            decls->second.signalInvoker = std::async(std::launch::async, [=]()
+            decls->second.signalInvoker = createFinisherGroup("DeclsReloadedSignal", decls->second.signalInvoker);
+            decls->second.signalInvoker->run([=]()
             {
                 emitDeclsReloadedSignal(parserType);
             });
@@ -791,6 +792,19 @@ void DeclarationManager::onParserFinished(Type parserType, ParseResult& parsedBl
     }
 }
 
+jobs::IJobGroup::Ptr DeclarationManager::createFinisherGroup(const std::string& name, const jobs::IJobGroup::Ptr& previous)
+{
+    auto group = GlobalJobSystem().createGroup(name);
+
+    // Run after the previous task of the same kind, such that waiting for the new group covers both
+    if (previous)
+    {
+        group->addDependency(previous);
+    }
+
+    return group;
+}
+
 void DeclarationManager::processParseResult(Type parserType, ParseResult& parsedBlocks)
 {
     // Sort all parsed blocks into our main dictionary
@@ -803,7 +817,9 @@ void DeclarationManager::processParseResult(Type parserType, ParseResult& parsed
 
 void DeclarationManager::processParsedBlocks(ParseResult& parsedBlocks)
 {
-    std::vector<DeclarationBlockSyntax> unrecognisedBlocks;
+    PROFILE_ZONE("DeclarationManager::processParsedBlocks");
+
+    std::vector<DeclarationBlockSyntax::Ptr> unrecognisedBlocks;
 
     {
         std::lock_guard declLock(_declarationAndCreatorLock);
@@ -852,7 +868,7 @@ bool DeclarationManager::tryDetermineBlockType(const DeclarationBlockSyntax& blo
     return true;
 }
 
-const IDeclaration::Ptr& DeclarationManager::createOrUpdateDeclaration(Type type, const DeclarationBlockSyntax& block)
+const IDeclaration::Ptr& DeclarationManager::createOrUpdateDeclaration(Type type, const DeclarationBlockSyntax::Ptr& block)
 {
     // Get the mapping for this decl type
     auto it = _declarationsByType.find(type);
@@ -865,13 +881,13 @@ const IDeclaration::Ptr& DeclarationManager::createOrUpdateDeclaration(Type type
     auto& map = it->second.decls;
 
     // See if this decl is already in use
-    auto existing = map.find(block.name);
+    auto existing = map.find(block->name);
 
     // Create declaration if not existing
     if (existing == map.end())
     {
         auto creator = _creatorsByType.at(type);
-        existing = map.emplace(block.name, creator->createDeclaration(block.name)).first;
+        existing = map.emplace(block->name, creator->createDeclaration(block->name)).first;
     }
     else if (existing->second->getParseStamp() == _parseStamp)
     {
@@ -882,7 +898,7 @@ const IDeclaration::Ptr& DeclarationManager::createOrUpdateDeclaration(Type type
         return existing->second;
     }
 
-    // Assign the block to the declaration instance
+    // Assign the block to the declaration instance, it's shared, not copied
     existing->second->setBlockSyntax(block);
 
     // Update the parse stamp for this instance
@@ -898,7 +914,7 @@ void DeclarationManager::handleUnrecognisedBlocks()
     if (_unrecognisedBlocks.empty()) return;
 
     // Move all unrecognised blocks to a temporary structure and release the lock
-    std::list<DeclarationBlockSyntax> unrecognisedBlocks(std::move(_unrecognisedBlocks));
+    std::list<DeclarationBlockSyntax::Ptr> unrecognisedBlocks(std::move(_unrecognisedBlocks));
     unrecognisedBlockLock.reset();
 
     {
@@ -908,7 +924,7 @@ void DeclarationManager::handleUnrecognisedBlocks()
         {
             auto type = Type::Undetermined;
 
-            if (!tryDetermineBlockType(*block, type))
+            if (!tryDetermineBlockType(**block, type))
             {
                 ++block;
                 continue;
@@ -960,6 +976,7 @@ const StringSet& DeclarationManager::getDependencies() const
     {
         MODULE_VIRTUALFILESYSTEM,
         MODULE_COMMANDSYSTEM,
+        MODULE_JOBSYSTEM,
     };
 
     return _dependencies;
@@ -969,6 +986,8 @@ void DeclarationManager::initialiseModule(const IApplicationContext& ctx)
 {
     GlobalCommandSystem().addCommand("ReloadDecls",
         std::bind(&DeclarationManager::reloadDeclsCmd, this, std::placeholders::_1));
+    GlobalCommandSystem().addCommand("ShowDeclMemoryStats",
+        std::bind(&DeclarationManager::showMemoryStatsCmd, this, std::placeholders::_1));
 
     // After the initial parsing, all decls will have a parseStamp of 0
     _parseStamp = 0;
@@ -995,7 +1014,7 @@ void DeclarationManager::shutdownModule()
     waitForSignalInvokersToFinish();
 
     // All parsers and tasks have finished, clear all structures, no need to lock anything
-    _parserCleanupTasks.clear();
+    _parserCleanupTasks.reset();
     _registeredFolders.clear();
     _unrecognisedBlocks.clear();
     _declarationsByType.clear();
@@ -1011,6 +1030,125 @@ void DeclarationManager::reloadDeclsCmd(const cmd::ArgumentList& _)
     reloadDeclarations();
 }
 
+namespace
+{
+    // Strings up to this capacity are stored in the object itself (small string optimisation)
+    const std::size_t SmallStringCapacity = std::string().capacity();
+
+    // Heap memory held by the given string, zero if it fits into the small string buffer
+    std::size_t getAllocatedSize(const std::string& str)
+    {
+        return str.capacity() > SmallStringCapacity ? str.capacity() + 1 : 0;
+    }
+
+    std::size_t getAllocatedSize(const DeclarationBlockSyntax::FileOrigin& origin)
+    {
+        return sizeof(DeclarationBlockSyntax::FileOrigin) + getAllocatedSize(origin.modName) +
+            getAllocatedSize(origin.fileInfo.topDir) + getAllocatedSize(origin.fileInfo.name);
+    }
+
+    // Blocks and file origins that have been visited before are only counted once
+    void addBlock(DeclarationMemoryStatistics& stats, const DeclarationBlockSyntax& block,
+        std::set<const void*>& visited)
+    {
+        if (!visited.insert(&block).second) return;
+
+        ++stats.numBlocks;
+        stats.contentBytes += getAllocatedSize(block.contents);
+        stats.blockBytes += sizeof(DeclarationBlockSyntax) +
+            getAllocatedSize(block.typeName) + getAllocatedSize(block.name);
+
+        auto originBytes = getAllocatedSize(*block.origin);
+        stats.unsharedFileOriginBytes += originBytes;
+
+        if (visited.insert(block.origin.get()).second)
+        {
+            ++stats.numFileOrigins;
+            stats.fileOriginBytes += originBytes;
+        }
+    }
+
+    std::string formatBytes(std::size_t bytes)
+    {
+        return fmt::format("{0:.2f} MB", bytes / (1024.0 * 1024.0));
+    }
+}
+
+std::map<Type, DeclarationMemoryStatistics> DeclarationManager::collectMemoryStatistics()
+{
+    waitForTypedParsersToFinish();
+
+    std::map<Type, DeclarationMemoryStatistics> result;
+
+    // Blocks and origins shared across types are counted for the first type only
+    std::set<const void*> visited;
+
+    {
+        std::lock_guard declLock(_declarationAndCreatorLock);
+
+        for (const auto& [type, declarations] : _declarationsByType)
+        {
+            auto& stats = result[type];
+            stats.numDeclarations = declarations.decls.size();
+
+            for (const auto& [_, decl] : declarations.decls)
+            {
+                addBlock(stats, decl->getBlockSyntax(), visited);
+            }
+        }
+    }
+
+    {
+        std::lock_guard lock(_unrecognisedBlockLock);
+
+        auto& stats = result[Type::Undetermined];
+
+        for (const auto& block : _unrecognisedBlocks)
+        {
+            addBlock(stats, *block, visited);
+        }
+    }
+
+    return result;
+}
+
+DeclarationMemoryStatistics DeclarationManager::getMemoryStatistics()
+{
+    DeclarationMemoryStatistics total;
+
+    for (const auto& [_, stats] : collectMemoryStatistics())
+    {
+        total.numDeclarations += stats.numDeclarations;
+        total.numBlocks += stats.numBlocks;
+        total.numFileOrigins += stats.numFileOrigins;
+        total.contentBytes += stats.contentBytes;
+        total.blockBytes += stats.blockBytes;
+        total.fileOriginBytes += stats.fileOriginBytes;
+        total.unsharedFileOriginBytes += stats.unsharedFileOriginBytes;
+    }
+
+    return total;
+}
+
+void DeclarationManager::showMemoryStatsCmd(const cmd::ArgumentList& _)
+{
+    std::size_t totalBytes = 0;
+
+    for (const auto& [type, stats] : collectMemoryStatistics())
+    {
+        auto typeName = type == Type::Undetermined ? std::string("Unrecognised") : getTypeName(type);
+
+        rMessage() << fmt::format("[DeclManager] {0}: {1} decls, {2} blocks, contents: {3}, blocks and names: {4}, "
+            "{5} files: {6} (unshared: {7})", typeName, stats.numDeclarations, stats.numBlocks,
+            formatBytes(stats.contentBytes), formatBytes(stats.blockBytes), stats.numFileOrigins,
+            formatBytes(stats.fileOriginBytes), formatBytes(stats.unsharedFileOriginBytes)) << std::endl;
+
+        totalBytes += stats.contentBytes + stats.blockBytes + stats.fileOriginBytes;
+    }
+
+    rMessage() << "[DeclManager] Total memory held by declaration blocks: " << formatBytes(totalBytes) << std::endl;
+}
+
 module::StaticModuleRegistration<DeclarationManager> _declManagerModule;
 
 }
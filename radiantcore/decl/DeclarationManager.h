@@ -2,6 +2,7 @@
 
 #include "ideclmanager.h"
 #include "icommandsystem.h"
+#include "ijobsystem.h"
 #include <map>
 #include <vector>
 #include <memory>
@@ -46,14 +47,14 @@ private:
         // If not empty, holds the running parser
         std::unique_ptr<DeclarationFolderParser> parser;
 
-        std::future<void> parserFinisher;
-        std::future<void> signalInvoker;
+        jobs::IJobGroup::Ptr parserFinisher;
+        jobs::IJobGroup::Ptr signalInvoker;
     };
 
     // One entry for each decl
     std::map<Type, Declarations> _declarationsByType;
 
-    std::list<DeclarationBlockSyntax> _unrecognisedBlocks;
+    std::list<DeclarationBlockSyntax::Ptr> _unrecognisedBlocks;
     std::recursive_mutex _unrecognisedBlockLock;
 
     std::map<Type, sigc::signal<void>> _declsReloadingSignals;
@@ -74,7 +75,7 @@ private:
     sigc::connection _vfsInitialisedConn;
 
     // Access allowed if the _declarationAndCreatorLock is owned
-    std::vector<std::shared_ptr<std::shared_future<void>>> _parserCleanupTasks;
+    jobs::IJobGroup::Ptr _parserCleanupTasks;
 
 public:
     void registerDeclType(const std::string& typeName, const IDeclarationCreator::Ptr& parser) override;
@@ -101,12 +102,15 @@ public:
     // Invoked once a parser thread has finished
     void onParserFinished(Type parserType, ParseResult& parsedBlocks);
 
+    DeclarationMemoryStatistics getMemoryStatistics() override;
+
 private:
     void processParseResult(Type parserType, ParseResult& parsedBlocks);
     void runParsersForAllFolders();
     void waitForTypedParsersToFinish();
     void waitForCleanupTasksToFinish();
     void waitForSignalInvokersToFinish();
+    jobs::IJobGroup::Ptr createFinisherGroup(const std::string& name, const jobs::IJobGroup::Ptr& previous);
 
     // Attempts to resolve the block type of the given block, returns true on success, false otherwise.
     // Stores the determined type in the given reference.
@@ -116,10 +120,14 @@ private:
     void removeDeclarationFromFile(const IDeclaration::Ptr& decl);
 
     // Requires the creatorsMutex and the declarationMutex to be locked
-    const IDeclaration::Ptr& createOrUpdateDeclaration(Type type, const DeclarationBlockSyntax& block);
+    const IDeclaration::Ptr& createOrUpdateDeclaration(Type type, const DeclarationBlockSyntax::Ptr& block);
     void doWithDeclarationLock(Type type, const std::function<void(NamedDeclarations&)>& action);
     void handleUnrecognisedBlocks();
     void reloadDeclsCmd(const cmd::ArgumentList& args);
+    void showMemoryStatsCmd(const cmd::ArgumentList& args);
+
+    // Collects the memory statistics per type, unrecognised blocks are listed as Type::Undetermined
+    std::map<Type, DeclarationMemoryStatistics> collectMemoryStatistics();
 
     // Requires the creatorsMutex to be locked
     std::string getTypenameByType(Type type);
@@ -0,0 +1,90 @@
+#include "AttributeNameTable.h"
+
+#include <cctype>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include "string/string.h"
+
+namespace eclass
+{
+
+namespace
+{
+    // FNV-1a over the lowercased characters
+    struct INameHash
+    {
+        std::size_t operator()(const std::string& name) const
+        {
+            std::size_t hash = 14695981039346656037ULL;
+
+            for (auto c : name)
+            {
+                hash ^= static_cast<std::size_t>(std::tolower(static_cast<unsigned char>(c)));
+                hash *= 1099511628211ULL;
+            }
+
+            return hash;
+        }
+    };
+
+    struct INameEquals
+    {
+        bool operator()(const std::string& lhs, const std::string& rhs) const
+        {
+            return lhs.size() == rhs.size() && string::icmp(lhs.c_str(), rhs.c_str()) == 0;
+        }
+    };
+
+    struct NameMap
+    {
+        // Entities and classes are not bound to the main thread, guard the table
+        std::shared_mutex lock;
+        std::unordered_map<std::string, AttributeId, INameHash, INameEquals> ids;
+    };
+
+    NameMap& getNameMap()
+    {
+        static NameMap _names;
+        return _names;
+    }
+}
+
+AttributeId AttributeNameTable::Intern(const std::string& name)
+{
+    auto& names = getNameMap();
+
+    {
+        std::shared_lock lock(names.lock);
+
+        if (auto existing = names.ids.find(name); existing != names.ids.end())
+        {
+            return existing->second;
+        }
+    }
+
+    std::unique_lock lock(names.lock);
+
+    // Another thread might have inserted the name in between, emplace won't overwrite it
+    return names.ids.emplace(name, static_cast<AttributeId>(names.ids.size())).first->second;
+}
+
+AttributeId AttributeNameTable::Find(const std::string& name)
+{
+    auto& names = getNameMap();
+
+    std::shared_lock lock(names.lock);
+
+    auto existing = names.ids.find(name);
+    return existing != names.ids.end() ? existing->second : InvalidAttributeId;
+}
+
+std::size_t AttributeNameTable::Size()
+{
+    auto& names = getNameMap();
+
+    std::shared_lock lock(names.lock);
+    return names.ids.size();
+}
+
+}
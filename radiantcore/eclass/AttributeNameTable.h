@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <limits>
+
+namespace eclass
+{
+
+// Integer identifier of an interned attribute name
+using AttributeId = std::uint32_t;
+
+constexpr AttributeId InvalidAttributeId = std::numeric_limits<AttributeId>::max();
+
+/**
+ * Process-wide table mapping attribute (spawnarg) names to integer IDs.
+ * Names are compared case-insensitively, "Model" and "model" share the same ID.
+ *
+ * Every attribute stored by an entity class or an entity is interned, such that
+ * lookups can compare integers instead of strings. A name that has never been
+ * interned is not stored anywhere, which allows lookups to bail out early.
+ */
+class AttributeNameTable
+{
+public:
+    // Returns the ID of the given name, assigning a new one if it's not known yet
+    static AttributeId Intern(const std::string& name);
+
+    // Returns the ID of the given name or InvalidAttributeId if it has never been interned
+    static AttributeId Find(const std::string& name);
+
+    // The number of distinct names in the table
+    static std::size_t Size();
+};
+
+}
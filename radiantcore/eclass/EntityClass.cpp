@@ -6,6 +6,10 @@
 
 #include "string/predicate.h"
 #include <functional>
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <limits>
 
 namespace eclass
 {
@@ -14,6 +18,15 @@ namespace
 {
     const Vector3 DefaultEntityColour(0.3, 0.3, 1);
     const Vector4 UndefinedColour(-1, -1, -1, -1);
+
+    // Source of the attribute modification stamps, shared by all classes
+    std::atomic<std::size_t> _nextAttributeStamp(1);
+
+    bool compareAttributeIds(const std::pair<AttributeId, EntityClassAttribute*>& a,
+        const std::pair<AttributeId, EntityClassAttribute*>& b)
+    {
+        return a.first < b.first;
+    }
 }
 
 EntityClass::EntityClass(const std::string& name)
@@ -22,7 +35,8 @@ EntityClass::EntityClass(const std::string& name)
   _colour(DefaultEntityColour),
   // greebo: Changed default behaviour when unknown entites are encountered to isFixedSize == FALSE
   // so that brushes of unknown classes don't get lost (issue #240)
-  _fixedSize(false)
+  _fixedSize(false),
+  _attributeTableStamp(std::numeric_limits<std::size_t>::max())
 {}
 
 EntityClass::~EntityClass()
@@ -50,7 +64,7 @@ vfs::Visibility EntityClass::getVisibility()
     ensureParsed();
 
     // File visibility overrides the setting in the entity key/value pairs
-    return getBlockSyntax().fileInfo.visibility == vfs::Visibility::HIDDEN ?
+    return getBlockSyntax().getFileInfo().visibility == vfs::Visibility::HIDDEN ?
         vfs::Visibility::HIDDEN : _visibility.get();
 }
 
@@ -201,9 +215,14 @@ const Vector4& EntityClass::getColour()
  */
 void EntityClass::emplaceAttribute(EntityClassAttribute&& attribute)
 {
+    // Make sure the name is known to the lookups
+    AttributeNameTable::Intern(attribute.getName());
+
     // Try to emplace the class attribute
     auto result = _attributes.try_emplace(attribute.getName(), std::move(attribute));
 
+    touchAttributes();
+
     if (!result.second)
     {
         auto& existing = result.first->second;
@@ -279,7 +298,7 @@ void EntityClass::resolveInheritance()
     // Lookup the parent name and return if it is not set. Also return if the
     // parent name is the same as our own classname, to avoid infinite
     // recursion.
-    std::string parentName = getAttributeValue("inherit");
+    std::string parentName = getAttributeValue("inherit", false);
     if (parentName.empty() || parentName == getDeclName())
     {
         resetColour();
@@ -293,6 +312,7 @@ void EntityClass::resolveInheritance()
     {
         // Set our parent pointer
         _parent = static_cast<EntityClass*>(parentClass.get());
+        touchAttributes();
     }
     else
     {
@@ -356,19 +376,96 @@ EntityClassAttribute* EntityClass::getAttribute(const std::string& name, bool in
 {
     ensureParsed();
 
-    // First look up the attribute on this class; if found, we can simply return it
-    auto f = _attributes.find(name);
-    if (f != _attributes.end())
-        return &f->second;
+    // If we have been instructed to ignore inheritance, look at our own attributes only
+    if (!includeInherited)
+    {
+        auto f = _attributes.find(name);
+        return f != _attributes.end() ? &f->second : nullptr;
+    }
+
+    // Otherwise consult the flattened table, which contains the inherited attributes.
+    // A name that has never been interned can't be present anywhere.
+    auto id = AttributeNameTable::Find(name);
+    return id != InvalidAttributeId ? findFlattenedAttribute(id) : nullptr;
+}
+
+EntityClassAttribute* EntityClass::findFlattenedAttribute(AttributeId id)
+{
+    ensureAttributeTable();
+
+    auto found = std::lower_bound(_attributeTable.begin(), _attributeTable.end(),
+        FlattenedAttribute(id, nullptr), compareAttributeIds);
 
-    // If there is no parent or we have been instructed to ignore inheritance,
-    // this is the end of the line: return nothing
-    if (!_parent || !includeInherited)
-        return nullptr;
+    return found != _attributeTable.end() && found->first == id ? found->second : nullptr;
+}
 
-    // Otherwise delegate to the parent (which will recurse until an attribute
-    // is found or a null parent ends the process)
-    return _parent->getAttribute(name);
+const EntityClassAttribute* EntityClass::getAttribute(AttributeId id)
+{
+    return findFlattenedAttribute(id);
+}
+
+std::string_view EntityClass::getAttributeValueView(AttributeId id)
+{
+    auto* attribute = getAttribute(id);
+    return attribute ? std::string_view(attribute->getValue()) : std::string_view();
+}
+
+void EntityClass::touchAttributes()
+{
+    _attributeStamp = _nextAttributeStamp++;
+}
+
+std::size_t EntityClass::getInheritedAttributeStamp()
+{
+    std::size_t stamp = 0;
+
+    for (auto cls = this; cls != nullptr; cls = cls->_parent)
+    {
+        // Parsing the class might change its attributes and parent
+        cls->ensureParsed();
+        stamp = std::max(stamp, cls->_attributeStamp);
+    }
+
+    return stamp;
+}
+
+void EntityClass::ensureAttributeTable()
+{
+    auto stamp = getInheritedAttributeStamp();
+
+    if (stamp == _attributeTableStamp)
+    {
+        return;
+    }
+
+    std::vector<FlattenedAttribute> ownAttributes;
+    ownAttributes.reserve(_attributes.size());
+
+    for (auto& [name, attribute] : _attributes)
+    {
+        ownAttributes.emplace_back(AttributeNameTable::Intern(name), &attribute);
+    }
+
+    std::sort(ownAttributes.begin(), ownAttributes.end(), compareAttributeIds);
+
+    if (_parent)
+    {
+        _parent->ensureAttributeTable();
+
+        // Merge the parent table, entries of the first range win on equal IDs
+        _attributeTable.clear();
+        _attributeTable.reserve(ownAttributes.size() + _parent->_attributeTable.size());
+
+        std::set_union(ownAttributes.begin(), ownAttributes.end(),
+            _parent->_attributeTable.begin(), _parent->_attributeTable.end(),
+            std::back_inserter(_attributeTable), compareAttributeIds);
+    }
+    else
+    {
+        _attributeTable.swap(ownAttributes);
+    }
+
+    _attributeTableStamp = stamp;
 }
 
 std::string EntityClass::getAttributeValue(const std::string& name, bool includeInherited)
@@ -433,6 +530,8 @@ void EntityClass::clear()
     _fixedSize = false;
 
     _attributes.clear();
+    touchAttributes();
+
     _inheritanceResolved = false;
 }
 
@@ -521,6 +620,7 @@ void EntityClass::parseFromTokens(parser::DefTokeniser& tokeniser)
         {
             // Attribute type is set, but value is empty, set the value.
             attribute->setValue(value);
+            touchAttributes();
         }
         else
         {
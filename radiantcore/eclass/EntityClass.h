@@ -11,11 +11,13 @@
 
 #include "parser/DefTokeniser.h"
 #include "decl/DeclarationBase.h"
+#include "AttributeNameTable.h"
 
 #include <vector>
 #include <map>
 #include <memory>
 #include <optional>
+#include <string_view>
 
 #include <sigc++/connection.h>
 
@@ -57,6 +59,19 @@ private:
     using EntityAttributeMap = std::map<std::string, EntityClassAttribute, string::ILess>;
     EntityAttributeMap _attributes;
 
+    // Flattened table of all attributes visible on this class, own ones and
+    // inherited ones, sorted by the interned name ID. Own attributes hide
+    // the inherited ones of the same name. Rebuilt on demand whenever the
+    // attributes of this class or one of its ancestors have been modified.
+    using FlattenedAttribute = std::pair<AttributeId, EntityClassAttribute*>;
+    std::vector<FlattenedAttribute> _attributeTable;
+
+    // Modification stamp of the own attributes and the parent pointer
+    std::size_t _attributeStamp = 0;
+
+    // The inherited modification stamp the attribute table has been built for
+    std::size_t _attributeTableStamp;
+
     // Flag to indicate inheritance resolved. An EntityClass resolves its
     // inheritance by copying all values from the parent onto the child,
     // after recursively instructing the parent to resolve its own inheritance.
@@ -85,6 +100,19 @@ private:
     // Return attribute if found, possibly checking parents
     EntityClassAttribute* getAttribute(const std::string&, bool includeInherited = true);
 
+    // Assigns a new modification stamp to the attributes of this class,
+    // which invalidates the flattened tables of this class and its subclasses
+    void touchAttributes();
+
+    // Returns the most recent modification stamp of this class and its ancestors
+    std::size_t getInheritedAttributeStamp();
+
+    // Brings the flattened attribute table up to date
+    void ensureAttributeTable();
+
+    // Binary search in the flattened attribute table
+    EntityClassAttribute* findFlattenedAttribute(AttributeId id);
+
 public:
 
     /// Construct a named EntityClass
@@ -112,6 +140,14 @@ public:
     // Resets the colour to the value defined in the attributes
     void resetColour();
     std::string getAttributeValue(const std::string&, bool includeInherited = true) override;
+
+    // Look up an attribute, including inherited ones, by its interned name.
+    // Returns nullptr if the attribute is not defined on this class or its ancestors.
+    const EntityClassAttribute* getAttribute(AttributeId id);
+
+    // Returns the (possibly inherited) value of the given attribute, or an empty view.
+    // The view is valid until this class or one of its ancestors is reparsed.
+    std::string_view getAttributeValueView(AttributeId id);
     std::string getAttributeType(const std::string& name) override;
     std::string getAttributeDescription(const std::string& name) override;
     void forEachAttribute(AttributeVisitor, bool) override;
@@ -10,6 +10,7 @@ namespace entity
 
 SpawnArgs::SpawnArgs(const IEntityClassPtr& eclass) :
 	_eclass(eclass),
+	_eclassAttributes(dynamic_cast<eclass::EntityClass*>(eclass.get())),
 	_undo(_keyValues, std::bind(&SpawnArgs::importState, this, std::placeholders::_1), 
         std::function<void()>(), "EntityKeyValues"),
 	_observerMutex(false),
@@ -23,6 +24,7 @@ SpawnArgs::SpawnArgs(const IEntityClassPtr& eclass) :
 SpawnArgs::SpawnArgs(const SpawnArgs& other) :
 	Entity(other),
 	_eclass(other.getEntityClass()),
+	_eclassAttributes(other._eclassAttributes),
 	_undo(_keyValues, std::bind(&SpawnArgs::importState, this, std::placeholders::_1), 
         std::function<void()>(), "EntityKeyValues"),
 	_observerMutex(false),
@@ -32,7 +34,7 @@ SpawnArgs::SpawnArgs(const SpawnArgs& other) :
     // Copy keyvalue strings, not actual KeyValue pointers
     for (const KeyValuePair& p : other._keyValues)
     {
-        insert(p.first, p.second->get());
+        insert(p.key, p.value->get());
     }
 }
 
@@ -51,9 +53,9 @@ void SpawnArgs::parseAttachments()
 
 bool SpawnArgs::isModel() const
 {
-	std::string name = getKeyValue("name");
-	std::string model = getKeyValue("model");
-	std::string classname = getKeyValue("classname");
+	auto name = getKeyValueView("name");
+	auto model = getKeyValueView("model");
+	auto classname = getKeyValueView("classname");
 
 	return (classname == "func_static" && !name.empty() && name != model);
 }
@@ -73,7 +75,7 @@ void SpawnArgs::importState(const KeyValues& keyValues)
 
 	for (const auto& pair : keyValues)
 	{
-		insert(pair.first, pair.second);
+		insert(pair.key, pair.value);
 	}
 }
 
@@ -87,7 +89,7 @@ void SpawnArgs::attachObserver(Observer* observer)
 	// Now notify the observer about all the existing keys
 	for(KeyValues::const_iterator i = _keyValues.begin(); i != _keyValues.end(); ++i)
     {
-		observer->onKeyInsert(i->first, *i->second);
+		observer->onKeyInsert(i->key, *i->value);
 	}
 }
 
@@ -110,7 +112,7 @@ void SpawnArgs::detachObserver(Observer* observer)
 	// Call onKeyErase() for every spawnarg, so that the observer gets cleanly shut down
 	for(KeyValues::const_iterator i = _keyValues.begin(); i != _keyValues.end(); ++i)
     {
-		observer->onKeyErase(i->first, *i->second);
+		observer->onKeyErase(i->key, *i->value);
 	}
 }
 
@@ -118,7 +120,7 @@ void SpawnArgs::connectUndoSystem(IUndoSystem& undoSystem)
 {
 	for (const auto& keyValue : _keyValues)
 	{
-		keyValue.second->connectUndoSystem(undoSystem);
+		keyValue.value->connectUndoSystem(undoSystem);
 	}
 
     _undo.connectUndoSystem(undoSystem);
@@ -130,7 +132,7 @@ void SpawnArgs::disconnectUndoSystem(IUndoSystem& undoSystem)
 
 	for (const auto& keyValue : _keyValues)
 	{
-		keyValue.second->disconnectUndoSystem(undoSystem);
+		keyValue.value->disconnectUndoSystem(undoSystem);
 	}
 }
 
@@ -145,7 +147,7 @@ void SpawnArgs::forEachKeyValue(KeyValueVisitFunc func,
     // Visit explicit spawnargs
     for (const KeyValuePair& pair : _keyValues)
 	{
-		func(pair.first, pair.second->get());
+		func(pair.key, pair.value->get());
 	}
 
     // If requested, visit inherited spawnargs from the entitydef
@@ -161,7 +163,7 @@ void SpawnArgs::forEachEntityKeyValue(const EntityKeyValueVisitFunctor& func)
 {
     for (const KeyValuePair& pair : _keyValues)
     {
-        func(pair.first, *pair.second);
+        func(pair.key, *pair.value);
     }
 }
 
@@ -181,28 +183,51 @@ void SpawnArgs::setKeyValue(const std::string& key, const std::string& value)
 
 std::string SpawnArgs::getKeyValue(const std::string& key) const
 {
-	// Lookup the key in the map
-	KeyValues::const_iterator i = find(key);
+	return std::string(getKeyValueView(key));
+}
+
+std::string_view SpawnArgs::getKeyValueView(const std::string& key) const
+{
+	auto id = eclass::AttributeNameTable::Find(key);
 
 	// If key is found, return it, otherwise lookup the default value on
 	// the entity class
-	if (i != _keyValues.end())
+	if (auto index = findIndex(id); index != -1)
 	{
-		return i->second->get();
+		return _keyValues[index].value->get();
 	}
-	else
+
+	return getInheritedValueView(id, key);
+}
+
+std::string_view SpawnArgs::getInheritedValueView(eclass::AttributeId id, const std::string& key) const
+{
+	if (_eclassAttributes == nullptr)
 	{
-		return _eclass->getAttributeValue(key);
+		// Not our own entity class implementation, search the attributes by name
+		std::string_view value;
+
+		_eclass->forEachAttribute([&](const EntityClassAttribute& attribute, bool)
+		{
+			if (string::iequals(attribute.getName(), key))
+			{
+				value = attribute.getValue();
+			}
+		}, true);
+
+		return value;
 	}
+
+	// No entity class can have a key that has never been interned
+	return id != eclass::InvalidAttributeId ? _eclassAttributes->getAttributeValueView(id) : std::string_view();
 }
 
 bool SpawnArgs::isInherited(const std::string& key) const
 {
-	// Check if we have the key in the local keyvalue map
-	bool definedLocally = (find(key) != _keyValues.end());
+	auto id = eclass::AttributeNameTable::Find(key);
 
 	// The value is inherited, if it doesn't exist locally and the inherited one is not empty
-	return (!definedLocally && !_eclass->getAttributeValue(key).empty());
+	return findIndex(id) == -1 && !getInheritedValueView(id, key).empty();
 }
 
 void SpawnArgs::forEachAttachment(AttachmentFunc func) const
@@ -214,12 +239,12 @@ EntityKeyValuePtr SpawnArgs::getEntityKeyValue(const std::string& key)
 {
 	KeyValues::const_iterator found = find(key);
 
-	return (found != _keyValues.end()) ? found->second : EntityKeyValuePtr();
+	return (found != _keyValues.end()) ? found->value : EntityKeyValuePtr();
 }
 
 bool SpawnArgs::isWorldspawn() const
 {
-	return getKeyValue("classname") == "worldspawn";
+	return getKeyValueView("classname") == "worldspawn";
 }
 
 bool SpawnArgs::isContainer() const
@@ -276,14 +301,14 @@ void SpawnArgs::notifyErase(const std::string& key, KeyValue& value)
 void SpawnArgs::insert(const std::string& key, const KeyValuePtr& keyValue)
 {
 	// Insert the new key at the end of the list
-	auto& pair = _keyValues.emplace_back(key, keyValue);
+	auto& pair = _keyValues.emplace_back(KeyValuePair{ key, keyValue, eclass::AttributeNameTable::Intern(key) });
 
 	// Dereference the iterator to get a KeyValue& reference and notify the observers
-	notifyInsert(key, *pair.second);
+	notifyInsert(key, *pair.value);
 
 	if (_undo.isConnected())
 	{
-        pair.second->connectUndoSystem(_undo.getUndoSystem());
+        pair.value->connectUndoSystem(_undo.getUndoSystem());
 	}
 }
 
@@ -295,7 +320,7 @@ void SpawnArgs::insert(const std::string& key, const std::string& value)
     if (i != _keyValues.end())
     {
         // Key has been found, assign the value
-        i->second->assign(value);
+        i->value->assign(value);
         // Observer notification happens through the lambda callback we passed 
         // to the KeyValue constructor
     }
@@ -315,12 +340,12 @@ void SpawnArgs::erase(const KeyValues::iterator& i)
 {
 	if (_undo.isConnected())
 	{
-		i->second->disconnectUndoSystem(_undo.getUndoSystem());
+		i->value->disconnectUndoSystem(_undo.getUndoSystem());
 	}
 
 	// Retrieve the key and value from the vector before deletion
-	std::string key(i->first);
-	KeyValuePtr value(i->second);
+	std::string key(i->key);
+	KeyValuePtr value(i->value);
 
 	// Actually delete the object from the list
 	_keyValues.erase(i);
@@ -344,36 +369,32 @@ void SpawnArgs::erase(const std::string& key)
 	}
 }
 
-SpawnArgs::KeyValues::const_iterator SpawnArgs::find(const std::string& key) const
+int SpawnArgs::findIndex(eclass::AttributeId id) const
 {
-	for (KeyValues::const_iterator i = _keyValues.begin();
-		 i != _keyValues.end();
-		 ++i)
+	for (std::size_t i = 0; i < _keyValues.size(); ++i)
 	{
-		if (string::iequals(i->first, key))
+		if (_keyValues[i].id == id)
 		{
-			return i;
+			return static_cast<int>(i);
 		}
 	}
 
 	// Not found
-	return _keyValues.end();
+	return -1;
+}
+
+SpawnArgs::KeyValues::const_iterator SpawnArgs::find(const std::string& key) const
+{
+	auto index = findIndex(eclass::AttributeNameTable::Find(key));
+
+	return index != -1 ? _keyValues.begin() + index : _keyValues.end();
 }
 
 SpawnArgs::KeyValues::iterator SpawnArgs::find(const std::string& key)
 {
-	for (KeyValues::iterator i = _keyValues.begin();
-		 i != _keyValues.end();
-		 ++i)
-	{
-		if (string::iequals(i->first, key))
-		{
-			return i;
-		}
-	}
+	auto index = findIndex(eclass::AttributeNameTable::Find(key));
 
-	// Not found
-	return _keyValues.end();
+	return index != -1 ? _keyValues.begin() + index : _keyValues.end();
 }
 
 } // namespace entity
@@ -5,6 +5,8 @@
 #include <vector>
 #include "KeyValue.h"
 #include <memory>
+#include <string_view>
+#include "eclass/EntityClass.h"
 
 class IUndoSystem;
 
@@ -24,10 +26,21 @@ class SpawnArgs: public Entity
 {
 	IEntityClassPtr _eclass;
 
+	// The implementing class of _eclass, used for the lookups by attribute ID.
+	// This is NULL for other IEntityClass implementations, these are
+	// searched by name instead.
+	eclass::EntityClass* _eclassAttributes;
+
 	typedef std::shared_ptr<KeyValue> KeyValuePtr;
 
-	// A key value pair using a dynamically allocated value
-	typedef std::pair<std::string, KeyValuePtr> KeyValuePair;
+	// A key value pair using a dynamically allocated value,
+	// along with the interned name of the key
+	struct KeyValuePair
+	{
+		std::string key;
+		KeyValuePtr value;
+		eclass::AttributeId id;
+	};
 
 	// The unsorted list of KeyValue pairs
 	typedef std::vector<KeyValuePair> KeyValues;
@@ -65,6 +78,11 @@ public:
     void forEachEntityKeyValue(const EntityKeyValueVisitFunctor& visitor) override;
 	void setKeyValue(const std::string& key, const std::string& value) override;
 	std::string getKeyValue(const std::string& key) const override;
+
+	// Returns the value of the given key without copying it, taking inherited
+	// values into account. The view is invalidated by the next change to the key
+	// (or the entity class), it is empty if the key doesn't exist.
+	std::string_view getKeyValueView(const std::string& key) const;
 	bool isInherited(const std::string& key) const override;
     void forEachAttachment(AttachmentFunc func) const override;
 
@@ -100,6 +118,12 @@ private:
 
 	KeyValues::iterator find(const std::string& key);
 	KeyValues::const_iterator find(const std::string& key) const;
+
+	// Returns the index of the keyvalue with the given interned name or -1 if not found
+	int findIndex(eclass::AttributeId id) const;
+
+	// Returns the value of the given key defined by the entity class, or an empty view
+	std::string_view getInheritedValueView(eclass::AttributeId id, const std::string& key) const;
 };
 
 } // namespace entity
@@ -5,6 +5,7 @@
 #include "iradiant.h"
 #include "itextstream.h"
 #include "iscenegraph.h"
+#include "iselection.h"
 #include "iregistry.h"
 #include "igame.h"
 #include "ishaders.h"
@@ -143,6 +144,8 @@ void BasicFilterSystem::setObjectSelectionByFilter(const std::string& filterName
 		return;
 	}
 
+	selection::SelectionTransaction transaction;
+
 	SetObjectSelectionByFilterWalker walker(*f->second, select);
 	GlobalSceneGraph().root()->traverse(walker);
 }
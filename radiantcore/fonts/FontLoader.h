@@ -19,7 +19,7 @@ private:
 
 public:
 	FontLoader(FontManager& manager) :
-        parser::ThreadedDefLoader<void>(std::bind(&FontLoader::loadFonts, this)),
+        parser::ThreadedDefLoader<void>(std::bind(&FontLoader::loadFonts, this), "FontLoader"),
 		_manager(manager)
 	{}
 
@@ -5,6 +5,7 @@
 #include "itextstream.h"
 #include "iregistry.h"
 #include "igame.h"
+#include "ijobsystem.h"
 #include "os/path.h"
 #include "module/StaticModule.h"
 
@@ -31,6 +32,7 @@ const StringSet& FontManager::getDependencies() const
         MODULE_XMLREGISTRY,
         MODULE_GAMEMANAGER,
         MODULE_SHADERSYSTEM,
+        MODULE_JOBSYSTEM,
     };
 
 	return _dependencies;
@@ -40,7 +42,7 @@ void FontManager::initialiseModule(const IApplicationContext& ctx)
 {
     _loader = std::make_unique<FontLoader>(*this);
 
-	// Find installed fonts in a new thread
+	// Find installed fonts in the background
     _loader->start();
 }
 
@@ -55,6 +55,42 @@ ImageLoader::ImageLoader()
 
 // Load image from VFS
 ImagePtr ImageLoader::imageFromVFS(const std::string& rawName) const
+{
+    ImagePtr image;
+
+    findImageFile(rawName, [&](const std::string& fullName, ImageTypeLoader& loader)
+    {
+        // Try to open the file (will fail if the extension does not fit)
+        auto file = GlobalFileSystem().openFile(fullName);
+
+        // Has the file been loaded?
+        if (!file) return false;
+
+        // Try to invoke the imageloader with a reference to the ArchiveFile
+        image = loader.load(*file);
+        return true;
+    });
+
+    return image;
+}
+
+std::string ImageLoader::findImageInVFS(const std::string& rawName) const
+{
+    std::string result;
+
+    findImageFile(rawName, [&](const std::string& fullName, ImageTypeLoader&)
+    {
+        if (GlobalFileSystem().getFileCount(fullName) == 0) return false;
+
+        result = fullName;
+        return true;
+    });
+
+    return result;
+}
+
+void ImageLoader::findImageFile(const std::string& rawName,
+    const std::function<bool(const std::string&, ImageTypeLoader&)>& tryFile) const
 {
     // Replace backslashes with forward slashes and strip of
     // the file extension of the provided token, and store
@@ -79,20 +115,11 @@ ImagePtr ImageLoader::imageFromVFS(const std::string& rawName) const
 		// prefix (e.g. "dds/") and the file extension.
 		std::string fullName = ldr.getPrefix() + name + "." + extension;
 
-		// Try to open the file (will fail if the extension does not fit)
-		auto file = GlobalFileSystem().openFile(fullName);
-
-		// Has the file been loaded?
-		if (file)
+        if (tryFile(fullName, ldr))
         {
-			// Try to invoke the imageloader with a reference to the
-			// ArchiveFile
-			return ldr.load(*file);
-		}
+            return;
+        }
 	}
-
-    // File not found
-	return ImagePtr();
 }
 
 ImagePtr ImageLoader::imageFromFile(const std::string& filename) const
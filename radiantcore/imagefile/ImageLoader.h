@@ -4,6 +4,7 @@
 #include "ImageTypeLoader.h"
 
 #include <map>
+#include <functional>
 
 namespace image
 {
@@ -23,6 +24,11 @@ private:
 private:
     void addLoaderToMap(const ImageTypeLoader::Ptr& loader);
 
+    // Invokes the given function for each candidate file name of the given image,
+    // in the order defined by the game. Stops as soon as the function returns true.
+    void findImageFile(const std::string& rawName,
+        const std::function<bool(const std::string&, ImageTypeLoader&)>& tryFile) const;
+
 public:
 
     // Construct and initialise loaders
@@ -30,6 +36,7 @@ public:
 
     // ImageLoader implementation
     ImagePtr imageFromVFS(const std::string& vfsPath) const override;
+    std::string findImageInVFS(const std::string& vfsPath) const override;
 	ImagePtr imageFromFile(const std::string& filename) const override;
 
     // RegisterableModule implementation
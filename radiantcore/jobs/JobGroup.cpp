@@ -0,0 +1,286 @@
+#include "JobGroup.h"
+
+#include <algorithm>
+#include "JobSystem.h"
+
+namespace jobs
+{
+
+JobGroup::JobGroup(JobSystem& system, const std::string& name) :
+    _system(system),
+    _name(name),
+    _numUnfinishedTasks(0),
+    _cancelled(false)
+{}
+
+const std::string& JobGroup::getName() const
+{
+    return _name;
+}
+
+void JobGroup::run(const std::function<void()>& function)
+{
+    if (_cancelled) return;
+
+    auto task = std::make_shared<Task>();
+    task->function = function;
+    task->group = shared_from_this();
+    task->queueTime = std::chrono::steady_clock::now();
+
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        ++_numUnfinishedTasks;
+        _pendingTasks.push_back(task);
+
+        if (!_dependencies.empty())
+        {
+            _heldBackTasks.push_back(task);
+            return;
+        }
+    }
+
+    // Wake up any thread waiting for this group, it can help running this task
+    _stateChanged.notify_all();
+
+    _system.schedule(task);
+}
+
+void JobGroup::addDependency(const Ptr& other)
+{
+    auto otherGroup = std::dynamic_pointer_cast<JobGroup>(other);
+
+    if (!otherGroup || otherGroup.get() == this) return;
+
+    // Keep the other group's lock while registering, such that it cannot finish in between
+    std::lock_guard<std::mutex> otherLock(otherGroup->_lock);
+
+    if (otherGroup->isFinishedUnlocked()) return;
+
+    otherGroup->_dependentGroups.push_back(weak_from_this());
+
+    std::lock_guard<std::mutex> lock(_lock);
+    _dependencies.push_back(other);
+}
+
+bool JobGroup::isFinished() const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return isFinishedUnlocked();
+}
+
+bool JobGroup::isFinishedUnlocked() const
+{
+    return _numUnfinishedTasks == 0 && _dependencies.empty();
+}
+
+void JobGroup::wait()
+{
+    waitForTasks();
+
+    std::exception_ptr exception;
+
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        std::swap(exception, _exception);
+    }
+
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
+void JobGroup::waitForTasks()
+{
+    while (true)
+    {
+        std::vector<Ptr> dependencies;
+
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+
+            if (isFinishedUnlocked()) return;
+
+            dependencies = _dependencies;
+        }
+
+        // The held back tasks can't run before the dependencies are done, help those first
+        for (const auto& dependency : dependencies)
+        {
+            std::static_pointer_cast<JobGroup>(dependency)->waitForTasks();
+        }
+
+        std::unique_lock<std::mutex> lock(_lock);
+
+        if (!_dependencies.empty())
+        {
+            continue; // dependency finished, but hasn't notified us yet
+        }
+
+        auto task = claimPendingTask();
+
+        if (task)
+        {
+            lock.unlock();
+            _system.execute(task);
+            continue;
+        }
+
+        // All tasks are running on other threads, wait until they're done or new ones arrive
+        _stateChanged.wait(lock, [this]()
+        {
+            return isFinishedUnlocked() || (_dependencies.empty() && !_pendingTasks.empty());
+        });
+    }
+}
+
+std::shared_ptr<Task> JobGroup::claimPendingTask()
+{
+    while (!_pendingTasks.empty())
+    {
+        auto task = std::move(_pendingTasks.front());
+        _pendingTasks.pop_front();
+
+        if (task->claim())
+        {
+            return task;
+        }
+    }
+
+    return std::shared_ptr<Task>();
+}
+
+void JobGroup::cancel()
+{
+    _cancelled = true;
+
+    std::vector<std::weak_ptr<JobGroup>> dependentGroups;
+    std::vector<std::function<void()>> continuations;
+
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        // Discard the tasks not started yet, the worker queues will skip them
+        std::size_t numDiscarded = 0;
+
+        while (auto task = claimPendingTask())
+        {
+            task->group.reset();
+            ++numDiscarded;
+        }
+
+        _heldBackTasks.clear();
+        _numUnfinishedTasks -= numDiscarded;
+
+        if (numDiscarded == 0 || !isFinishedUnlocked()) return;
+
+        dependentGroups.swap(_dependentGroups);
+        continuations.swap(_continuations);
+    }
+
+    _stateChanged.notify_all();
+
+    notifyFinished(std::move(dependentGroups), std::move(continuations));
+}
+
+bool JobGroup::isCancelled() const
+{
+    return _cancelled;
+}
+
+void JobGroup::continueOnMainThread(const std::function<void()>& continuation)
+{
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        if (!isFinishedUnlocked())
+        {
+            _continuations.push_back(continuation);
+            return;
+        }
+    }
+
+    _system.postToMainThread(continuation);
+}
+
+void JobGroup::onTaskDone(std::exception_ptr exception)
+{
+    std::vector<std::weak_ptr<JobGroup>> dependentGroups;
+    std::vector<std::function<void()>> continuations;
+
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        if (exception && !_exception)
+        {
+            _exception = exception;
+        }
+
+        --_numUnfinishedTasks;
+
+        if (!isFinishedUnlocked()) return;
+
+        // All tasks are done, the remaining entries have been claimed already
+        _pendingTasks.clear();
+
+        dependentGroups.swap(_dependentGroups);
+        continuations.swap(_continuations);
+    }
+
+    _stateChanged.notify_all();
+
+    notifyFinished(std::move(dependentGroups), std::move(continuations));
+}
+
+void JobGroup::onDependencyFinished(const JobGroup& dependency)
+{
+    std::vector<std::shared_ptr<Task>> tasksToSchedule;
+    std::vector<std::weak_ptr<JobGroup>> dependentGroups;
+    std::vector<std::function<void()>> continuations;
+
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        _dependencies.erase(std::remove_if(_dependencies.begin(), _dependencies.end(),
+            [&](const Ptr& candidate) { return candidate.get() == &dependency; }), _dependencies.end());
+
+        if (!_dependencies.empty()) return;
+
+        tasksToSchedule.swap(_heldBackTasks);
+
+        if (isFinishedUnlocked())
+        {
+            dependentGroups.swap(_dependentGroups);
+            continuations.swap(_continuations);
+        }
+    }
+
+    _stateChanged.notify_all();
+
+    for (const auto& task : tasksToSchedule)
+    {
+        _system.schedule(task);
+    }
+
+    notifyFinished(std::move(dependentGroups), std::move(continuations));
+}
+
+void JobGroup::notifyFinished(std::vector<std::weak_ptr<JobGroup>>&& dependentGroups,
+    std::vector<std::function<void()>>&& continuations)
+{
+    for (const auto& weakGroup : dependentGroups)
+    {
+        if (auto group = weakGroup.lock())
+        {
+            group->onDependencyFinished(*this);
+        }
+    }
+
+    for (const auto& continuation : continuations)
+    {
+        _system.postToMainThread(continuation);
+    }
+}
+
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "ijobsystem.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+namespace jobs
+{
+
+class JobSystem;
+struct Task;
+
+class JobGroup :
+    public IJobGroup,
+    public std::enable_shared_from_this<JobGroup>
+{
+private:
+    JobSystem& _system;
+    std::string _name;
+
+    mutable std::mutex _lock;
+    std::condition_variable _stateChanged;
+
+    // Tasks added to this group which are not done yet
+    std::size_t _numUnfinishedTasks;
+
+    // Tasks which haven't been claimed by any thread yet (might contain claimed ones too,
+    // these are removed lazily). Waiting threads pick their tasks from this list.
+    std::deque<std::shared_ptr<Task>> _pendingTasks;
+
+    // Tasks held back until the dependencies are finished
+    std::vector<std::shared_ptr<Task>> _heldBackTasks;
+
+    // The unfinished groups this one is depending on
+    std::vector<Ptr> _dependencies;
+
+    // The groups depending on this one
+    std::vector<std::weak_ptr<JobGroup>> _dependentGroups;
+
+    std::vector<std::function<void()>> _continuations;
+
+    std::exception_ptr _exception;
+    std::atomic<bool> _cancelled;
+
+public:
+    JobGroup(JobSystem& system, const std::string& name);
+
+    const std::string& getName() const override;
+    void run(const std::function<void()>& task) override;
+    void addDependency(const Ptr& other) override;
+    bool isFinished() const override;
+    void wait() override;
+    void cancel() override;
+    bool isCancelled() const override;
+    void continueOnMainThread(const std::function<void()>& continuation) override;
+
+    // Called by the job system after a task of this group has been executed
+    void onTaskDone(std::exception_ptr exception);
+
+private:
+    // Requires the lock to be held
+    bool isFinishedUnlocked() const;
+
+    // Waits for the tasks of this group without rethrowing any exception
+    void waitForTasks();
+
+    // Requires the lock to be held, returns an empty pointer if there's nothing to claim
+    std::shared_ptr<Task> claimPendingTask();
+
+    void onDependencyFinished(const JobGroup& dependency);
+
+    // Notifies dependent groups and queues the continuations, to be called
+    // without holding the lock after the group changed to finished
+    void notifyFinished(std::vector<std::weak_ptr<JobGroup>>&& dependentGroups,
+        std::vector<std::function<void()>>&& continuations);
+};
+
+}
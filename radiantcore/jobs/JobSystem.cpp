@@ -0,0 +1,361 @@
+#include "JobSystem.h"
+
+#include "itextstream.h"
+#include "module/StaticModule.h"
+#include <fmt/format.h>
+
+#include "JobGroup.h"
+
+namespace jobs
+{
+
+namespace
+{
+    // The worker running on the current thread, null for threads outside the pool
+    thread_local void* _currentWorker = nullptr;
+
+    inline double getMsecsBetween(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+    {
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+}
+
+JobSystem::JobSystem() :
+    _numWorkers(std::max(std::thread::hardware_concurrency(), 2u)),
+    _numQueuedTasks(0),
+    _stopping(false),
+    _running(false)
+{}
+
+const std::string& JobSystem::getName() const
+{
+    static std::string _name(MODULE_JOBSYSTEM);
+    return _name;
+}
+
+const StringSet& JobSystem::getDependencies() const
+{
+    static StringSet _dependencies
+    {
+        MODULE_COMMANDSYSTEM,
+    };
+
+    return _dependencies;
+}
+
+void JobSystem::initialiseModule(const IApplicationContext& ctx)
+{
+    GlobalCommandSystem().addCommand("ShowJobStats", std::bind(&JobSystem::showStatisticsCmd, this, std::placeholders::_1));
+
+    startWorkers();
+
+    rMessage() << "JobSystem: started " << _numWorkers << " worker threads" << std::endl;
+}
+
+void JobSystem::shutdownModule()
+{
+    // Modules depending on us have been shut down, finish what's left in the queues
+    stopWorkers();
+
+    // Run any continuations that haven't been picked up by the main thread
+    processMainThreadTasks();
+
+    std::lock_guard<std::mutex> lock(_mainThreadLock);
+    _mainThreadDispatcher = decltype(_mainThreadDispatcher)();
+}
+
+IJobGroup::Ptr JobSystem::createGroup(const std::string& name)
+{
+    return std::make_shared<JobGroup>(*this, name);
+}
+
+std::size_t JobSystem::getNumWorkers() const
+{
+    return _numWorkers;
+}
+
+void JobSystem::startWorkers()
+{
+    _stopping = false;
+    _running = true;
+
+    for (std::size_t i = 0; i < _numWorkers; ++i)
+    {
+        _workers.emplace_back(std::make_unique<Worker>());
+        _workers.back()->index = i;
+    }
+
+    // Start the threads after all workers are constructed, they're accessing each other's queues
+    for (auto& worker : _workers)
+    {
+        worker->thread = std::thread(&JobSystem::runWorker, this, std::ref(*worker));
+    }
+}
+
+void JobSystem::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(_wakeupLock);
+        _stopping = true;
+    }
+
+    _wakeup.notify_all();
+
+    for (auto& worker : _workers)
+    {
+        worker->thread.join();
+    }
+
+    // From now on, all tasks are executed right away on the calling thread
+    _running = false;
+    _workers.clear();
+}
+
+void JobSystem::schedule(const TaskPtr& task)
+{
+    if (!_running)
+    {
+        if (task->claim())
+        {
+            execute(task);
+        }
+        return;
+    }
+
+    {
+        // Count the task before it becomes visible, the counter must never drop below zero
+        std::lock_guard<std::mutex> lock(_wakeupLock);
+        ++_numQueuedTasks;
+    }
+
+    if (_currentWorker != nullptr)
+    {
+        // Tasks submitted by a worker go to its own queue
+        auto& worker = *static_cast<Worker*>(_currentWorker);
+
+        std::lock_guard<std::mutex> lock(worker.lock);
+        worker.queue.push_back(task);
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(_injectionLock);
+        _injectionQueue.push_back(task);
+    }
+
+    _wakeup.notify_one();
+}
+
+void JobSystem::execute(const TaskPtr& task)
+{
+    auto group = std::move(task->group);
+
+    // Release the function (and everything it captured) right after it's done
+    auto function = std::move(task->function);
+
+    auto startTime = std::chrono::steady_clock::now();
+    std::exception_ptr exception;
+
+    try
+    {
+        function();
+    }
+    catch (...)
+    {
+        exception = std::current_exception();
+    }
+
+    function = decltype(function)();
+
+    auto endTime = std::chrono::steady_clock::now();
+    auto runTime = getMsecsBetween(startTime, endTime);
+
+    {
+        std::lock_guard<std::mutex> lock(_statisticsLock);
+
+        auto& statistics = _statistics[group->getName()];
+
+        statistics.numTasks++;
+        statistics.totalQueueTimeMsec += getMsecsBetween(task->queueTime, startTime);
+        statistics.totalRunTimeMsec += runTime;
+        statistics.maxRunTimeMsec = std::max(statistics.maxRunTimeMsec, runTime);
+    }
+
+    group->onTaskDone(exception);
+}
+
+void JobSystem::runWorker(Worker& worker)
+{
+    _currentWorker = &worker;
+
+    while (true)
+    {
+        if (auto task = findTask(worker))
+        {
+            // Tasks might have been run by a waiting thread or cancelled in the meantime
+            if (task->claim())
+            {
+                execute(task);
+            }
+
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_wakeupLock);
+
+        _wakeup.wait(lock, [this]() { return _stopping || _numQueuedTasks > 0; });
+
+        if (_stopping && _numQueuedTasks == 0)
+        {
+            break;
+        }
+    }
+
+    _currentWorker = nullptr;
+}
+
+TaskPtr JobSystem::findTask(Worker& worker)
+{
+    // Newest task of our own queue first, it's the most likely to have its data in the cache
+    if (auto task = popTask(worker.lock, worker.queue, true))
+    {
+        return task;
+    }
+
+    if (auto task = popTask(_injectionLock, _injectionQueue, false))
+    {
+        return task;
+    }
+
+    // Steal the oldest task from one of the other workers
+    for (std::size_t i = 1; i < _workers.size(); ++i)
+    {
+        auto& victim = *_workers[(worker.index + i) % _workers.size()];
+
+        if (auto task = popTask(victim.lock, victim.queue, false))
+        {
+            return task;
+        }
+    }
+
+    return TaskPtr();
+}
+
+TaskPtr JobSystem::popTask(std::mutex& lock, std::deque<TaskPtr>& queue, bool fromBack)
+{
+    std::lock_guard<std::mutex> queueLock(lock);
+
+    if (queue.empty())
+    {
+        return TaskPtr();
+    }
+
+    TaskPtr task;
+
+    if (fromBack)
+    {
+        task = std::move(queue.back());
+        queue.pop_back();
+    }
+    else
+    {
+        task = std::move(queue.front());
+        queue.pop_front();
+    }
+
+    --_numQueuedTasks;
+
+    return task;
+}
+
+void JobSystem::postToMainThread(const std::function<void()>& func)
+{
+    std::function<void(const std::function<void()>&)> dispatcher;
+
+    {
+        std::lock_guard<std::mutex> lock(_mainThreadLock);
+
+        _mainThreadTasks.push_back(func);
+
+        // Notify the main thread only once for a batch of functions
+        if (_mainThreadTasks.size() > 1) return;
+
+        dispatcher = _mainThreadDispatcher;
+    }
+
+    if (dispatcher)
+    {
+        dispatcher([this]() { processMainThreadTasks(); });
+    }
+}
+
+void JobSystem::processMainThreadTasks()
+{
+    std::vector<std::function<void()>> tasks;
+
+    {
+        std::lock_guard<std::mutex> lock(_mainThreadLock);
+        tasks.swap(_mainThreadTasks);
+    }
+
+    for (const auto& task : tasks)
+    {
+        try
+        {
+            task();
+        }
+        catch (const std::exception& ex)
+        {
+            rError() << "JobSystem: Exception in main thread task: " << ex.what() << std::endl;
+        }
+    }
+}
+
+void JobSystem::setMainThreadDispatcher(const std::function<void(const std::function<void()>&)>& dispatcher)
+{
+    bool tasksPending = false;
+
+    {
+        std::lock_guard<std::mutex> lock(_mainThreadLock);
+
+        _mainThreadDispatcher = dispatcher;
+        tasksPending = !_mainThreadTasks.empty();
+    }
+
+    // Pick up the functions queued before the dispatcher has been set
+    if (dispatcher && tasksPending)
+    {
+        dispatcher([this]() { processMainThreadTasks(); });
+    }
+}
+
+void JobSystem::foreachTaskStatistics(const std::function<void(const std::string&, const TaskStatistics&)>& functor)
+{
+    std::map<std::string, TaskStatistics> statistics;
+
+    {
+        std::lock_guard<std::mutex> lock(_statisticsLock);
+        statistics = _statistics;
+    }
+
+    for (const auto& [name, taskStatistics] : statistics)
+    {
+        functor(name, taskStatistics);
+    }
+}
+
+void JobSystem::showStatisticsCmd(const cmd::ArgumentList& args)
+{
+    rMessage() << "JobSystem: " << _numWorkers << " workers" << std::endl;
+
+    foreachTaskStatistics([&](const std::string& name, const TaskStatistics& statistics)
+    {
+        rMessage() << fmt::format("[JobSystem] {0}: {1} tasks, run time: {2:.1f} ms (avg {3:.2f} ms, max {4:.2f} ms), queued: avg {5:.2f} ms",
+            name, statistics.numTasks, statistics.totalRunTimeMsec, statistics.totalRunTimeMsec / statistics.numTasks,
+            statistics.maxRunTimeMsec, statistics.totalQueueTimeMsec / statistics.numTasks) << std::endl;
+    });
+}
+
+// Static module instance
+module::StaticModuleRegistration<JobSystem> jobSystemModule;
+
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "ijobsystem.h"
+#include "icommandsystem.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace jobs
+{
+
+class JobGroup;
+
+// A single task submitted to a job group
+struct Task
+{
+    std::function<void()> function;
+    std::shared_ptr<JobGroup> group;
+
+    std::chrono::steady_clock::time_point queueTime;
+
+    // Set by the thread executing (or discarding) this task, a task
+    // can be referenced by the group and a worker queue at the same time
+    std::atomic<bool> claimed = false;
+
+    // Returns true if the calling thread got the exclusive right to run this task
+    bool claim()
+    {
+        return !claimed.exchange(true);
+    }
+};
+using TaskPtr = std::shared_ptr<Task>;
+
+class JobSystem :
+    public IJobSystem
+{
+private:
+    struct Worker
+    {
+        std::size_t index;
+        std::thread thread;
+
+        // Tasks submitted by this worker. The owner takes the newest tasks
+        // from the back, other workers steal the oldest ones from the front.
+        std::mutex lock;
+        std::deque<TaskPtr> queue;
+    };
+
+    std::size_t _numWorkers;
+    std::vector<std::unique_ptr<Worker>> _workers;
+
+    // Tasks submitted by threads outside the pool
+    std::mutex _injectionLock;
+    std::deque<TaskPtr> _injectionQueue;
+
+    // Idle workers are waiting for this condition
+    std::mutex _wakeupLock;
+    std::condition_variable _wakeup;
+    std::atomic<std::size_t> _numQueuedTasks;
+    bool _stopping;
+
+    // Tasks are only dispatched to the workers while the pool is running,
+    // they are executed immediately on the calling thread otherwise
+    std::atomic<bool> _running;
+
+    std::mutex _mainThreadLock;
+    std::vector<std::function<void()>> _mainThreadTasks;
+    std::function<void(const std::function<void()>&)> _mainThreadDispatcher;
+
+    std::mutex _statisticsLock;
+    std::map<std::string, TaskStatistics> _statistics;
+
+public:
+    JobSystem();
+
+    // RegisterableModule implementation
+    const std::string& getName() const override;
+    const StringSet& getDependencies() const override;
+    void initialiseModule(const IApplicationContext& ctx) override;
+    void shutdownModule() override;
+
+    IJobGroup::Ptr createGroup(const std::string& name) override;
+    std::size_t getNumWorkers() const override;
+
+    void postToMainThread(const std::function<void()>& func) override;
+    void processMainThreadTasks() override;
+    void setMainThreadDispatcher(const std::function<void(const std::function<void()>&)>& dispatcher) override;
+
+    void foreachTaskStatistics(const std::function<void(const std::string&, const TaskStatistics&)>& functor) override;
+
+    // Passes the given task to the worker queues (or runs it right away if the pool is not running)
+    void schedule(const TaskPtr& task);
+
+    // Runs the given task, which must have been claimed by the calling thread
+    void execute(const TaskPtr& task);
+
+private:
+    void startWorkers();
+    void stopWorkers();
+
+    void runWorker(Worker& worker);
+    TaskPtr findTask(Worker& worker);
+    TaskPtr popTask(std::mutex& lock, std::deque<TaskPtr>& queue, bool fromBack);
+
+    void showStatisticsCmd(const cmd::ArgumentList& args);
+};
+
+}
@@ -12,6 +12,7 @@
 #include "SetLayerSelectedWalker.h"
 
 #include <functional>
+#include <algorithm>
 #include <climits>
 #include <unordered_set>
 
@@ -59,7 +60,7 @@ int LayerManager::createLayer(const std::string& name, int layerID)
 	_layerParentIds.resize(highestID+1);
 
 	// Set the newly created layer to "visible"
-	_layerVisibility[layerID] = true;
+	setLayerVisibilityFlag(layerID, true);
     _layerParentIds[layerID] = NO_PARENT_ID;
 
 	// Layers have changed
@@ -112,7 +113,7 @@ void LayerManager::deleteLayer(const std::string& name)
 	_layers.erase(layerID);
 
 	// Reset the visibility flag to TRUE, remove parent
-	_layerVisibility[layerID] = true;
+	setLayerVisibilityFlag(layerID, true);
 	_layerParentIds[layerID] = NO_PARENT_ID;
 
 	if (layerID == _activeLayer)
@@ -145,7 +146,8 @@ void LayerManager::reset()
 	_layers.emplace(DEFAULT_LAYER, _(DEFAULT_LAYER_NAME));
 
 	_layerVisibility.resize(1);
-	_layerVisibility[DEFAULT_LAYER] = true;
+	_visibleLayers.clear();
+	setLayerVisibilityFlag(DEFAULT_LAYER, true);
 
     _layerParentIds.resize(1);
     _layerParentIds[DEFAULT_LAYER] = NO_PARENT_ID;
@@ -224,7 +226,8 @@ bool LayerManager::layerIsVisible(int layerID)
 
 void LayerManager::setLayerVisibility(int layerId, bool visible)
 {
-    auto layerVisibilityChanged = setLayerVisibilityRecursively(layerId, visible);
+    std::vector<int> changedLayerIds;
+    setLayerVisibilityRecursively(layerId, visible, changedLayerIds);
 
 	if (!visible && !_layerVisibility.at(_activeLayer))
 	{
@@ -240,37 +243,191 @@ void LayerManager::setLayerVisibility(int layerId, bool visible)
         _activeLayer = layerId;
     }
 
-    if (layerVisibilityChanged)
+    if (!changedLayerIds.empty())
     {
 	    // Fire the visibility changed event
-	    onLayerVisibilityChanged();
+	    onLayerVisibilityChanged(changedLayerIds);
     }
 }
 
-bool LayerManager::setLayerVisibilityRecursively(int rootLayerId, bool visible)
+void LayerManager::setLayerVisibilityRecursively(int rootLayerId, bool visible, std::vector<int>& changedLayerIds)
 {
-    bool visibilityChange = false;
-
     foreachLayerInHierarchy(rootLayerId, [&](int layerId)
     {
         if (layerId < 0 || layerId >= _layerVisibility.size()) return;
 
-        visibilityChange |= _layerVisibility.at(layerId) != visible;
-        _layerVisibility.at(layerId) = visible;
+        if (_layerVisibility.at(layerId) != visible)
+        {
+            setLayerVisibilityFlag(layerId, visible);
+            changedLayerIds.push_back(layerId);
+        }
     });
+}
+
+void LayerManager::setLayerVisibilityFlag(int layerId, bool visible)
+{
+    _layerVisibility.at(layerId) = visible;
 
-    return visibilityChange;
+    if (visible)
+    {
+        _visibleLayers.insert(layerId);
+    }
+    else
+    {
+        _visibleLayers.erase(layerId);
+    }
 }
 
-void LayerManager::updateSceneGraphVisibility()
+void LayerManager::updateChangedNodeVisibility()
 {
-	UpdateNodeVisibilityWalker walker(*this);
-	_rootNode.traverseChildren(walker);
+    std::vector<INode*> nodes(_nodesWithChangedLayers.begin(), _nodesWithChangedLayers.end());
+    _nodesWithChangedLayers.clear();
+
+    updateVisibilityOfNodes(nodes);
 
 	// Redraw
 	SceneChangeNotify();
 }
 
+void LayerManager::updateVisibilityOfNodes(const std::vector<INode*>& nodes)
+{
+    // The visibility of a parent depends on its children, so the ancestors
+    // of every node need to be re-evaluated too, after their children
+    std::unordered_set<INode*> queuedNodes;
+    std::vector<std::pair<std::size_t, INodePtr>> nodesByDepth;
+
+    for (auto node : nodes)
+    {
+        std::size_t depth = 0;
+
+        for (auto parent = node->getParent(); parent; parent = parent->getParent())
+        {
+            ++depth;
+        }
+
+        // Walk upwards until we hit the root or an already queued ancestor
+        for (auto current = node->getSelf();
+             current && current->getNodeType() != INode::Type::MapRoot && queuedNodes.insert(current.get()).second;
+             current = current->getParent(), --depth)
+        {
+            nodesByDepth.emplace_back(depth, current);
+        }
+    }
+
+    // Deepest nodes first
+    std::stable_sort(nodesByDepth.begin(), nodesByDepth.end(), [](const auto& a, const auto& b)
+    {
+        return a.first > b.first;
+    });
+
+    // This is doing the same as the UpdateNodeVisibilityWalker, for the queued nodes only
+    for (const auto& [depth, node] : nodesByDepth)
+    {
+        auto isVisible = updateNodeVisibility(node);
+
+        // Nodes with visible children are shown regardless of their own layers
+        if (!isVisible)
+        {
+            node->foreachNode([&](const INodePtr& child)
+            {
+                isVisible = !child->supportsStateFlag(Node::eLayered) || !child->checkStateFlag(Node::eLayered);
+                return !isVisible;
+            });
+
+            if (isVisible)
+            {
+                node->disable(Node::eLayered);
+            }
+        }
+
+        if (node->checkStateFlag(Node::eLayered))
+        {
+            // Node is hidden by layers after update (and no children are visible), de-select
+            Node_setSelected(node, false);
+        }
+    }
+}
+
+void LayerManager::addLayerMember(INode& node, int layerId)
+{
+    _layerMembers[layerId].insert(&node);
+}
+
+void LayerManager::removeLayerMember(INode& node, int layerId)
+{
+    auto members = _layerMembers.find(layerId);
+
+    if (members == _layerMembers.end()) return;
+
+    members->second.erase(&node);
+
+    if (members->second.empty())
+    {
+        _layerMembers.erase(members);
+    }
+}
+
+void LayerManager::registerNode(INode& node)
+{
+    auto [registration, isNew] = _registeredNodes.emplace(&node, node.getLayers());
+
+    if (!isNew)
+    {
+        // Already registered, treat this like a membership change
+        onNodeLayersChanged(node);
+        return;
+    }
+
+    for (auto layerId : registration->second)
+    {
+        addLayerMember(node, layerId);
+    }
+}
+
+void LayerManager::unregisterNode(INode& node)
+{
+    auto registration = _registeredNodes.find(&node);
+
+    if (registration == _registeredNodes.end()) return;
+
+    for (auto layerId : registration->second)
+    {
+        removeLayerMember(node, layerId);
+    }
+
+    _registeredNodes.erase(registration);
+    _nodesWithChangedLayers.erase(&node);
+}
+
+void LayerManager::onNodeLayersChanged(INode& node)
+{
+    auto registration = _registeredNodes.find(&node);
+
+    if (registration == _registeredNodes.end()) return;
+
+    const auto& oldLayers = registration->second;
+    const auto& newLayers = node.getLayers();
+
+    for (auto layerId : oldLayers)
+    {
+        if (newLayers.count(layerId) == 0)
+        {
+            removeLayerMember(node, layerId);
+        }
+    }
+
+    for (auto layerId : newLayers)
+    {
+        if (oldLayers.count(layerId) == 0)
+        {
+            addLayerMember(node, layerId);
+        }
+    }
+
+    registration->second = newLayers;
+    _nodesWithChangedLayers.insert(&node);
+}
+
 void LayerManager::onLayersChanged()
 {
 	_layersChangedSignal.emit();
@@ -280,13 +437,25 @@ void LayerManager::onNodeMembershipChanged()
 {
 	_nodeMembershipChangedSignal.emit();
 
-	updateSceneGraphVisibility();
+	updateChangedNodeVisibility();
 }
 
-void LayerManager::onLayerVisibilityChanged()
+void LayerManager::onLayerVisibilityChanged(const std::vector<int>& changedLayerIds)
 {
-	// Update all nodes and views
-	updateSceneGraphVisibility();
+	// Only the members of the changed layers need to be updated,
+	// plus any nodes that changed their membership in the meantime
+	for (auto layerId : changedLayerIds)
+	{
+		auto members = _layerMembers.find(layerId);
+
+		if (members != _layerMembers.end())
+		{
+			_nodesWithChangedLayers.insert(members->second.begin(), members->second.end());
+		}
+	}
+
+	// Update the nodes and views
+	updateChangedNodeVisibility();
 
 	// Update the UI
 	_layerVisibilityChangedSignal.emit();
@@ -335,23 +504,8 @@ bool LayerManager::updateNodeVisibility(const INodePtr& node)
         return true; // doesn't support layers, return true for visible
     }
 
-	// Get the list of layers the node is associated with
-	const auto& layers = node->getLayers();
-
-	// We start with the assumption that a node is hidden
-    bool isHidden = true;
-
-	// Cycle through the Node's layers, and show the node as soon as
-	// a visible layer is found.
-	for (int layerId : layers)
-	{
-		if (_layerVisibility[layerId])
-		{
-			// The layer is visible, set the visibility to true and quit
-            isHidden = false;
-			break;
-		}
-	}
+	// The node is shown as soon as any of its layers is visible
+	bool isHidden = !node->getLayers().intersects(_visibleLayers);
 
     if (isHidden)
     {
@@ -2,6 +2,8 @@
 
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include "ilayer.h"
 
 namespace scene 
@@ -21,12 +23,24 @@ private:
 	// quickly check whether a layer is visible or not.
     std::vector<bool> _layerVisibility;
 
+    // The same information as bitset, to check a node's layers in one go
+    LayerList _visibleLayers;
+
     // The parent IDs of each layer (-1 for no parent)
     std::vector<int> _layerParentIds;
 
 	// The ID of the active layer
 	int _activeLayer;
 
+	// The registered scene nodes of each layer
+	std::unordered_map<int, std::unordered_set<INode*>> _layerMembers;
+
+	// The layers each registered node has been added to the member lists with
+	std::unordered_map<INode*, LayerList> _registeredNodes;
+
+	// Registered nodes whose memberships changed since the last visibility update
+	std::unordered_set<INode*> _nodesWithChangedLayers;
+
 	sigc::signal<void> _layersChangedSignal;
 	sigc::signal<void> _layerVisibilityChangedSignal;
 	sigc::signal<void> _layerHierarchyChangedSignal;
@@ -109,6 +123,10 @@ public:
 
 	bool updateNodeVisibility(const scene::INodePtr& node) override;
 
+	void registerNode(INode& node) override;
+	void unregisterNode(INode& node) override;
+	void onNodeLayersChanged(INode& node) override;
+
 	// Selects/unselects an entire layer
 	void setSelected(int layerID, bool selected) override;
 
@@ -124,8 +142,11 @@ public:
 private:
     // Recursively sets the visibility of the given layer and updates
     // the flags on the _layerVisibility vector.
-    // Returns true if any flag changed, false if nothing changed.
-    bool setLayerVisibilityRecursively(int layerID, bool visible);
+    // The IDs of the layers whose flag changed are added to the given vector.
+    void setLayerVisibilityRecursively(int layerID, bool visible, std::vector<int>& changedLayerIds);
+
+    // Sets the visibility flag of a single layer
+    void setLayerVisibilityFlag(int layerID, bool visible);
 
     // Invokes the function object with each layer ID in the hierarchy, including the given root
     void foreachLayerInHierarchy(int rootLayerId, const std::function<void(int)>& functor);
@@ -133,14 +154,20 @@ private:
 	// Internal event emitter
 	void onLayersChanged();
 
-	// Internal event, updates the scenegraph
-	void onLayerVisibilityChanged();
+	// Internal event, updates the members of the given layers
+	void onLayerVisibilityChanged(const std::vector<int>& changedLayerIds);
 
 	// Internal event emitter
 	void onNodeMembershipChanged();
 
-	// Updates the visibility state of the entire scenegraph
-	void updateSceneGraphVisibility();
+	// Updates the visibility of the nodes whose memberships changed
+	void updateChangedNodeVisibility();
+
+	// Updates the visibility state of the given nodes and their ancestors
+	void updateVisibilityOfNodes(const std::vector<INode*>& nodes);
+
+	void addLayerMember(INode& node, int layerID);
+	void removeLayerMember(INode& node, int layerID);
 
 	// Returns the highest used layer Id
 	int getHighestLayerID() const;
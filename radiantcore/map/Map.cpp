@@ -3,6 +3,7 @@
 #include "i18n.h"
 #include <ostream>
 #include <fstream>
+#include <unordered_map>
 #include "itextstream.h"
 #include "iscenegraph.h"
 #include "icameraview.h"
@@ -11,6 +12,7 @@
 #include "ifilesystem.h"
 #include "ifiletypes.h"
 #include "iselectiongroup.h"
+#include "iselectionset.h"
 #include "ifilter.h"
 #include "icounter.h"
 #include "iradiant.h"
@@ -24,14 +26,19 @@
 #include "registry/registry.h"
 #include "entitylib.h"
 #include "gamelib.h"
+#include "iprofiler.h"
 #include "os/path.h"
 #include "os/file.h"
 #include "time/ScopeTimer.h"
+#include "util/ScopedBoolLock.h"
 
 #include "brush/BrushModule.h"
+#include "patch/PatchTesselationBatch.h"
 #include "scene/BasicRootNode.h"
+#include "scene/Clone.h"
 #include "scene/PrefabBoundsAccumulator.h"
 #include "map/MapFileManager.h"
+#include "map/RootNode.h"
 #include "map/MapPositionManager.h"
 #include "map/MapResource.h"
 #include "map/algorithm/Import.h"
@@ -68,6 +75,34 @@ namespace map
 namespace
 {
     const char* const MAP_UNNAMED_STRING = N_("unnamed.map");
+
+    // Copies the layer definitions, hierarchy and visibility to another layer manager
+    void copyLayers(scene::ILayerManager& source, scene::ILayerManager& target)
+    {
+        source.foreachLayer([&](int layerId, const std::string& layerName)
+        {
+            if (target.layerExists(layerId))
+            {
+                target.renameLayer(layerId, layerName); // default layer
+            }
+            else
+            {
+                target.createLayer(layerName, layerId);
+            }
+        });
+
+        source.foreachLayer([&](int layerId, const std::string& layerName)
+        {
+            target.setParentLayer(layerId, source.getParentLayer(layerId));
+
+            if (!source.layerIsVisible(layerId))
+            {
+                target.setLayerVisibility(layerId, false);
+            }
+        });
+
+        target.setActiveLayer(source.getActiveLayer());
+    }
 }
 
 Map::Map() :
@@ -167,6 +202,10 @@ void Map::loadMapResourceFromLocation(const MapLocation& location)
     try
     {
         util::ScopeTimer timer("map load");
+        PROFILE_ZONE("Map::loadMapResourceFromLocation");
+
+        // Tesselate the loaded patches in parallel once parsing is done
+        patch::ScopedTesselationBatch tesselationBatch;
 
         if (isUnnamed() || !_resource->load())
         {
@@ -752,6 +791,111 @@ void Map::saveDirect(const std::string& filename, const MapFormatPtr& mapFormat)
     _saveInProgress = false;
 }
 
+scene::IMapRootNodePtr Map::createSceneSnapshot()
+{
+    auto root = getRoot();
+
+    if (_saveInProgress || !root) return scene::IMapRootNodePtr(); // safeguard
+
+    util::ScopedBoolLock lock(_saveInProgress);
+
+    auto snapshot = std::make_shared<RootNode>(_mapName);
+
+    // Let the subscribers store their data (camera position, editing time,
+    // model scales) in the live scene, such that it ends up in the copy
+    GlobalMapResourceManager().signal_onResourceExporting().emit(root);
+
+    try
+    {
+        root->foreachProperty([&](const std::string& key, const std::string& value)
+        {
+            snapshot->setProperty(key, value);
+        });
+
+        copyLayers(root->getLayerManager(), snapshot->getLayerManager());
+
+        // Group and set memberships need to be transferred to the copied nodes
+        std::unordered_map<scene::INodePtr, scene::INodePtr> copiedMembers;
+
+        root->getSelectionGroupManager().foreachSelectionGroup([&](selection::ISelectionGroup& group)
+        {
+            snapshot->getSelectionGroupManager().createSelectionGroup(group.getId())->setName(group.getName());
+
+            group.foreachNode([&](const scene::INodePtr& node)
+            {
+                copiedMembers.emplace(node, scene::INodePtr());
+            });
+        });
+
+        root->getSelectionSetManager().foreachSelectionSet([&](const selection::ISelectionSetPtr& set)
+        {
+            for (const auto& node : set->getNodes())
+            {
+                copiedMembers.emplace(node, scene::INodePtr());
+            }
+        });
+
+        scene::CloneAll cloner(snapshot, [&](const scene::INodePtr& source, const scene::INodePtr& clone)
+        {
+            auto member = copiedMembers.find(source);
+
+            if (member != copiedMembers.end())
+            {
+                member->second = clone;
+            }
+        });
+        root->traverseChildren(cloner);
+
+        for (const auto& [source, clone] : copiedMembers)
+        {
+            auto selectable = std::dynamic_pointer_cast<IGroupSelectable>(source);
+
+            if (!clone || !selectable) continue;
+
+            // Keep the order of the group IDs, the most recent group comes last
+            for (auto groupId : selectable->getGroupIds())
+            {
+                snapshot->getSelectionGroupManager().findOrCreateSelectionGroup(groupId)->addNode(clone);
+            }
+        }
+
+        root->getSelectionSetManager().foreachSelectionSet([&](const selection::ISelectionSetPtr& set)
+        {
+            auto copiedSet = snapshot->getSelectionSetManager().createSelectionSet(set->getName());
+
+            for (const auto& node : set->getNodes())
+            {
+                if (const auto& clone = copiedMembers[node]; clone)
+                {
+                    copiedSet->addNode(clone);
+                }
+            }
+        });
+    }
+    catch (const std::exception&)
+    {
+        GlobalMapResourceManager().signal_onResourceExported().emit(root);
+        throw;
+    }
+
+    GlobalMapResourceManager().signal_onResourceExported().emit(root);
+
+    return snapshot;
+}
+
+void Map::exportSceneSnapshot(const MapFormat& format, const scene::IMapRootNodePtr& snapshot,
+    std::ostream& mapStream, std::ostream* infoStream)
+{
+    // The export events have already been fired on the live scene by createSceneSnapshot()
+    MapResource::exportToStreams(format, snapshot, scene::traverse, mapStream,
+        format.allowInfoFileCreation() ? infoStream : nullptr, false, false);
+}
+
+bool Map::isSaveInProgress() const
+{
+    return _saveInProgress;
+}
+
 void Map::saveSelected(const std::string& filename, const MapFormatPtr& mapFormat)
 {
     if (_saveInProgress) return; // safeguard
@@ -988,12 +1132,6 @@ void Map::saveMapCopyAs(const cmd::ArgumentList& args)
     }
 }
 
-void Map::saveAutomaticMapBackup(const cmd::ArgumentList& args)
-{
-    // Use the saveDirect routine to not change with the _lastCopyMapName member
-    saveDirect(args[0].getString());
-}
-
 void Map::registerCommands()
 {
     GlobalCommandSystem().addCommand("NewMap", Map::newMap);
@@ -1011,8 +1149,6 @@ void Map::registerCommands()
     GlobalCommandSystem().addCommand("SaveMap", std::bind(&Map::saveMapCmd, this, std::placeholders::_1));
     GlobalCommandSystem().addCommand("SaveMapAs", Map::saveMapAs);
     GlobalCommandSystem().addCommand("SaveMapCopyAs", std::bind(&Map::saveMapCopyAs, this, std::placeholders::_1), { cmd::ARGTYPE_STRING | cmd::ARGTYPE_OPTIONAL });
-    // Command used by the autosaver to save a copy without messing with the remembered paths
-    GlobalCommandSystem().addCommand("SaveAutomaticBackup", std::bind(&Map::saveAutomaticMapBackup, this, std::placeholders::_1), { cmd::ARGTYPE_STRING });
     GlobalCommandSystem().addCommand("ExportMap", std::bind(&Map::exportMap, this, std::placeholders::_1));
     GlobalCommandSystem().addCommand("SaveSelected", Map::exportSelection);
     GlobalCommandSystem().addCommand("FocusViews", std::bind(&Map::focusViewCmd, this, std::placeholders::_1), { cmd::ARGTYPE_VECTOR3, cmd::ARGTYPE_VECTOR3 });
@@ -172,6 +172,28 @@ public:
 	 */
 	void saveDirect(const std::string& filename, const MapFormatPtr& mapFormat = MapFormatPtr());
 
+	/**
+	 * Creates a detached copy of the current map for the auto saver, including the
+	 * root properties, layers, selection groups and selection sets. The copy doesn't
+	 * share any mutable state with the scene, so it can be serialised on a worker
+	 * thread using exportSceneSnapshot() while editing continues. Returns an empty
+	 * pointer if another save is in progress (e.g. a user save pumping the events
+	 * of its progress dialog). The snapshot should be released on the main thread.
+	 */
+	scene::IMapRootNodePtr createSceneSnapshot();
+
+	/**
+	 * Serialises a snapshot created by createSceneSnapshot() into the given streams.
+	 * The info file stream is optional. Doesn't touch the live scene and doesn't send
+	 * any messages, safe to call from a worker thread.
+	 * Throws an OperationException on failure.
+	 */
+	static void exportSceneSnapshot(const MapFormat& format, const scene::IMapRootNodePtr& snapshot,
+		std::ostream& mapStream, std::ostream* infoStream);
+
+	// True while the map is being written by any of the save methods
+	bool isSaveInProgress() const;
+
 	void rename(const std::string& filename);
 
 	void exportSelected(std::ostream& out) override;
@@ -235,9 +257,6 @@ public:
 	 */
 	void saveMapCopyAs(const cmd::ArgumentList& args);
 
-    // Used by the auto saver
-	void saveAutomaticMapBackup(const cmd::ArgumentList& args);
-
 	/** greebo: Asks the user for the .pfb file and exports the file/selection
 	 */
 	static void saveSelectedAsPrefab(const cmd::ArgumentList& args);
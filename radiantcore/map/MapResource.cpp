@@ -444,10 +444,28 @@ void MapResource::saveFile(const MapFormat& format, const scene::IMapRootNodePtr
 
 	rMessage() << "success" << std::endl;
 
+	exportToStreams(format, root, traverse, outFileStream, auxFileStream.get());
+
+	// Check for any stream failures now that we're done writing
+	if (outFileStream.fail())
+	{
+		throw OperationException(fmt::format(_("Failure writing to file {0}"), outFile.string()));
+	}
+
+	if (auxFileStream && auxFileStream->fail())
+	{
+		throw OperationException(fmt::format(_("Failure writing to file {0}"), auxFile.string()));
+	}
+}
+
+void MapResource::exportToStreams(const MapFormat& format, const scene::IMapRootNodePtr& root,
+	const GraphTraversalFunc& traverse, std::ostream& mapStream, std::ostream* auxStream,
+	bool showProgress, bool emitExportEvents)
+{
 	// Check the total count of nodes to traverse
 	NodeCounter counter;
 	traverse(root, counter);
-		
+
 	// Create our main MapExporter walker, and pass the desired 
 	// format to it. The constructor will prepare the scene
 	// and the destructor will clean it up afterwards. That way
@@ -455,13 +473,18 @@ void MapResource::saveFile(const MapFormat& format, const scene::IMapRootNodePtr
 	MapExporterPtr exporter;
 	auto mapWriter = format.getMapWriter();
 
-	if (format.allowInfoFileCreation())
+	if (format.allowInfoFileCreation() && auxStream != nullptr)
 	{
-		exporter.reset(new MapExporter(*mapWriter, root, outFileStream, *auxFileStream, counter.getCount()));
+		exporter.reset(new MapExporter(*mapWriter, root, mapStream, *auxStream, counter.getCount(), emitExportEvents));
 	}
 	else
 	{
-		exporter.reset(new MapExporter(*mapWriter, root, outFileStream, counter.getCount())); // no aux stream
+		exporter.reset(new MapExporter(*mapWriter, root, mapStream, counter.getCount(), emitExportEvents)); // no aux stream
+	}
+
+	if (!showProgress)
+	{
+		exporter->disableProgressMessages();
 	}
 
 	try
@@ -474,17 +497,6 @@ void MapResource::saveFile(const MapFormat& format, const scene::IMapRootNodePtr
 	{
 		throw OperationException(_("Map writing cancelled"));
 	}
-
-	// Check for any stream failures now that we're done writing
-	if (outFileStream.fail())
-	{
-		throw OperationException(fmt::format(_("Failure writing to file {0}"), outFile.string()));
-	}
-
-	if (auxFileStream && auxFileStream->fail())
-	{
-		throw OperationException(fmt::format(_("Failure writing to file {0}"), auxFile.string()));
-	}
 }
 
 } // namespace map
@@ -66,6 +66,15 @@ public:
 	static void saveFile(const MapFormat& format, const scene::IMapRootNodePtr& root,
 						 const GraphTraversalFunc& traverse, const std::string& filename);
 
+	// Export the map contents to the given streams using the given MapFormat export module.
+	// The aux stream is optional, it is only written to if the format supports info files.
+	// Throws an OperationException if the export has been cancelled
+	// The onResourceExporting/Exported events can be suppressed if they have been
+	// fired by the caller already (e.g. for detached copies of the scene).
+	static void exportToStreams(const MapFormat& format, const scene::IMapRootNodePtr& root,
+		const GraphTraversalFunc& traverse, std::ostream& mapStream, std::ostream* auxStream,
+		bool showProgress = true, bool emitExportEvents = true);
+
 protected:
     // Implementation-specific method to open the stream of the primary .map or .mapx file
     // May return an empty reference, may throw OperationException on failure
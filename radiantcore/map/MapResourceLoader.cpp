@@ -1,6 +1,7 @@
 #include "MapResourceLoader.h"
 
 #include "i18n.h"
+#include "iprofiler.h"
 #include "fmt/format.h"
 #include "scene/ChildPrimitives.h"
 #include "scenelib.h"
@@ -17,6 +18,8 @@ MapResourceLoader::MapResourceLoader(std::istream& stream, const MapFormat& form
 
 RootNodePtr MapResourceLoader::load()
 {
+    PROFILE_ZONE("MapResourceLoader::load");
+
     // Create a new map root node
     auto root = std::make_shared<RootNode>("");
 
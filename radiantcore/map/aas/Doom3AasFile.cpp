@@ -1,7 +1,7 @@
 #include "Doom3AasFile.h"
 
 #include "itextstream.h"
-#include "string/convert.h"
+#include "parser/DefTokeniser.h"
 #include "Util.h"
 
 namespace map
@@ -95,181 +95,175 @@ const IAasFile::Area& Doom3AasFile::getArea(int areaNum) const
     return _areas[areaNum];
 }
 
-void Doom3AasFile::parseFromTokens(parser::DefTokeniser& tok)
+void Doom3AasFile::parseFromBuffer(parser::NumericTextReader& reader)
 {
-    while (tok.hasMoreTokens())
+    while (reader.hasMoreTokens())
     {
-        std::string token = tok.nextToken();
+        auto token = reader.nextToken();
 
         if (token == "settings")
         {
+            // The settings block is small and contains strings, leave it to the DefTokeniser
+            std::string settingsBlock(reader.nextBlock());
+            parser::BasicDefTokeniser<std::string> tok(settingsBlock);
+
             _settings.parseFromTokens(tok);
         }
         else if (token == "planes")
         {
-            std::size_t planesCount = string::convert<std::size_t>(tok.nextToken());
+            auto planesCount = reader.nextInteger<std::size_t>();
 
             _planes.reserve(planesCount);
 
-            tok.assertNextToken("{");
+            reader.assertNextToken("{");
 
             // num ( a b c dist )
             for (std::size_t i = 0; i < planesCount; ++i)
             {
-                string::convert<int>(tok.nextToken()); // plane index
+                reader.nextInteger<int>(); // plane index
 
-                tok.assertNextToken("(");
+                reader.assertNextToken("(");
 
                 Plane3 plane;
-                plane.normal().x() = string::convert<Vector3::ElementType>(tok.nextToken());
-                plane.normal().y() = string::convert<Vector3::ElementType>(tok.nextToken());
-                plane.normal().z() = string::convert<Vector3::ElementType>(tok.nextToken());
-                plane.dist() = string::convert<Vector3::ElementType>(tok.nextToken());
+                plane.normal().x() = reader.nextDouble();
+                plane.normal().y() = reader.nextDouble();
+                plane.normal().z() = reader.nextDouble();
+                plane.dist() = reader.nextDouble();
 
                 _planes.push_back(plane);
 
-                tok.assertNextToken(")");
+                reader.assertNextToken(")");
             }
 
-            tok.assertNextToken("}");
+            reader.assertNextToken("}");
         }
         else if (token == "vertices")
         {
-            std::size_t vertCount = string::convert<std::size_t>(tok.nextToken());
+            auto vertCount = reader.nextInteger<std::size_t>();
 
             _vertices.reserve(vertCount);
 
-            tok.assertNextToken("{");
+            reader.assertNextToken("{");
 
             // num ( x y z )
             for (std::size_t i = 0; i < vertCount; ++i)
             {
-                string::convert<int>(tok.nextToken()); // index
-                _vertices.push_back(parseVector3(tok)); // components
+                reader.nextInteger<int>(); // index
+                _vertices.push_back(parseVector3(reader)); // components
             }
 
-            tok.assertNextToken("}");
+            reader.assertNextToken("}");
         }
         else if (token == "edges")
         {
-            std::size_t edgeCount = string::convert<std::size_t>(tok.nextToken());
+            auto edgeCount = reader.nextInteger<std::size_t>();
 
             _edges.reserve(edgeCount);
 
-            tok.assertNextToken("{");
+            reader.assertNextToken("{");
 
             // num ( vertIdx1 vertIdx2 )
             for (std::size_t i = 0; i < edgeCount; ++i)
             {
-                string::convert<int>(tok.nextToken()); // index
+                reader.nextInteger<int>(); // index
 
-                tok.assertNextToken("(");
+                reader.assertNextToken("(");
 
                 Edge edge;
-                edge.vertexNumber[0] = string::convert<int>(tok.nextToken());
-                edge.vertexNumber[1] = string::convert<int>(tok.nextToken());
+                edge.vertexNumber[0] = reader.nextInteger<int>();
+                edge.vertexNumber[1] = reader.nextInteger<int>();
 
-                tok.assertNextToken(")");
+                reader.assertNextToken(")");
 
                 _edges.push_back(edge); // components
             }
 
-            tok.assertNextToken("}");
+            reader.assertNextToken("}");
         }
         else if (token == "edgeIndex")
         {
-            parseIndex(tok, _edgeIndex);
+            parseIndex(reader, _edgeIndex);
         }
         else if (token == "faces")
         {
-            std::size_t faceCount = string::convert<std::size_t>(tok.nextToken());
+            auto faceCount = reader.nextInteger<std::size_t>();
 
             _faces.reserve(faceCount);
 
-            tok.assertNextToken("{");
+            reader.assertNextToken("{");
 
             // num ( planeNum flags areas[0] areas[1] firstEdge numEdges )
             for (std::size_t i = 0; i < faceCount; ++i)
             {
-                string::convert<int>(tok.nextToken()); // number
+                reader.nextInteger<int>(); // number
 
-                tok.assertNextToken("(");
+                reader.assertNextToken("(");
 
                 Face face;
 
-                face.planeNum = string::convert<int>(tok.nextToken());
-                face.flags = string::convert<unsigned short>(tok.nextToken());
-                face.areas[0] = string::convert<short>(tok.nextToken());
-                face.areas[1] = string::convert<short>(tok.nextToken());
-                face.firstEdge = string::convert<int>(tok.nextToken());
-                face.numEdges = string::convert<int>(tok.nextToken());
+                face.planeNum = reader.nextInteger<int>();
+                face.flags = reader.nextInteger<unsigned short>();
+                face.areas[0] = reader.nextInteger<short>();
+                face.areas[1] = reader.nextInteger<short>();
+                face.firstEdge = reader.nextInteger<int>();
+                face.numEdges = reader.nextInteger<int>();
 
                 _faces.push_back(face);
 
-                tok.assertNextToken(")");
+                reader.assertNextToken(")");
             }
 
-            tok.assertNextToken("}");
+            reader.assertNextToken("}");
         }
         else if (token == "faceIndex")
         {
-            parseIndex(tok, _faceIndex);
+            parseIndex(reader, _faceIndex);
         }
         else if (token == "areas")
         {
-            std::size_t areaCount = string::convert<std::size_t>(tok.nextToken());
+            auto areaCount = reader.nextInteger<std::size_t>();
 
             _areas.reserve(areaCount);
 
-            tok.assertNextToken("{");
+            reader.assertNextToken("{");
 
             // num ( flags contents firstFace numFaces cluster clusterAreaNum ) reachabilityCount { reachabilities }
             for (std::size_t i = 0; i < areaCount; ++i)
             {
-                string::convert<int>(tok.nextToken()); // number
+                reader.nextInteger<int>(); // number
 
-                tok.assertNextToken("(");
+                reader.assertNextToken("(");
 
                 Area area;
 
-                area.flags = string::convert<unsigned short>(tok.nextToken());
-                area.contents = string::convert<unsigned short>(tok.nextToken());
-                area.firstFace = string::convert<int>(tok.nextToken());
-                area.numFaces = string::convert<int>(tok.nextToken());
-                area.cluster = string::convert<short>(tok.nextToken());
-                area.clusterAreaNum = string::convert<short>(tok.nextToken());
+                area.flags = reader.nextInteger<unsigned short>();
+                area.contents = reader.nextInteger<unsigned short>();
+                area.firstFace = reader.nextInteger<int>();
+                area.numFaces = reader.nextInteger<int>();
+                area.cluster = reader.nextInteger<short>();
+                area.clusterAreaNum = reader.nextInteger<short>();
 
                 _areas.push_back(area);
 
-                tok.assertNextToken(")");
+                reader.assertNextToken(")");
 
                 // Skip over reachabilities for the moment being
-                /*std::size_t reachCount = */string::convert<std::size_t>(tok.nextToken());
-                tok.assertNextToken("{");
-
-                while (tok.nextToken() != "}")
-                {
-                    // do nothing
-                }
+                /*std::size_t reachCount = */reader.nextInteger<std::size_t>();
+                reader.skipBlock();
             }
 
             // Skip the step LinkReversedReachability();
 
-            tok.assertNextToken("}");
+            reader.assertNextToken("}");
         }
         else if (token == "nodes" || token == "portals" || token == "portalIndex" || token == "clusters")
         {
-            tok.nextToken(); // integer
-            tok.assertNextToken("{");
-
-            while (tok.nextToken() != "}")
-            {
-                // do nothing
-            }
+            reader.nextToken(); // integer
+            reader.skipBlock();
         }
         else
         {
-            throw parser::ParseException("Unknown token: " + token);
+            throw parser::ParseException("Unknown token: " + std::string(token));
         }
     }
 
@@ -389,25 +383,25 @@ Vector3 Doom3AasFile::calcReachableGoalForArea(const IAasFile::Area& area) const
     return center;
 }
 
-void Doom3AasFile::parseIndex(parser::DefTokeniser& tok, Index& index)
+void Doom3AasFile::parseIndex(parser::NumericTextReader& reader, Index& index)
 {
-    std::size_t idxCount = string::convert<std::size_t>(tok.nextToken());
+    auto idxCount = reader.nextInteger<std::size_t>();
 
     index.reserve(idxCount);
 
-    tok.assertNextToken("{");
+    reader.assertNextToken("{");
 
     // num ( idx )
     for (std::size_t i = 0; i < idxCount; ++i)
     {
-        string::convert<int>(tok.nextToken()); // number
+        reader.nextInteger<int>(); // number
 
-        tok.assertNextToken("(");
-        index.push_back(string::convert<int>(tok.nextToken()));
-        tok.assertNextToken(")");
+        reader.assertNextToken("(");
+        index.push_back(reader.nextInteger<int>());
+        reader.assertNextToken(")");
     }
 
-    tok.assertNextToken("}");
+    reader.assertNextToken("}");
 }
 
 }
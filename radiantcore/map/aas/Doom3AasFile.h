@@ -1,7 +1,7 @@
 #pragma once
 
 #include "iaasfile.h"
-#include "parser/DefTokeniser.h"
+#include "parser/NumericTextReader.h"
 #include "Doom3AasFileSettings.h"
 #include <vector>
 #include "math/Plane3.h"
@@ -49,10 +49,12 @@ public:
     virtual std::size_t     getNumAreas() const override;
     virtual const Area&     getArea(int areaNum) const override;
 
-    void parseFromTokens(parser::DefTokeniser& tok);
+    // Parses the file contents following the header, throws parser::ParseException on failure.
+    // Doesn't access any modules, it's safe to call this from a worker thread.
+    void parseFromBuffer(parser::NumericTextReader& reader);
 
 private:
-    void parseIndex(parser::DefTokeniser& tok, Index& index);
+    void parseIndex(parser::NumericTextReader& reader, Index& index);
     void finishAreas();
     Vector3 calcReachableGoalForArea(const IAasFile::Area& area) const;
     Vector3 calcFaceCenter(int faceNum) const;
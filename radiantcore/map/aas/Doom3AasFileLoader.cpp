@@ -2,8 +2,8 @@
 
 #include "itextstream.h"
 
-#include "parser/DefTokeniser.h"
-#include "string/convert.h"
+#include <sstream>
+#include "parser/NumericTextReader.h"
 #include "Doom3AasFile.h"
 #include "module/StaticModule.h"
 
@@ -13,6 +13,9 @@ namespace map
 namespace
 {
     const float DEWM3_AAS_VERSION = 1.07f;
+
+    // Amount of bytes read by canLoad(), enough to cover the version tag
+    constexpr std::size_t HEADER_PEEK_SIZE = 64;
 }
 
 const std::string& Doom3AasFileLoader::getAasFormatName() const
@@ -29,21 +32,23 @@ const std::string& Doom3AasFileLoader::getGameType() const
 
 bool Doom3AasFileLoader::canLoad(std::istream& stream) const
 {
-    // Instantiate a tokeniser to read the first few tokens
-	parser::BasicDefTokeniser<std::istream> tok(stream);
+    // Only the first few tokens are needed, don't read the whole file
+    char header[HEADER_PEEK_SIZE];
+    stream.read(header, sizeof(header));
+
+    auto headerSize = static_cast<std::size_t>(stream.gcount());
+    stream.clear(); // reading past the end of short files sets the fail bit
+
+    parser::NumericTextReader reader(std::string_view(header, headerSize));
 
 	try
 	{
-        parseVersion(tok);
+        parseVersion(reader);
 	}
 	catch (parser::ParseException&)
 	{
         return false;
     }
-	catch (std::invalid_argument&)
-	{
-        return false;
-    }
 
 	return true;
 }
@@ -52,42 +57,40 @@ IAasFilePtr Doom3AasFileLoader::loadFromStream(std::istream& stream)
 {
     Doom3AasFilePtr aasFile = std::make_shared<Doom3AasFile>();
 
-    // We assume that the stream is rewound to the beginning
+    // We assume that the stream is rewound to the beginning,
+    // read it into memory in one go and parse it from there
+    std::ostringstream contents;
+    contents << stream.rdbuf();
 
-    // Instantiate a tokeniser to read the version tag
-	parser::BasicDefTokeniser<std::istream> tok(stream);
+    auto buffer = contents.str();
+    parser::NumericTextReader reader(buffer);
 
     try
 	{
         // File header
-        parseVersion(tok);
+        parseVersion(reader);
 
-        // Checksum (will throw if the string conversion fails)
-        string::convert<long>(tok.nextToken());
+        // Checksum (will throw if the conversion fails)
+        reader.nextInteger<unsigned long>();
 
-        aasFile->parseFromTokens(tok);
+        aasFile->parseFromBuffer(reader);
 	}
 	catch (parser::ParseException& ex)
 	{
         rError() << "Failure parsing AAS file: " << ex.what() << std::endl;
         return IAasFilePtr();
     }
-	catch (std::invalid_argument& ex)
-	{
-        rError() << "Conversion error while parsing AAS file: " << ex.what() << std::endl;
-        return IAasFilePtr();
-    }
 
     return aasFile;
 }
 
-void Doom3AasFileLoader::parseVersion(parser::DefTokeniser& tok) const
+void Doom3AasFileLoader::parseVersion(parser::NumericTextReader& reader) const
 {
     // Require a "Version" token
-    tok.assertNextToken("DewmAAS");
+    reader.assertNextToken("DewmAAS");
 
 	// Require specific version, return true on success
-    if (std::stof(tok.nextToken()) != DEWM3_AAS_VERSION)
+    if (reader.nextFloat() != DEWM3_AAS_VERSION)
     {
         throw parser::ParseException("AAS File version mismatch");
     }
@@ -2,7 +2,7 @@
 
 #include "iaasfile.h"
 
-namespace parser { class DefTokeniser; }
+namespace parser { class NumericTextReader; }
 
 namespace map
 {
@@ -29,7 +29,7 @@ public:
 
 private:
     // Parses the file header, throws exception on failure
-    void parseVersion(parser::DefTokeniser& tok) const;
+    void parseVersion(parser::NumericTextReader& reader) const;
 };
 
 }
\ No newline at end of file
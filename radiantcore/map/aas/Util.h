@@ -2,6 +2,7 @@
 
 #include "math/Vector3.h"
 #include "parser/DefTokeniser.h"
+#include "parser/NumericTextReader.h"
 #include "string/convert.h"
 
 namespace map
@@ -18,4 +19,17 @@ namespace map
 
         return vec;
     }
+
+    inline Vector3 parseVector3(parser::NumericTextReader& reader)
+    {
+        Vector3 vec;
+
+        reader.assertNextToken("(");
+        vec[0] = reader.nextDouble();
+        vec[1] = reader.nextDouble();
+        vec[2] = reader.nextDouble();
+        reader.assertNextToken(")");
+
+        return vec;
+    }
 }
@@ -374,6 +374,16 @@ void importFromStream(std::istream& stream)
     }
 }
 
+void importFromRootNode(const scene::IMapRootNodePtr& foreignRoot)
+{
+    GlobalSelectionSystem().setSelectedAll(false);
+
+    // Adjust all new names to fit into the existing map namespace
+    prepareNamesForImport(GlobalMap().getRoot(), foreignRoot);
+
+    importMap(foreignRoot);
+}
+
 }
 
 }
@@ -37,6 +37,13 @@ void prepareNamesForImport(const scene::IMapRootNodePtr& targetRoot, const scene
  */
 void importFromStream(std::istream& stream);
 
+/**
+ * Imports the map objects held by the given foreign root node into the active map,
+ * adjusting their names to not conflict with the ones in the map.
+ * De-selects the current selection before importing, selects the imported objects.
+ */
+void importFromRootNode(const scene::IMapRootNodePtr& foreignRoot);
+
 /**
  * Returns a map format capable of loading the data in the given stream,
  * matching the the given extension. Since more than one map format might
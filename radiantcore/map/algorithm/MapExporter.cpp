@@ -25,7 +25,8 @@ namespace map
 		const char* const RKEY_MAP_SAVE_STATUS_INTERLEAVE = "user/ui/map/saveStatusInterleave";
 	}
 
-MapExporter::MapExporter(IMapWriter& writer, const scene::IMapRootNodePtr& root, std::ostream& mapStream, std::size_t nodeCount) :
+MapExporter::MapExporter(IMapWriter& writer, const scene::IMapRootNodePtr& root, std::ostream& mapStream,
+				std::size_t nodeCount, bool emitExportEvents) :
 	_writer(writer),
 	_mapStream(mapStream),
 	_root(root),
@@ -34,13 +35,14 @@ MapExporter::MapExporter(IMapWriter& writer, const scene::IMapRootNodePtr& root,
 	_curNodeCount(0),
 	_entityNum(0),
 	_primitiveNum(0),
-    _sendProgressMessages(true)
+    _sendProgressMessages(true),
+	_emitExportEvents(emitExportEvents)
 {
 	construct();
 }
 
 MapExporter::MapExporter(IMapWriter& writer, const scene::IMapRootNodePtr& root,
-				std::ostream& mapStream, std::ostream& auxStream, std::size_t nodeCount) :
+				std::ostream& mapStream, std::ostream& auxStream, std::size_t nodeCount, bool emitExportEvents) :
 	_writer(writer),
 	_mapStream(mapStream),
 	_infoFileExporter(new InfoFileExporter(auxStream)),
@@ -50,7 +52,8 @@ MapExporter::MapExporter(IMapWriter& writer, const scene::IMapRootNodePtr& root,
 	_curNodeCount(0),
 	_entityNum(0),
 	_primitiveNum(0),
-    _sendProgressMessages(true)
+    _sendProgressMessages(true),
+	_emitExportEvents(emitExportEvents)
 {
 	construct();
 }
@@ -272,13 +275,19 @@ void MapExporter::prepareScene()
 	}
 
 	// Emit the pre-export event to give subscribers a chance to prepare the scene
-	GlobalMapResourceManager().signal_onResourceExporting().emit(_root);
+	if (_emitExportEvents)
+	{
+		GlobalMapResourceManager().signal_onResourceExporting().emit(_root);
+	}
 }
 
 void MapExporter::finishScene()
 {
 	// Emit the post-export event to give subscribers a chance to cleanup the scene
-	GlobalMapResourceManager().signal_onResourceExported().emit(_root);
+	if (_emitExportEvents)
+	{
+		GlobalMapResourceManager().signal_onResourceExported().emit(_root);
+	}
 
 	// stgatilov: Hack to disable recalculateBrushWindings for hot-reload diffs
 	if (registry::getValue<std::string>("MapExporter_IgnoreBrushes") != "yes")
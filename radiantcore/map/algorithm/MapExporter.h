@@ -55,14 +55,18 @@ private:
 
     bool _sendProgressMessages;
 
+	// Whether to fire the onResourceExporting/Exported events of the MapResourceManager
+	bool _emitExportEvents;
+
 public:
 	// The constructor prepares the scene and the output stream
 	MapExporter(IMapWriter& writer, const scene::IMapRootNodePtr& root,
-				std::ostream& mapStream, std::size_t nodeCount = 0);
+				std::ostream& mapStream, std::size_t nodeCount = 0, bool emitExportEvents = true);
 
 	// Additional constructor allowed to write to the auxiliary .darkradiant file
 	MapExporter(IMapWriter& writer, const scene::IMapRootNodePtr& root,
-				std::ostream& mapStream, std::ostream& auxStream, std::size_t nodeCount = 0);
+				std::ostream& mapStream, std::ostream& auxStream, std::size_t nodeCount = 0,
+				bool emitExportEvents = true);
 
 	// Cleans up the scene on destruction
 	~MapExporter();
@@ -10,7 +10,7 @@
 #include "iregistry.h"
 #include "igame.h"
 #include "ipreferencesystem.h"
-#include "icommandsystem.h"
+#include "imapformat.h"
 
 #include "registry/registry.h"
 
@@ -19,6 +19,8 @@
 #include "os/dir.h"
 #include "os/fs.h"
 #include "gamelib.h"
+#include "scene/Traverse.h"
+#include "time/ScopeTimer.h"
 
 #include <limits.h>
 #include "string/string.h"
@@ -29,6 +31,8 @@
 #include "map/Map.h"
 
 #include <fmt/format.h>
+#include <fstream>
+#include <sstream>
 
 namespace map
 {
@@ -38,10 +42,9 @@ namespace
 	// Registry key names
 	const char* GKEY_MAP_EXTENSION = "/mapFormat/fileExtension";
 
-	std::string constructSnapshotName(const fs::path& snapshotPath, const std::string& mapName, int num)
+	std::string constructSnapshotName(const fs::path& snapshotPath, const std::string& mapName,
+		int num, const std::string& mapExt)
 	{
-		std::string mapExt = game::current::getValue<std::string>(GKEY_MAP_EXTENSION);
-
 		// Construct the base name without numbered extension
 		std::string filename = (snapshotPath / mapName).replace_extension().string();
 
@@ -53,6 +56,31 @@ namespace
 
 		return filename;
 	}
+
+	// Writes the data to a temporary file first, such that an interrupted
+	// write doesn't leave a truncated file at the target location
+	void writeFileContents(const fs::path& path, const std::string& contents)
+	{
+		fs::path tempPath = path.string() + ".tmp";
+
+		{
+			std::ofstream stream(tempPath.string(), std::ios::binary);
+
+			if (!stream.is_open())
+			{
+				throw std::runtime_error(fmt::format(_("Could not open file for writing: {0}"), tempPath.string()));
+			}
+
+			stream.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+
+			if (stream.fail())
+			{
+				throw std::runtime_error(fmt::format(_("Failure writing to file {0}"), tempPath.string()));
+			}
+		}
+
+		fs::rename(tempPath, path);
+	}
 }
 
 AutoMapSaver::AutoMapSaver() :
@@ -77,6 +105,7 @@ void AutoMapSaver::saveSnapshot()
 	// 1. make sure the snapshot directory exists (create it if it doesn't)
 	// 2. find out what the lastest save is based on number
 	// 3. inc that and save the map
+	// Only the paths are resolved here, the rest is done by the background writer
 
 	// Construct the fs::path class out of the full map path (throws on fail)
 	fs::path fullPath = GlobalMapModule().getMapName();
@@ -86,42 +115,203 @@ void AutoMapSaver::saveSnapshot()
         fullPath = GlobalFileSystem().findFile(fullPath.string()) + fullPath.string();
     }
 
+	SaveJob job;
+	job.isSnapshot = true;
+	job.mapExtension = game::current::getValue<std::string>(GKEY_MAP_EXTENSION);
+
 	// Assemble the absolute path to the snapshot folder
-	fs::path snapshotPath = fullPath;
-	snapshotPath.remove_filename();
+	job.snapshotPath = fullPath;
+	job.snapshotPath.remove_filename();
 
     // If the snapshots folder in the registry is absolute, operator/= will use the absolute one
-	snapshotPath /= GlobalRegistry().get(RKEY_AUTOSAVE_SNAPSHOTS_FOLDER);
+	job.snapshotPath /= GlobalRegistry().get(RKEY_AUTOSAVE_SNAPSHOTS_FOLDER);
 
 	// Retrieve the mapname
-	auto mapName = fullPath.filename().string();
+	job.mapName = fullPath.filename().string();
+
+	// The map format is determined by the extension of the snapshot files
+	auto formatFilename = constructSnapshotName(job.snapshotPath, job.mapName, 0, job.mapExtension);
+
+	startSave(std::move(job), formatFilename);
+}
+
+void AutoMapSaver::saveToFile(const std::string& filename)
+{
+	SaveJob job;
+	job.filename = filename;
+
+	startSave(std::move(job), filename);
+}
+
+void AutoMapSaver::startSave(SaveJob&& job, const std::string& formatFilename)
+{
+	auto format = GlobalMapFormatManager().getMapFormatForFilename(formatFilename);
 
-	// Check if the folder exists and create it if necessary
-	if (os::fileOrDirExists(snapshotPath.string()) || os::makeDirectory(snapshotPath.string()))
+	// Fall back to the format of the current map if the extension is unknown
+	if (!format)
 	{
-        // Map existing snapshots (snapshot num => path)
-        std::map<int, std::string> existingSnapshots;
+		format = GlobalMapFormatManager().getMapFormatForFilename(GlobalMapModule().getMapName());
+	}
 
-		collectExistingSnapshots(existingSnapshots, snapshotPath, mapName);
+	if (!format)
+	{
+		rError() << "AutoSaver: Unable to determine the map format for " << formatFilename << std::endl;
+		return;
+	}
 
-		int highestNum = existingSnapshots.empty() ? 0 : existingSnapshots.rbegin()->first + 1;
+	// Only a detached copy of the scene is taken on the main thread, it is
+	// serialised and written to disk in the background while editing continues
+	{
+		util::ScopeTimer timer("Autosave scene snapshot");
 
-		std::string filename = constructSnapshotName(snapshotPath, mapName, highestNum);
+		try
+		{
+			job.snapshot = GlobalMap().createSceneSnapshot();
+		}
+		catch (const std::exception& ex)
+		{
+			rError() << "AutoSaver: Failed to copy the scene: " << ex.what() << std::endl;
+			return;
+		}
 
-		rMessage() << "Autosaving snapshot to " << filename << std::endl;
+		if (!job.snapshot)
+		{
+			rMessage() << "AutoSaver: Skipped, the map is being saved" << std::endl;
+			return;
+		}
+	}
 
-		// Dump to map to the next available filename
-        GlobalCommandSystem().executeCommand("SaveAutomaticBackup", filename);
+	job.format = format;
 
-		handleSnapshotSizeLimit(existingSnapshots, snapshotPath, mapName);
+	if (format->allowInfoFileCreation())
+	{
+		job.infoFileExtension = game::current::getInfoFileExtension();
 	}
-	else
+
+	rMessage() << "AutoSaver: Scene copied, serialising in background" << std::endl;
+
+	_pendingSaveTask = GlobalJobSystem().createGroup("AutoSaver");
+	_pendingSave = jobs::runWithResult(_pendingSaveTask, [job = std::move(job)]() mutable
 	{
-		rError() << "Snapshot save failed, unable to create directory " << snapshotPath << std::endl;
+		return writeFiles(job);
+	});
+}
+
+AutoMapSaver::SaveResult AutoMapSaver::writeFiles(SaveJob& job)
+{
+	SaveResult result;
+
+	// The snapshot goes back to the main thread, it's not destroyed here
+	result.snapshot = std::move(job.snapshot);
+
+	try
+	{
+		std::ostringstream mapStream;
+		std::ostringstream infoStream;
+
+		{
+			util::ScopeTimer timer("Autosave serialisation");
+
+			Map::exportSceneSnapshot(*job.format, result.snapshot, mapStream,
+				job.infoFileExtension.empty() ? nullptr : &infoStream);
+		}
+
+		auto mapData = mapStream.str();
+		auto infoFileData = infoStream.str();
+
+		rMessage() << "AutoSaver: Serialised " << (mapData.size() + infoFileData.size()) / 1024
+			<< " kB of map data" << std::endl;
+
+		util::ScopeTimer timer("Autosave background write");
+
+		auto filename = job.filename;
+
+		if (job.isSnapshot)
+		{
+			// Check if the folder exists and create it if necessary
+			if (!os::fileOrDirExists(job.snapshotPath.string()) && !os::makeDirectory(job.snapshotPath.string()))
+			{
+				result.errorMessage = "Snapshot save failed, unable to create directory " + job.snapshotPath.string();
+				return result;
+			}
+
+			// Map existing snapshots (snapshot num => path)
+			std::map<int, std::string> existingSnapshots;
+
+			collectExistingSnapshots(existingSnapshots, job.snapshotPath, job.mapName, job.mapExtension);
+
+			int highestNum = existingSnapshots.empty() ? 0 : existingSnapshots.rbegin()->first + 1;
+
+			filename = constructSnapshotName(job.snapshotPath, job.mapName, highestNum, job.mapExtension);
+
+			// Sum up the total folder size
+			std::size_t folderSize = 0;
+
+			for (const auto& pair : existingSnapshots)
+			{
+				folderSize += os::getFileSize(pair.second);
+			}
+
+			rMessage() << "Autosaving snapshot to " << filename << std::endl;
+
+			result.warningMessage = handleSnapshotSizeLimit(folderSize, job.snapshotPath, job.mapName);
+		}
+
+		writeFileContents(filename, mapData);
+
+		if (!job.infoFileExtension.empty())
+		{
+			writeFileContents(fs::path(filename).replace_extension(job.infoFileExtension), infoFileData);
+		}
+	}
+	catch (const std::exception& ex)
+	{
+		result.errorMessage = ex.what();
+	}
+
+	return result;
+}
+
+void AutoMapSaver::finishPendingSave(bool wait)
+{
+	if (!_pendingSave.valid()) return;
+
+	if (!wait && _pendingSave.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+	{
+		return;
+	}
+
+	if (wait)
+	{
+		// Runs the write on this thread if no worker picked it up yet
+		_pendingSaveTask->wait();
+	}
+
+	_pendingSaveTask.reset();
+	auto result = _pendingSave.get();
+
+	// Release the scene copy here on the main thread
+	result.snapshot.reset();
+
+	if (!result.errorMessage.empty())
+	{
+		rError() << "AutoSaver: " << result.errorMessage << std::endl;
+		radiant::NotificationMessage::SendError(result.errorMessage);
+		return;
+	}
+
+	if (!result.warningMessage.empty())
+	{
+		radiant::NotificationMessage::SendWarning(result.warningMessage);
 	}
 }
 
-void AutoMapSaver::handleSnapshotSizeLimit(const std::map<int, std::string>& existingSnapshots,
+void AutoMapSaver::waitForPendingSave()
+{
+	finishPendingSave(true);
+}
+
+std::string AutoMapSaver::handleSnapshotSizeLimit(std::size_t folderSize,
 	const fs::path& snapshotPath, const std::string& mapName)
 {
 	std::size_t maxSnapshotFolderSize =
@@ -133,14 +323,6 @@ void AutoMapSaver::handleSnapshotSizeLimit(const std::map<int, std::string>& exi
 		maxSnapshotFolderSize = 100;
 	}
 
-	// Sum up the total folder size
-	std::size_t folderSize = 0;
-
-	for (const std::pair<int, std::string>& pair : existingSnapshots)
-	{
-		folderSize += os::getFileSize(pair.second);
-	}
-
 	std::size_t maxSize = maxSnapshotFolderSize * 1024 * 1024;
 
 	// The key containing the previously calculated size
@@ -163,31 +345,30 @@ void AutoMapSaver::handleSnapshotSizeLimit(const std::map<int, std::string>& exi
 		if (prevSize > maxSize)
 		{
 			rMessage() << "User has already been notified about the snapshot size exceeding limits." << std::endl;
-			return;
+			return std::string();
 		}
 
 		rMessage() << "AutoSaver: The snapshot files in " << snapshotPath <<
 			" take up more than " << maxSnapshotFolderSize << " MB. You might consider cleaning it up." << std::endl;
 
-		// Notify the user
-		radiant::NotificationMessage::SendWarning(
-			fmt::format(_("The snapshots saved for this map are exceeding the configured size limit."
-				"\nConsider cleaning up the folder {0}"), snapshotPath.string()));
-	}
-	else
-	{
-		// Folder size is within limits (again), delete the size info from the registry
-		GlobalRegistry().deleteXPath(mapKey);
+		// The user is notified on the main thread
+		return fmt::format(_("The snapshots saved for this map are exceeding the configured size limit."
+			"\nConsider cleaning up the folder {0}"), snapshotPath.string());
 	}
+
+	// Folder size is within limits (again), delete the size info from the registry
+	GlobalRegistry().deleteXPath(mapKey);
+
+	return std::string();
 }
 
 void AutoMapSaver::collectExistingSnapshots(std::map<int, std::string>& existingSnapshots,
-	const fs::path& snapshotPath, const std::string& mapName)
+	const fs::path& snapshotPath, const std::string& mapName, const std::string& mapExtension)
 {
 	for (int num = 0; num < INT_MAX; num++)
 	{
 		// Construct the base name without numbered extension
-		std::string filename = constructSnapshotName(snapshotPath, mapName, num);
+		std::string filename = constructSnapshotName(snapshotPath, mapName, num, mapExtension);
 
 		if (!os::fileOrDirExists(filename))
 		{
@@ -200,6 +381,9 @@ void AutoMapSaver::collectExistingSnapshots(std::map<int, std::string>& existing
 
 bool AutoMapSaver::runAutosaveCheck()
 {
+    // Pick up the result of the previous save if it has been written by now
+    finishPendingSave(false);
+
     // Check, if changes have been made since the last autosave
     if (!GlobalSceneGraph().root() || _savedChangeCount == GlobalSceneGraph().root()->getUndoChangeTracker().getCurrentChangeCount())
     {
@@ -207,7 +391,16 @@ bool AutoMapSaver::runAutosaveCheck()
     }
 
     AutomaticMapSaveRequest request;
-    GlobalRadiantCore().getMessageBus().sendMessage(request);
+
+    // Don't export the scene while a user save is still traversing it
+    if (GlobalMap().isSaveInProgress())
+    {
+        request.denyWithReason(_("Map is being saved"));
+    }
+    else
+    {
+        GlobalRadiantCore().getMessageBus().sendMessage(request);
+    }
 
     if (request.isDenied())
     {
@@ -220,6 +413,9 @@ bool AutoMapSaver::runAutosaveCheck()
 
 void AutoMapSaver::performAutosave()
 {
+    // Only one save can be in flight, the snapshot numbering depends on the previous one
+    finishPendingSave(true);
+
     // Remember the change tracking counter
     _savedChangeCount = GlobalSceneGraph().root()->getUndoChangeTracker().getCurrentChangeCount();
 
@@ -251,8 +447,7 @@ void AutoMapSaver::performAutosave()
 
             rMessage() << "Autosaving unnamed map to " << autoSaveFilename << std::endl;
 
-            // Invoke the save call
-            GlobalCommandSystem().executeCommand("SaveAutomaticBackup", autoSaveFilename);
+            saveToFile(autoSaveFilename);
         }
         else
         {
@@ -267,8 +462,7 @@ void AutoMapSaver::performAutosave()
 
             rMessage() << "Autosaving map to " << filename << std::endl;
 
-            // Invoke the save call
-            GlobalCommandSystem().executeCommand("SaveAutomaticBackup", filename);
+            saveToFile(filename);
         }
     }
 }
@@ -313,8 +507,10 @@ const StringSet& AutoMapSaver::getDependencies() const
 	if (_dependencies.empty())
 	{
 		_dependencies.insert(MODULE_MAP);
+		_dependencies.insert(MODULE_MAPFORMATMANAGER);
 		_dependencies.insert(MODULE_PREFERENCESYSTEM);
 		_dependencies.insert(MODULE_XMLREGISTRY);
+		_dependencies.insert(MODULE_JOBSYSTEM);
 	}
 
 	return _dependencies;
@@ -343,6 +539,9 @@ void AutoMapSaver::initialiseModule(const IApplicationContext& ctx)
 
 void AutoMapSaver::shutdownModule()
 {
+	// Don't leave a half-written backup behind
+	waitForPendingSave();
+
 	// Unsubscribe from all connections
 	for (sigc::connection& connection : _signalConnections)
 	{
@@ -3,9 +3,12 @@
 #include <map>
 
 #include "imap.h"
+#include "imapformat.h"
 #include "iautosaver.h"
+#include "ijobsystem.h"
 
 #include <vector>
+#include <future>
 #include <sigc++/connection.h>
 #include "os/fs.h"
 
@@ -27,6 +30,39 @@ private:
 
 	std::vector<sigc::connection> _signalConnections;
 
+	// The scene copy taken on the main thread, handed over to the background writer
+	struct SaveJob
+	{
+		scene::IMapRootNodePtr snapshot;
+		MapFormatPtr format;
+
+		// Empty if the map format doesn't write info files
+		std::string infoFileExtension;
+
+		// The target file, in snapshot mode this is determined by the writer
+		std::string filename;
+
+		bool isSnapshot = false;
+		fs::path snapshotPath;
+		std::string mapName;
+		std::string mapExtension;
+	};
+
+	struct SaveResult
+	{
+		std::string errorMessage;
+
+		// Set if the snapshot folder exceeds the size limit
+		std::string warningMessage;
+
+		// Handed back to be released on the main thread
+		scene::IMapRootNodePtr snapshot;
+	};
+
+	// The save currently being written in the background
+	std::future<SaveResult> _pendingSave;
+	jobs::IJobGroup::Ptr _pendingSaveTask;
+
 public:
 	// Constructor
 	AutoMapSaver();
@@ -46,6 +82,8 @@ public:
 
     void performAutosave() override;
 
+    void waitForPendingSave() override;
+
 private:
 	void constructPreferences();
 
@@ -56,10 +94,24 @@ private:
 	// Saves a snapshot of the currently active map (only named maps)
 	void saveSnapshot();
 
-	void collectExistingSnapshots(std::map<int, std::string>& existingSnapshots,
-		const fs::path& snapshotPath, const std::string& mapName);
+	// Saves the currently active map to the given file
+	void saveToFile(const std::string& filename);
+
+	// Copies the scene into the given job and starts the background writer
+	void startSave(SaveJob&& job, const std::string& formatFilename);
+
+	// Processes the result of the background save (if it's done or wait is true)
+	void finishPendingSave(bool wait);
+
+	// Runs in the background, serialises the snapshot, resolves the snapshot number
+	// and writes the files
+	static SaveResult writeFiles(SaveJob& job);
+
+	static void collectExistingSnapshots(std::map<int, std::string>& existingSnapshots,
+		const fs::path& snapshotPath, const std::string& mapName, const std::string& mapExtension);
 
-	void handleSnapshotSizeLimit(const std::map<int, std::string>& existingSnapshots,
+	// Updates the size history in the registry, returns the warning to show (if any)
+	static std::string handleSnapshotSizeLimit(std::size_t folderSize,
 		const fs::path& snapshotPath, const std::string& mapName);
 };
 
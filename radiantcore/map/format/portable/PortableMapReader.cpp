@@ -15,6 +15,7 @@
 #include "scenelib.h"
 #include "string/convert.h"
 #include "xmlutil/Document.h"
+#include "xmlutil/StreamReader.h"
 
 namespace map
 {
@@ -55,21 +56,70 @@ PortableMapReader::PortableMapReader(IMapImportFilter& importFilter) :
 
 void PortableMapReader::readFromStream(std::istream& stream)
 {
-	xml::Document doc(stream);
+	try
+	{
+		xml::StreamReader reader(stream);
 
-	auto mapNode = doc.getTopLevelNode();
+		readMap(reader);
+	}
+	catch (const xml::StreamReader::ParseError& ex)
+	{
+		throw FailureException(std::string("Failed to parse map: ") + ex.what());
+	}
+}
 
-	if (string::convert<std::size_t>(mapNode.getAttributeValue(ATTR_VERSION)) != PortableMapFormat::Version)
+void PortableMapReader::readMap(xml::StreamReader& reader)
+{
+	if (!reader.next() || !reader.isStartElement())
+	{
+		throw FailureException("No map data found.");
+	}
+
+	if (string::convert<std::size_t>(reader.getAttributeValue(ATTR_VERSION)) != PortableMapFormat::Version)
 	{
 		throw FailureException("Unsupported format version.");
 	}
 
+	// The header sections in front of the entities are small,
+	// they are collected and processed as a whole
+	auto header = xml::Document::create();
+	auto headerNode = header.addTopLevelNode(reader.getName());
+	bool headerProcessed = false;
+
+	// Visit the children of the map tag, subtrees are consumed as a whole
+	bool hasChildren = !reader.isEmptyElement();
+
+	while (hasChildren && reader.next() && reader.getDepth() > 0)
+	{
+		if (reader.getName() == TAG_ENTITY)
+		{
+			if (!headerProcessed)
+			{
+				readMapHeader(headerNode);
+				headerProcessed = true;
+			}
+
+			readEntity(reader);
+			continue;
+		}
+
+		header.copyNodes({ reader.expand() });
+		reader.skipSubtree();
+	}
+
+	// Maps without any entities
+	if (!headerProcessed)
+	{
+		readMapHeader(headerNode);
+	}
+}
+
+void PortableMapReader::readMapHeader(const xml::Node& mapNode)
+{
 	readLayers(mapNode);
 	readSelectionGroups(mapNode);
 	readSelectionSets(mapNode);
 	readMapProperties(mapNode);
-
-	readEntities(mapNode);
 }
 
 void PortableMapReader::readLayers(const xml::Node& mapNode)
@@ -197,44 +247,89 @@ void PortableMapReader::readMapProperties(const xml::Node& mapNode)
 	}
 }
 
-void PortableMapReader::readEntities(const xml::Node& mapNode)
+void PortableMapReader::readEntity(xml::StreamReader& reader)
 {
-	auto entityNodes = mapNode.getNamedChildren(TAG_ENTITY);
+	auto entityNumber = reader.getAttributeValue(ATTR_ENTITY_NUMBER);
+
+	// Everything except the primitives is collected and processed
+	// once the end of the entity has been reached
+	auto entityDoc = xml::Document::create();
+	auto entityTag = entityDoc.addTopLevelNode(TAG_ENTITY);
+
+	std::vector<scene::INodePtr> primitives;
+	std::size_t numPrimitiveTags = 0;
+	bool hasChildren = !reader.isEmptyElement();
 
-	for (const auto& entityNode : entityNodes)
+	while (hasChildren && reader.next() && !reader.isEndElement())
 	{
-		try
-		{
-			readEntity(entityNode);
-		}
-		catch (const BadDocumentFormatException & ex)
+		if (reader.getName() == TAG_ENTITY_PRIMITIVES)
 		{
-			rError() << "PortableMapReader: Failed to parse entity: " << ex.what() << std::endl;
+			readPrimitives(reader, entityNumber, primitives);
+			numPrimitiveTags++;
 			continue;
 		}
+
+		entityDoc.copyNodes({ reader.expand() });
+		reader.skipSubtree();
+	}
+
+	scene::INodePtr entityNode;
+
+	try
+	{
+		entityNode = createEntity(entityTag);
+	}
+	catch (const BadDocumentFormatException& ex)
+	{
+		rError() << "PortableMapReader: Failed to parse entity: " << ex.what() << std::endl;
+		return;
+	}
+
+	if (numPrimitiveTags != 1)
+	{
+		rError() << "PortableMapReader: Entity " << entityNode->name() << ": Odd number of " <<
+			TAG_ENTITY_PRIMITIVES << " nodes encountered." << std::endl;
+		return;
+	}
+
+	for (const auto& primitive : primitives)
+	{
+		_importFilter.addPrimitiveToEntity(primitive, entityNode);
 	}
 }
 
-void PortableMapReader::readPrimitives(const xml::Node& primitivesNode, const scene::INodePtr& entity)
+void PortableMapReader::readPrimitives(xml::StreamReader& reader, const std::string& entityNumber,
+	std::vector<scene::INodePtr>& primitives)
 {
-	auto childNodes = primitivesNode.getChildren();
-	
-	for (const auto childNode : childNodes)
+	// Each primitive tag is expanded and turned into a scene node right away
+	bool hasChildren = !reader.isEmptyElement();
+
+	while (hasChildren && reader.next() && !reader.isEndElement())
 	{
-		const std::string name = childNode.getName();
+		const auto name = reader.getName();
+		auto childNode = reader.expand();
 
-		if (name == TAG_BRUSH)
+		try
 		{
-			readBrush(childNode, entity);
+			if (name == TAG_BRUSH)
+			{
+				primitives.push_back(readBrush(childNode, entityNumber));
+			}
+			else if (name == TAG_PATCH)
+			{
+				primitives.push_back(readPatch(childNode));
+			}
 		}
-		else if (name == TAG_PATCH)
+		catch (const BadDocumentFormatException& ex)
 		{
-			readPatch(childNode, entity);
+			rError() << "PortableMapReader: Entity " << entityNumber << ": " << ex.what() << std::endl;
 		}
+
+		reader.skipSubtree();
 	}
 }
 
-void PortableMapReader::readBrush(const xml::Node& brushTag, const scene::INodePtr& entity)
+scene::INodePtr PortableMapReader::readBrush(const xml::Node& brushTag, const std::string& entityNumber)
 {
 	// Create a new brush
 	auto node = GlobalBrushCreator().createBrush();
@@ -290,7 +385,7 @@ void PortableMapReader::readBrush(const xml::Node& brushTag, const scene::INodeP
 		}
 		catch (const BadDocumentFormatException& ex)
 		{
-			rError() << "PortableMapReader: Entity " << entity->name() << ", Brush " << 
+			rError() << "PortableMapReader: Entity " << entityNumber << ", Brush " << 
 				brushTag.getAttributeValue(ATTR_BRUSH_NUMBER) << ": " << ex.what() << std::endl;
 		}
 	}
@@ -298,14 +393,14 @@ void PortableMapReader::readBrush(const xml::Node& brushTag, const scene::INodeP
     // Cleanup redundant face planes
     brush.removeRedundantFaces();
 
-	_importFilter.addPrimitiveToEntity(node, entity);
-
 	readLayerInformation(brushTag, node);
 	readSelectionGroupInformation(brushTag, node);
 	readSelectionSetInformation(brushTag, node);
+
+	return node;
 }
 
-void PortableMapReader::readPatch(const xml::Node& patchTag, const scene::INodePtr& entity)
+scene::INodePtr PortableMapReader::readPatch(const xml::Node& patchTag)
 {
 	bool isFixedSubdiv = patchTag.getAttributeValue(ATTR_PATCH_FIXED_SUBDIV) == ATTR_VALUE_TRUE;
 
@@ -356,14 +451,14 @@ void PortableMapReader::readPatch(const xml::Node& patchTag, const scene::INodeP
 
 	patch.controlPointsChanged();
 
-	_importFilter.addPrimitiveToEntity(node, entity);
-
 	readLayerInformation(patchTag, node);
 	readSelectionGroupInformation(patchTag, node);
 	readSelectionSetInformation(patchTag, node);
+
+	return node;
 }
 
-void PortableMapReader::readEntity(const xml::Node& entityTag)
+scene::INodePtr PortableMapReader::createEntity(const xml::Node& entityTag)
 {
 	std::map<std::string, std::string> entityKeyValues{};
 
@@ -412,14 +507,7 @@ void PortableMapReader::readEntity(const xml::Node& entityTag)
 
 	_importFilter.addEntity(entityNode);
 
-	try
-	{
-		readPrimitives(getNamedChild(entityTag, TAG_ENTITY_PRIMITIVES), entityNode);
-	}
-	catch (const BadDocumentFormatException & ex)
-	{
-		rError() << "PortableMapReader: Entity " << entityNode->name() << ": " << ex.what() << std::endl;
-	}
+	return entityNode;
 }
 
 void PortableMapReader::readLayerInformation(const xml::Node& tag, const scene::INodePtr& sceneNode)
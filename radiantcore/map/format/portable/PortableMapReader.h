@@ -1,12 +1,13 @@
 #pragma once
 
 #include <map>
+#include <vector>
 #include "inode.h"
 #include "imapformat.h"
 #include "iselectionset.h"
 #include "parser/DefTokeniser.h"
 
-namespace xml { class Node; }
+namespace xml { class Node; class StreamReader; }
 
 namespace map 
 {
@@ -14,6 +15,11 @@ namespace map
 namespace format
 {
 
+/**
+ * Reads the XML-based portable map format. The file is parsed as a stream,
+ * primitives are created while their tags are read, such that the XML
+ * representation of the whole map never needs to be held in memory.
+ */
 class PortableMapReader :
 	public IMapReader
 {
@@ -41,15 +47,17 @@ public:
 	static bool CanLoad(std::istream& stream);
 
 private:
+	void readMap(xml::StreamReader& reader);
+	void readMapHeader(const xml::Node& mapNode);
 	void readLayers(const xml::Node& mapNode);
 	void readSelectionGroups(const xml::Node& mapNode);
 	void readSelectionSets(const xml::Node& mapNode);
 	void readMapProperties(const xml::Node& mapNode);
-	void readEntities(const xml::Node& mapNode);
-	void readEntity(const xml::Node& entityNode);
-	void readPrimitives(const xml::Node& primitivesNode, const scene::INodePtr& entity);
-	void readBrush(const xml::Node& brushNode, const scene::INodePtr& entity);
-	void readPatch(const xml::Node& patchNode, const scene::INodePtr& entity);
+	void readEntity(xml::StreamReader& reader);
+	scene::INodePtr createEntity(const xml::Node& entityNode);
+	void readPrimitives(xml::StreamReader& reader, const std::string& entityNumber, std::vector<scene::INodePtr>& primitives);
+	scene::INodePtr readBrush(const xml::Node& brushNode, const std::string& entityNumber);
+	scene::INodePtr readPatch(const xml::Node& patchNode);
 	void readLayerInformation(const xml::Node& parentTag, const scene::INodePtr& sceneNode);
 	void readSelectionGroupInformation(const xml::Node& parentTag, const scene::INodePtr& sceneNode);
 	void readSelectionSetInformation(const xml::Node& parentTag, const scene::INodePtr& sceneNode);
@@ -3,7 +3,8 @@
 #include "imapformat.h"
 #include "iselectionset.h"
 
-#include "xmlutil/Document.h"
+#include <memory>
+#include "xmlutil/StreamWriter.h"
 
 namespace map
 {
@@ -13,6 +14,8 @@ namespace format
 
 /**
  * Exporter class writing the map data into an XML-based file format.
+ * The XML is written to the stream while the map is traversed,
+ * each primitive is passed on as soon as it has been visited.
  */
 class PortableMapWriter :
 	public IMapWriter
@@ -22,10 +25,7 @@ protected:
 	std::size_t _entityCount;
 	std::size_t _primitiveCount;
 
-	xml::Document _document;
-
-	xml::Node _map;
-	xml::Node _curEntityPrimitives;
+	std::unique_ptr<xml::StreamWriter> _writer;
 
 	struct SelectionSetExportInfo
 	{
@@ -58,9 +58,9 @@ public:
 	virtual void endWritePatch(const IPatchNodePtr& patch, std::ostream& stream) override;
 
 private:
-	void appendLayerInformation(xml::Node& xmlNode, const scene::INodePtr& sceneNode);
-	void appendSelectionGroupInformation(xml::Node& xmlNode, const scene::INodePtr& sceneNode);
-	void appendSelectionSetInformation(xml::Node& xmlNode, const scene::INodePtr& sceneNode);
+	void appendLayerInformation(const scene::INodePtr& sceneNode);
+	void appendSelectionGroupInformation(const scene::INodePtr& sceneNode);
+	void appendSelectionSetInformation(const scene::INodePtr& sceneNode);
 };
 
 }
@@ -11,6 +11,7 @@ namespace map
 {
 
 const char* const InfoFile::HEADER_SEQUENCE = "DarkRadiant Map Information File Version";
+std::mutex InfoFile::ModuleMutex;
 
 // Pass the input stream to the constructor
 InfoFile::InfoFile(std::istream& infoStream, const scene::IMapRootNodePtr& root, const NodeIndexMap& nodeMap) :
@@ -22,6 +23,8 @@ InfoFile::InfoFile(std::istream& infoStream, const scene::IMapRootNodePtr& root,
 
 void InfoFile::parse()
 {
+	std::lock_guard<std::mutex> lock(ModuleMutex);
+
 	// Initialise the modules
 	GlobalMapInfoFileManager().foreachModule([](IMapInfoFileModule& module)
 	{
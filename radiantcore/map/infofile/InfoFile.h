@@ -3,6 +3,7 @@
 #include "imap.h"
 #include "imapinfofile.h"
 #include "parser/DefTokeniser.h"
+#include <mutex>
 
 namespace map
 {
@@ -17,6 +18,10 @@ public:
 	// InfoFile tokens --------------------------------------------------
 	static const char* const HEADER_SEQUENCE;
 
+	// The info file modules keep the state of a single import or export,
+	// this mutex is held while they are in use (exports can run on worker threads)
+	static std::mutex ModuleMutex;
+
 private:
 	// The actual DefTokeniser to split the infoStream into pieces
 	parser::BasicDefTokeniser<std::istream> _tok;
@@ -8,7 +8,8 @@ namespace map
 {
 
 InfoFileExporter::InfoFileExporter(std::ostream& stream) :
-    _stream(stream)
+    _stream(stream),
+    _moduleLock(InfoFile::ModuleMutex)
 {
 	GlobalMapInfoFileManager().foreachModule([](IMapInfoFileModule& module)
 	{
@@ -5,6 +5,7 @@
 #include "inode.h"
 #include "imap.h"
 #include <map>
+#include <mutex>
 
 namespace map
 {
@@ -15,6 +16,9 @@ private:
 	// The stream we're writing to
 	std::ostream& _stream;
 
+	// Keeps other threads away from the info file modules until we're done
+	std::unique_lock<std::mutex> _moduleLock;
+
 public:
 	// The constructor prepares the output stream
 	InfoFileExporter(std::ostream& stream);
@@ -1,6 +1,7 @@
 #include "ComplexName.h"
 
 #include <climits>
+#include <iterator>
 #include "string/trim.h"
 #include "string/convert.h"
 
@@ -25,33 +26,170 @@ std::string ComplexName::getFullname() const
 
 namespace
 {
-    // Find the first integer not in the given set
-    std::string findFirstUnusedNumber(const PostfixSet& set)
+    constexpr int LOWEST_NUMBER = 1;
+
+    // Returns the number represented by the given postfix, or -1 if the postfix
+    // is not the canonical string form of a number in [1..INT_MAX)
+    int getCanonicalNumber(const std::string& postfix)
     {
-        static const int LOWEST_VAL = 1;
+        // Leading zeros are not canonical, also reject anything exceeding int range
+        if (postfix.empty() || postfix.size() > 10 || postfix[0] < '1' || postfix[0] > '9')
+        {
+            return -1;
+        }
 
-        for (int i = LOWEST_VAL; i < INT_MAX; ++i)
+        long long value = 0;
+
+        for (auto c : postfix)
         {
-			std::string testPostfix = string::to_string(i);
+            if (c < '0' || c > '9') return -1;
+
+            value = value * 10 + (c - '0');
+        }
+
+        return value < INT_MAX ? static_cast<int>(value) : -1;
+    }
+}
+
+bool PostfixSet::insert(const std::string& postfix)
+{
+    if (!_postfixes.insert(postfix).second)
+    {
+        return false;
+    }
+
+    auto number = getCanonicalNumber(postfix);
+
+    if (number >= LOWEST_NUMBER)
+    {
+        occupyNumber(number);
+    }
+
+    return true;
+}
 
-            if (set.find(testPostfix) == set.end())
+bool PostfixSet::erase(const std::string& postfix)
+{
+    if (_postfixes.erase(postfix) == 0)
+    {
+        return false;
+    }
+
+    auto number = getCanonicalNumber(postfix);
+
+    if (number >= LOWEST_NUMBER)
+    {
+        releaseNumber(number);
+    }
+
+    return true;
+}
+
+void PostfixSet::merge(const PostfixSet& other)
+{
+    for (const auto& postfix : other._postfixes)
+    {
+        insert(postfix);
+    }
+}
+
+int PostfixSet::findFirstUnusedNumber() const
+{
+    // The first range needs to start at the lowest number, otherwise that one is free
+    if (_usedNumbers.empty() || _usedNumbers.begin()->first > LOWEST_NUMBER)
+    {
+        return LOWEST_NUMBER;
+    }
+
+    // Ranges never touch, so the number following the first range is unused
+    // In the pathological case of all numbers being used this returns INT_MAX
+    return _usedNumbers.begin()->second + 1;
+}
+
+void PostfixSet::occupyNumber(int number)
+{
+    // The first range starting after the number
+    auto next = _usedNumbers.upper_bound(number);
+
+    bool joinsNext = next != _usedNumbers.end() && next->first == number + 1;
+
+    if (next != _usedNumbers.begin())
+    {
+        auto prev = std::prev(next);
+
+        if (prev->second >= number)
+        {
+            return; // already covered
+        }
+
+        if (prev->second == number - 1)
+        {
+            // Extend the previous range, swallowing the next one if it's adjacent
+            prev->second = joinsNext ? next->second : number;
+
+            if (joinsNext)
             {
-                // Found an unused value
-                return testPostfix;
+                _usedNumbers.erase(next);
             }
+
+            return;
         }
+    }
+
+    if (joinsNext)
+    {
+        // Move the start of the next range down by one
+        auto last = next->second;
+        _usedNumbers.erase(next);
+        _usedNumbers.emplace(number, last);
+        return;
+    }
 
-        // Pathological case, could not find a value
-        return string::to_string(INT_MAX);
+    _usedNumbers.emplace(number, number);
+}
+
+void PostfixSet::releaseNumber(int number)
+{
+    auto range = _usedNumbers.upper_bound(number);
+
+    if (range == _usedNumbers.begin())
+    {
+        return; // not occupied
+    }
+
+    --range;
+
+    auto first = range->first;
+    auto last = range->second;
+
+    if (last < number)
+    {
+        return; // not occupied
+    }
+
+    if (first == number)
+    {
+        _usedNumbers.erase(range);
+    }
+    else
+    {
+        // Cut off the part starting at the number
+        range->second = number - 1;
+    }
+
+    // Re-add the part above the number, if any
+    if (last > number)
+    {
+        _usedNumbers.emplace(number + 1, last);
     }
 }
 
 std::string ComplexName::makePostfixUnique(const PostfixSet& postfixes)
 {
     // If our postfix is already in the set, change it to a unique value
-    if (postfixes.find(_postFix) != postfixes.end())
+    if (postfixes.contains(_postFix))
     {
-        _postFix = findFirstUnusedNumber(postfixes);
+        _postFix = string::to_string(postfixes.findFirstUnusedNumber());
     }
 
     return _postFix;
@@ -2,9 +2,68 @@
 
 #include <string>
 #include <set>
+#include <map>
 
-/// Set of unique postfixes, e.g. "1", "6" or "04"
-typedef std::set<std::string> PostfixSet;
+/**
+ * Set of unique postfixes, e.g. "1", "6" or "04".
+ *
+ * Next to the postfix strings this keeps track of the numbers in use as
+ * a list of occupied intervals, such that the lowest unused number can be
+ * looked up in logarithmic time. Only canonical postfixes like "4" occupy
+ * a number, "04" doesn't prevent "4" from being handed out.
+ */
+class PostfixSet
+{
+    std::set<std::string> _postfixes;
+
+    // Occupied number ranges, first => last (inclusive).
+    // The ranges never overlap or touch each other.
+    std::map<int, int> _usedNumbers;
+
+public:
+    typedef std::set<std::string>::const_iterator const_iterator;
+
+    bool empty() const
+    {
+        return _postfixes.empty();
+    }
+
+    std::size_t size() const
+    {
+        return _postfixes.size();
+    }
+
+    const_iterator begin() const
+    {
+        return _postfixes.begin();
+    }
+
+    const_iterator end() const
+    {
+        return _postfixes.end();
+    }
+
+    bool contains(const std::string& postfix) const
+    {
+        return _postfixes.count(postfix) > 0;
+    }
+
+    /// Adds the postfix, returns false if it was already present
+    bool insert(const std::string& postfix);
+
+    /// Removes the postfix, returns false if it wasn't present
+    bool erase(const std::string& postfix);
+
+    /// Adds all postfixes of the other set to this one
+    void merge(const PostfixSet& other);
+
+    /// Returns the lowest number >= 1 which is not in use
+    int findFirstUnusedNumber() const;
+
+private:
+    void occupyNumber(int number);
+    void releaseNumber(int number);
+};
 
 /// Name consisting of initial text and optional unique-making number-postfix 
 /// e.g. "Carl" + "6", or "Mary" + "03"
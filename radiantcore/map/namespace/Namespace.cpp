@@ -286,34 +286,48 @@ void Namespace::ensureNoConflicts(const scene::INodePtr& foreignRoot, const std:
     UniqueNameSet allNames = _uniqueNames;
     allNames.merge(foreignNamespace._uniqueNames);
 
+    // The renames are collected first and applied in one go afterwards
+    std::vector<std::pair<NamespacedPtr, std::string>> renames;
+
     // Process each object in the to-be-imported tree of nodes, ensuring that it
     // has a unique name
     for (const auto& foreignNode : foreignNodes)
     {
+        const auto& name = foreignNode->getName();
+
         // If the imported node conflicts with a name in THIS namespace, then it
         // needs to be given a new name which is unique in BOTH namespaces.
-        if (_uniqueNames.nameExists(foreignNode->getName()))
+        if (_uniqueNames.nameExists(name))
         {
-            // Name exists in the target namespace, get a new name
-            std::string uniqueName = allNames.insertUnique(foreignNode->getName());
-
-            rMessage() << "Namespace::ensureNoConflicts(): '" << foreignNode->getName()
-                << "' already exists in this namespace. Rename it to '"
-                << uniqueName << "'\n";
-
-            // Change the name of the imported node, this should trigger all
-            // observers in the foreign namespace
-            foreignNode->changeName(uniqueName);
+            // Name exists in the target namespace, reserve a new name
+            renames.emplace_back(foreignNode, allNames.insertUnique(name));
         }
         else
         {
             // Name does not exist yet, insert it into the local combined
             // namespace (but not our destination namespace, this will be
             // populated in the subsequent call to connect()).
-            allNames.insert(foreignNode->getName());
+            allNames.insert(name);
         }
     }
 
+    for (const auto& [foreignNode, uniqueName] : renames)
+    {
+        rDebug() << "Namespace::ensureNoConflicts(): '" << foreignNode->getName()
+            << "' already exists in this namespace. Rename it to '"
+            << uniqueName << "'\n";
+
+        // Change the name of the imported node, this should trigger all
+        // observers in the foreign namespace
+        foreignNode->changeName(uniqueName);
+    }
+
+    if (!renames.empty())
+    {
+        rMessage() << "Namespace::ensureNoConflicts(): renamed " << renames.size()
+            << " conflicting names" << std::endl;
+    }
+
     // at this point, all names in the foreign namespace have been converted to
     // something unique in this namespace. The calling code can now move the
     // nodes into this namespace without name conflicts
@@ -133,6 +133,27 @@ void MD5Anim::parseFrame(std::size_t frame, parser::DefTokeniser& tok)
 	tok.assertNextToken("}");
 }
 
+MD5Anim::PosePtr MD5Anim::getFramePose(std::size_t frame) const
+{
+	std::lock_guard<std::mutex> lock(_framePoseLock);
+
+	return frame < _framePoses.size() ? _framePoses[frame] : PosePtr();
+}
+
+void MD5Anim::storeFramePose(std::size_t frame, const PosePtr& pose) const
+{
+	std::lock_guard<std::mutex> lock(_framePoseLock);
+
+	if (frame >= _frames.size()) return;
+
+	if (_framePoses.size() != _frames.size())
+	{
+		_framePoses.resize(_frames.size());
+	}
+
+	_framePoses[frame] = pose;
+}
+
 void MD5Anim::parseFromStream(std::istream& stream)
 {
 	parser::BasicDefTokeniser<std::istream> tokeniser(stream);
@@ -2,10 +2,12 @@
 
 #include "imd5anim.h"
 #include <vector>
+#include <mutex>
 #include "parser/DefTokeniser.h"
 #include "math/AABB.h"
 #include "math/Vector3.h"
 #include "math/Quaternion.h"
+#include "MD5Skinning.h"
 
 namespace md5
 {
@@ -15,6 +17,15 @@ class MD5AnimTokeniser;
 class MD5Anim :
 	public IMD5Anim
 {
+public:
+	// The fully evaluated joint hierarchy at a given point in time
+	struct Pose
+	{
+		std::vector<IMD5Anim::Key> keys;
+		JointTransforms transforms;
+	};
+	typedef std::shared_ptr<const Pose> PosePtr;
+
 private:
 	// The command line used to export this md5anim def
 	std::string _commandLine;
@@ -34,6 +45,11 @@ private:
 	// Each frame has <numAnimatedComponents> float values
 	std::vector<FrameKeys> _frames;
 
+	// Poses evaluated at exact frame times, shared by all skeletons
+	// playing this anim. Filled on demand, one slot per frame.
+	mutable std::mutex _framePoseLock;
+	mutable std::vector<PosePtr> _framePoses;
+
 public:
 	MD5Anim();
 
@@ -72,6 +88,12 @@ public:
 		return _frames[index];
 	}
 
+	// Returns the cached pose of the given frame, or an empty pointer if it hasn't been evaluated yet
+	PosePtr getFramePose(std::size_t frame) const;
+
+	// Stores the evaluated pose of the given frame, to be re-used by subsequent skeleton updates
+	void storeFramePose(std::size_t frame, const PosePtr& pose) const;
+
 	void parseFromStream(std::istream& stream);
 
 private:
@@ -12,7 +12,8 @@ class MD5AnimationCache :
 	public IAnimationCache
 {
 private:
-	// The path => anim mapping
+	// The path => anim mapping. Each anim holds the poses evaluated
+	// at its frame times, these are kept alive along with the anim.
 	typedef std::map<std::string, MD5AnimPtr> AnimationMap;
 	AnimationMap _animations;
 
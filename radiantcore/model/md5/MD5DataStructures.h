@@ -77,6 +77,24 @@ struct MD5Weight
 
 typedef std::vector<MD5Weight> MD5Weights;
 
+/**
+ * The weights of a mesh flattened into separate arrays, ordered by vertex.
+ * The weights of vertex i are found in [vertexOffsets[i]..vertexOffsets[i+1]).
+ * This is the layout the skinning kernel is iterating over.
+ */
+struct MD5WeightStreams
+{
+	std::vector<std::size_t> vertexOffsets;
+	std::vector<std::size_t> joints;
+	std::vector<double> weights;
+	std::vector<double> x;
+	std::vector<double> y;
+	std::vector<double> z;
+
+	// The highest referenced joint index + 1
+	std::size_t numJoints = 0;
+};
+
 // The combination of vertices, triangles and weighting information
 // represents our MD5 mesh - using this info it's possible to create
 // the actual rendered geometry (position, normals, etc.)
@@ -85,6 +103,9 @@ struct MD5Mesh
 	MD5Verts	vertices;
 	MD5Tris		triangles;
 	MD5Weights	weights;
+
+	// Derived from vertices and weights after parsing
+	MD5WeightStreams weightStreams;
 };
 typedef std::shared_ptr<MD5Mesh> MD5MeshPtr;
 
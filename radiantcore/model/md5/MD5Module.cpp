@@ -1,4 +1,5 @@
 #include "imodule.h"
+#include "ijobsystem.h"
 
 #include "MD5ModelLoader.h"
 #include "MD5AnimationCache.h"
@@ -26,6 +27,7 @@ public:
 		if (_dependencies.empty())
 		{
 			_dependencies.insert(MODULE_MODELFORMATMANAGER);
+			_dependencies.insert(MODULE_JOBSYSTEM);
 		}
 
 		return _dependencies;
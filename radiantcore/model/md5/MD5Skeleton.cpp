@@ -1,6 +1,7 @@
 #include "MD5Skeleton.h"
 
 #include <cstdlib>
+#include "MD5Anim.h"
 
 namespace md5
 {
@@ -91,6 +92,24 @@ void MD5Skeleton::update(const IMD5AnimPtr& anim, std::size_t time)
 	std::size_t curFrame = static_cast<std::size_t>(std::floor(frameTime)) % _anim->getNumFrames();
 	std::size_t nextFrame = curFrame == _anim->getNumFrames() -1 ? curFrame : (curFrame + 1) % _anim->getNumFrames();
 
+	// Poses at exact frame times are evaluated once per anim and shared,
+	// which is what happens when scrubbing through the frames or when many
+	// models are showing the same anim at time 0
+	auto md5Anim = dynamic_cast<const MD5Anim*>(_anim.get());
+	bool isFramePose = md5Anim != nullptr && nextFrameFrac == 0;
+
+	if (isFramePose)
+	{
+		auto pose = md5Anim->getFramePose(curFrame);
+
+		if (pose && pose->keys.size() == numJoints)
+		{
+			_skeleton = pose->keys;
+			_jointTransforms = pose->transforms;
+			return;
+		}
+	}
+
 	// Apply the current frame keys to the base frame
 	for (std::size_t i = 0; i < numJoints; ++i)
 	{
@@ -178,6 +197,23 @@ void MD5Skeleton::update(const IMD5AnimPtr& anim, std::size_t time)
 			updateJointRecursively(i);
 		}
 	}
+
+	updateJointTransforms();
+
+	if (isFramePose)
+	{
+		md5Anim->storeFramePose(curFrame, std::make_shared<MD5Anim::Pose>(MD5Anim::Pose{ _skeleton, _jointTransforms }));
+	}
+}
+
+void MD5Skeleton::updateJointTransforms()
+{
+	_jointTransforms.resize(_skeleton.size());
+
+	for (std::size_t i = 0; i < _skeleton.size(); ++i)
+	{
+		_jointTransforms[i].set(_skeleton[i].orientation, _skeleton[i].origin);
+	}
 }
 
 void MD5Skeleton::updateJointRecursively(std::size_t jointId)
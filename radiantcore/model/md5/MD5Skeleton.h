@@ -2,6 +2,7 @@
 
 #include <vector>
 #include "imd5anim.h"
+#include "MD5Skinning.h"
 
 namespace md5
 {
@@ -17,6 +18,9 @@ protected:
 	// The position and orientation of the animated joints at the current time
 	std::vector<IMD5Anim::Key> _skeleton;
 
+	// The keys above baked into matrices, as consumed by the skinning code
+	JointTransforms _jointTransforms;
+
 	// The current animation, needed to get joint information etc.
 	IMD5AnimPtr _anim;
 
@@ -34,6 +38,11 @@ public:
 		return _skeleton[jointIndex];
 	}
 
+	const JointTransforms& getJointTransforms() const
+	{
+		return _jointTransforms;
+	}
+
 	const Joint& getJoint(std::size_t index) const
 	{
 		return _anim->getJoint(index);
@@ -41,6 +50,7 @@ public:
 
 private:
 	void updateJointRecursively(std::size_t jointId);
+	void updateJointTransforms();
 };
 
 } // namespace
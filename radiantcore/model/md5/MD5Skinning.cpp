@@ -0,0 +1,167 @@
+#include "MD5Skinning.h"
+
+#include <cassert>
+#include <algorithm>
+#include "util/ParallelFor.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MD5_SKINNING_SSE2
+#endif
+
+namespace md5
+{
+
+namespace
+{
+    // Below this amount of vertices it's not worth spawning a thread
+    constexpr std::size_t MinVerticesPerBatch = 4096;
+
+    void skinVertexRange(const MD5WeightStreams& streams, const JointTransforms& joints,
+        std::vector<MeshVertex>& vertices, std::size_t begin, std::size_t end)
+    {
+        for (auto v = begin; v < end; ++v)
+        {
+            auto first = streams.vertexOffsets[v];
+            auto last = streams.vertexOffsets[v + 1];
+
+#ifdef MD5_SKINNING_SSE2
+            // The xy components are processed in one register, z in the lower half of another
+            auto xy = _mm_setzero_pd();
+            auto z = _mm_setzero_pd();
+
+            for (auto w = first; w < last; ++w)
+            {
+                const auto& m = joints[streams.joints[w]].columns;
+
+                auto wx = _mm_set1_pd(streams.x[w]);
+                auto wy = _mm_set1_pd(streams.y[w]);
+                auto wz = _mm_set1_pd(streams.z[w]);
+                auto t = _mm_set1_pd(streams.weights[w]);
+
+                auto pointXY = _mm_add_pd(_mm_add_pd(_mm_add_pd(
+                    _mm_mul_pd(_mm_load_pd(m[0]), wx),
+                    _mm_mul_pd(_mm_load_pd(m[1]), wy)),
+                    _mm_mul_pd(_mm_load_pd(m[2]), wz)),
+                    _mm_load_pd(m[3]));
+
+                auto pointZ = _mm_add_pd(_mm_add_pd(_mm_add_pd(
+                    _mm_mul_pd(_mm_load_pd(m[0] + 2), wx),
+                    _mm_mul_pd(_mm_load_pd(m[1] + 2), wy)),
+                    _mm_mul_pd(_mm_load_pd(m[2] + 2), wz)),
+                    _mm_load_pd(m[3] + 2));
+
+                xy = _mm_add_pd(xy, _mm_mul_pd(pointXY, t));
+                z = _mm_add_pd(z, _mm_mul_pd(pointZ, t));
+            }
+
+            alignas(16) double result[4];
+            _mm_store_pd(result, xy);
+            _mm_store_pd(result + 2, z);
+
+            Vector3 skinned(result[0], result[1], result[2]);
+#else
+            Vector3 skinned(0, 0, 0);
+
+            for (auto w = first; w < last; ++w)
+            {
+                const auto& joint = joints[streams.joints[w]];
+                skinned += joint.transformPoint(Vector3(streams.x[w], streams.y[w], streams.z[w])) * streams.weights[w];
+            }
+#endif
+            auto& vertex = vertices[v];
+
+            vertex.vertex = skinned;
+            vertex.normal = Normal3(0, 0, 0);
+            vertex.tangent = Normal3(0, 0, 0);
+            vertex.bitangent = Normal3(0, 0, 0);
+        }
+    }
+}
+
+void JointTransform::set(const Quaternion& orientation, const Vector3& origin)
+{
+    double x = orientation.x();
+    double y = orientation.y();
+    double z = orientation.z();
+    double w = orientation.w();
+
+    double xx = x * x;
+    double yy = y * y;
+    double zz = z * z;
+    double ww = w * w;
+
+    double xy2 = x * y * 2;
+    double xz2 = x * z * 2;
+    double xw2 = x * w * 2;
+    double yz2 = y * z * 2;
+    double yw2 = y * w * 2;
+    double zw2 = z * w * 2;
+
+    // Image of the X axis
+    columns[0][0] = ww + xx - zz - yy;
+    columns[0][1] = xy2 + zw2;
+    columns[0][2] = xz2 - yw2;
+    columns[0][3] = 0;
+
+    // Image of the Y axis
+    columns[1][0] = xy2 - zw2;
+    columns[1][1] = yy - zz + ww - xx;
+    columns[1][2] = yz2 + xw2;
+    columns[1][3] = 0;
+
+    // Image of the Z axis
+    columns[2][0] = yw2 + xz2;
+    columns[2][1] = yz2 - xw2;
+    columns[2][2] = zz - yy - xx + ww;
+    columns[2][3] = 0;
+
+    columns[3][0] = origin.x();
+    columns[3][1] = origin.y();
+    columns[3][2] = origin.z();
+    columns[3][3] = 0;
+}
+
+void buildWeightStreams(MD5Mesh& mesh)
+{
+    auto& streams = mesh.weightStreams;
+
+    streams = MD5WeightStreams();
+    streams.vertexOffsets.reserve(mesh.vertices.size() + 1);
+    streams.vertexOffsets.push_back(0);
+
+    for (const auto& vert : mesh.vertices)
+    {
+        for (std::size_t k = 0; k < vert.weight_count && vert.weight_index + k < mesh.weights.size(); ++k)
+        {
+            const auto& weight = mesh.weights[vert.weight_index + k];
+
+            streams.joints.push_back(weight.joint);
+            streams.numJoints = std::max(streams.numJoints, weight.joint + 1);
+            streams.weights.push_back(weight.t);
+            streams.x.push_back(weight.v.x());
+            streams.y.push_back(weight.v.y());
+            streams.z.push_back(weight.v.z());
+        }
+
+        streams.vertexOffsets.push_back(streams.joints.size());
+    }
+}
+
+bool skinVertices(const MD5WeightStreams& streams, const JointTransforms& joints,
+    std::vector<MeshVertex>& vertices)
+{
+    assert(streams.vertexOffsets.size() == vertices.size() + 1);
+
+    // A skeleton not matching the mesh leaves the vertices alone
+    if (joints.size() < streams.numJoints) return false;
+
+    util::parallelFor(vertices.size(), MinVerticesPerBatch, [&](std::size_t begin, std::size_t end)
+    {
+        skinVertexRange(streams, joints, vertices, begin, end);
+    });
+
+    return true;
+}
+
+}
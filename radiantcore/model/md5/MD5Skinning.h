@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+#include "math/Vector3.h"
+#include "math/Quaternion.h"
+#include "render/MeshVertex.h"
+#include "MD5DataStructures.h"
+
+namespace md5
+{
+
+/**
+ * A joint orientation and origin baked into a 3x4 matrix, ready to be
+ * applied to the weight offsets during skinning. The four columns hold the
+ * rotated X, Y, Z axes and the translation, each padded to four doubles
+ * such that the kernel can load them in aligned pairs.
+ */
+struct alignas(16) JointTransform
+{
+    double columns[4][4];
+
+    // Bakes the given orientation and origin. This is the matrix form of
+    // Quaternion::transformPoint(), it doesn't require a unit quaternion.
+    void set(const Quaternion& orientation, const Vector3& origin);
+
+    Vector3 transformPoint(const Vector3& point) const
+    {
+        return Vector3(
+            columns[0][0] * point.x() + columns[1][0] * point.y() + columns[2][0] * point.z() + columns[3][0],
+            columns[0][1] * point.x() + columns[1][1] * point.y() + columns[2][1] * point.z() + columns[3][1],
+            columns[0][2] * point.x() + columns[1][2] * point.y() + columns[2][2] * point.z() + columns[3][2]
+        );
+    }
+};
+typedef std::vector<JointTransform> JointTransforms;
+
+// Builds the weight streams of the given mesh from its vertex and weight arrays
+void buildWeightStreams(MD5Mesh& mesh);
+
+/**
+ * Calculates the skinned position of every mesh vertex using the given
+ * joint transforms, writing the result into the vertex array (which must
+ * be sized to match the mesh). Normals and tangent vectors of the written
+ * vertices are reset to zero, texcoords are left untouched.
+ * Returns false without touching the vertices if the transforms don't cover
+ * all joints referenced by the mesh.
+ */
+bool skinVertices(const MD5WeightStreams& streams, const JointTransforms& joints,
+    std::vector<MeshVertex>& vertices);
+
+}
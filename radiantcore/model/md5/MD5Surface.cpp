@@ -3,6 +3,7 @@
 #include "ivolumetest.h"
 #include "string/convert.h"
 #include "MD5Model.h"
+#include "MD5Skinning.h"
 #include "math/Ray.h"
 
 namespace md5
@@ -182,70 +183,38 @@ const AABB& MD5Surface::getSurfaceBounds() const
 
 void MD5Surface::updateToDefaultPose(const MD5Joints& joints)
 {
-	if (_vertices.size() != _mesh->vertices.size())
-	{
-		_vertices.resize(_mesh->vertices.size());
-	}
+	JointTransforms transforms(joints.size());
 
-	for (std::size_t j = 0; j < _mesh->vertices.size(); ++j)
-	{
-		MD5Vert& vert = _mesh->vertices[j];
-
-		Vector3 skinned(0, 0, 0);
-
-		for (std::size_t k = 0; k != vert.weight_count; ++k)
-		{
-			MD5Weight& weight = _mesh->weights[vert.weight_index + k];
-			const MD5Joint& joint = joints[weight.joint];
-
-			Vector3 rotatedPoint = joint.rotation.transformPoint(weight.v);
-			skinned += (rotatedPoint + joint.position) * weight.t;
-		}
-
-		_vertices[j].vertex = skinned;
-		_vertices[j].texcoord = TexCoord2f(vert.u, vert.v);
-		_vertices[j].normal = Normal3(0,0,0);
-	}
-
-	// Ensure the index array is ok
-	if (_indices.empty())
+	for (std::size_t i = 0; i < joints.size(); ++i)
 	{
-		buildIndexArray();
+		transforms[i].set(joints[i].rotation, joints[i].position);
 	}
 
-	buildVertexNormals();
-
-	updateGeometry();
+	updateToPose(transforms);
 }
 
 void MD5Surface::updateToSkeleton(const MD5Skeleton& skeleton)
 {
-	// Ensure we have all vertices allocated
+	updateToPose(skeleton.getJointTransforms());
+}
+
+void MD5Surface::updateToPose(const JointTransforms& transforms)
+{
+	// Ensure we have all vertices allocated, the texcoords don't change between poses
 	if (_vertices.size() != _mesh->vertices.size())
 	{
 		_vertices.resize(_mesh->vertices.size());
-	}
 
-	// Deform vertices to fit the skeleton
-	for (std::size_t j = 0; j < _mesh->vertices.size(); ++j)
-	{
-		MD5Vert& vert = _mesh->vertices[j];
-
-		Vector3 skinned(0, 0, 0);
-
-		for (std::size_t k = 0; k != vert.weight_count; ++k)
+		for (std::size_t j = 0; j < _mesh->vertices.size(); ++j)
 		{
-			MD5Weight& weight = _mesh->weights[vert.weight_index + k];
-			const IMD5Anim::Key& key = skeleton.getKey(weight.joint);
-			//const Joint& joint = skeleton.getJoint(weight.joint);
-
-			Vector3 rotatedPoint = key.orientation.transformPoint(weight.v);
-			skinned += (rotatedPoint + key.origin) * weight.t;
+			_vertices[j].texcoord = TexCoord2f(_mesh->vertices[j].u, _mesh->vertices[j].v);
 		}
+	}
 
-		_vertices[j].vertex = skinned;
-		_vertices[j].texcoord = TexCoord2f(vert.u, vert.v);
-		_vertices[j].normal = Normal3(0,0,0);
+	// Deform vertices to fit the pose
+	if (!skinVertices(_mesh->weightStreams, transforms, _vertices))
+	{
+		return;
 	}
 
 	// Ensure the index array is ok
@@ -388,6 +357,9 @@ void MD5Surface::parseFromTokens(parser::DefTokeniser& tok)
 	// ----- END OF MESH DECL -----
 
 	tok.assertNextToken("}");
+
+	// Flatten the weights for the skinning kernel, the mesh doesn't change after this point
+	buildWeightStreams(mesh);
 }
 
 } // namespace
@@ -9,6 +9,7 @@
 #include "imodelsurface.h"
 
 #include "MD5DataStructures.h"
+#include "MD5Skinning.h"
 #include "parser/DefTokeniser.h"
 
 class Ray;
@@ -95,6 +96,9 @@ public:
 	void buildIndexArray();
 
 private:
+    // Skins the vertices using the given joint transforms, then updates normals and tangents
+    void updateToPose(const JointTransforms& transforms);
+
     // Re-calculate the normal vectors
     void buildVertexNormals();
 };
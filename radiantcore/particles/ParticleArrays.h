@@ -0,0 +1,93 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+namespace particles
+{
+
+/**
+ * Structure-of-arrays working set used to simulate all live particles
+ * of a bunch in one go. Every attribute lives in its own contiguous array,
+ * such that each simulation pass is a tight loop over a few attributes.
+ *
+ * The arrays are owned by the RenderableParticleStage and shared by its
+ * bunches, they are cleared but never deallocated between updates.
+ */
+struct ParticleArrays
+{
+	std::vector<std::size_t> index;	// zero-based index of the particle within the stage
+
+	std::vector<float> timeSecs;		// particle time in seconds
+	std::vector<float> timeFraction;	// time fraction within particle lifetime
+
+	std::vector<float> rand[5];		// the random numbers needed for pathing
+
+	std::vector<double> originX;
+	std::vector<double> originY;
+	std::vector<double> originZ;
+
+	std::vector<double> colourR;
+	std::vector<double> colourG;
+	std::vector<double> colourB;
+	std::vector<double> colourA;
+
+	std::vector<float> angle;
+	std::vector<float> size;
+	std::vector<float> aspect;
+
+	std::size_t count() const
+	{
+		return index.size();
+	}
+
+	void clear()
+	{
+		index.clear();
+		timeSecs.clear();
+		timeFraction.clear();
+
+		for (auto& r : rand)
+		{
+			r.clear();
+		}
+
+		angle.clear();
+	}
+
+	// Appends a new particle with the values known before simulation starts
+	void add(std::size_t particleIndex, float particleTimeSecs, float particleTimeFraction,
+		const float* randomValues, float initialAngle)
+	{
+		index.push_back(particleIndex);
+		timeSecs.push_back(particleTimeSecs);
+		timeFraction.push_back(particleTimeFraction);
+
+		for (std::size_t i = 0; i < 5; ++i)
+		{
+			rand[i].push_back(randomValues[i]);
+		}
+
+		angle.push_back(initialAngle);
+	}
+
+	// Sizes the derived attribute arrays to match the particle count
+	void resizeDerivedAttributes()
+	{
+		auto n = count();
+
+		originX.resize(n);
+		originY.resize(n);
+		originZ.resize(n);
+
+		colourR.resize(n);
+		colourG.resize(n);
+		colourB.resize(n);
+		colourA.resize(n);
+
+		size.resize(n);
+		aspect.resize(n);
+	}
+};
+
+} // namespace
@@ -45,7 +45,7 @@ public:
 	void setFilename(const std::string& filename) override
 	{
         auto syntax = getBlockSyntax();
-        setFileInfo(vfs::FileInfo(syntax.fileInfo.topDir, filename, vfs::Visibility::NORMAL));
+        setFileInfo(vfs::FileInfo(syntax.getFileInfo().topDir, filename, vfs::Visibility::NORMAL));
 	}
 
 	// Clears stage and depth hack information
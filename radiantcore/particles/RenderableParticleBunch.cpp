@@ -10,10 +10,10 @@ namespace particles
 
 RenderableParticleBunch::RenderableParticleBunch(std::size_t index,
 	Rand48::result_type randSeed, const IStageDef& stage, const Matrix4& viewRotation,
-    const Vector3& direction, const Vector3& entityColour) :
+    const Vector3& direction, const Vector3& entityColour, ParticleArrays& particles) :
     _index(index),
     _stage(stage),
-    _quads(),
+    _particles(particles),
     _randSeed(randSeed),
     _distributeParticlesRandomly(_stage.getRandomDistribution()),
     _offset(_stage.getOffset()),
@@ -21,13 +21,14 @@ RenderableParticleBunch::RenderableParticleBunch(std::size_t index,
     _direction(direction),
     _entityColour(entityColour)
 {
-    // Geometry is written in update(), just reserve the space
+    // Geometry is written in update()
 }
 
 void RenderableParticleBunch::update(std::size_t time)
 {
     _bounds = AABB();
-    _quads.clear();
+    _vertices.clear();
+    _particles.clear();
 
     // Length of one cycle (duration + deadtime)
     std::size_t cycleMsec = static_cast<std::size_t>(_stage.getCycleMsec());
@@ -37,9 +38,6 @@ void RenderableParticleBunch::update(std::size_t time)
         return;
     }
 
-    // Reserve enough space for all the particles (non-animated case)
-    _quads.reserve(_stage.getCount() * 4);
-
     // Normalise the global input time into local cycle time
     // The cycleTime may be larger than the _stage.cycleMsec argument if bunching is turned off
     std::size_t cycleTime = time - cycleMsec * _index;
@@ -47,18 +45,53 @@ void RenderableParticleBunch::update(std::size_t time)
     // Reset the random number generator using our stored seed
     _random.seed(_randSeed);
 
-    // Calculate the time between each particle spawn
-    // When bunching is set to 1 the spacing is 0, and vice versa.
     std::size_t stageDurationMsec = static_cast<std::size_t>(SEC2MS(_stage.getDuration()));
 
+    // Collect the live particles into the working set, then run
+    // the simulation passes over all of them
+    spawnParticles(cycleTime, stageDurationMsec);
+
+    if (_particles.count() == 0)
+    {
+        return;
+    }
+
+    _particles.resizeDerivedAttributes();
+
+    calculateOrigins();
+    calculateAngles();
+    calculateColours();
+    calculateSizes();
+
+    // For aimed orientation, we need to override particle height and aspect
+    if (_stage.getOrientationType() == IStageDef::ORIENTATION_AIMED)
+    {
+        emitAimedQuads(stageDurationMsec);
+    }
+    else
+    {
+        emitQuads();
+    }
+}
+
+void RenderableParticleBunch::spawnParticles(std::size_t cycleTime, std::size_t stageDurationMsec)
+{
+    // Calculate the time between each particle spawn
+    // When bunching is set to 1 the spacing is 0, and vice versa.
     float spawnSpacing = _stage.getBunching() * static_cast<float>(stageDurationMsec) / _stage.getCount();
 
     // This is the spacing between each particle
     std::size_t spawnSpacingMsec = static_cast<std::size_t>(spawnSpacing);
 
-    // Generate all particle quads, regardless of their visibility
+    auto count = static_cast<std::size_t>(_stage.getCount());
+    auto initialAngle = _stage.getInitialAngle();
+    auto maxVal = _random.max();
+
+    float rand[5];
+
+    // Visit all particles, regardless of their visibility
     // Visibility is considered by not rendering particles that haven't been spawned yet
-    for (std::size_t i = 0; i < static_cast<std::size_t>(_stage.getCount()); ++i)
+    for (std::size_t i = 0; i < count; ++i)
     {
         // Consider bunching parameter
         std::size_t particleStartTimeMsec = i * spawnSpacingMsec;
@@ -74,25 +107,19 @@ void RenderableParticleBunch::update(std::size_t time)
         // Get the "local particle time" in msecs
         std::size_t particleTime = cycleTime - particleStartTimeMsec;
 
-        // Generate the particle renderinfo structure (our working set)
-        ParticleRenderInfo particle(i, _random);
-
-        // Calculate the time fraction [0..1]
-        particle.timeFraction = static_cast<float>(particleTime) / stageDurationMsec;
-
-        // We need the particle time in seconds for the location/angle integrations
-        particle.timeSecs = MS2SEC(particleTime);
-
-        // Calculate particle origin at time t
-        calculateOrigin(particle);
+        // Generate five random numbers for path calcs, this is needed in calculateOrigin
+        for (auto& value : rand)
+        {
+            value = static_cast<float>(_random()) / maxVal;
+        }
 
         // Get the initial angle value
-        particle.angle = _stage.getInitialAngle();
+        auto angle = initialAngle;
 
-        if (particle.angle == 0)
+        if (angle == 0)
         {
             // Use random angle
-            particle.angle = 360 * static_cast<float>(_random()) / _random.max();
+            angle = 360 * static_cast<float>(_random()) / _random.max();
         }
 
         // Past this point, no more "randomness" is required, so let's check if we still need
@@ -106,85 +133,240 @@ void RenderableParticleBunch::update(std::size_t time)
             continue; // particle has expired
         }
 
+        // Calculate the time fraction [0..1], we need the particle time in seconds
+        // for the location/angle integrations
+        _particles.add(i, MS2SEC(particleTime), static_cast<float>(particleTime) / stageDurationMsec, rand, angle);
+    }
+}
+
+void RenderableParticleBunch::calculateOrigins()
+{
+    preparePathConstants();
+
+    float rand[5];
+
+    for (std::size_t p = 0; p < _particles.count(); ++p)
+    {
+        for (std::size_t r = 0; r < 5; ++r)
+        {
+            rand[r] = _particles.rand[r][p];
+        }
+
+        auto origin = calculateOrigin(rand, _particles.timeSecs[p]);
+
+        _particles.originX[p] = origin.x();
+        _particles.originY[p] = origin.y();
+        _particles.originZ[p] = origin.z();
+    }
+}
+
+void RenderableParticleBunch::calculateAngles()
+{
+    const auto& rotationSpeed = _stage.getRotationSpeed();
+
+    for (std::size_t p = 0; p < _particles.count(); ++p)
+    {
         // Calculate the time-dependent angle
         // according to docs, half the quads have negative rotation speed
-        int rotFactor = i % 2 == 0 ? -1 : 1;
-        particle.angle += rotFactor * integrate(_stage.getRotationSpeed(), particle.timeSecs);
+        int rotFactor = _particles.index[p] % 2 == 0 ? -1 : 1;
+        _particles.angle[p] += rotFactor * integrate(rotationSpeed, _particles.timeSecs[p]);
+    }
+}
+
+void RenderableParticleBunch::calculateColours()
+{
+    Vector4 mainColour = !_stage.getUseEntityColour() ?
+        _stage.getColour() : Vector4(_entityColour.x(), _entityColour.y(), _entityColour.z(), 1);
 
-        // Calculate render colour for this particle
-        calculateColour(particle);
+    const auto& fadeColour = _stage.getFadeColour();
+    auto count = _stage.getCount();
 
-        // Consider quad size
-        particle.size = _stage.getSize().evaluate(particle.timeFraction);
+    // Consider fade index fraction, which can spawn particles already faded to some extent
+    float fadeIndexFraction = _stage.getFadeIndexFraction();
+
+    float fadeInFraction = _stage.getFadeInFraction();
+
+    float fadeOutFraction = _stage.getFadeOutFraction();
+    float fadeOutFractionInverse = 1.0f - fadeOutFraction;
 
-        // Consider aspect ratio
-        particle.aspect = _stage.getAspect().evaluate(particle.timeFraction);
+    for (std::size_t p = 0; p < _particles.count(); ++p)
+    {
+        // We start with the stage's standard colour
+        Vector4 colour = mainColour;
 
-        // Consider animation frames
-        particle.animFrames = static_cast<std::size_t>(_stage.getAnimationFrames());
+        auto timeFraction = _particles.timeFraction[p];
 
-        if (particle.animFrames > 0)
+        if (fadeIndexFraction > 0)
         {
-            // Calculate the s coordinates and the resulting particle colour
-            calculateAnim(particle);
+            // greebo: The linear fading function goes like this:
+            // frac(t) = (startFrac - t) / (startFrac - 1) with t in [0..1]
+            // Boundary conditions: frac(1) = 1 and frac(startFrac) = 0
+
+            // Use the particle index as "time", normalised to [0..1]
+            // such that particle with higher index start more faded
+            float pIdx = static_cast<float>(_particles.index[p]) / count;
+
+            // Calculate how much we should be faded already
+            float startFrac = 1.0f - fadeIndexFraction;
+            float frac = (startFrac - pIdx) / (startFrac - 1.0f);
+
+            // Ignore negative fraction values, this also takes care that only
+            // those particles with time >= fadeIndexFraction get faded.
+            if (frac > 0)
+            {
+                colour = lerpColour(colour, fadeColour, frac);
+            }
         }
 
-        // For aimed orientation, we need to override particle height and aspect
-        if (_stage.getOrientationType() == IStageDef::ORIENTATION_AIMED)
+        if (fadeInFraction > 0 && timeFraction <= fadeInFraction)
         {
-            pushAimedParticles(particle, stageDurationMsec);
+            colour = lerpColour(fadeColour, mainColour, timeFraction / fadeInFraction);
         }
-        else
+
+        if (fadeOutFraction > 0 && timeFraction >= fadeOutFractionInverse)
         {
-            if (particle.animFrames > 0)
-            {
-                // Animated, push two crossfaded quads
-                pushQuad(particle, particle.curColour, particle.sWidth * particle.curFrame, particle.sWidth);
-                pushQuad(particle, particle.nextColour, particle.sWidth * particle.nextFrame, particle.sWidth);
-            }
-            else
-            {
-                // Non-animated quad
-                pushQuad(particle, particle.colour);
-            }
+            colour = lerpColour(mainColour, fadeColour, (timeFraction - fadeOutFractionInverse) / fadeOutFraction);
         }
+
+        _particles.colourR[p] = colour.x();
+        _particles.colourG[p] = colour.y();
+        _particles.colourB[p] = colour.z();
+        _particles.colourA[p] = colour.w();
+    }
+}
+
+void RenderableParticleBunch::calculateSizes()
+{
+    const auto& size = _stage.getSize();
+    const auto& aspect = _stage.getAspect();
+
+    for (std::size_t p = 0; p < _particles.count(); ++p)
+    {
+        _particles.size[p] = size.evaluate(_particles.timeFraction[p]);
+        _particles.aspect[p] = aspect.evaluate(_particles.timeFraction[p]);
     }
 }
 
-void RenderableParticleBunch::addVertexData(std::vector<render::RenderVertex>& vertices, 
-    std::vector<unsigned int>& indices, const Matrix4& localToWorld)
+void RenderableParticleBunch::emitQuads()
 {
-    if (_quads.empty()) return;
+    auto animFrames = static_cast<std::size_t>(_stage.getAnimationFrames());
+
+    // Animated particles are rendered using two crossfaded quads
+    _vertices.reserve(_particles.count() * (animFrames > 0 ? 8 : 4));
+
+    // The quads are created facing the z axis, then rotated to fit the requested
+    // orientation. Instead of transforming all four corners, transform the two
+    // half-axes of the quad once and span the corners from the particle origin.
+    Vector3 xAxis = _viewRotation.xCol3();
+    Vector3 yAxis = _viewRotation.yCol3();
+    Vector3 translation = _viewRotation.tCol().getVector3();
 
-    auto firstIndex = static_cast<unsigned int>(vertices.size());
+    Vector3f normal(_viewRotation.zCol3());
 
-    auto quadIndex = 0;
+    ParticleRenderInfo anim;
+    anim.animFrames = animFrames;
 
-    for (const auto& quad : _quads)
+    for (std::size_t p = 0; p < _particles.count(); ++p)
     {
-        for (auto i = 0; i < 4; ++i)
+        double cosPhi = cos(degrees_to_radians(_particles.angle[p]));
+        double sinPhi = sin(degrees_to_radians(_particles.angle[p]));
+
+        double size = _particles.size[p];
+        double height = _particles.size[p] * _particles.aspect[p];
+
+        // The quad's rotated half-width and half-height vectors
+        Vector3 right = xAxis * (cosPhi * size) - yAxis * (sinPhi * size);
+        Vector3 up = xAxis * (sinPhi * height) + yAxis * (cosPhi * height);
+
+        Vector3 centre(_particles.originX[p], _particles.originY[p], _particles.originZ[p]);
+        centre += translation;
+
+        Vector3f corners[4] =
+        {
+            Vector3f(centre - right + up),
+            Vector3f(centre + right + up),
+            Vector3f(centre + right - up),
+            Vector3f(centre - right - up),
+        };
+
+        Vector4 colour(_particles.colourR[p], _particles.colourG[p], _particles.colourB[p], _particles.colourA[p]);
+
+        auto emitQuad = [&](const Vector4& quadColour, float s0, float sWidth)
         {
-            auto worldVertex = localToWorld * quad.verts[i].vertex;
-
-            vertices.push_back(render::RenderVertex(
-                worldVertex,
-                quad.verts[i].normal, 
-                quad.verts[i].texcoord, 
-                quad.verts[i].colour)
-            );
+            Vector4f vertexColour(quadColour);
+
+            _vertices.emplace_back(corners[0], normal, Vector2f(s0, 0), vertexColour);
+            _vertices.emplace_back(corners[1], normal, Vector2f(s0 + sWidth, 0), vertexColour);
+            _vertices.emplace_back(corners[2], normal, Vector2f(s0 + sWidth, 1), vertexColour);
+            _vertices.emplace_back(corners[3], normal, Vector2f(s0, 1), vertexColour);
+        };
+
+        if (animFrames > 0)
+        {
+            // Calculate the s coordinates and the resulting particle colour
+            anim.timeSecs = _particles.timeSecs[p];
+            anim.colour = colour;
+            calculateAnim(anim);
+
+            // Animated, push two crossfaded quads
+            emitQuad(anim.curColour, anim.sWidth * anim.curFrame, anim.sWidth);
+            emitQuad(anim.nextColour, anim.sWidth * anim.nextFrame, anim.sWidth);
         }
+        else
+        {
+            // Non-animated quad
+            emitQuad(colour, 0, 1);
+        }
+    }
+}
 
-        auto index = firstIndex + quadIndex * 4;
+void RenderableParticleBunch::emitAimedQuads(std::size_t stageDurationMsec)
+{
+    auto animFrames = static_cast<std::size_t>(_stage.getAnimationFrames());
+
+    for (std::size_t p = 0; p < _particles.count(); ++p)
+    {
+        // Aimed particles are rendered as trail of quads, which is
+        // using the per-particle render info as working structure
+        ParticleRenderInfo particle;
 
-        indices.push_back(index + 0);
-        indices.push_back(index + 1);
-        indices.push_back(index + 2);
+        particle.index = _particles.index[p];
+        particle.timeSecs = _particles.timeSecs[p];
+        particle.timeFraction = _particles.timeFraction[p];
+
+        for (std::size_t r = 0; r < 5; ++r)
+        {
+            particle.rand[r] = _particles.rand[r][p];
+        }
 
-        indices.push_back(index + 0);
-        indices.push_back(index + 2);
-        indices.push_back(index + 3);
+        particle.origin = Vector3(_particles.originX[p], _particles.originY[p], _particles.originZ[p]);
+        particle.colour = Vector4(_particles.colourR[p], _particles.colourG[p], _particles.colourB[p], _particles.colourA[p]);
+        particle.angle = _particles.angle[p];
+        particle.size = _particles.size[p];
+        particle.aspect = _particles.aspect[p];
+        particle.animFrames = animFrames;
 
-        quadIndex++;
+        if (particle.animFrames > 0)
+        {
+            calculateAnim(particle);
+        }
+
+        _aimedQuads.clear();
+        pushAimedParticles(particle, stageDurationMsec);
+
+        for (const auto& quad : _aimedQuads)
+        {
+            pushQuad(quad);
+        }
+    }
+}
+
+void RenderableParticleBunch::addVertexData(std::vector<render::RenderVertex>& vertices, const Matrix4& localToWorld)
+{
+    for (const auto& vertex : _vertices)
+    {
+        vertices.push_back(vertex);
+        vertices.back().vertex = localToWorld.transformPoint(Vector3(vertex.vertex));
     }
 }
 
@@ -263,83 +445,47 @@ void RenderableParticleBunch::calculateAnim(ParticleRenderInfo& particle)
     particle.sWidth = 1.0f / particle.animFrames;
 }
 
-void RenderableParticleBunch::calculateColour(ParticleRenderInfo& particle)
+void RenderableParticleBunch::preparePathConstants()
 {
-    Vector4 mainColour = !_stage.getUseEntityColour() ?
-        _stage.getColour() : Vector4(_entityColour.x(), _entityColour.y(), _entityColour.z(), 1);
-
-    // We start with the stage's standard colour
-    particle.colour = mainColour;
-
-    // Consider fade index fraction, which can spawn particles already faded to some extent
-    float fadeIndexFraction = _stage.getFadeIndexFraction();
-
-    if (fadeIndexFraction > 0)
-    {
-        // greebo: The linear fading function goes like this:
-        // frac(t) = (startFrac - t) / (startFrac - 1) with t in [0..1]
-        // Boundary conditions: frac(1) = 1 and frac(startFrac) = 0
-
-        // Use the particle index as "time", normalised to [0..1]
-        // such that particle with higher index start more faded
-        float pIdx = static_cast<float>(particle.index) / _stage.getCount();
-
-        // Calculate how much we should be faded already
-        float startFrac = 1.0f - fadeIndexFraction;
-        float frac = (startFrac - pIdx) / (startFrac - 1.0f);
+    // Check if the main direction is different to the z axis
+    Vector3 dir = _direction.getNormalised();
+    Vector3 zDir(0,0,1);
 
-        // Ignore negative fraction values, this also takes care that only
-        // those particles with time >= fadeIndexFraction get faded.
-        if (frac > 0)
-        {
-            particle.colour = lerpColour(particle.colour, _stage.getFadeColour(), frac);
-        }
-    }
+    double deviation = dir.angle(zDir);
 
-    float fadeInFraction = _stage.getFadeInFraction();
+    _pathRotation = deviation != 0 ? Matrix4::getRotation(zDir, dir) : Matrix4::getIdentity();
 
-    if (fadeInFraction > 0 && particle.timeFraction <= fadeInFraction)
-    {
-        particle.colour = lerpColour(_stage.getFadeColour(), mainColour, particle.timeFraction / fadeInFraction);
-    }
-
-    float fadeOutFraction = _stage.getFadeOutFraction();
-    float fadeOutFractionInverse = 1.0f - fadeOutFraction;
+    // Consider offset as starting point
+    _rotatedOffset = _pathRotation.transformPoint(_offset);
 
-    if (fadeOutFraction > 0 && particle.timeFraction >= fadeOutFractionInverse)
-    {
-        particle.colour = lerpColour(mainColour, _stage.getFadeColour(), (particle.timeFraction - fadeOutFractionInverse) / fadeOutFraction);
-    }
+    // if "world" is set, use -z as gravity direction, otherwise use the reverse emitter direction
+    _gravityDirection = _stage.getWorldGravityFlag() ? Vector3(0,0,-1) : -dir;
 }
 
 void RenderableParticleBunch::calculateOrigin(ParticleRenderInfo& particle)
 {
-    // Check if the main direction is different to the z axis
-    Vector3 dir = _direction.getNormalised();
-    Vector3 zDir(0,0,1);
-
-    double deviation = dir.angle(zDir);
-
-    Matrix4 rotation = deviation != 0 ? Matrix4::getRotation(zDir, dir) : Matrix4::getIdentity();
+    particle.origin = calculateOrigin(particle.rand, particle.timeSecs);
+}
 
-    // Consider offset as starting point
-    particle.origin = rotation.transformPoint(_offset);
+Vector3 RenderableParticleBunch::calculateOrigin(const float* rand, float timeSecs)
+{
+    Vector3 origin = _rotatedOffset;
 
     switch (_stage.getCustomPathType())
     {
     case IStageDef::PATH_STANDARD: // Standard path calculation
         {
             // Consider particle distribution
-            Vector3 distributionOffset = getDistributionOffset(particle, _distributeParticlesRandomly);
+            Vector3 distributionOffset = getDistributionOffset(rand, _distributeParticlesRandomly);
 
             // Add this to the origin
-            particle.origin += distributionOffset;
+            origin += distributionOffset;
 
             // Calculate particle direction, pass distribution offset (this is needed for DIRECTION_OUTWARD)
-            Vector3 particleDirection = getDirection(particle, rotation, distributionOffset);
+            Vector3 particleDirection = getDirection(rand, _pathRotation, distributionOffset);
 
             // Consider speed
-            particle.origin += particleDirection * integrate(_stage.getSpeed(), particle.timeSecs);
+            origin += particleDirection * integrate(_stage.getSpeed(), timeSecs);
         }
         break;
 
@@ -355,22 +501,22 @@ void RenderableParticleBunch::calculateOrigin(ParticleRenderInfo& particle)
             float radius = _stage.getCustomPathParm(2);
 
             // Generate starting conditions speed (+/-50%)
-            float rand = 2 * particle.rand[0] - 1.0f;
-            float radialSpeedFactor = 1.0f + 0.5f * rand * rand;
+            float deviation = 2 * rand[0] - 1.0f;
+            float radialSpeedFactor = 1.0f + 0.5f * deviation * deviation;
 
             // greebo: factor 0.4 is empirical, I measured a few D3 particles for their circulation times
             float radialSpeed = _stage.getCustomPathParm(0) * radialSpeedFactor * 0.4f;
 
-            rand = 2 * particle.rand[1] - 1.0f;
-            float axialSpeedFactor = 1.0f + 0.5f * rand * rand;
+            deviation = 2 * rand[1] - 1.0f;
+            float axialSpeedFactor = 1.0f + 0.5f * deviation * deviation;
             float axialSpeed = _stage.getCustomPathParm(1) * axialSpeedFactor * 0.4f;
 
-            float phi0 = 2 * static_cast<float>(math::PI) * particle.rand[2];
-            float theta0 = static_cast<float>(math::PI) * particle.rand[3];
+            float phi0 = 2 * static_cast<float>(math::PI) * rand[2];
+            float theta0 = static_cast<float>(math::PI) * rand[3];
 
             // Calculate angles at the given particleTime
-            float phi = phi0 + axialSpeed * particle.timeSecs;
-            float theta = theta0 + radialSpeed * particle.timeSecs;
+            float phi = phi0 + axialSpeed * timeSecs;
+            float theta = theta0 + radialSpeed * timeSecs;
 
             // Pre-calculate the sin/cos values
             float cosPhi = cos(phi);
@@ -379,7 +525,7 @@ void RenderableParticleBunch::calculateOrigin(ParticleRenderInfo& particle)
             float sinTheta = sin(theta);
 
             // Move the particle origin
-            particle.origin += Vector3(radius * cosTheta * sinPhi, radius * sinTheta * sinPhi, radius * cosPhi);
+            origin += Vector3(radius * cosTheta * sinPhi, radius * sinTheta * sinPhi, radius * cosPhi);
         }
         break;
 
@@ -394,20 +540,20 @@ void RenderableParticleBunch::calculateOrigin(ParticleRenderInfo& particle)
             float sizeY = _stage.getCustomPathParm(1);
             float sizeZ = _stage.getCustomPathParm(2);
 
-            float radialSpeed = _stage.getCustomPathParm(3) * (2 * particle.rand[0] - 1.0f);
-            float axialSpeed = _stage.getCustomPathParm(4) * (2 * particle.rand[1] - 1.0f);
+            float radialSpeed = _stage.getCustomPathParm(3) * (2 * rand[0] - 1.0f);
+            float axialSpeed = _stage.getCustomPathParm(4) * (2 * rand[1] - 1.0f);
 
-            float phi0 = 2 * static_cast<float>(math::PI) * particle.rand[2];
-            float z0 = sizeZ * (2 * particle.rand[3] - 1.0f);
+            float phi0 = 2 * static_cast<float>(math::PI) * rand[2];
+            float z0 = sizeZ * (2 * rand[3] - 1.0f);
 
-            float sinPhi = sin(phi0 + radialSpeed * particle.timeSecs);
-            float cosPhi = cos(phi0 + radialSpeed * particle.timeSecs);
+            float sinPhi = sin(phi0 + radialSpeed * timeSecs);
+            float cosPhi = cos(phi0 + radialSpeed * timeSecs);
 
             float x = sizeX * cosPhi;
             float y = sizeY * sinPhi;
-            float z = z0 + axialSpeed * particle.timeSecs;
+            float z = z0 + axialSpeed * timeSecs;
 
-            particle.origin += Vector3(x, y, z);
+            origin += Vector3(x, y, z);
         }
         break;
 
@@ -423,27 +569,26 @@ void RenderableParticleBunch::calculateOrigin(ParticleRenderInfo& particle)
     };
 
     // Consider gravity
-    // if "world" is set, use -z as gravity direction, otherwise use the reverse emitter direction
-    Vector3 gravity = _stage.getWorldGravityFlag() ? Vector3(0,0,-1) : -_direction.getNormalised();
+    origin += _gravityDirection * _stage.getGravity() * timeSecs * timeSecs * 0.5f;
 
-    particle.origin += gravity * _stage.getGravity() * particle.timeSecs * particle.timeSecs * 0.5f;
+    return origin;
 }
 
-Vector3 RenderableParticleBunch::getDirection(ParticleRenderInfo& particle, const Matrix4& rotation, const Vector3& distributionOffset)
+Vector3 RenderableParticleBunch::getDirection(const float* rand, const Matrix4& rotation, const Vector3& distributionOffset)
 {
     switch (_stage.getDirectionType())
     {
     case IStageDef::DIRECTION_CONE:
         {
             // Find a random vector on the sphere surface defined by the cone with apex 2*angle
-            float u = particle.rand[3];
+            float u = rand[3];
 
             // Scale the variable v such that it takes uniform values in the interval [(1+cos(angle))/2 .. 1]
             float angleRad = _stage.getDirectionParm(0) * static_cast<float>(math::PI) / 180.0f;
             float v0 = (1 + cos(angleRad)) * 0.5f;
             float v1 = 1;
 
-            float v = v0 + particle.rand[4] * (v1 - v0);
+            float v = v0 + rand[4] * (v1 - v0);
 
             float theta = 2 * static_cast<float>(math::PI) * u;
             float phi = acos(2*v - 1);
@@ -470,7 +615,7 @@ Vector3 RenderableParticleBunch::getDirection(ParticleRenderInfo& particle, cons
     };
 }
 
-Vector3 RenderableParticleBunch::getDistributionOffset(ParticleRenderInfo& particle, bool distributeParticlesRandomly)
+Vector3 RenderableParticleBunch::getDistributionOffset(const float* rand, bool distributeParticlesRandomly)
 {
     switch (_stage.getDistributionType())
     {
@@ -485,9 +630,9 @@ Vector3 RenderableParticleBunch::getDistributionOffset(ParticleRenderInfo& parti
             if (distributeParticlesRandomly)
             {
                 // Rectangular spawn zone
-                randX = 2 * particle.rand[0] - 1.0f;
-                randY = 2 * particle.rand[1] - 1.0f;
-                randZ = 2 * particle.rand[2] - 1.0f;
+                randX = 2 * rand[0] - 1.0f;
+                randY = 2 * rand[1] - 1.0f;
+                randZ = 2 * rand[2] - 1.0f;
             }
 
             // If random distribution is off, particles get spawned at <sizex, sizey, sizez>
@@ -519,11 +664,11 @@ Vector3 RenderableParticleBunch::getDistributionOffset(ParticleRenderInfo& parti
             if (distributeParticlesRandomly)
             {
                 // Get a random angle in [0..2pi]
-                float angle = static_cast<float>(2*math::PI) * particle.rand[0];
+                float angle = static_cast<float>(2*math::PI) * rand[0];
 
                 float xPos = cos(angle) * sizeX;
                 float yPos = sin(angle) * sizeY;
-                float zPos = sizeZ * (2 * particle.rand[1] - 1.0f);
+                float zPos = sizeZ * (2 * rand[1] - 1.0f);
 
                 return Vector3(xPos, yPos, zPos);
             }
@@ -549,14 +694,14 @@ Vector3 RenderableParticleBunch::getDistributionOffset(ParticleRenderInfo& parti
             if (distributeParticlesRandomly)
             {
                 // The following is modeled after http://mathworld.wolfram.com/SpherePointPicking.html
-                float u = particle.rand[0];
-                float v = particle.rand[1];
+                float u = rand[0];
+                float v = rand[1];
 
                 float theta = 2 * static_cast<float>(math::PI) * u;
                 float phi = acos(2*v - 1);
 
                 // Take the sqrt(radius) to correct bunching at the center of the sphere
-                float r = sqrt(particle.rand[2]);
+                float r = sqrt(rand[2]);
 
                 float x = (minX + (maxX - minX) * r) * cos(theta) * sin(phi);
                 float y = (minY + (maxY - minY) * r) * sin(theta) * sin(phi);
@@ -577,16 +722,12 @@ Vector3 RenderableParticleBunch::getDistributionOffset(ParticleRenderInfo& parti
     };
 }
 
-void RenderableParticleBunch::pushQuad(ParticleRenderInfo& particle, const Vector4& colour, float s0, float sWidth)
+void RenderableParticleBunch::pushQuad(const ParticleQuad& quad)
 {
-    // greebo: Create a (rotated) quad facing the z axis
-    // then rotate it to fit the requested orientation
-    // finally translate it to its position.
-    const Vector3 normal = _viewRotation.zCol3();
-
-    _quads.push_back(ParticleQuad(particle.size, particle.aspect, particle.angle, colour, normal, s0, sWidth));
-    _quads.back().transform(_viewRotation);
-    _quads.back().translate(particle.origin);
+    for (const auto& vertex : quad.verts)
+    {
+        _vertices.emplace_back(vertex.vertex, vertex.normal, vertex.texcoord, vertex.colour);
+    }
 }
 
 void RenderableParticleBunch::pushAimedParticles(ParticleRenderInfo& particle, std::size_t stageDurationMsec)
@@ -667,10 +808,10 @@ void RenderableParticleBunch::pushAimedParticles(ParticleRenderInfo& particle, s
                 // Glue the first row of vertices to the last quad, if applicable
                 if (i > 1)
                 {
-                    snapQuads(curQuad, *(_quads.end()-2));
+                    snapQuads(curQuad, *(_aimedQuads.end()-2));
                 }
 
-                _quads.push_back(curQuad);
+                _aimedQuads.push_back(curQuad);
 
                 // "Next" quad, re-use the curQuad structure
                 curQuad.assignColour(aimedParticle.nextColour);
@@ -680,20 +821,20 @@ void RenderableParticleBunch::pushAimedParticles(ParticleRenderInfo& particle, s
 
                 if (i > 1)
                 {
-                    snapQuads(curQuad, *(_quads.end()-2));
+                    snapQuads(curQuad, *(_aimedQuads.end()-2));
                 }
 
-                _quads.push_back(curQuad);
+                _aimedQuads.push_back(curQuad);
             }
             else
             {
                 if (i > 1)
                 {
-                    snapQuads(curQuad, _quads.back());
+                    snapQuads(curQuad, _aimedQuads.back());
                 }
 
                 // Non-animated case
-                _quads.push_back(curQuad);
+                _aimedQuads.push_back(curQuad);
             }
         }
 
@@ -721,12 +862,9 @@ void RenderableParticleBunch::snapQuads(ParticleQuad& curQuad, ParticleQuad& pre
 
 void RenderableParticleBunch::calculateBounds()
 {
-    for (Quads::const_iterator i = _quads.begin(); i != _quads.end(); ++i)
+    for (const auto& vertex : _vertices)
     {
-        _bounds.includePoint(i->verts[0].vertex);
-        _bounds.includePoint(i->verts[1].vertex);
-        _bounds.includePoint(i->verts[2].vertex);
-        _bounds.includePoint(i->verts[3].vertex);
+        _bounds.includePoint(Vector3(vertex.vertex));
     }
 }
 
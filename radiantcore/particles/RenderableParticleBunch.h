@@ -8,8 +8,10 @@
 #include "math/Vector3.h"
 #include "math/Matrix4.h"
 
+#include "render/RenderVertex.h"
 #include "ParticleQuad.h"
 #include "ParticleRenderInfo.h"
+#include "ParticleArrays.h"
 
 namespace particles
 {
@@ -27,9 +29,22 @@ class RenderableParticleBunch
 	// The stage this bunch is part of
 	const IStageDef& _stage;
 
-	// The quads of this particle bunch
+	// The simulation working set, shared with the other bunches of the stage
+	ParticleArrays& _particles;
+
+	// The quad vertices of this particle bunch in local space, four per quad.
+	// The buffer is re-used between updates.
+	std::vector<render::RenderVertex> _vertices;
+
+	// Scratch buffer for the trailing quads of a single aimed particle
 	typedef std::vector<ParticleQuad> Quads;
-	Quads _quads;
+	Quads _aimedQuads;
+
+	// Path constants derived from the stage and the emitter direction,
+	// calculated once per update before evaluating the particle origins
+	Matrix4 _pathRotation;
+	Vector3 _rotatedOffset;
+	Vector3 _gravityDirection;
 
 	// The seed for our local randomiser, as passed by the parent stage
 	Rand48::result_type _randSeed;
@@ -62,7 +77,8 @@ public:
 							const IStageDef& stage,
 							const Matrix4& viewRotation,
 							const Vector3& direction,
-							const Vector3& entityColour);
+							const Vector3& entityColour,
+							ParticleArrays& particles);
 
 	std::size_t getIndex() const
 	{
@@ -73,15 +89,15 @@ public:
 	// Time is specified in stage time without offset,in msecs.
 	void update(std::size_t time);
 
-    // Add the renderable geometry to the given arrays
-    void addVertexData(std::vector<render::RenderVertex>& vertices,
-        std::vector<unsigned int>& indices, const Matrix4& localToWorld);
+    // Append the quad vertices to the given array, four per quad, transformed to world space.
+    // The index pattern is the same for every quad, the caller is taking care of that.
+    void addVertexData(std::vector<render::RenderVertex>& vertices, const Matrix4& localToWorld);
 
 	const AABB& getBounds();
 
     std::size_t getNumQuads() const
     {
-        return _quads.size();
+        return _vertices.size() / 4;
     }
 
 private:
@@ -96,7 +112,26 @@ private:
 		return startColour * (1.0f - fraction) + endColour * fraction;
 	}
 
-	void calculateColour(ParticleRenderInfo& particle);
+	// Spawns the visible particles into the working set, this is where all the randomness happens
+	void spawnParticles(std::size_t cycleTime, std::size_t stageDurationMsec);
+
+	// The simulation passes, each running over all particles in the working set
+	void calculateOrigins();
+	void calculateAngles();
+	void calculateColours();
+	void calculateSizes();
+
+	// Writes the quads of all non-aimed particles to the vertex buffer
+	void emitQuads();
+
+	// Writes the trailing quads of all aimed particles to the vertex buffer
+	void emitAimedQuads(std::size_t stageDurationMsec);
+
+	// Calculates the path constants used by calculateOrigin
+	void preparePathConstants();
+
+	// Calculates the origin of a particle with the given random values at the given time
+	Vector3 calculateOrigin(const float* rand, float timeSecs);
 
 	// Calculates origin at the given time, write result back to the given struct
 	void calculateOrigin(ParticleRenderInfo& particle);
@@ -105,9 +140,9 @@ private:
 	void calculateAnim(ParticleRenderInfo& particle);
 
 	// The rotation is used to deviate the offsets should be normalised and not degenerate
-	Vector3 getDirection(ParticleRenderInfo& particle, const Matrix4& rotation, const Vector3& distributionOffset);
+	Vector3 getDirection(const float* rand, const Matrix4& rotation, const Vector3& distributionOffset);
 
-	Vector3 getDistributionOffset(ParticleRenderInfo& particle, bool distributeParticlesRandomly);
+	Vector3 getDistributionOffset(const float* rand, bool distributeParticlesRandomly);
 
 	// Calculates the matrix which rotates faces towards the viewer (used for "aimed" orientation)
 	Matrix4 getAimedMatrix(const Vector3& particleVelocity);
@@ -115,9 +150,8 @@ private:
 	// Handles aimed particles
 	void pushAimedParticles(ParticleRenderInfo& particle, std::size_t stageDurationMsec);
 
-	// Generates a new quad using the given struct as data source.
-	// colour, s0 and sWidth override the values in info
-	void pushQuad(ParticleRenderInfo& particle, const Vector4& colour, float s0 = 0.0f, float sWidth = 1.0f);
+	// Appends the four vertices of the given quad to the vertex buffer
+	void pushQuad(const ParticleQuad& quad);
 
 	// Makes the quad transition seamless by snapping the adjacent vertices at the midpoint
 	void snapQuads(ParticleQuad& curQuad, ParticleQuad& prevQuad);
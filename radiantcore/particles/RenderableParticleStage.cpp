@@ -83,32 +83,46 @@ std::size_t RenderableParticleStage::getNumQuads() const
 
 void RenderableParticleStage::updateGeometry()
 {
-    std::vector<render::RenderVertex> vertices;
-    std::vector<unsigned int> indices;
+    _vertices.clear();
 
     auto numQuads = getNumQuads();
 
     if (numQuads == 0)
     {
-        updateGeometryWithData(render::GeometryType::Triangles, vertices,
-                                                   indices);
+        _indices.clear();
+        updateGeometryWithData(render::GeometryType::Triangles, _vertices, _indices);
         return;
     }
 
-    vertices.reserve(numQuads * 4);
-    indices.reserve(numQuads * 6);
+    _vertices.reserve(numQuads * 4);
 
     if (_bunches[0])
     {
-        _bunches[0]->addVertexData(vertices, indices, _localToWorld);
+        _bunches[0]->addVertexData(_vertices, _localToWorld);
     }
 
     if (_bunches[1])
     {
-        _bunches[1]->addVertexData(vertices, indices, _localToWorld);
+        _bunches[1]->addVertexData(_vertices, _localToWorld);
     }
 
-    updateGeometryWithData(render::GeometryType::Triangles, vertices, indices);
+    // All quads share the same index pattern, only extend it when the quad count grows
+    auto numIndices = numQuads * 6;
+
+    for (auto index = static_cast<unsigned int>(_indices.size() / 6 * 4); _indices.size() < numIndices; index += 4)
+    {
+        _indices.push_back(index + 0);
+        _indices.push_back(index + 1);
+        _indices.push_back(index + 2);
+
+        _indices.push_back(index + 0);
+        _indices.push_back(index + 2);
+        _indices.push_back(index + 3);
+    }
+
+    _indices.resize(numIndices);
+
+    updateGeometryWithData(render::GeometryType::Triangles, _vertices, _indices);
 }
 
 const AABB& RenderableParticleStage::getBounds()
@@ -227,7 +241,7 @@ void RenderableParticleStage::ensureBunches(std::size_t localTimeMSec)
 RenderableParticleBunchPtr RenderableParticleStage::createBunch(std::size_t cycleIndex)
 {
 	return std::make_shared<RenderableParticleBunch>(cycleIndex, getSeed(cycleIndex), 
-        _stageDef, _viewRotation, _direction, _entityColour);
+        _stageDef, _viewRotation, _direction, _entityColour, _particles);
 }
 
 Rand48::result_type RenderableParticleStage::getSeed(std::size_t cycleIndex)
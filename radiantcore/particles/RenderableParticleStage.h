@@ -30,6 +30,13 @@ class RenderableParticleStage :
 
 	std::vector<RenderableParticleBunchPtr> _bunches;
 
+	// The simulation working set used by the bunches when updating
+	ParticleArrays _particles;
+
+	// Vertex and index buffers submitted to the geometry slot, re-used between frames
+	std::vector<render::RenderVertex> _vertices;
+	std::vector<unsigned int> _indices;
+
 	// The rotation matrix to orient particles
 	Matrix4 _viewRotation;
     // Matrix to produce world coordinates
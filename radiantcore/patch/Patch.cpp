@@ -17,8 +17,11 @@
 #include "selection/algorithm/Shader.h"
 #include "selection/algorithm/Texturing.h"
 
+#include "util/ParallelFor.h"
+
 #include "PatchSavedState.h"
 #include "PatchNode.h"
+#include "PatchTesselationBatch.h"
 
 // ====== Helper Functions ==================================================================
 
@@ -265,7 +268,7 @@ void Patch::freezeTransform()
     // Don't call controlPointsChanged() here since that one will re-apply the
     // current transformation matrix, possible the second time.
     transformChanged();
-    updateTesselation();
+    requestTesselationUpdate();
 
     for (Observers::iterator i = _observers.begin(); i != _observers.end();)
     {
@@ -278,7 +281,7 @@ void Patch::controlPointsChanged()
 {
     transformChanged();
     evaluateTransform();
-    updateTesselation();
+    requestTesselationUpdate();
     _node.onControlPointsChanged();
 
     for (Observers::iterator i = _observers.begin(); i != _observers.end();)
@@ -479,28 +482,86 @@ bool Patch::isDegenerate() const {
     return true;
 }
 
-void Patch::updateTesselation(bool force)
+bool Patch::generateTesselation()
 {
-    // Only do something if the tesselation has actually changed
-    if (!_tesselationChanged && !force) return;
-
     _tesselationChanged = false;
 
     if (!isValid())
     {
         _mesh.clear();
         _localAABB = AABB();
-        return;
+        return false;
     }
 
     // Run the tesselation code
     _mesh.generate(_width, _height, _ctrlTransformed, subdivisionsFixed(), getSubdivisions(), _node.getRenderEntity());
 
+    return true;
+}
+
+void Patch::updateTesselation(bool force)
+{
+    // Only do something if the tesselation has actually changed
+    if (!_tesselationChanged && !force) return;
+
+    if (!generateTesselation()) return;
+
     updateAABB();
 
     _node.onTesselationChanged();
 }
 
+void Patch::requestTesselationUpdate()
+{
+    // Patches which are not yet owned by a shared_ptr can't be queued
+    auto self = _node.weak_from_this().lock();
+
+    if (!patch::ScopedTesselationBatch::IsActive() || !self)
+    {
+        updateTesselation();
+        return;
+    }
+
+    // The bounds are derived from the control points, keep them up to date right away
+    updateAABB();
+
+    patch::ScopedTesselationBatch::AddPatch(self);
+}
+
+void Patch::UpdateTesselations(const std::vector<Patch*>& patches)
+{
+    std::vector<Patch*> changedPatches;
+    changedPatches.reserve(patches.size());
+
+    for (auto patch : patches)
+    {
+        if (patch->_tesselationChanged)
+        {
+            changedPatches.push_back(patch);
+        }
+    }
+
+    // Every patch only touches its own mesh, so these can run concurrently
+    std::vector<char> validPatches(changedPatches.size(), 0);
+
+    util::parallelFor(changedPatches.size(), 16, [&](std::size_t begin, std::size_t end)
+    {
+        for (auto i = begin; i < end; ++i)
+        {
+            validPatches[i] = changedPatches[i]->generateTesselation() ? 1 : 0;
+        }
+    });
+
+    // The notifications need to happen in the calling thread
+    for (std::size_t i = 0; i < changedPatches.size(); ++i)
+    {
+        if (!validPatches[i]) continue;
+
+        changedPatches[i]->updateAABB();
+        changedPatches[i]->_node.onTesselationChanged();
+    }
+}
+
 void Patch::invertMatrix()
 {
   undoSave();
@@ -1740,6 +1801,10 @@ PatchMesh Patch::getTesselatedPatchMesh() const
     mesh.width = _mesh.width;
     mesh.height = _mesh.height;
 
+    mesh.vertices.reserve(_mesh.vertices.size());
+    mesh.tangents.reserve(_mesh.vertices.size());
+    mesh.bitangents.reserve(_mesh.vertices.size());
+
     for (std::vector<MeshVertex>::const_iterator i = _mesh.vertices.begin();
         i != _mesh.vertices.end(); ++i)
     {
@@ -1750,6 +1815,8 @@ PatchMesh Patch::getTesselatedPatchMesh() const
         v.normal = i->normal;
 
         mesh.vertices.push_back(v);
+        mesh.tangents.push_back(i->tangent);
+        mesh.bitangents.push_back(i->bitangent);
     }
 
     return mesh;
@@ -329,7 +329,19 @@ public:
     void updateTesselation(bool force = false) override;
     void queueTesselationUpdate();
 
+    // Re-tesselates all of the given patches that need an update, distributing the
+    // work across threads. Notifications are sent from the calling thread.
+    static void UpdateTesselations(const std::vector<Patch*>& patches);
+
 private:
+    // Updates the tesselation right away, or defers it to the end of the
+    // currently active patch::ScopedTesselationBatch
+    void requestTesselationUpdate();
+
+    // Generates the mesh without sending any notifications, returns false if
+    // the patch is invalid and the mesh has been cleared
+    bool generateTesselation();
+
 	// This notifies the surfaceinspector/patchinspector about the texture change
 	void textureChanged();
 
@@ -1,6 +1,7 @@
 #include "PatchModule.h"
 
 #include "ifilter.h"
+#include "ijobsystem.h"
 #include "ilayer.h"
 #include "imap.h"
 #include "ipreferencesystem.h"
@@ -57,6 +58,7 @@ const StringSet& PatchModule::getDependencies() const
 	{
 		_dependencies.insert(MODULE_PREFERENCESYSTEM);
 		_dependencies.insert(MODULE_RENDERSYSTEM);
+		_dependencies.insert(MODULE_JOBSYSTEM);
 	}
 
 	return _dependencies;
@@ -79,6 +81,53 @@ void PatchModule::initialiseModule(const IApplicationContext& ctx)
 void PatchModule::shutdownModule()
 {
 	_patchTextureChanged.disconnect();
+
+	_pendingTesselations.clear();
+	_pendingTesselationSet.clear();
+}
+
+void PatchModule::beginTesselationBatch()
+{
+	++_tesselationBatchDepth;
+}
+
+void PatchModule::endTesselationBatch()
+{
+	if (--_tesselationBatchDepth > 0) return;
+
+	std::vector<scene::INodePtr> pendingNodes;
+	pendingNodes.swap(_pendingTesselations);
+	_pendingTesselationSet.clear();
+
+	std::vector<Patch*> patches;
+	patches.reserve(pendingNodes.size());
+
+	for (const auto& node : pendingNodes)
+	{
+		patches.push_back(&std::dynamic_pointer_cast<IPatchNode>(node)->getPatchInternal());
+	}
+
+	Patch::UpdateTesselations(patches);
+}
+
+bool PatchModule::isTesselationBatchActive() const
+{
+	return _tesselationBatchDepth > 0;
+}
+
+void PatchModule::queueTesselation(const scene::INodePtr& patchNode)
+{
+	if (_pendingTesselationSet.insert(patchNode.get()).second)
+	{
+		_pendingTesselations.push_back(patchNode);
+	}
+}
+
+PatchModule& PatchModule::GetInstanceInternal()
+{
+	// Cached, this is queried whenever patch control points change
+	static module::InstanceReference<PatchModule> _reference(MODULE_PATCH);
+	return _reference;
 }
 
 void PatchModule::registerPatchCommands()
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+#include <unordered_set>
 #include <sigc++/connection.h>
 #include "ipatch.h"
 #include "PatchSettings.h"
@@ -15,6 +17,14 @@ private:
 
 	sigc::connection _patchTextureChanged;
 
+	// State of the patch::ScopedTesselationBatch instances
+	std::size_t _tesselationBatchDepth = 0;
+
+	// The patch nodes queued for tesselation, the strong references keep
+	// the patches alive until the batch is done
+	std::vector<scene::INodePtr> _pendingTesselations;
+	std::unordered_set<scene::INode*> _pendingTesselationSet;
+
 public:
 	// PatchCreator implementation
 	scene::INodePtr createPatch(PatchDefType type) override;
@@ -27,6 +37,15 @@ public:
 	void initialiseModule(const IApplicationContext& ctx) override;
 	void shutdownModule() override;
 
+	// Tesselation batches, see patch::ScopedTesselationBatch
+	void beginTesselationBatch();
+	void endTesselationBatch();
+	bool isTesselationBatchActive() const;
+	void queueTesselation(const scene::INodePtr& patchNode);
+
+	// Internal accessor to the module instance
+	static PatchModule& GetInstanceInternal();
+
 private:
 	void registerPatchCommands();
 };
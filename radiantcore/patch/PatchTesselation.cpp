@@ -263,14 +263,17 @@ void PatchTesselation::sampleSinglePatchPoint(const MeshVertex ctrl[3][3], float
 void PatchTesselation::sampleSinglePatch(const MeshVertex ctrl[3][3],
 	std::size_t baseCol, std::size_t baseRow,
 	std::size_t w, std::size_t horzSub, std::size_t vertSub,
-	std::vector<MeshVertex>& outVerts) const
+	std::vector<MeshVertex>& outVerts, bool skipLastColumn, bool skipLastRow) const
 {
 	horzSub++;
 	vertSub++;
 
-	for (std::size_t i = 0; i < horzSub; i++)
+	std::size_t numColumns = skipLastColumn ? horzSub - 1 : horzSub;
+	std::size_t numRows = skipLastRow ? vertSub - 1 : vertSub;
+
+	for (std::size_t i = 0; i < numColumns; i++)
 	{
-		for (std::size_t j = 0; j < vertSub; j++)
+		for (std::size_t j = 0; j < numRows; j++)
 		{
 			float u = static_cast<float>(i) / (horzSub - 1);
 			float v = static_cast<float>(j) / (vertSub - 1);
@@ -733,17 +736,62 @@ void PatchTesselation::deriveFaceTangents(std::vector<FaceTangents>& faceTangent
 	}
 }
 
-void PatchTesselation::deriveTangents()
+void PatchTesselation::deriveTangents(const std::vector<bool>* changedVertices)
 {
 	if (lenStrips < 2) return;
 
+	std::size_t numFacesPerStrip = lenStrips - 2;
+
+	// In partial mode, only the vertices sharing a face with a changed vertex are affected
+	std::vector<bool> affected;
+
+	if (changedVertices != nullptr)
+	{
+		affected.resize(vertices.size(), false);
+
+		const RenderIndex* strip_indices = &indices.front();
+
+		for (std::size_t strip = 0; strip < numStrips; strip++, strip_indices += lenStrips)
+		{
+			for (std::size_t i = 0; i < lenStrips - 2; i += 2)
+			{
+				// The two triangles of this quad cover the indices i..i+3
+				if ((*changedVertices)[strip_indices[i]] || (*changedVertices)[strip_indices[i + 1]] ||
+					(*changedVertices)[strip_indices[i + 2]] || (*changedVertices)[strip_indices[i + 3]])
+				{
+					for (std::size_t j = 0; j < 4; j++)
+					{
+						affected[strip_indices[i + j]] = true;
+					}
+				}
+			}
+		}
+
+		// The affected tangents are summed up from scratch below
+		for (std::size_t v = 0; v < vertices.size(); v++)
+		{
+			if (affected[v])
+			{
+				vertices[v].tangent.set(0, 0, 0);
+				vertices[v].bitangent.set(0, 0, 0);
+			}
+		}
+	}
+
+	auto isAffected = [&](RenderIndex index)
+	{
+		return affected.empty() || affected[index];
+	};
+
 	std::vector<FaceTangents> faceTangents;
-	deriveFaceTangents(faceTangents);
 
-	// Note: we don't clear the tangent vectors here since the calling code
-	// just allocated the mesh which initialises all vectors to 0,0,0
+	if (affected.empty())
+	{
+		deriveFaceTangents(faceTangents);
+	}
 
-	std::size_t numFacesPerStrip = lenStrips - 2;
+	// Note: in full mode we don't clear the tangent vectors here since the calling code
+	// just allocated the mesh which initialises all vectors to 0,0,0
 
 	// The sum of all tangent vectors is assigned to each vertex of every face
 	// Since vertices can be shared across triangles this might very well add
@@ -754,26 +802,46 @@ void PatchTesselation::deriveTangents()
 	{
 		for (std::size_t i = 0; i < lenStrips - 2; i += 2)
 		{
-			// First tri of the quad
-			const FaceTangents& ft1 = faceTangents[strip*numFacesPerStrip + i];
+			FaceTangents quadTangents[2];
 
+			if (affected.empty())
+			{
+				quadTangents[0] = faceTangents[strip*numFacesPerStrip + i];
+				quadTangents[1] = faceTangents[strip*numFacesPerStrip + i + 1];
+			}
+			else if (isAffected(strip_indices[i]) || isAffected(strip_indices[i + 1]) ||
+				isAffected(strip_indices[i + 2]) || isAffected(strip_indices[i + 3]))
+			{
+				calculateFaceTangent(quadTangents[0], vertices[strip_indices[i + 0]],
+					vertices[strip_indices[i + 1]], vertices[strip_indices[i + 2]]);
+				calculateFaceTangent(quadTangents[1], vertices[strip_indices[i + 1]],
+					vertices[strip_indices[i + 2]], vertices[strip_indices[i + 3]]);
+			}
+			else
+			{
+				continue; // this quad doesn't touch any affected vertex
+			}
+
+			// First tri of the quad
 			for (std::size_t j = 0; j < 3; j++)
 			{
+				if (!isAffected(strip_indices[i + j])) continue;
+
 				MeshVertex& vert = vertices[strip_indices[i + j]];
 
-				vert.tangent += ft1.tangents[0];
-				vert.bitangent += ft1.tangents[1];
+				vert.tangent += quadTangents[0].tangents[0];
+				vert.bitangent += quadTangents[0].tangents[1];
 			}
 
 			// Second tri of the quad
-			const FaceTangents& ft2 = faceTangents[strip*numFacesPerStrip + i + 1];
-
 			for (std::size_t j = 0; j < 3; j++)
 			{
+				if (!isAffected(strip_indices[i + j + 1])) continue;
+
 				MeshVertex& vert = vertices[strip_indices[i + j + 1]];
 
-				vert.tangent += ft2.tangents[0];
-				vert.bitangent += ft2.tangents[1];
+				vert.tangent += quadTangents[1].tangents[0];
+				vert.bitangent += quadTangents[1].tangents[1];
 			}
 		}
 	}
@@ -782,8 +850,12 @@ void PatchTesselation::deriveTangents()
 	// and normalize.  The tangent vectors will not necessarily
 	// be orthogonal to each other, but they will be orthogonal
 	// to the surface normal.
-	for (MeshVertex& vert : vertices)
+	for (std::size_t v = 0; v < vertices.size(); v++)
 	{
+		if (!isAffected(static_cast<RenderIndex>(v))) continue;
+
+		MeshVertex& vert = vertices[v];
+
 		auto d = vert.tangent.dot(vert.normal);
 		vert.tangent = vert.tangent - vert.normal * d;
 		vert.tangent.normalise();
@@ -835,9 +907,8 @@ void PatchTesselation::generateIndices()
 	}
 }
 
-void PatchTesselation::generate(std::size_t patchWidth, std::size_t patchHeight,
-	const PatchControlArray& controlPoints, bool subdivionsFixed, const Subdivisions& subdivs,
-    IRenderEntity* renderEntity)
+void PatchTesselation::setupControlMesh(std::size_t patchWidth, std::size_t patchHeight,
+	const PatchControlArray& controlPoints)
 {
 	width = patchWidth;
 	height = patchHeight;
@@ -846,7 +917,8 @@ void PatchTesselation::generate(std::size_t patchWidth, std::size_t patchHeight,
 	_maxHeight = height;
 
 	// We start off with the control vertex grid, copy it into our tesselation structure
-	vertices.resize(controlPoints.size());
+	// Start with fresh vertices, the tangents are accumulated in deriveTangents()
+	vertices.assign(controlPoints.size(), MeshVertex());
 
 	for (std::size_t w = 0; w < width; w++)
 	{
@@ -859,6 +931,163 @@ void PatchTesselation::generate(std::size_t patchWidth, std::size_t patchHeight,
 
 	// generate normals for the control mesh
 	generateNormals();
+}
+
+namespace
+{
+
+inline bool controlVertexChanged(const MeshVertex& a, const MeshVertex& b)
+{
+	return a.vertex != b.vertex || a.normal != b.normal || a.texcoord != b.texcoord;
+}
+
+}
+
+bool PatchTesselation::updateChangedSpans(std::vector<MeshVertex>& controlMesh, const Vector4& colour)
+{
+	std::size_t subdivX = _subdivisions.x();
+	std::size_t subdivY = _subdivisions.y();
+	std::size_t numSpansX = (_controlWidth - 1) / 2;
+	std::size_t numSpansY = (_controlHeight - 1) / 2;
+
+	std::vector<bool> changedVertices;
+	MeshVertex sample[3][3];
+
+	// Walk the spans in the same order as subdivideMeshFixed() does
+	for (std::size_t spanX = 0; spanX < numSpansX; spanX++)
+	{
+		for (std::size_t spanY = 0; spanY < numSpansY; spanY++)
+		{
+			std::size_t i = spanX * 2;
+			std::size_t j = spanY * 2;
+			bool spanChanged = false;
+
+			for (std::size_t k = 0; k < 3; k++)
+			{
+				for (std::size_t l = 0; l < 3; l++)
+				{
+					std::size_t index = ((j + l) * _controlWidth) + i + k;
+
+					sample[k][l] = controlMesh[index];
+					spanChanged |= controlVertexChanged(controlMesh[index], _controlMesh[index]);
+				}
+			}
+
+			if (!spanChanged) continue;
+
+			if (changedVertices.empty())
+			{
+				changedVertices.resize(vertices.size(), false);
+			}
+
+			std::size_t baseCol = spanX * subdivX;
+			std::size_t baseRow = spanY * subdivY;
+
+			// The last column and row are shared with the following spans, which are
+			// sampled after this one in a full run. Leave those vertices to them.
+			bool skipLastColumn = spanX + 1 < numSpansX;
+			bool skipLastRow = spanY + 1 < numSpansY;
+
+			sampleSinglePatch(sample, baseCol, baseRow, width, subdivX, subdivY,
+				vertices, skipLastColumn, skipLastRow);
+
+			std::size_t numColumns = skipLastColumn ? subdivX : subdivX + 1;
+			std::size_t numRows = skipLastRow ? subdivY : subdivY + 1;
+
+			for (std::size_t row = baseRow; row < baseRow + numRows; row++)
+			{
+				for (std::size_t col = baseCol; col < baseCol + numColumns; col++)
+				{
+					MeshVertex& vertex = vertices[row * width + col];
+
+					if (vertex.normal.getLengthSquared() > 0)
+					{
+						vertex.normal.normalise();
+					}
+
+					changedVertices[row * width + col] = true;
+				}
+			}
+		}
+	}
+
+	if (changedVertices.empty())
+	{
+		return false;
+	}
+
+	for (MeshVertex& vertex : vertices)
+	{
+		vertex.colour = colour;
+	}
+
+	_controlMesh.swap(controlMesh);
+
+	deriveTangents(&changedVertices);
+
+	return true;
+}
+
+void PatchTesselation::generate(std::size_t patchWidth, std::size_t patchHeight,
+	const PatchControlArray& controlPoints, bool subdivionsFixed, const Subdivisions& subdivs,
+    IRenderEntity* renderEntity)
+{
+    auto colour = renderEntity ? renderEntity->getEntityColour() : Vector4(1, 1, 1, 1);
+
+	// Fixed subdivisions map every 3x3 span to its own block of vertices, so if the layout
+	// didn't change we only need to re-sample the spans whose control vertices changed
+	bool canUpdateIncrementally = subdivionsFixed && _subdivisionsFixed &&
+		subdivs == _subdivisions && patchWidth == _controlWidth && patchHeight == _controlHeight &&
+		!vertices.empty() && _controlMesh.size() == controlPoints.size();
+
+	// Keep the previous tesselation around when trying to do an incremental update
+	std::vector<MeshVertex> previousVertices;
+	std::size_t previousWidth = width;
+	std::size_t previousHeight = height;
+
+	if (canUpdateIncrementally)
+	{
+		previousVertices.swap(vertices);
+	}
+
+	setupControlMesh(patchWidth, patchHeight, controlPoints);
+
+	if (canUpdateIncrementally)
+	{
+		std::vector<MeshVertex> controlMesh;
+		controlMesh.swap(vertices);
+
+		vertices.swap(previousVertices);
+		width = _maxWidth = previousWidth;
+		height = _maxHeight = previousHeight;
+
+		if (!updateChangedSpans(controlMesh, colour))
+		{
+			// No control vertex changed, the mesh is still valid, just refresh the colour
+			for (MeshVertex& vertex : vertices)
+			{
+				vertex.colour = colour;
+			}
+		}
+
+		return;
+	}
+
+	// Remember the input for the next run, adaptive subdivision always
+	// re-tesselates the whole patch and doesn't need it
+	if (subdivionsFixed)
+	{
+		_controlMesh = vertices;
+	}
+	else
+	{
+		std::vector<MeshVertex>().swap(_controlMesh);
+	}
+
+	_controlWidth = patchWidth;
+	_controlHeight = patchHeight;
+	_subdivisionsFixed = subdivionsFixed;
+	_subdivisions = subdivs;
 
 	if (subdivionsFixed)
 	{
@@ -870,8 +1099,6 @@ void PatchTesselation::generate(std::size_t patchWidth, std::size_t patchHeight,
 	}
 
     // Final update: assign colours and normalise normals
-    auto colour = renderEntity ? renderEntity->getEntityColour() : Vector4(1, 1, 1, 1);
-
 	for (MeshVertex& vertex : vertices)
 	{
 	    // normalize all the lerped normals
@@ -29,6 +29,16 @@ private:
 	std::size_t _maxWidth;
 	std::size_t _maxHeight;
 
+	// The input of the last generate() call: the control vertices including
+	// their derived normals, plus the subdivision parameters. This is used to
+	// detect which spans of a fixed-subdivision patch need to be re-tesselated,
+	// the control mesh is left empty for patches using adaptive subdivision.
+	std::vector<MeshVertex> _controlMesh;
+	std::size_t _controlWidth;
+	std::size_t _controlHeight;
+	bool _subdivisionsFixed;
+	Subdivisions _subdivisions;
+
 public:
 
     /// Construct an uninitialised patch tesselation
@@ -38,17 +48,31 @@ public:
 		width(0),
 		height(0),
 		_maxWidth(0),
-		_maxHeight(0)
+		_maxHeight(0),
+		_controlWidth(0),
+		_controlHeight(0),
+		_subdivisionsFixed(false),
+		_subdivisions(0, 0)
 	{}
 
     /// Clear all patch data
     void clear();
 
-	// Generates the tesselated mesh based on the input parameters
+	// Generates the tesselated mesh based on the input parameters.
+	// If the mesh has been generated before using the same dimensions and fixed
+	// subdivisions, only the spans affected by changed control points are
+	// re-tesselated, the result is the same as a full re-generation.
 	void generate(std::size_t width, std::size_t height, const PatchControlArray& controlPoints, 
 		bool subdivionsFixed, const Subdivisions& subdivs, IRenderEntity* renderEntity);
 
 private:
+	// Copies the control points into the vertex array and derives their normals
+	void setupControlMesh(std::size_t patchWidth, std::size_t patchHeight, const PatchControlArray& controlPoints);
+
+	// Re-samples the spans of a fixed-subdivision mesh whose control vertices
+	// differ from the ones in _controlMesh. Returns false if nothing changed.
+	bool updateChangedSpans(std::vector<MeshVertex>& controlMesh, const Vector4& colour);
+
 	// Private methods used for tesselation, modeled after the patch subdivision code found in idTech4
 	void generateIndices();
 	void generateNormals();
@@ -63,10 +87,15 @@ private:
 	static void lerpVert(const MeshVertex& a, const MeshVertex& b, MeshVertex&out);
 	static Vector3 projectPointOntoVector(const Vector3& point, const Vector3& vStart, const Vector3& vEnd);
 
+	// Samples a single 3x3 span into the output vertices. The span's last column and/or row
+	// can be skipped, these are shared with the neighbouring span that is sampled after this one.
 	void sampleSinglePatch(const MeshVertex ctrl[3][3], std::size_t baseCol, std::size_t baseRow, 
 		std::size_t width, std::size_t horzSub, std::size_t vertSub, 
-		std::vector<MeshVertex>& outVerts) const;
+		std::vector<MeshVertex>& outVerts, bool skipLastColumn = false, bool skipLastRow = false) const;
 	void sampleSinglePatchPoint(const MeshVertex ctrl[3][3], float u, float v, MeshVertex& out) const;
-	void deriveTangents();
+
+	// Derives the tangents of all vertices, or only of the vertices that share
+	// a face with one of the vertices flagged in the given (optional) array
+	void deriveTangents(const std::vector<bool>* changedVertices = nullptr);
 	void deriveFaceTangents(std::vector<FaceTangents>& faceTangents);
 };
@@ -0,0 +1,28 @@
+#include "PatchTesselationBatch.h"
+
+#include "PatchModule.h"
+
+namespace patch
+{
+
+ScopedTesselationBatch::ScopedTesselationBatch()
+{
+    PatchModule::GetInstanceInternal().beginTesselationBatch();
+}
+
+ScopedTesselationBatch::~ScopedTesselationBatch()
+{
+    PatchModule::GetInstanceInternal().endTesselationBatch();
+}
+
+bool ScopedTesselationBatch::IsActive()
+{
+    return PatchModule::GetInstanceInternal().isTesselationBatchActive();
+}
+
+void ScopedTesselationBatch::AddPatch(const scene::INodePtr& patchNode)
+{
+    PatchModule::GetInstanceInternal().queueTesselation(patchNode);
+}
+
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "inode.h"
+
+namespace patch
+{
+
+/**
+ * While an instance of this class is alive, patches whose control points are
+ * changed don't re-tesselate right away, their tesselation is deferred until
+ * the outermost batch goes out of scope. All pending patches are then
+ * tesselated in parallel, the renderables are notified afterwards.
+ *
+ * Intended for bulk operations like map loading or freezing the transform
+ * of a large selection. Batches can be nested, they must only be used in
+ * the main thread.
+ */
+class ScopedTesselationBatch final
+{
+public:
+    ScopedTesselationBatch();
+    ~ScopedTesselationBatch();
+
+    ScopedTesselationBatch(const ScopedTesselationBatch& other) = delete;
+    ScopedTesselationBatch& operator=(const ScopedTesselationBatch& other) = delete;
+
+    // Returns true if a batch is currently active
+    static bool IsActive();
+
+    // Queues the given patch node for tesselation when the batch ends
+    static void AddPatch(const scene::INodePtr& patchNode);
+};
+
+}
@@ -0,0 +1,230 @@
+#include "Profiler.h"
+
+#include <fstream>
+#include "itextstream.h"
+#include "module/StaticModule.h"
+#include "os/path.h"
+#include <fmt/format.h>
+
+namespace profiling
+{
+
+namespace
+{
+    // Shared by all profiler instances, such that a thread never mistakes
+    // a buffer of a previous instance for the one of the current instance
+    std::atomic<std::size_t> _nextGeneration(1);
+
+    struct ThreadBufferReference
+    {
+        std::size_t generation = 0;
+        std::shared_ptr<Profiler::ThreadBuffer> buffer;
+    };
+
+    thread_local ThreadBufferReference _threadBuffer;
+
+    std::string escapeJsonString(const char* input)
+    {
+        std::string result;
+
+        for (auto c = input; *c != '\0'; ++c)
+        {
+            switch (*c)
+            {
+            case '"': result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20) continue;
+                result += *c;
+            }
+        }
+
+        return result;
+    }
+}
+
+Profiler::Profiler() :
+    _enabled(false),
+    _epoch(std::chrono::steady_clock::now()),
+    _generation(_nextGeneration++)
+{}
+
+const std::string& Profiler::getName() const
+{
+    static std::string _name(MODULE_PROFILER);
+    return _name;
+}
+
+const StringSet& Profiler::getDependencies() const
+{
+    static StringSet _dependencies
+    {
+        MODULE_COMMANDSYSTEM,
+    };
+
+    return _dependencies;
+}
+
+void Profiler::initialiseModule(const IApplicationContext& ctx)
+{
+    _mainThreadId = std::this_thread::get_id();
+    _settingsPath = ctx.getSettingsPath();
+
+    GlobalCommandSystem().addCommand("StartProfiling", std::bind(&Profiler::startProfilingCmd, this, std::placeholders::_1));
+    GlobalCommandSystem().addCommand("StopProfiling", std::bind(&Profiler::stopProfilingCmd, this, std::placeholders::_1));
+    GlobalCommandSystem().addCommand("ExportProfilingTrace", std::bind(&Profiler::exportTraceCmd, this, std::placeholders::_1),
+        { cmd::ARGTYPE_STRING | cmd::ARGTYPE_OPTIONAL });
+}
+
+void Profiler::shutdownModule()
+{
+    setEnabled(false);
+    clear();
+}
+
+bool Profiler::isEnabled() const
+{
+    return _enabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::setEnabled(bool enabled)
+{
+    _enabled = enabled;
+}
+
+std::int64_t Profiler::getTimestamp() const
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _epoch).count();
+}
+
+Profiler::ThreadBuffer& Profiler::getBufferForCurrentThread()
+{
+    if (_threadBuffer.generation != _generation.load())
+    {
+        auto buffer = std::make_shared<ThreadBuffer>();
+        buffer->isMainThread = std::this_thread::get_id() == _mainThreadId;
+
+        std::lock_guard<std::mutex> lock(_buffersLock);
+
+        buffer->threadIndex = _buffers.size();
+        _buffers.push_back(buffer);
+
+        _threadBuffer.generation = _generation;
+        _threadBuffer.buffer = buffer;
+    }
+
+    return *_threadBuffer.buffer;
+}
+
+void Profiler::beginZone(const char* name)
+{
+    getBufferForCurrentThread().openZones.emplace_back(name, getTimestamp());
+}
+
+void Profiler::endZone()
+{
+    auto end = getTimestamp();
+    auto& buffer = getBufferForCurrentThread();
+
+    // The zone might have been opened before the last clear()
+    if (buffer.openZones.empty()) return;
+
+    Zone zone{ buffer.openZones.back().first, buffer.openZones.back().second, end };
+    buffer.openZones.pop_back();
+
+    std::lock_guard<std::mutex> lock(buffer.lock);
+
+    if (buffer.zones.size() < MaxZonesPerThread)
+    {
+        buffer.zones.push_back(zone);
+    }
+    else
+    {
+        buffer.zones[buffer.nextZone] = zone;
+    }
+
+    buffer.nextZone = (buffer.nextZone + 1) % MaxZonesPerThread;
+}
+
+void Profiler::clear()
+{
+    std::lock_guard<std::mutex> lock(_buffersLock);
+
+    // The threads will pick up new buffers the next time they record a zone
+    _generation = _nextGeneration++;
+    _buffers.clear();
+}
+
+void Profiler::exportChromeTrace(std::ostream& stream)
+{
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+    {
+        std::lock_guard<std::mutex> lock(_buffersLock);
+        buffers = _buffers;
+    }
+
+    stream << "{\"traceEvents\":[";
+
+    bool first = true;
+
+    auto writeSeparator = [&]()
+    {
+        stream << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    for (const auto& buffer : buffers)
+    {
+        writeSeparator();
+        stream << fmt::format(R"({{"name":"thread_name","ph":"M","pid":1,"tid":{0},"args":{{"name":"{1}"}}}})",
+            buffer->threadIndex, buffer->isMainThread ? "Main thread" : fmt::format("Thread {0}", buffer->threadIndex));
+
+        std::lock_guard<std::mutex> lock(buffer->lock);
+
+        for (const auto& zone : buffer->zones)
+        {
+            // Trace event timestamps are in microseconds
+            writeSeparator();
+            stream << fmt::format(R"({{"name":"{0}","cat":"zone","ph":"X","pid":1,"tid":{1},"ts":{2:.3f},"dur":{3:.3f}}})",
+                escapeJsonString(zone.name), buffer->threadIndex, zone.start / 1000.0, (zone.end - zone.start) / 1000.0);
+        }
+    }
+
+    stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+void Profiler::startProfilingCmd(const cmd::ArgumentList& args)
+{
+    setEnabled(true);
+    rMessage() << "Profiler: recording zones" << std::endl;
+}
+
+void Profiler::stopProfilingCmd(const cmd::ArgumentList& args)
+{
+    setEnabled(false);
+    rMessage() << "Profiler: stopped recording zones" << std::endl;
+}
+
+void Profiler::exportTraceCmd(const cmd::ArgumentList& args)
+{
+    auto path = !args.empty() && !args[0].getString().empty() ?
+        args[0].getString() : os::standardPathWithSlash(_settingsPath) + "profile_trace.json";
+
+    std::ofstream stream(path);
+
+    if (!stream.is_open())
+    {
+        rError() << "Profiler: cannot open " << path << " for writing" << std::endl;
+        return;
+    }
+
+    exportChromeTrace(stream);
+
+    rMessage() << "Profiler: trace written to " << path << std::endl;
+}
+
+// Static module instance
+module::StaticModuleRegistration<Profiler> profilerModule;
+
+}
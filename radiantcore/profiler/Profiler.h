@@ -0,0 +1,87 @@
+#pragma once
+
+#include "iprofiler.h"
+#include "icommandsystem.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace profiling
+{
+
+class Profiler :
+    public IProfiler
+{
+public:
+    // Number of zones kept per thread, older zones are overwritten
+    static constexpr std::size_t MaxZonesPerThread = 1 << 16;
+
+    struct Zone
+    {
+        const char* name;
+
+        // Nanoseconds since the profiler has been constructed
+        std::int64_t start;
+        std::int64_t end;
+    };
+
+    // The zones recorded by a single thread
+    struct ThreadBuffer
+    {
+        std::size_t threadIndex;
+        bool isMainThread;
+
+        // Only accessed by the owning thread
+        std::vector<std::pair<const char*, std::int64_t>> openZones;
+
+        // Ring buffer of the completed zones
+        std::mutex lock;
+        std::vector<Zone> zones;
+        std::size_t nextZone = 0;
+    };
+
+private:
+    std::atomic<bool> _enabled;
+
+    std::chrono::steady_clock::time_point _epoch;
+
+    // Changes with every clear(), threads get a new buffer when they notice
+    std::atomic<std::size_t> _generation;
+
+    std::mutex _buffersLock;
+    std::vector<std::shared_ptr<ThreadBuffer>> _buffers;
+
+    std::thread::id _mainThreadId;
+    std::string _settingsPath;
+
+public:
+    Profiler();
+
+    // RegisterableModule implementation
+    const std::string& getName() const override;
+    const StringSet& getDependencies() const override;
+    void initialiseModule(const IApplicationContext& ctx) override;
+    void shutdownModule() override;
+
+    bool isEnabled() const override;
+    void setEnabled(bool enabled) override;
+    void beginZone(const char* name) override;
+    void endZone() override;
+    void clear() override;
+    void exportChromeTrace(std::ostream& stream) override;
+
+private:
+    std::int64_t getTimestamp() const;
+    ThreadBuffer& getBufferForCurrentThread();
+
+    void startProfilingCmd(const cmd::ArgumentList& args);
+    void stopProfilingCmd(const cmd::ArgumentList& args);
+    void exportTraceCmd(const cmd::ArgumentList& args);
+};
+
+}
@@ -181,6 +181,9 @@ void OpenGLRenderSystem::startFrame()
 {
     // Prepare the storage objects
     _geometryStore.onFrameStart();
+
+    // Let the texture manager release what exceeds its memory budget
+    GlobalMaterialManager().startFrame();
 }
 
 void OpenGLRenderSystem::endFrame()
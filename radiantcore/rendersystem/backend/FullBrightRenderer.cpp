@@ -2,6 +2,7 @@
 
 #include "OpenGLShaderPass.h"
 #include "OpenGLShader.h"
+#include "iprofiler.h"
 
 namespace render
 {
@@ -30,6 +31,8 @@ public:
 
 IRenderResult::Ptr FullBrightRenderer::render(RenderStateFlags globalstate, const IRenderView& view, std::size_t time)
 {
+    PROFILE_ZONE("FullBrightRenderer::render");
+
     // Make sure all the data is uploaded
     _geometryStore.syncToBufferObjects();
 
@@ -52,13 +52,13 @@ InteractionPass::InteractionPass(OpenGLShader& owner, OpenGLRenderSystem& render
 
     for (auto&& stage : stages)
     {
-        auto texture = getTextureOrInteractionDefault(stage)->getGLTexNum();
+        auto texture = owner.getPassTextureNumber(getTextureOrInteractionDefault(stage));
         _interactionStages.emplace_back(Stage{ std::move(stage), texture });
     }
 
-    _defaultBumpTexture = getDefaultInteractionTexture(IShaderLayer::BUMP)->getGLTexNum();
-    _defaultDiffuseTexture = getDefaultInteractionTexture(IShaderLayer::DIFFUSE)->getGLTexNum();
-    _defaultSpecularTexture = getDefaultInteractionTexture(IShaderLayer::SPECULAR)->getGLTexNum();
+    _defaultBumpTexture = owner.getPassTextureNumber(getDefaultInteractionTexture(IShaderLayer::BUMP));
+    _defaultDiffuseTexture = owner.getPassTextureNumber(getDefaultInteractionTexture(IShaderLayer::DIFFUSE));
+    _defaultSpecularTexture = owner.getPassTextureNumber(getDefaultInteractionTexture(IShaderLayer::SPECULAR));
 }
 
 GLuint InteractionPass::getDefaultInteractionTextureBinding(IShaderLayer::Type type)
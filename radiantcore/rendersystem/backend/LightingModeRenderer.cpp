@@ -6,6 +6,7 @@
 #include "OpenGLShader.h"
 #include "ObjectRenderer.h"
 #include "OpenGLState.h"
+#include "iprofiler.h"
 #include "glprogram/CubeMapProgram.h"
 #include "glprogram/DepthFillAlphaProgram.h"
 #include "glprogram/InteractionProgram.h"
@@ -62,6 +63,8 @@ void LightingModeRenderer::ensureShadowMapSetup()
 IRenderResult::Ptr LightingModeRenderer::render(RenderStateFlags globalFlagsMask, 
     const IRenderView& view, std::size_t time)
 {
+    PROFILE_ZONE("LightingModeRenderer::render");
+
     _result = std::make_shared<LightingModeRenderResult>();
 
     ensureShadowMapSetup();
@@ -117,6 +120,8 @@ IRenderResult::Ptr LightingModeRenderer::render(RenderStateFlags globalFlagsMask
 
 void LightingModeRenderer::collectLights(const IRenderView& view)
 {
+    PROFILE_ZONE("LightingModeRenderer::collectLights");
+
     _regularLights.reserve(_lights.size());
 
     // Categorise all visible lights
@@ -230,6 +235,8 @@ void LightingModeRenderer::addToShadowLights(RegularLight& light, const Vector3&
 void LightingModeRenderer::drawInteractingLights(OpenGLState& current, RenderStateFlags globalFlagsMask,
     const IRenderView& view, std::size_t renderTime)
 {
+    PROFILE_ZONE("LightingModeRenderer::drawInteractingLights");
+
     // Draw the surfaces per light and material
     auto interactionState = InteractionPass::GenerateInteractionState(_programFactory);
 
@@ -276,6 +283,8 @@ void LightingModeRenderer::drawInteractingLights(OpenGLState& current, RenderSta
 void LightingModeRenderer::drawBlendLights(OpenGLState& current, RenderStateFlags globalFlagsMask,
     const IRenderView& view, std::size_t renderTime)
 {
+    PROFILE_ZONE("LightingModeRenderer::drawBlendLights");
+
     if (_blendLights.empty()) return;
 
     // Set the openGL state
@@ -294,6 +303,8 @@ void LightingModeRenderer::drawBlendLights(OpenGLState& current, RenderStateFlag
 
 void LightingModeRenderer::drawShadowMaps(OpenGLState& current,std::size_t renderTime)
 {
+    PROFILE_ZONE("LightingModeRenderer::drawShadowMaps");
+
     if (!_shadowMappingEnabled.get()) return;
 
     // Draw the shadow maps of each light
@@ -356,6 +367,8 @@ void LightingModeRenderer::drawShadowMaps(OpenGLState& current,std::size_t rende
 void LightingModeRenderer::drawDepthFillPass(OpenGLState& current, RenderStateFlags globalFlagsMask,
     const IRenderView& view, std::size_t renderTime)
 {
+    PROFILE_ZONE("LightingModeRenderer::drawDepthFillPass");
+
     // Run the depth fill pass
     auto depthFillState = DepthFillPass::GenerateDepthFillState(_programFactory);
 
@@ -393,6 +406,8 @@ void LightingModeRenderer::drawDepthFillPass(OpenGLState& current, RenderStateFl
 void LightingModeRenderer::drawNonInteractionPasses(OpenGLState& current, RenderStateFlags globalFlagsMask, 
     const IRenderView& view, std::size_t time)
 {
+    PROFILE_ZONE("LightingModeRenderer::drawNonInteractionPasses");
+
     glUseProgram(0);
     glActiveTexture(GL_TEXTURE0);
     glClientActiveTexture(GL_TEXTURE0);
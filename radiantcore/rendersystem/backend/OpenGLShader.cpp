@@ -78,6 +78,24 @@ void OpenGLShader::destroy()
     _materialChanged.disconnect();
     _material.reset();
     clearPasses();
+
+    // The passes are gone, the textures may be released again
+    for (const auto& texture : _passTextures)
+    {
+        texture->removePassReference();
+    }
+
+    _passTextures.clear();
+}
+
+GLuint OpenGLShader::getPassTextureNumber(const TexturePtr& texture)
+{
+    if (!texture) return 0;
+
+    texture->addPassReference();
+    _passTextures.push_back(texture);
+
+    return texture->getGLTexNum();
 }
 
 void OpenGLShader::addRenderable(const OpenGLRenderable& renderable,
@@ -485,9 +503,9 @@ void OpenGLShader::constructLightingPassesFromMaterial()
             auto& zPass = appendDepthFillPass();
 
             zPass.stage0 = diffuseForDepthFillPass;
-            zPass.texture0 = diffuseForDepthFillPass ? 
-                getTextureOrInteractionDefault(diffuseForDepthFillPass)->getGLTexNum() :
-                getDefaultInteractionTexture(IShaderLayer::DIFFUSE)->getGLTexNum();
+            zPass.texture0 = getPassTextureNumber(diffuseForDepthFillPass ?
+                getTextureOrInteractionDefault(diffuseForDepthFillPass) :
+                getDefaultInteractionTexture(IShaderLayer::DIFFUSE));
             zPass.alphaThreshold = diffuseForDepthFillPass ? diffuseForDepthFillPass->getAlphaTest() : -1.0f;
         }
 
@@ -524,7 +542,7 @@ void OpenGLShader::constructEditorPreviewPassFromMaterial()
 
     // Render the editor texture in legacy mode
     auto editorTex = _material->getEditorImage();
-    previewPass.texture0 = editorTex ? editorTex->getGLTexNum() : 0;
+    previewPass.texture0 = getPassTextureNumber(editorTex);
 
     // If there's a diffuse stage's, link it to this shader pass to inherit
     // settings like scale and translate
@@ -594,12 +612,12 @@ void OpenGLShader::appendBlendLayer(const IShaderLayer::Ptr& layer)
 	state.stage0 = layer;
 
     // Set the texture
-    state.texture0 = layerTex->getGLTexNum();
+    state.texture0 = getPassTextureNumber(layerTex);
 
     // BlendLights need to load the fall off image into texture unit 1
     if (_material->isBlendLight())
     {
-        state.texture1 = _material->lightFalloffImage()->getGLTexNum();
+        state.texture1 = getPassTextureNumber(_material->lightFalloffImage());
         state.setRenderFlag(RENDER_CULLFACE);
     }
 
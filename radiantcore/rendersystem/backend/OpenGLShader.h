@@ -65,6 +65,9 @@ private:
 
     bool _mergeModeActive;
 
+    // The textures whose GL numbers have been stored in the passes of this shader
+    std::vector<TexturePtr> _passTextures;
+
 private:
 
     void constructFromMaterial(const MaterialPtr& material);
@@ -161,6 +164,10 @@ public:
     // Returns the interaction pass of this shader, or null if this shader doesn't have one
     InteractionPass* getInteractionPass() const;
 
+    // Returns the GL number of the given texture, to be stored in one of the passes.
+    // The texture is kept loaded until this shader is unrealised.
+    GLuint getPassTextureNumber(const TexturePtr& texture);
+
 protected:
     // Start point for constructing shader passes from the shader name
     virtual void construct();
@@ -7,14 +7,29 @@
 #include "debugging/debugging.h"
 
 #include "math/AABB.h"
+#include "math/AABBBatch.h"
 #include "Octree.h"
 #include "SceneGraphFactory.h"
 #include "util/ScopedBoolLock.h"
 #include "module/StaticModule.h"
 
+#include <deque>
+
 namespace scene
 {
 
+struct SceneGraph::ChildCullingStack
+{
+	struct Level
+	{
+		AABBBatch bounds;
+		std::vector<VolumeIntersectionValue> results;
+	};
+
+	// Deque elements stay in place when deeper levels are added
+	std::deque<Level> levels;
+};
+
 SceneGraph::SceneGraph() :
 	_spacePartition(new Octree),
 	_visitedSPNodes(0),
@@ -257,7 +272,8 @@ void SceneGraph::foreachNodeInVolume(const VolumeTest& volume, const INode::Visi
 
         _visitedSPNodes = _skippedSPNodes = 0;
 
-        foreachNodeInVolume_r(*root, volume, functor, visitHidden);
+        ChildCullingStack cullingStack;
+        foreachNodeInVolume_r(*root, volume, functor, visitHidden, cullingStack, 0);
 
         _visitedSPNodes = _skippedSPNodes = 0;
     }
@@ -283,7 +299,8 @@ void SceneGraph::foreachVisibleNodeInVolume(const VolumeTest& volume, Walker& wa
 }
 
 bool SceneGraph::foreachNodeInVolume_r(const ISPNode& node, const VolumeTest& volume,
-									   const INode::VisitorFunc& functor, bool visitHidden)
+									   const INode::VisitorFunc& functor, bool visitHidden,
+									   ChildCullingStack& cullingStack, std::size_t depth)
 {
 	_visitedSPNodes++;
 
@@ -310,9 +327,32 @@ bool SceneGraph::foreachNodeInVolume_r(const ISPNode& node, const VolumeTest& vo
 	// Now consider the children
 	const ISPNode::NodeList& children = node.getChildNodes();
 
-	for (ISPNode::NodeList::const_iterator i = children.begin(); i != children.end(); ++i)
+	if (children.empty())
+	{
+		return true;
+	}
+
+	// Classify all children in one go
+	if (cullingStack.levels.size() <= depth)
+	{
+		cullingStack.levels.emplace_back();
+	}
+
+	auto& culling = cullingStack.levels[depth];
+
+	culling.bounds.clear();
+
+	for (const auto& child : children)
+	{
+		culling.bounds.add(child->getBounds());
+	}
+
+	culling.results.resize(children.size());
+	volume.TestAABBs(culling.bounds, culling.results.data());
+
+	for (std::size_t i = 0; i < children.size(); ++i)
 	{
-		if (volume.TestAABB((*i)->getBounds()) == VOLUME_OUTSIDE)
+		if (culling.results[i] == VOLUME_OUTSIDE)
 		{
 			// Skip this node, not visible
 			_skippedSPNodes++;
@@ -320,7 +360,7 @@ bool SceneGraph::foreachNodeInVolume_r(const ISPNode& node, const VolumeTest& vo
 		}
 
 		// Traverse all the children too, enter recursion
-		if (!foreachNodeInVolume_r(**i, volume, functor, visitHidden))
+		if (!foreachNodeInVolume_r(*children[i], volume, functor, visitHidden, cullingStack, depth + 1))
 		{
 			// The walker returned false somewhere in the recursion depths, propagate this message
 			return false;
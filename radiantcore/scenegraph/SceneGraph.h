@@ -99,9 +99,13 @@ public:
 private:
 	void foreachNodeInVolume(const VolumeTest& volume, const INode::VisitorFunc& functor, bool visitHidden);
 
+	// Child bounds and classifications of the SpacePartition nodes, one entry per tree level
+	struct ChildCullingStack;
+
 	// Recursive method used to descend the SpacePartition tree, returns FALSE if the walker signaled stop
 	bool foreachNodeInVolume_r(const ISPNode& node, const VolumeTest& volume, 
-							   const INode::VisitorFunc& functor, bool visitHidden);
+							   const INode::VisitorFunc& functor, bool visitHidden,
+							   ChildCullingStack& cullingStack, std::size_t depth);
 
     void flushActionBuffer();
 
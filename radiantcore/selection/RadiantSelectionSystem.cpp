@@ -6,9 +6,11 @@
 #include "iselectiongroup.h"
 #include "iradiant.h"
 #include "ipreferencesystem.h"
+#include "iprofiler.h"
 #include "selection/SelectionPool.h"
 #include "module/StaticModule.h"
 #include "brush/csg/CSG.h"
+#include "patch/PatchTesselationBatch.h"
 #include "selection/algorithm/General.h"
 #include "selection/algorithm/Primitives.h"
 #include "selection/algorithm/Transformation.h"
@@ -43,7 +45,8 @@ RadiantSelectionSystem::RadiantSelectionSystem() :
     _componentMode(ComponentSelectionMode::Default),
     _countPrimitive(0),
     _countComponent(0),
-    _selectionFocusActive(false)
+    _selectionFocusActive(false),
+    _transactionDepth(0)
 {}
 
 const SelectionInfo& RadiantSelectionSystem::getSelectionInfo() {
@@ -73,6 +76,94 @@ void RadiantSelectionSystem::notifyObservers(const scene::INodePtr& node, bool i
     }
 }
 
+void RadiantSelectionSystem::beginTransaction()
+{
+    ++_transactionDepth;
+}
+
+void RadiantSelectionSystem::endTransaction()
+{
+    if (_transactionDepth == 0)
+    {
+        rWarning() << "RadiantSelectionSystem: endTransaction() called without active transaction" << std::endl;
+        return;
+    }
+
+    if (--_transactionDepth == 0)
+    {
+        flushPendingChanges();
+    }
+}
+
+void RadiantSelectionSystem::onSelectionChanged(const scene::INodePtr& node, const ISelectable& selectable, bool isComponent)
+{
+    if (_transactionDepth == 0)
+    {
+        _sigSelectionChanged(selectable);
+        notifyObservers(node, isComponent);
+        return;
+    }
+
+    auto [change, inserted] = _pendingChanges.changes.try_emplace(node.get());
+
+    if (inserted)
+    {
+        _pendingChanges.nodes.push_back(node);
+    }
+
+    if (isComponent)
+    {
+        change->second.components = true;
+    }
+    else
+    {
+        change->second.delta += selectable.isSelected() ? +1 : -1;
+    }
+
+    _pendingChanges.lastChangedNode = node;
+}
+
+void RadiantSelectionSystem::flushPendingChanges()
+{
+    if (_pendingChanges.nodes.empty()) return;
+
+    // Move the changes out of the way, the notified code might open another transaction
+    PendingChanges pending;
+    std::swap(pending, _pendingChanges);
+
+    SelectionChangeSet changeSet;
+
+    for (const auto& node : pending.nodes)
+    {
+        const auto& change = pending.changes[node.get()];
+
+        if (change.delta > 0)
+        {
+            changeSet.selected.push_back(node);
+        }
+        else if (change.delta < 0)
+        {
+            changeSet.deselected.push_back(node);
+        }
+
+        if (change.components)
+        {
+            changeSet.componentsChanged.push_back(node);
+        }
+    }
+
+    // The signal needs a selectable, the changed nodes are selectables themselves
+    if (auto selectable = scene::node_cast<ISelectable>(pending.lastChangedNode); selectable)
+    {
+        _sigSelectionChanged(*selectable);
+    }
+
+    for (auto i = _observers.begin(); i != _observers.end(); )
+    {
+        (*i++)->selectionBatchChanged(changeSet);
+    }
+}
+
 void RadiantSelectionSystem::toggleSelectionFocus()
 {
     if (_selectionFocusActive)
@@ -208,11 +299,6 @@ void RadiantSelectionSystem::pivotChangedSelection(const ISelectable& selectable
     pivotChanged();
 }
 
-bool RadiantSelectionSystem::higherEntitySelectionPriority() const
-{
-    return registry::getValue<bool>(RKEY_HIGHER_ENTITY_PRIORITY);
-}
-
 void RadiantSelectionSystem::setSelectionMode(SelectionMode mode)
 {
     // Only change something if the mode has actually changed
@@ -406,10 +492,8 @@ void RadiantSelectionSystem::onSelectedChanged(const scene::INodePtr& node, cons
     }
 
 	// greebo: Moved this here, the selectionInfo structure should be up to date before calling this
-	_sigSelectionChanged(selectable);
-
-    // Notify observers, FALSE = primitive selection change
-    notifyObservers(node, false);
+    // FALSE = primitive selection change
+    onSelectionChanged(node, selectable, false);
 
     // Check if the number of selected primitives in the list matches the value of the selection counter
     ASSERT_MESSAGE(_selection.size() == _countPrimitive, "selection-tracking error");
@@ -443,10 +527,8 @@ void RadiantSelectionSystem::onComponentSelection(const scene::INodePtr& node, c
     }
 
 	// Moved here, since the _selectionInfo struct needs to be up to date
-	_sigSelectionChanged(selectable);
-
-    // Notify observers, TRUE => this is a component selection change
-    notifyObservers(node, true);
+    // TRUE => this is a component selection change
+    onSelectionChanged(node, selectable, true);
 
     // Check if the number of selected components in the list matches the value of the selection counter
     ASSERT_MESSAGE(_componentSelection.size() == _countComponent, "component selection-tracking error");
@@ -476,6 +558,8 @@ scene::INodePtr RadiantSelectionSystem::penultimateSelected()
 // Deselect or select all the instances in the scenegraph and notify the manipulator class as well
 void RadiantSelectionSystem::setSelectedAll(bool selected)
 {
+    SelectionTransaction transaction(*this);
+
 	GlobalSceneGraph().foreachNode([&] (const scene::INodePtr& node)->bool
 	{
 		Node_setSelected(node, selected);
@@ -488,6 +572,8 @@ void RadiantSelectionSystem::setSelectedAll(bool selected)
 // Deselect or select all the component instances in the scenegraph and notify the manipulator class as well
 void RadiantSelectionSystem::setSelectedAllComponents(bool selected)
 {
+    SelectionTransaction transaction(*this);
+
 	const scene::INodePtr& root = GlobalSceneGraph().root();
 
 	if (root)
@@ -514,46 +600,40 @@ void RadiantSelectionSystem::setSelectedAllComponents(bool selected)
 // Traverse the current selection components and visit them with the given visitor class
 void RadiantSelectionSystem::foreachSelectedComponent(const Visitor& visitor)
 {
-    for (auto i = _componentSelection.begin(); i != _componentSelection.end(); /* in-loop increment */)
+    _componentSelection.foreachNode([&](const scene::INodePtr& node)
     {
-        visitor.visit((i++)->first);
-    }
+        visitor.visit(node);
+    });
 }
 
 void RadiantSelectionSystem::foreachSelected(const std::function<void(const scene::INodePtr&)>& functor)
 {
-	for (auto i = _selection.begin(); i != _selection.end(); /* in-loop increment */)
-    {
-        functor((i++)->first);
-    }
+	_selection.foreachNode(functor);
 }
 
 void RadiantSelectionSystem::foreachSelectedComponent(const std::function<void(const scene::INodePtr&)>& functor)
 {
-	for (auto i = _componentSelection.begin(); i != _componentSelection.end(); /* in-loop increment */)
-    {
-        functor((i++)->first);
-    }
+	_componentSelection.foreachNode(functor);
 }
 
 void RadiantSelectionSystem::foreachBrush(const std::function<void(Brush&)>& functor)
 {
 	BrushSelectionWalker walker(functor);
 
-	for (auto i = _selection.begin(); i != _selection.end(); /* in-loop increment */)
+	_selection.foreachNode([&](const scene::INodePtr& node)
     {
-		walker.visit((i++)->first); // Handles group nodes recursively
-    }
+		walker.visit(node); // Handles group nodes recursively
+    });
 }
 
 void RadiantSelectionSystem::foreachFace(const std::function<void(IFace&)>& functor)
 {
 	FaceSelectionWalker walker(functor);
 
-	for (auto i = _selection.begin(); i != _selection.end(); /* in-loop increment */)
+	_selection.foreachNode([&](const scene::INodePtr& node)
     {
-		walker.visit((i++)->first); // Handles group nodes recursively
-    }
+		walker.visit(node); // Handles group nodes recursively
+    });
 
 	// Handle the component selection too
 	algorithm::forEachSelectedFaceComponent(functor);
@@ -563,10 +643,10 @@ void RadiantSelectionSystem::foreachPatch(const std::function<void(IPatch&)>& fu
 {
 	PatchSelectionWalker walker(functor);
 
-	for (auto i = _selection.begin(); i != _selection.end(); /* in-loop increment */)
+	_selection.foreachNode([&](const scene::INodePtr& node)
     {
-		walker.visit((i++)->first); // Handles group nodes recursively
-    }
+		walker.visit(node); // Handles group nodes recursively
+    });
 }
 
 std::size_t RadiantSelectionSystem::getSelectedFaceCount()
@@ -598,6 +678,10 @@ void RadiantSelectionSystem::deselectAll() {
 
 void RadiantSelectionSystem::selectPoint(SelectionTest& test, EModifier modifier, bool face)
 {
+    PROFILE_ZONE("RadiantSelectionSystem::selectPoint");
+
+    SelectionTransaction transaction(*this);
+
     // If the user is holding the replace modifiers (default: Alt-Shift), deselect the current selection
     if (modifier == SelectionSystem::eReplace) {
         if (face) {
@@ -730,6 +814,10 @@ void RadiantSelectionSystem::performPointSelection(const SelectablesList& candid
 
 void RadiantSelectionSystem::selectArea(SelectionTest& test, SelectionSystem::EModifier modifier, bool face)
 {
+    PROFILE_ZONE("RadiantSelectionSystem::selectArea");
+
+    SelectionTransaction transaction(*this);
+
     // If we are in replace mode, deselect all the components or previous selections
     if (modifier == SelectionSystem::eReplace)
     {
@@ -813,7 +901,11 @@ void RadiantSelectionSystem::onManipulationChanged()
 
 void RadiantSelectionSystem::onManipulationEnd()
 {
-    GlobalSceneGraph().foreachNode(scene::freezeTransformableNode);
+    {
+        // The transformed patches are re-tesselated in parallel
+        patch::ScopedTesselationBatch tesselationBatch;
+        GlobalSceneGraph().foreachNode(scene::freezeTransformableNode);
+    }
 
     _pivot.endOperation();
 
@@ -1065,18 +1157,13 @@ void RadiantSelectionSystem::shutdownModule()
 	// selectable node a chance to remove itself from the container by setting
 	// its own selected state to false (rather than waiting for this to happen
 	// in its destructor).
-    for (auto i = _selection.begin(); i != _selection.end(); )
+    _selection.foreachNode([&](const scene::INodePtr& node)
     {
-        // Take a reference to the node and increment the iterator while the
-        // iterator is still valid.
-        scene::INodePtr node = (i++)->first;
-
-        // If this is a selectable node, unselect it (which might remove it from
-        // the map and invalidate the original iterator)
+        // If this is a selectable node, unselect it (which removes it from the list)
         auto selectable = scene::node_cast<ISelectable>(node);
         if (selectable)
             selectable->setSelected(false);
-    }
+    });
 
     // Clear the list of anything which remains.
 	_selection.clear();
@@ -9,6 +9,9 @@
 #include "selectionlib.h"
 #include "SelectedNodeList.h"
 
+#include <map>
+#include <unordered_map>
+
 #include "SceneManipulationPivot.h"
 
 namespace selection
@@ -70,6 +73,29 @@ private:
     bool _selectionFocusActive;
     std::set<scene::INodePtr> _selectionFocusPool;
 
+    // Nesting level of the active selection transactions
+    std::size_t _transactionDepth;
+
+    // The selection changes accumulated during a transaction
+    struct PendingChanges
+    {
+        // Every touched node in the order of its first change
+        std::vector<scene::INodePtr> nodes;
+
+        // Net change of the primitive selection (+1 = selected, -1 = deselected)
+        // and whether the node's component selection has been changed
+        struct NodeChange
+        {
+            int delta = 0;
+            bool components = false;
+        };
+        std::unordered_map<scene::INode*, NodeChange> changes;
+
+        // The most recently changed node, passed to the selection changed signal
+        scene::INodePtr lastChangedNode;
+    };
+    PendingChanges _pendingChanges;
+
 public:
 	RadiantSelectionSystem();
 
@@ -118,6 +144,9 @@ public:
         return _sigSelectionChanged;
     }
 
+    void beginTransaction() override;
+    void endTransaction() override;
+
 	scene::INodePtr ultimateSelected() override;
 	scene::INodePtr penultimateSelected() override;
 
@@ -185,10 +214,15 @@ private:
 	void testSelectScene(SelectablesList& targetList, SelectionTest& test,
         const VolumeTest& view, SelectionMode mode);
 
-	bool higherEntitySelectionPriority() const;
-
 	void notifyObservers(const scene::INodePtr& node, bool isComponent);
 
+    // Emits the selection changed signal and notifies the observers, or
+    // records the change if a transaction is active
+    void onSelectionChanged(const scene::INodePtr& node, const ISelectable& selectable, bool isComponent);
+
+    // Delivers the changes accumulated during the finished transaction
+    void flushPendingChanges();
+
 	std::size_t getManipulatorIdForType(IManipulator::Type type);
 
 	// Command targets used to connect to the event system
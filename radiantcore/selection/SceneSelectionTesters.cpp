@@ -1,9 +1,11 @@
 #include "SceneSelectionTesters.h"
 
 #include "iscenegraph.h"
+#include "iorthoview.h"
 #include "SelectionTestWalkers.h"
 #include "selection/EntitiesFirstSelector.h"
 #include "selection/SelectionPool.h"
+#include "registry/CachedKey.h"
 
 namespace selection
 {
@@ -87,7 +89,10 @@ void PrimitiveSelectionTester::testSelectSceneWithFilter(const VolumeTest& view,
 
 bool PrimitiveSelectionTester::higherEntitySelectionPriority() const
 {
-    return registry::getValue<bool>(RKEY_HIGHER_ENTITY_PRIORITY);
+    // Testers are created for every click, cache the key to avoid the registry lookup
+    static registry::CachedKey<bool> higherEntityPriorityKey(RKEY_HIGHER_ENTITY_PRIORITY);
+
+    return higherEntityPriorityKey.get();
 }
 
 EntitySelectionTester::EntitySelectionTester(const NodePredicate& nodePredicate) :
@@ -1,119 +1,184 @@
 #include "SelectedNodeList.h"
 
-const scene::INodePtr& SelectedNodeList::ultimate() {
-	if (size() == 0) {
-		return end()->first; // return invalid iterator
-	}
+#include "debugging/debugging.h"
 
-	std::size_t latestTime(0);
-	iterator latest;
+namespace
+{
+	const scene::INodePtr _emptyNode;
 
-	for (iterator i = begin(); i != end(); i++) {
-		if (i->second > latestTime) {
-			latestTime = i->second;
-			latest = i;
+	// Raises the iteration depth for its lifetime, also when the functor throws
+	class ScopedIterationDepth
+	{
+	private:
+		std::size_t& _depth;
+
+	public:
+		ScopedIterationDepth(std::size_t& depth) :
+			_depth(depth)
+		{
+			++_depth;
 		}
-	}
 
-	return latest->first;
+		~ScopedIterationDepth()
+		{
+			// The list might have been cleared during the traversal
+			if (_depth > 0)
+			{
+				--_depth;
+			}
+		}
+	};
 }
 
-const scene::INodePtr& SelectedNodeList::ultimate() const {
-	if (size() == 0) {
-		return end()->first; // return invalid iterator
-	}
+SelectedNodeList::SelectedNodeList() :
+	_size(0),
+	_iterationDepth(0)
+{}
 
-	std::size_t latestTime(0);
-	const_iterator latest;
+std::size_t SelectedNodeList::size() const
+{
+	return _size;
+}
 
-	for (const_iterator i = begin(); i != end(); i++) {
-		if (i->second > latestTime) {
-			latestTime = i->second;
-			latest = i;
-		}
-	}
+bool SelectedNodeList::empty() const
+{
+	return _size == 0;
+}
 
-	return latest->first;
+void SelectedNodeList::clear()
+{
+	_slots.clear();
+	_latestSlot.clear();
+	_size = 0;
+	_iterationDepth = 0;
 }
 
-const scene::INodePtr& SelectedNodeList::penultimate() const {
-	if (size() <= 1) {
-		return end()->first; // return invalid iterator
+const scene::INodePtr& SelectedNodeList::ultimate() const
+{
+	// Trailing gaps are usually removed in erase(), except during iteration
+	for (auto slot = _slots.size(); slot-- > 0;)
+	{
+		if (_slots[slot].node)
+		{
+			return _slots[slot].node;
+		}
 	}
 
-	std::size_t ultimateTime(0);
-	std::size_t penUltimateTime(0);
-	const_iterator ultimate;
-	const_iterator penUltimate;
+	return _emptyNode;
+}
 
-	for (const_iterator i = begin(); i != end(); i++) {
-		if (i->second > ultimateTime) {
-			penUltimateTime = ultimateTime;
-			penUltimate = ultimate;
+const scene::INodePtr& SelectedNodeList::penultimate() const
+{
+	bool ultimateFound = false;
 
-			ultimateTime = i->second;
-			ultimate = i;
-		}
-		else if (i->second > penUltimateTime) {
-			penUltimateTime = i->second;
-			penUltimate = i;
+	for (auto slot = _slots.size(); slot-- > 0;)
+	{
+		if (!_slots[slot].node) continue;
+
+		if (ultimateFound)
+		{
+			return _slots[slot].node;
 		}
+
+		ultimateFound = true;
 	}
 
-	return penUltimate->first;
+	return _emptyNode;
 }
 
-const scene::INodePtr& SelectedNodeList::penultimate() {
-	if (size() <= 1) {
-		return end()->first; // return invalid iterator
+void SelectedNodeList::append(const scene::INodePtr& selected)
+{
+	// Compact the array when more than half of it is made up of gaps
+	if (_iterationDepth == 0 && _slots.size() > 32 && _size < _slots.size() / 2)
+	{
+		compact();
 	}
 
-	std::size_t ultimateTime(0);
-	std::size_t penUltimateTime(0);
-	iterator ultimate;
-	iterator penUltimate;
+	auto latest = _latestSlot.find(selected.get());
+	auto previousOccurrence = latest != _latestSlot.end() ? latest->second : NoSlot;
 
-	for (iterator i = begin(); i != end(); i++) {
-		if (i->second > ultimateTime) {
-			penUltimateTime = ultimateTime;
-			penUltimate = ultimate;
+	_latestSlot[selected.get()] = _slots.size();
+	_slots.push_back(Slot{ selected, previousOccurrence });
+	++_size;
+}
 
-			ultimateTime = i->second;
-			ultimate = i;
-		}
-		else if (i->second > penUltimateTime) {
-			penUltimateTime = i->second;
-			penUltimate = i;
-		}
+void SelectedNodeList::erase(const scene::INodePtr& selected)
+{
+	auto latest = _latestSlot.find(selected.get());
+
+	ASSERT_MESSAGE(latest != _latestSlot.end(), "node is not in the selection list");
+
+	if (latest == _latestSlot.end())
+	{
+		return;
 	}
 
-	return penUltimate->first;
-}
+	auto& slot = _slots[latest->second];
 
-void SelectedNodeList::append(const scene::INodePtr& selected) {
-	time++;
-	MapType::insert(value_type(selected, time));
+	// Any earlier occurrence of this node is the latest one now
+	if (slot.previousOccurrence != NoSlot)
+	{
+		latest->second = slot.previousOccurrence;
+	}
+	else
+	{
+		_latestSlot.erase(latest);
+	}
+
+	slot.node.reset();
+	--_size;
+
+	// Remove any gaps at the end, as long as nobody is iterating
+	while (_iterationDepth == 0 && !_slots.empty() && !_slots.back().node)
+	{
+		_slots.pop_back();
+	}
 }
 
-void SelectedNodeList::erase(const scene::INodePtr& selected) {
-	iterator last;
-	std::size_t lastTime(0);
+void SelectedNodeList::foreachNode(const std::function<void(const scene::INodePtr&)>& functor)
+{
+	{
+		ScopedIterationDepth depth(_iterationDepth);
+
+		// Use indices, the array might be extended during traversal
+		for (std::size_t i = 0; i < _slots.size(); ++i)
+		{
+			// Take a copy, the functor might deselect this node
+			auto node = _slots[i].node;
+
+			if (node)
+			{
+				functor(node);
+			}
+		}
+	}
 
-	// Lookup the instance selected last
-	for (iterator it = MapType::find(selected);
-		 it != upper_bound(selected) && it != end();
-		 it++)
+	if (_iterationDepth == 0)
 	{
-		if (it->second > lastTime) {
-			last = it;
-			lastTime = it->second;
+		while (!_slots.empty() && !_slots.back().node)
+		{
+			_slots.pop_back();
 		}
 	}
+}
 
-	assert(last != end());
+void SelectedNodeList::compact()
+{
+	std::vector<Slot> slots;
+	slots.reserve(_size);
 
-	// Remove the element selected last, leave the others
-	MapType::erase(last);
-}
+	_latestSlot.clear();
+
+	for (auto& slot : _slots)
+	{
+		if (!slot.node) continue;
+
+		auto latest = _latestSlot.find(slot.node.get());
+		auto previousOccurrence = latest != _latestSlot.end() ? latest->second : NoSlot;
 
-std::size_t SelectedNodeList::time = 1;
+		_latestSlot[slot.node.get()] = slots.size();
+		slots.push_back(Slot{ std::move(slot.node), previousOccurrence });
+	}
+
+	_slots.swap(slots);
+}
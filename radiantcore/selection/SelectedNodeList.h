@@ -1,49 +1,64 @@
 #ifndef SELECTEDNODELIST_H_
 #define SELECTEDNODELIST_H_
 
-#include <map>
+#include <vector>
+#include <unordered_map>
+#include <functional>
 #include "inode.h"
 
 /**
- * greebo: This container adapts a std::multimap to keep track of
- * all the selected nodes in the scene. Additionally,
- * the insertion order is remembered to allow for retrieval
- * of the ultimate/penultimate selected node.
+ * greebo: This container keeps track of all the selected nodes
+ * in the scene, in the order they have been selected. This allows
+ * for retrieval of the ultimate/penultimate selected node.
  *
  * It also allows for the same node occuring multiple times in
- * the map at once. On deletion, the node which has been added
+ * the list at once. On deletion, the node which has been added
  * latest is removed.
  *
- * It is not as fast when inserting new elements as std::list but
- * allows for fast lookup of arbitrary nodes.
- *
- * Also, the map interface is extended by the penultimate() accessor
- * which is needed by the RadiantSelectionSystem.
+ * The nodes are stored in a flat array, an additional index allows for
+ * constant-time removal. Removed entries leave a gap which is closed
+ * when the array is compacted during the next insertion.
  */
-class SelectedNodeList :
-	public std::multimap<scene::INodePtr, std::size_t>
+class SelectedNodeList
 {
-	// Shortcut typedef
-	typedef std::multimap<scene::INodePtr, std::size_t> MapType;
+private:
+	static constexpr std::size_t NoSlot = static_cast<std::size_t>(-1);
+
+	struct Slot
+	{
+		// Empty if the node has been removed
+		scene::INodePtr node;
+
+		// The previous slot holding the same node, or NoSlot
+		std::size_t previousOccurrence;
+	};
+
+	std::vector<Slot> _slots;
+
+	// Maps each node to the slot it has been added to latest
+	std::unordered_map<scene::INode*, std::size_t> _latestSlot;
+
+	std::size_t _size;
+
+	// Compaction is suppressed while the list is being iterated over
+	std::size_t _iterationDepth;
 
-	// This is an ever-incrementing counter, some sort of "insertion time"
-	static std::size_t time;
 public:
+	SelectedNodeList();
+
+	std::size_t size() const;
+	bool empty() const;
+	void clear();
+
 	/**
 	 * greebo: Returns the element which has been inserted last.
-	 *
-	 * Note: Runs in linear time = SLOW
 	 */
-	const scene::INodePtr& ultimate();
 	const scene::INodePtr& ultimate() const;
 
 	/**
 	 * greebo: Returns the element right before the last selected.
-	 *
-	 * Note: Runs in linear time = SLOW
 	 */
 	const scene::INodePtr& penultimate() const;
-	const scene::INodePtr& penultimate();
 
 	/**
 	 * greebo: Inserts a new element to this container.
@@ -54,11 +69,21 @@ public:
 
 	/**
 	 * greebo: Removes the node which has been selected last
-	 * from this map. If multiple nodes with the same
-	 * address exist in the map, only the one with the
-	 * highest time is removed, the others are left.
+	 * from this list. If the node occurs multiple times
+	 * only the one with the highest time is removed, the others are left.
 	 */
 	void erase(const scene::INodePtr& selected);
+
+	/**
+	 * Invokes the functor for each node, in the order they have been added.
+	 * It's safe to add or remove nodes from within the functor, nodes added
+	 * during the traversal are visited too.
+	 */
+	void foreachNode(const std::function<void(const scene::INodePtr&)>& functor);
+
+private:
+	// Closes the gaps left by removed nodes
+	void compact();
 };
 
 #endif /*SELECTEDNODELIST_H_*/
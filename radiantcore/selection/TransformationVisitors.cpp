@@ -1,9 +1,9 @@
 #include "TransformationVisitors.h"
 
 #include "editable.h"
+#include "ientity.h"
 #include "manipulators/ManipulatorComponents.h"
 #include "transformlib.h"
-#include "registry/registry.h"
 #include "selection/algorithm/General.h"
 
 // greebo: This is needed e.g. to calculate the translation vector of a rotation transformation
@@ -61,7 +61,7 @@ void TranslateSelected::visit(const scene::INodePtr& node) const {
 RotateSelected::RotateSelected(const Quaternion& rotation, const Vector3& world_pivot) :
     _rotation(rotation),
     _worldPivot(world_pivot),
-    _freeObjectRotation(registry::getValue<bool>(selection::algorithm::RKEY_FREE_OBJECT_ROTATION))
+    _freeObjectRotation(GlobalEntityModule().getSettings().getFreeObjectRotation())
 {}
 
 void RotateSelected::visit(const scene::INodePtr& node) const
@@ -79,6 +79,8 @@ bool EntitySelectByClassnameWalker::entityMatches(Entity* entity) const {
 
 void selectAllOfType(const cmd::ArgumentList& args)
 {
+	selection::SelectionTransaction transaction;
+
 	if (GlobalSelectionSystem().getSelectionInfo().componentCount > 0 &&
 		!FaceInstance::Selection().empty())
 	{
@@ -432,6 +434,8 @@ public:
 
 void invertSelection(const cmd::ArgumentList& args)
 {
+	selection::SelectionTransaction transaction;
+
 	if (GlobalSelectionSystem().getSelectionMode() == SelectionMode::Component)
 	{
 		InvertComponentSelectionWalker walker(GlobalSelectionSystem().ComponentMode());
@@ -581,6 +585,8 @@ public:
 
     static void DoSelection(const std::vector<AABB>& aabbs)
     {
+        selection::SelectionTransaction transaction;
+
         SelectByBounds<TSelectionPolicy> walker(aabbs);
         GlobalSceneGraph().root()->traverse(walker);
 
@@ -50,6 +50,15 @@ void GroupCycle::selectionChanged(const scene::INodePtr& node, bool isComponent)
 	}
 }
 
+void GroupCycle::selectionBatchChanged(const SelectionChangeSet& changes)
+{
+	// Rescan once for the whole batch, component changes are ignored as above
+	if (!changes.selected.empty() || !changes.deselected.empty())
+	{
+		rescanSelection();
+	}
+}
+
 void GroupCycle::rescanSelection() {
 	if (_updateActive) {
 		return;
@@ -32,6 +32,7 @@ public:
 	 * by the RadiantSelectionSystem
 	 */
 	void selectionChanged(const scene::INodePtr& node, bool isComponent);
+	void selectionBatchChanged(const SelectionChangeSet& changes);
 
 	/** greebo: Rescans the current selection and populates the Vector of candidates
 	 */
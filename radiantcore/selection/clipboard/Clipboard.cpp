@@ -4,13 +4,13 @@
 #include "iselection.h"
 #include "igrid.h"
 #include "icameraview.h"
-#include "imapformat.h"
 #include "iclipboard.h"
 #include "ishaderclipboard.h"
 #include "string/trim.h"
 
 #include "map/Map.h"
 #include "brush/FaceInstance.h"
+#include "MapClipboardContent.h"
 #include "map/algorithm/Import.h"
 #include "selection/algorithm/General.h"
 #include "selection/algorithm/Transformation.h"
@@ -31,21 +31,25 @@ void pasteToMap()
 		throw cmd::ExecutionNotPossible(_("No clipboard module attached, cannot perform this action."));
 	}
 
+    // Map elements copied within this process can be cloned directly,
+    // without parsing them from text
+    auto content = std::dynamic_pointer_cast<MapClipboardContent>(GlobalClipboard().getContent());
+
+    if (content)
+    {
+        map::algorithm::importFromRootNode(content->cloneNodes());
+        return;
+    }
+
     std::stringstream stream(GlobalClipboard().getString());
 	map::algorithm::importFromStream(stream);
 }
 
 void copySelectedMapElementsToClipboard()
 {
-    // When exporting to the system clipboard, use the portable format
-    auto format = GlobalMapFormatManager().getMapFormatByName(map::PORTABLE_MAP_FORMAT_NAME);
-
-    // Stream selected objects into a stringstream
-    std::stringstream out;
-    GlobalMap().exportSelected(out, format);
-
-    // Copy the resulting string to the clipboard
-    GlobalClipboard().setString(out.str());
+    // Keep a copy of the selected nodes, it's converted
+    // to text only when the clipboard contents are requested
+    GlobalClipboard().setContent(MapClipboardContent::CreateFromSelection());
 }
 
 void copy(const cmd::ArgumentList& args)
@@ -104,6 +108,12 @@ std::string getMaterialNameFromClipboard()
         return std::string();
     }
 
+    // Map elements copied by us won't be a material name
+    if (GlobalClipboard().getContent())
+    {
+        return std::string();
+    }
+
     auto candidate = GlobalClipboard().getString();
     string::trim(candidate);
 
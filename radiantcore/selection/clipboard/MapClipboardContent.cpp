@@ -0,0 +1,141 @@
+#include "MapClipboardContent.h"
+
+#include <sstream>
+#include "imapformat.h"
+#include "iscenegraph.h"
+#include "iselectiongroup.h"
+#include "scene/BasicRootNode.h"
+#include "scene/Clone.h"
+#include "scene/Traverse.h"
+#include "map/algorithm/MapExporter.h"
+
+namespace selection
+{
+
+namespace clipboard
+{
+
+namespace
+{
+
+// Clones the visited nodes into the given root, keeping the hierarchy
+// and the selection group memberships of the source nodes
+class NodeCloner :
+    public scene::NodeVisitor
+{
+private:
+    scene::IMapRootNodePtr _targetRoot;
+    scene::Path _path;
+
+public:
+    NodeCloner(const scene::IMapRootNodePtr& targetRoot) :
+        _targetRoot(targetRoot),
+        _path(targetRoot)
+    {}
+
+    bool pre(const scene::INodePtr& node) override
+    {
+        // Children of non-cloneable nodes are left out
+        auto clone = _path.top() ? scene::cloneSingleNode(node) : scene::INodePtr();
+
+        _path.push(clone);
+
+        if (!clone)
+        {
+            return false;
+        }
+
+        // Add the clone to its parent before visiting the children, like the map readers do
+        _path.parent()->addChildNode(clone);
+
+        copyGroupMemberships(node, clone);
+
+        return true;
+    }
+
+    void post(const scene::INodePtr& node) override
+    {
+        _path.pop();
+    }
+
+private:
+    void copyGroupMemberships(const scene::INodePtr& node, const scene::INodePtr& clone)
+    {
+        auto groupSelectable = std::dynamic_pointer_cast<IGroupSelectable>(node);
+        auto sourceRoot = node->getRootNode();
+
+        if (!groupSelectable || !sourceRoot) return;
+
+        auto& targetGroupManager = _targetRoot->getSelectionGroupManager();
+
+        for (auto id : groupSelectable->getGroupIds())
+        {
+            auto sourceGroup = sourceRoot->getSelectionGroupManager().getSelectionGroup(id);
+            auto group = targetGroupManager.findOrCreateSelectionGroup(id);
+
+            if (sourceGroup)
+            {
+                group->setName(sourceGroup->getName());
+            }
+
+            group->addNode(clone);
+        }
+    }
+};
+
+}
+
+MapClipboardContent::MapClipboardContent() :
+    _root(std::make_shared<scene::BasicRootNode>()),
+    _textGenerated(false)
+{}
+
+MapClipboardContent::Ptr MapClipboardContent::CreateFromSelection()
+{
+    Ptr content(new MapClipboardContent);
+
+    NodeCloner cloner(content->_root);
+    scene::traverseSelected(GlobalSceneGraph().root(), cloner);
+
+    return content;
+}
+
+std::string MapClipboardContent::getString()
+{
+    if (_textGenerated)
+    {
+        return _text;
+    }
+
+    // When exporting to the system clipboard, use the portable format
+    auto format = GlobalMapFormatManager().getMapFormatByName(map::PORTABLE_MAP_FORMAT_NAME);
+    auto writer = format->getMapWriter();
+
+    std::stringstream out;
+
+    {
+        map::MapExporter exporter(*writer, _root, out);
+        exporter.disableProgressMessages();
+
+        exporter.exportMap(_root, scene::traverse);
+    }
+
+    _text = out.str();
+    _textGenerated = true;
+
+    return _text;
+}
+
+scene::IMapRootNodePtr MapClipboardContent::cloneNodes() const
+{
+    auto root = std::make_shared<scene::BasicRootNode>();
+
+    NodeCloner cloner(root);
+    _root->traverseChildren(cloner);
+
+    return root;
+}
+
+}
+
+}
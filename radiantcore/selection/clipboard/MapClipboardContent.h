@@ -0,0 +1,47 @@
+#pragma once
+
+#include "iclipboard.h"
+#include "imap.h"
+
+namespace selection
+{
+
+namespace clipboard
+{
+
+/**
+ * Clipboard content holding copies of the map elements selected at the time
+ * of creation. Pasting within the same process clones these nodes directly,
+ * the map data is only written to text (in portable format) when the clipboard
+ * contents are requested as string, e.g. by another application.
+ */
+class MapClipboardContent :
+    public radiant::IClipboardContent
+{
+private:
+    // Root holding the copied entities and primitives
+    scene::IMapRootNodePtr _root;
+
+    std::string _text;
+    bool _textGenerated;
+
+    MapClipboardContent();
+
+public:
+    using Ptr = std::shared_ptr<MapClipboardContent>;
+
+    // Copies the selected map elements of the current scene,
+    // following the same rules as the selection export.
+    static Ptr CreateFromSelection();
+
+    // Returns the copied map elements in portable map format
+    std::string getString() override;
+
+    // Returns a new root node holding copies of the contained map elements,
+    // suitable for importing them into the active map
+    scene::IMapRootNodePtr cloneNodes() const;
+};
+
+}
+
+}
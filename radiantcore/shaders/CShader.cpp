@@ -258,7 +258,7 @@ void CShader::clearMaterialFlag(Flags flag)
 
 bool CShader::IsDefault() const
 {
-	return _isInternal || _template->getBlockSyntax().fileInfo.name.empty();
+	return _isInternal || _template->getBlockSyntax().getFileInfo().name.empty();
 }
 
 // get the cull type
@@ -357,7 +357,7 @@ Material::Coverage CShader::getCoverage() const
 // get shader file name (ie the file where this one is defined)
 const char* CShader::getShaderFileName() const
 {
-	return _template->getBlockSyntax().fileInfo.name.c_str();
+	return _template->getBlockSyntax().getFileInfo().name.c_str();
 }
 
 void CShader::setShaderFileName(const std::string& fullPath)
@@ -370,7 +370,7 @@ void CShader::setShaderFileName(const std::string& fullPath)
 
 const vfs::FileInfo& CShader::getShaderFileInfo() const
 {
-    return _template->getBlockSyntax().fileInfo;
+    return _template->getBlockSyntax().getFileInfo();
 }
 
 std::string CShader::getDefinition()
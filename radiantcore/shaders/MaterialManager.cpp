@@ -80,7 +80,7 @@ bool MaterialManager::materialCanBeModified(const std::string& name)
     }
 
     auto decl = _library->getTemplate(name);
-    const auto& fileInfo = decl->getBlockSyntax().fileInfo;
+    const auto& fileInfo = decl->getBlockSyntax().getFileInfo();
     return fileInfo.name.empty() || fileInfo.getIsPhysicalFile();
 }
 
@@ -274,6 +274,16 @@ void MaterialManager::reloadImages()
     });
 }
 
+void MaterialManager::startFrame()
+{
+    _textureManager->startFrame();
+}
+
+TextureMemoryStatistics MaterialManager::getTextureMemoryStatistics()
+{
+    return _textureManager->getMemoryStatistics();
+}
+
 const std::string& MaterialManager::getName() const
 {
     static std::string _name(MODULE_SHADERSYSTEM);
@@ -310,6 +320,7 @@ void MaterialManager::initialiseModule(const IApplicationContext& ctx)
     GlobalFiletypes().registerPattern("material", FileTypePattern(_("Material File"), "mtr", "*.mtr"));
 
     GlobalCommandSystem().addCommand("ReloadImages", [this](const cmd::ArgumentList&) { reloadImages(); });
+    GlobalCommandSystem().addCommand("ShowTextureMemoryStats", [this](const cmd::ArgumentList&) { _textureManager->printMemoryStats(); });
 }
 
 void MaterialManager::onMaterialDefsReloaded()
@@ -89,6 +89,8 @@ public:
 	ITableDefinition::Ptr getTable(const std::string& name) override;
 
     void reloadImages() override;
+    void startFrame() override;
+    TextureMemoryStatistics getTextureMemoryStatistics() override;
 
 public:
     sigc::signal<void> signal_activeShadersChanged() const override;
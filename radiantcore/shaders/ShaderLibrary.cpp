@@ -65,7 +65,7 @@ void ShaderLibrary::copyDefinition(const std::string& nameOfOriginal, const std:
     // Replace the syntax block of the target with the one of the original
     auto syntax = originalDecl->getBlockSyntax();
     syntax.name = nameOfCopy;
-    syntax.fileInfo = vfs::FileInfo{ "", "", vfs::Visibility::HIDDEN };
+    syntax.setFileInfo(vfs::FileInfo{ "", "", vfs::Visibility::HIDDEN });
 
     decl->setBlockSyntax(syntax);
 }
@@ -127,7 +127,7 @@ void ShaderLibrary::foreachShaderName(const ShaderNameCallback& callback)
 {
     GlobalDeclarationManager().foreachDeclaration(decl::Type::Material, [&](const decl::IDeclaration::Ptr& decl)
     {
-        if (decl->getBlockSyntax().fileInfo.visibility == vfs::Visibility::NORMAL)
+        if (decl->getBlockSyntax().getFileInfo().visibility == vfs::Visibility::NORMAL)
         {
             callback(decl->getDeclName());
         }
@@ -13,6 +13,7 @@
 #include "string/convert.h"
 #include "parser/DefTokeniser.h"
 
+#include "string/predicate.h"
 #include "string/case_conv.h"
 #include "string/trim.h"
 #include <iostream>
@@ -82,9 +83,55 @@ std::shared_ptr<ShaderTemplate> ShaderTemplate::clone()
 
 const MapExpressionPtr& ShaderTemplate::getEditorTexture()
 {
-    ensureParsed();
+    // Browsers request the editor image of every material, avoid a full parse for that
+    return isParsed() ? _editorTex : getMetadata().editorTex;
+}
+
+const ShaderTemplate::Metadata& ShaderTemplate::getMetadata()
+{
+    if (_metadata.scanned) return _metadata;
+
+    _metadata.scanned = true;
+
+    try
+    {
+        parser::BasicDefTokeniser<std::string> tokeniser(getBlockSyntax().contents,
+            DiscardedDelimiters, KeptDelimiters);
+
+        // Only global-level keywords are of interest, stages are skipped
+        int level = 1;
+
+        while (level > 0 && tokeniser.hasMoreTokens())
+        {
+            auto token = tokeniser.nextToken();
+
+            if (token == "}")
+            {
+                --level;
+            }
+            else if (token == "{")
+            {
+                ++level;
+            }
+            else if (level == 1)
+            {
+                if (string::iequals(token, "qer_editorimage"))
+                {
+                    _metadata.editorTex = MapExpression::createForToken(tokeniser);
+                }
+                else if (string::iequals(token, "description"))
+                {
+                    _metadata.description = tokeniser.nextToken();
+                }
+            }
+        }
+    }
+    catch (const parser::ParseException&)
+    {
+        // Errors will be reported once the material is fully parsed
+    }
 
-    return _editorTex;
+    return _metadata;
 }
 
 void ShaderTemplate::setEditorImageExpressionFromString(const std::string& expression)
@@ -1639,6 +1686,9 @@ void ShaderTemplate::onSyntaxBlockAssigned(const decl::DeclarationBlockSyntax& b
 {
     EditableDeclaration<IShaderTemplate>::onSyntaxBlockAssigned(block);
 
+    // The metadata needs to be picked up from the new block
+    _metadata = Metadata();
+
     // Don't call onTemplateChanged() since that is meant is to be used
     // when the template is modified after parsing
     // Just emit the template changed signal
@@ -41,6 +41,16 @@ private:
     sigc::signal<void> _sigTemplateChanged;
     bool _suppressChangeSignal;
 
+    // Editor image and description as found by a quick scan of the syntax block,
+    // these are used as long as the material has not been fully parsed
+    struct Metadata
+    {
+        bool scanned = false;
+        MapExpressionPtr editorTex;
+        std::string description;
+    };
+    Metadata _metadata;
+
 public:
     using Ptr = std::shared_ptr<ShaderTemplate>;
 
@@ -171,8 +181,8 @@ public:
 
 	const std::string& getDescription()
 	{
-		ensureParsed();
-		return description;
+		// The description is available without parsing the whole material
+		return isParsed() ? description : getMetadata().description;
 	}
 
     void setDescription(const std::string& newDescription)
@@ -596,6 +606,10 @@ protected:
     std::string generateSyntax() override;
 
 private:
+    // Scans the unparsed syntax block for the keywords needed to display
+    // this material in a list or browser, without running the full parser
+    const Metadata& getMetadata();
+
     // Add the given layer and assigns editor preview layer if applicable
 	void addLayer(const Doom3ShaderLayer::Ptr& layer);
 
@@ -8,14 +8,139 @@
 #include "../MapExpression.h"
 #include "TextureManipulator.h"
 #include "parser/DefTokeniser.h"
+#include "string/format.h"
+
+#include <vector>
+#include <algorithm>
 
 namespace
 {
     const std::string SHADER_NOT_FOUND = "notex.bmp";
+
+    // Textures used within this amount of frames are never released,
+    // since there might be more than one view drawing them
+    constexpr std::size_t MIN_RESIDENT_FRAMES = 8;
 }
 
 namespace shaders {
 
+class GLTextureManager::ResidentTexture :
+    public Texture
+{
+private:
+    GLTextureManager& _manager;
+    std::string _name;
+    std::function<TexturePtr()> _load;
+
+    mutable TexturePtr _texture;
+    mutable std::size_t _lastUsedFrame;
+
+    // Number of render passes holding on to the GL texture number
+    std::size_t _passReferences;
+
+    // The size is kept when the texture is released
+    std::size_t _width;
+    std::size_t _height;
+
+public:
+    ResidentTexture(GLTextureManager& manager, const std::string& name,
+                    const std::function<TexturePtr()>& load, const TexturePtr& texture) :
+        _manager(manager),
+        _name(name),
+        _load(load),
+        _texture(texture),
+        _lastUsedFrame(manager._frame),
+        _passReferences(0),
+        _width(texture->getWidth()),
+        _height(texture->getHeight())
+    {}
+
+    std::string getName() const override
+    {
+        return _name;
+    }
+
+    GLuint getGLTexNum() const override
+    {
+        _lastUsedFrame = _manager._frame;
+
+        if (!_texture)
+        {
+            // Texture has been released, load it again
+            _texture = _load();
+            ++_manager._numReloads;
+
+            if (!_texture)
+            {
+                rError() << "[shaders] Unable to reload texture: " << _name << std::endl;
+
+                auto notFound = _manager.getShaderNotFound();
+                return notFound ? notFound->getGLTexNum() : 0;
+            }
+        }
+
+        return _texture->getGLTexNum();
+    }
+
+    std::size_t getWidth() const override
+    {
+        return _width;
+    }
+
+    std::size_t getHeight() const override
+    {
+        return _height;
+    }
+
+    void addPassReference() override
+    {
+        ++_passReferences;
+    }
+
+    void removePassReference() override
+    {
+        if (_passReferences > 0)
+        {
+            --_passReferences;
+        }
+    }
+
+    bool isResident() const
+    {
+        return static_cast<bool>(_texture);
+    }
+
+    // Realised shaders cached the texture number, it can't be released
+    bool isPinned() const
+    {
+        return _passReferences > 0;
+    }
+
+    std::size_t getLastUsedFrame() const
+    {
+        return _lastUsedFrame;
+    }
+
+    // Estimated amount of texture memory including the mipmaps, assuming 32 bits per pixel.
+    // Returns 0 for textures without a known size like cube maps.
+    std::size_t getMemorySize() const
+    {
+        return _width * _height * 4 * 4 / 3;
+    }
+
+    void release()
+    {
+        _texture.reset();
+    }
+};
+
+GLTextureManager::GLTextureManager() :
+    _memoryBudget(RKEY_TEXTURE_MEMORY_BUDGET),
+    _frame(0),
+    _numEvictions(0),
+    _numReloads(0)
+{}
+
 void GLTextureManager::checkBindings()
 {
     // Check the TextureMap for unique pointers and release them
@@ -58,10 +183,13 @@ TexturePtr GLTextureManager::getBinding(const NamedBindablePtr& bindable,
     }
 
     // Create and insert texture object, if it is valid
-    auto texture = bindable->bindTexture(identifier, role);
+    auto texture = createResidentTexture(identifier, [bindable, identifier, role]()
+    {
+        return bindable->bindTexture(identifier, role);
+    });
+
     if (texture)
     {
-        _textures.emplace(identifier, texture);
         return texture;
     }
 
@@ -74,28 +202,44 @@ TexturePtr GLTextureManager::getBinding(const std::string& fullPath)
     // check if the texture has to be loaded
     TextureMap::iterator i = _textures.find(fullPath);
 
-    if (i == _textures.end())
+    if (i != _textures.end())
+    {
+        return i->second;
+    }
+
+    auto texture = createResidentTexture(fullPath, [fullPath]()
     {
         ImagePtr img = GlobalImageLoader().imageFromFile(fullPath);
 
-        // see if the MapExpression returned a valid image
-        if (img != NULL)
-        {
-            // Constructor returned a valid image, now create the texture object
-            TexturePtr texture = img->bindTexture(fullPath);
-            _textures[fullPath] = texture;
-        }
-        else
-        {
-            rError() << "[shaders] Unable to load texture: "
-                                << fullPath << "\n";
-            // invalid image produced, return shader not found
-            return getShaderNotFound();
-        }
+        // Create the texture object if the loader returned a valid image
+        return img ? img->bindTexture(fullPath) : TexturePtr();
+    });
+
+    if (!texture)
+    {
+        rError() << "[shaders] Unable to load texture: "
+                            << fullPath << "\n";
+        // invalid image produced, return shader not found
+        return getShaderNotFound();
     }
 
-    // Cast should succeed since all single image textures will be Texture2D
-    return _textures[fullPath];
+    return texture;
+}
+
+TexturePtr GLTextureManager::createResidentTexture(const std::string& identifier,
+                                                   const std::function<TexturePtr()>& load)
+{
+    auto texture = load();
+
+    if (!texture)
+    {
+        return TexturePtr();
+    }
+
+    auto resident = std::make_shared<ResidentTexture>(*this, identifier, load, texture);
+    _textures.emplace(identifier, resident);
+
+    return resident;
 }
 
 void GLTextureManager::clearCacheForBindable(const NamedBindablePtr& bindable)
@@ -117,6 +261,86 @@ TexturePtr GLTextureManager::getShaderNotFound()
     return _shaderNotFound;
 }
 
+void GLTextureManager::startFrame()
+{
+    ++_frame;
+
+    // A budget of 0 means no limit
+    auto budget = static_cast<std::size_t>(std::max(_memoryBudget.get(), 0)) * 1024 * 1024;
+
+    if (budget == 0) return;
+
+    std::size_t residentBytes = 0;
+    std::vector<ResidentTexture*> candidates;
+
+    for (const auto& [_, texture] : _textures)
+    {
+        if (!texture->isResident()) continue;
+
+        auto size = texture->getMemorySize();
+        residentBytes += size;
+
+        if (size > 0 && !texture->isPinned() && texture->getLastUsedFrame() + MIN_RESIDENT_FRAMES < _frame)
+        {
+            candidates.push_back(texture.get());
+        }
+    }
+
+    if (residentBytes <= budget) return;
+
+    // Release the least recently used textures first
+    std::sort(candidates.begin(), candidates.end(), [](const ResidentTexture* a, const ResidentTexture* b)
+    {
+        return a->getLastUsedFrame() < b->getLastUsedFrame();
+    });
+
+    for (auto texture : candidates)
+    {
+        if (residentBytes <= budget) break;
+
+        residentBytes -= texture->getMemorySize();
+        texture->release();
+        ++_numEvictions;
+    }
+}
+
+TextureMemoryStatistics GLTextureManager::getMemoryStatistics()
+{
+    TextureMemoryStatistics stats;
+
+    stats.numTextures = _textures.size();
+    stats.numEvictions = _numEvictions;
+    stats.numReloads = _numReloads;
+
+    for (const auto& [_, texture] : _textures)
+    {
+        if (texture->isPinned())
+        {
+            ++stats.numPinned;
+        }
+
+        if (!texture->isResident()) continue;
+
+        ++stats.numResident;
+        stats.residentBytes += texture->getMemorySize();
+    }
+
+    return stats;
+}
+
+void GLTextureManager::printMemoryStats()
+{
+    auto stats = getMemoryStatistics();
+    auto budget = static_cast<std::size_t>(std::max(_memoryBudget.get(), 0)) * 1024 * 1024;
+
+    rMessage() << "-- Texture Memory --" << std::endl;
+    rMessage() << "Textures: " << stats.numTextures << ", resident: " << stats.numResident
+        << ", used by shaders: " << stats.numPinned << std::endl;
+    rMessage() << "Resident memory (estimated): " << string::getFormattedByteSize(stats.residentBytes) << std::endl;
+    rMessage() << "Budget: " << (budget > 0 ? string::getFormattedByteSize(budget) : std::string("unlimited")) << std::endl;
+    rMessage() << "Frames: " << _frame << ", evicted: " << stats.numEvictions << ", reloaded: " << stats.numReloads << std::endl;
+}
+
 TexturePtr GLTextureManager::loadStandardTexture(const std::string& filename)
 {
     // Create the texture path
@@ -3,27 +3,50 @@
 
 #include "ishaders.h"
 #include <map>
+#include <functional>
 #include "../MapExpression.h"
 #include "texturelib.h"
+#include "registry/CachedKey.h"
 
 namespace shaders
 {
 
 class GLTextureManager
 {
+	/**
+	 * Texture handed out by the manager. The actual GL texture is loaded
+	 * on demand and can be released by the manager when it hasn't been used
+	 * for a while, it will be reloaded the next time its number is requested.
+	 */
+	class ResidentTexture;
+	using ResidentTexturePtr = std::shared_ptr<ResidentTexture>;
+
 	// The mapping between texturekeys and Texture instances
-	typedef std::map<std::string, TexturePtr> TextureMap;
+	typedef std::map<std::string, ResidentTexturePtr> TextureMap;
 	TextureMap _textures;
 
 	// The fallback textures in case a texture is empty or broken
 	TexturePtr _shaderNotFound;
 
+	registry::CachedKey<int> _memoryBudget;
+
+	// Incremented on every startFrame() call, used to track the last use of each texture
+	std::size_t _frame;
+
+	// Statistics
+	std::size_t _numEvictions;
+	std::size_t _numReloads;
+
 private:
 
 	// Constructs the fallback textures like "Shader Image Missing"
 	TexturePtr loadStandardTexture(const std::string& filename);
 
+	// Loads the texture using the given function and adds it to the map
+	TexturePtr createResidentTexture(const std::string& identifier, const std::function<TexturePtr()>& load);
+
 public:
+	GLTextureManager();
 
     /// Construct a bound texture from a generic named bindable.
     TexturePtr getBinding(const NamedBindablePtr& bindable,
@@ -53,6 +76,17 @@ public:
 	 */
 	void checkBindings();
 
+	/**
+	 * Advances the frame counter. If the loaded textures exceed the memory
+	 * budget, the least recently used ones are released until the budget is
+	 * met again. Needs to be called with the GL context being current.
+	 */
+	void startFrame();
+
+	TextureMemoryStatistics getMemoryStatistics();
+
+	// Writes the residency statistics to the console
+	void printMemoryStats();
 };
 
 typedef std::shared_ptr<GLTextureManager> GLTextureManagerPtr;
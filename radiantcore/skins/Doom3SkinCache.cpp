@@ -56,7 +56,7 @@ decl::ISkin::Ptr Doom3SkinCache::copySkin(const std::string& nameOfOriginal, con
     // Replace the syntax block of the target with the one of the original
     auto syntax = existing->getBlockSyntax();
     syntax.name = nameOfCopy;
-    syntax.fileInfo = vfs::FileInfo{ "", "", vfs::Visibility::HIDDEN };
+    syntax.setFileInfo(vfs::FileInfo{ "", "", vfs::Visibility::HIDDEN });
 
     copiedSkin->setBlockSyntax(syntax);
     copiedSkin->setIsModified();
@@ -91,7 +91,7 @@ bool Doom3SkinCache::skinCanBeModified(const std::string& name)
 
     if (!decl) return false;
 
-    const auto& fileInfo = decl->getBlockSyntax().fileInfo;
+    const auto& fileInfo = decl->getBlockSyntax().getFileInfo();
     return fileInfo.name.empty() || fileInfo.getIsPhysicalFile();
 }
 
@@ -1,6 +1,7 @@
 #include "UndoSystem.h"
 
 #include "itextstream.h"
+#include "iprofiler.h"
 
 #include <iostream>
 
@@ -64,6 +65,8 @@ void UndoSystem::cancel()
 
 void UndoSystem::finish(const std::string& command)
 {
+	PROFILE_ZONE("UndoSystem::finish");
+
 	if (finishUndo(command))
     {
 		rMessage() << command << std::endl;
@@ -73,6 +76,8 @@ void UndoSystem::finish(const std::string& command)
 
 void UndoSystem::undo()
 {
+	PROFILE_ZONE("UndoSystem::undo");
+
 	if (_undoStack.empty())
 	{
 		rMessage() << "Undo: no undo available" << std::endl;
@@ -98,6 +103,8 @@ void UndoSystem::undo()
 
 void UndoSystem::redo()
 {
+	PROFILE_ZONE("UndoSystem::redo");
+
 	if (_redoStack.empty())
 	{
 		rMessage() << "Redo: no redo available" << std::endl;
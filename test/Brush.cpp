@@ -3,9 +3,12 @@
 #include "ibrush.h"
 #include "imap.h"
 #include "iselection.h"
+#include "iundo.h"
 #include "itransformable.h"
 #include "scenelib.h"
 #include "math/Quaternion.h"
+#include "math/pi.h"
+#include "registry/registry.h"
 #include "algorithm/Scene.h"
 #include "algorithm/Primitives.h"
 #include "math/Vector3.h"
@@ -183,6 +186,41 @@ TEST_F(BrushTest, FacePlaneTranslate)
     });
 }
 
+TEST_F(BrushTest, FacePlaneSet)
+{
+    testFacePlane([this](const IBrushNodePtr& brush)
+    {
+        for (std::size_t i = 0; i < brush->getIBrush().getNumFaces(); ++i)
+        {
+            auto& face = brush->getIBrush().getFace(i);
+
+            if (math::isParallel(face.getPlane3().normal(), Vector3(1, 0, 0)))
+            {
+                Plane3 orig = face.getPlane3();
+                auto origBounds = _brushNode->localAABB();
+
+                // Push the face outwards by 10 units
+                {
+                    UndoableCommand cmd("setFacePlane");
+                    face.setPlane3(Plane3(orig.normal(), orig.dist() + 10));
+                }
+
+                EXPECT_EQ(face.getPlane3(), Plane3(orig.normal(), orig.dist() + 10));
+                EXPECT_NEAR(_brushNode->localAABB().getExtents().x(), origBounds.getExtents().x() + 5, 0.01);
+
+                GlobalUndoSystem().undo();
+
+                EXPECT_EQ(face.getPlane3(), orig);
+                EXPECT_NEAR(_brushNode->localAABB().getExtents().x(), origBounds.getExtents().x(), 0.01);
+
+                return true;
+            }
+        }
+
+        return false;
+    });
+}
+
 // Load a brush with one vertex at 0,0,0, and an identity shift/scale/rotation texdef
 TEST_F(Quake3BrushTest, LoadBrushWithIdentityTexDef)
 {
@@ -446,4 +484,120 @@ TEST_F(BrushTest, LoadBrushWithDuplicatePlanes)
     }
 }
 
+namespace
+{
+
+// Applies the transformation of the given step to the brush like a manipulator does,
+// the transformation is kept pending, the geometry is evaluated
+void applyManipulationStep(const scene::INodePtr& brushNode, int step)
+{
+    auto transformable = scene::node_cast<ITransformable>(brushNode);
+    transformable->setType(TRANSFORM_PRIMITIVE);
+    transformable->setTranslation(Vector3(step * 3.5, step * -2.0, step));
+    transformable->setRotation(Quaternion::createForZ(degrees_to_radians(step * 4.5)));
+
+    Node_getIBrush(brushNode)->evaluateBRep();
+}
+
+// The windings might start at a different vertex, they're compared as cyclic sequence
+void expectSameWinding(const IWinding& winding, const IWinding& reference)
+{
+    ASSERT_EQ(winding.size(), reference.size());
+    ASSERT_FALSE(winding.empty());
+
+    std::size_t offset = 0;
+
+    while (offset < reference.size() && !math::isNear(reference[offset].vertex, winding[0].vertex, 0.001))
+    {
+        ++offset;
+    }
+
+    ASSERT_LT(offset, reference.size()) << "Vertex " << winding[0].vertex << " not found in the reference winding";
+
+    for (std::size_t v = 0; v < winding.size(); ++v)
+    {
+        const auto& expected = reference[(v + offset) % reference.size()];
+
+        EXPECT_TRUE(math::isNear(winding[v].vertex, expected.vertex, 0.001))
+            << "Vertex " << v << ": " << winding[v].vertex << " != " << expected.vertex;
+        EXPECT_TRUE(math::isNear(winding[v].texcoord, expected.texcoord, 0.001))
+            << "Texcoord " << v << ": " << winding[v].texcoord << " != " << expected.texcoord;
+    }
+}
+
+void expectSameGeometry(const scene::INodePtr& brushNode, const scene::INodePtr& referenceNode)
+{
+    EXPECT_TRUE(math::isNear(brushNode->localAABB().getOrigin(), referenceNode->localAABB().getOrigin(), 0.01));
+    EXPECT_TRUE(math::isNear(brushNode->localAABB().getExtents(), referenceNode->localAABB().getExtents(), 0.01));
+
+    auto brush = Node_getIBrush(brushNode);
+    auto reference = Node_getIBrush(referenceNode);
+
+    ASSERT_EQ(brush->getNumFaces(), reference->getNumFaces());
+
+    for (std::size_t i = 0; i < brush->getNumFaces(); ++i)
+    {
+        SCOPED_TRACE("Face " + std::to_string(i));
+
+        expectNear(brush->getFace(i).getPlane3(), reference->getFace(i).getPlane3(), 0.001);
+        expectSameWinding(brush->getFace(i).getWinding(), reference->getFace(i).getWinding());
+    }
+}
+
+// Creates a brush with the transformation of the given step, built without preview
+scene::INodePtr createReferenceBrush(int step, bool freeze)
+{
+    registry::setValue(RKEY_BRUSH_TRANSFORM_PREVIEW, false);
+
+    auto brush = algorithm::createCubicBrush(GlobalMapModule().findOrInsertWorldspawn(),
+        Vector3(64, 32, 16), "textures/numbers/1");
+    applyManipulationStep(brush, step);
+
+    if (freeze)
+    {
+        scene::node_cast<ITransformable>(brush)->freezeTransform();
+        Node_getIBrush(brush)->evaluateBRep();
+    }
+
+    registry::setValue(RKEY_BRUSH_TRANSFORM_PREVIEW, true);
+
+    return brush;
+}
+
+}
+
+// Brushes being manipulated transform their windings instead of rebuilding them,
+// the outcome needs to be the same as with the full rebuild after every step
+TEST_F(BrushTest, TransformPreviewMatchesFullRebuild)
+{
+    registry::setValue(RKEY_BRUSH_TRANSFORM_PREVIEW, true);
+
+    auto previewBrush = algorithm::createCubicBrush(GlobalMapModule().findOrInsertWorldspawn(),
+        Vector3(64, 32, 16), "textures/numbers/1");
+
+    constexpr int NumSteps = 10;
+
+    for (int step = 1; step <= NumSteps; ++step)
+    {
+        SCOPED_TRACE("Step " + std::to_string(step));
+
+        applyManipulationStep(previewBrush, step);
+
+        // Compare the preview windings against a brush rebuilt with the same transform
+        auto reference = createReferenceBrush(step, false);
+        expectSameGeometry(previewBrush, reference);
+        scene::removeNodeFromParent(reference);
+    }
+
+    // Freezing the transformation ends the preview with a full rebuild
+    scene::node_cast<ITransformable>(previewBrush)->freezeTransform();
+    Node_getIBrush(previewBrush)->evaluateBRep();
+
+    SCOPED_TRACE("After freezeTransform");
+
+    auto reference = createReferenceBrush(NumSteps, true);
+    expectSameGeometry(previewBrush, reference);
+    scene::removeNodeFromParent(reference);
+}
+
 }
@@ -3,10 +3,18 @@
 #include "iselectable.h"
 #include "iselection.h"
 #include "ishaderclipboard.h"
+#include "iselectiongroup.h"
+#include "ientity.h"
+#include "ibrush.h"
+
+#include <map>
+#include <sstream>
 
 #include "testutil/CommandFailureHelper.h"
 #include "testutil/MapOperationMonitor.h"
 #include "algorithm/Primitives.h"
+#include "algorithm/Entity.h"
+#include "algorithm/Scene.h"
 #include "algorithm/View.h"
 #include "algorithm/XmlUtils.h"
 #include "render/View.h"
@@ -146,4 +154,119 @@ TEST_F(ClipboardTest, CopyFaceSelection)
     EXPECT_EQ(GlobalShaderClipboard().getShaderName(), "textures/common/caulk") << "Shaderclipboard should contain the material name now";
 }
 
+namespace
+{
+
+// Describes the selected nodes in a way that doesn't depend on entity names or node identity
+std::vector<std::string> describeSelection()
+{
+    std::vector<std::string> result;
+
+    GlobalSelectionSystem().foreachSelected([&](const scene::INodePtr& node)
+    {
+        std::stringstream description;
+        description << static_cast<int>(node->getNodeType());
+
+        if (auto entity = Node_getEntity(node); entity)
+        {
+            std::map<std::string, std::string> keyValues;
+
+            entity->forEachKeyValue([&](const std::string& key, const std::string& value)
+            {
+                keyValues[key] = value;
+            });
+
+            // Names are made unique during each paste operation
+            keyValues.erase("name");
+            keyValues.erase("model");
+
+            for (const auto& [key, value] : keyValues)
+            {
+                description << " " << key << "=" << value;
+            }
+
+            description << " children=" << algorithm::getChildCount(node);
+        }
+        else
+        {
+            description << " parent=" << Node_getEntity(node->getParent())->getKeyValue("classname");
+        }
+
+        if (auto brush = Node_getIBrush(node); brush)
+        {
+            for (std::size_t i = 0; i < brush->getNumFaces(); ++i)
+            {
+                const auto& face = brush->getFace(i);
+                description << " " << face.getShader() << " " << face.getPlane3().normal() << " " << face.getPlane3().dist();
+            }
+        }
+
+        if (auto groupSelectable = std::dynamic_pointer_cast<IGroupSelectable>(node); groupSelectable)
+        {
+            description << " groups=" << groupSelectable->getGroupIds().size();
+        }
+
+        result.push_back(description.str());
+    });
+
+    std::sort(result.begin(), result.end());
+
+    return result;
+}
+
+}
+
+// Pasting the copied nodes within the same process should lead to the
+// same result as pasting the map text placed on the clipboard
+TEST_F(ClipboardTest, PasteCopiedNodesMatchesPasteFromText)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    auto brush1 = algorithm::createCubicBrush(worldspawn, { 0, 0, 0 }, "textures/numbers/1");
+    auto brush2 = algorithm::createCubicBrush(worldspawn, { 64, 0, 0 }, "textures/numbers/2");
+
+    auto funcStatic = algorithm::createEntityByClassName("func_static");
+    GlobalMapModule().getRoot()->addChildNode(funcStatic);
+    funcStatic->getEntity().setKeyValue("origin", "0 128 0");
+    algorithm::createCubicBrush(funcStatic, { 0, 128, 0 }, "textures/numbers/3");
+
+    auto light = algorithm::createEntityByClassName("light");
+    GlobalMapModule().getRoot()->addChildNode(light);
+    light->getEntity().setKeyValue("origin", "0 0 256");
+
+    Node_setSelected(brush1, true);
+    Node_setSelected(brush2, true);
+    Node_setSelected(funcStatic, true);
+    GlobalCommandSystem().executeCommand("GroupSelected");
+    Node_setSelected(light, true);
+
+    GlobalCommandSystem().executeCommand("Copy");
+    EXPECT_TRUE(GlobalClipboard().getContent()) << "Clipboard should hold the copied nodes";
+
+    // Paste within this process, the copied nodes are cloned
+    GlobalCommandSystem().executeCommand("Paste");
+    auto selectionAfterClonedPaste = describeSelection();
+
+    // Paste the text as if it has been put there by another application
+    GlobalClipboard().setString(GlobalClipboard().getString());
+    EXPECT_FALSE(GlobalClipboard().getContent()) << "Clipboard should hold text only";
+
+    GlobalCommandSystem().executeCommand("Paste");
+    auto selectionAfterTextPaste = describeSelection();
+
+    EXPECT_EQ(selectionAfterClonedPaste.size(), 4) << "Expected 2 brushes and 2 entities to be pasted";
+    EXPECT_EQ(selectionAfterClonedPaste, selectionAfterTextPaste);
+
+    // Both pastes added their own brushes to worldspawn
+    EXPECT_EQ(algorithm::getChildCount(worldspawn), 6);
+
+    // The clipboard contents are still valid after cutting the original nodes
+    GlobalSelectionSystem().setSelectedAll(false);
+    Node_setSelected(brush1, true);
+    GlobalCommandSystem().executeCommand("Cut");
+
+    GlobalCommandSystem().executeCommand("Paste");
+    EXPECT_EQ(GlobalSelectionSystem().countSelected(), 3) << "The cut brush is part of a group of 3";
+    EXPECT_EQ(algorithm::getChildCount(worldspawn), 6);
+}
+
 }
@@ -1,5 +1,6 @@
 #include "RadiantTest.h"
 
+#include <set>
 #include "igame.h"
 #include "ideclmanager.h"
 #include "testutil/TemporaryFile.h"
@@ -435,7 +436,7 @@ TEST_F(DeclManagerTest, FindOrCreateDeclaration)
     EXPECT_EQ(defaultDecl->getDeclType(), decl::Type::TestDecl);
     EXPECT_EQ(defaultDecl->getDeclName(), "decl/nonexistent");
     EXPECT_EQ(defaultDecl->getBlockSyntax().contents, std::string());
-    EXPECT_EQ(defaultDecl->getBlockSyntax().fileInfo.visibility, vfs::Visibility::HIDDEN);
+    EXPECT_EQ(defaultDecl->getBlockSyntax().getFileInfo().visibility, vfs::Visibility::HIDDEN);
 
     EXPECT_EQ(GlobalDeclarationManager().findOrCreateDeclaration(decl::Type::TestDecl, "decl/nonexistent"), defaultDecl)
         << "We expect the created declaration to be persistent";
@@ -699,7 +700,7 @@ testdecl    decl/temporary/12 { diffusemap textures/temporary/12 }
 
     EXPECT_TRUE(decl) << "Declaration should still be registered after reloadDecls";
     EXPECT_TRUE(decl->getBlockSyntax().contents.empty()) << "Declaration should be empty after reloadDecls";
-    EXPECT_EQ(decl->getBlockSyntax().fileInfo.visibility, vfs::Visibility::HIDDEN) << "Declaration should be hidden after reloadDecls";
+    EXPECT_EQ(decl->getBlockSyntax().getFileInfo().visibility, vfs::Visibility::HIDDEN) << "Declaration should be hidden after reloadDecls";
 }
 
 TEST_F(DeclManagerTest, DeclarationPrecedence)
@@ -735,10 +736,10 @@ TEST_F(DeclManagerTest, RemoveDeclaration)
     EXPECT_TRUE(decl->getBlockSyntax().name.empty());
     EXPECT_TRUE(decl->getBlockSyntax().typeName.empty());
     EXPECT_TRUE(decl->getBlockSyntax().contents.empty());
-    EXPECT_TRUE(decl->getBlockSyntax().fileInfo.name.empty());
-    EXPECT_TRUE(decl->getBlockSyntax().fileInfo.topDir.empty());
-    EXPECT_TRUE(decl->getBlockSyntax().fileInfo.fullPath().empty());
-    EXPECT_EQ(decl->getBlockSyntax().fileInfo.visibility, vfs::Visibility::HIDDEN);
+    EXPECT_TRUE(decl->getBlockSyntax().getFileInfo().name.empty());
+    EXPECT_TRUE(decl->getBlockSyntax().getFileInfo().topDir.empty());
+    EXPECT_TRUE(decl->getBlockSyntax().getFileInfo().fullPath().empty());
+    EXPECT_EQ(decl->getBlockSyntax().getFileInfo().visibility, vfs::Visibility::HIDDEN);
 }
 
 // Removing a decl defined in a PK4 file will throw
@@ -749,7 +750,7 @@ TEST_F(DeclManagerTest, RemoveDeclarationInPk4File)
 
     auto decl = GlobalDeclarationManager().findDeclaration(decl::Type::TestDecl, "decl/export/0");
     EXPECT_TRUE(decl) << "decl/export/0 must be present";
-    EXPECT_FALSE(decl->getBlockSyntax().fileInfo.getIsPhysicalFile()) << "decl/export/0 should be in a PK4 file";
+    EXPECT_FALSE(decl->getBlockSyntax().getFileInfo().getIsPhysicalFile()) << "decl/export/0 should be in a PK4 file";
 
     // Attempting to remove the decl will throw
     EXPECT_THROW(GlobalDeclarationManager().removeDeclaration(decl->getDeclType(), decl->getDeclName()),
@@ -766,7 +767,7 @@ TEST_F(DeclManagerTest, RemoveDeclarationFromPhysicalFile)
     expectDeclIsPresent(decl::Type::TestDecl, "decl/removal/1");
 
     auto originalSyntax = decl->getBlockSyntax();
-    EXPECT_TRUE(originalSyntax.fileInfo.getIsPhysicalFile()) << "decl/removal/1 must be in a physical file";
+    EXPECT_TRUE(originalSyntax.getFileInfo().getIsPhysicalFile()) << "decl/removal/1 must be in a physical file";
 
     auto fileContents = algorithm::loadTextFromVfsFile(decl->getDeclFilePath());
     EXPECT_NE(fileContents.find(originalSyntax.contents), std::string::npos) << "Decl source not found";
@@ -1128,7 +1129,7 @@ TEST_F(DeclManagerTest, RenameDeclaration)
     EXPECT_EQ(newSyntax.contents, oldSyntax.contents);
     EXPECT_EQ(newSyntax.getModName(), oldSyntax.getModName());
     EXPECT_EQ(newSyntax.typeName, oldSyntax.typeName);
-    EXPECT_EQ(newSyntax.fileInfo.fullPath(), oldSyntax.fileInfo.fullPath());
+    EXPECT_EQ(newSyntax.getFileInfo().fullPath(), oldSyntax.getFileInfo().fullPath());
 }
 
 TEST_F(DeclManagerTest, DeclRenamedSignal)
@@ -1347,7 +1348,7 @@ TEST_F(DeclManagerTest, SaveNewDeclToNewFile)
 
     EXPECT_TRUE(fs::exists(outputPath)) << "Output file should exist now";
 
-    expectDeclIsPresentInFile(decl, decl->getBlockSyntax().fileInfo.fullPath(), true);
+    expectDeclIsPresentInFile(decl, decl->getBlockSyntax().getFileInfo().fullPath(), true);
 }
 
 // Save the decl to a file that already exists (but doesn't contain the def)
@@ -1366,15 +1367,15 @@ TEST_F(DeclManagerTest, SaveNewDeclToExistingFile)
     auto fileInfo = vfs::FileInfo(TEST_DECL_FOLDER, "numbers.decl", vfs::Visibility::NORMAL);
     decl->setFileInfo(fileInfo);
 
-    auto outputPath = _context.getTestProjectPath() + syntax.fileInfo.fullPath();
+    auto outputPath = _context.getTestProjectPath() + syntax.getFileInfo().fullPath();
     EXPECT_TRUE(fs::exists(outputPath)) << "Output file must already exist";
 
     // Def file should not have that decl yet
-    expectDeclIsPresentInFile(decl, decl->getBlockSyntax().fileInfo.fullPath(), false);
+    expectDeclIsPresentInFile(decl, decl->getBlockSyntax().getFileInfo().fullPath(), false);
 
     GlobalDeclarationManager().saveDeclaration(decl);
 
-    expectDeclIsPresentInFile(decl, decl->getBlockSyntax().fileInfo.fullPath(), true);
+    expectDeclIsPresentInFile(decl, decl->getBlockSyntax().getFileInfo().fullPath(), true);
 
     // the fixture will revert the changes to numbers.decl
 }
@@ -1393,11 +1394,11 @@ TEST_F(DeclManagerTest, SaveExistingDeclToExistingFile)
     decl->setKeyValue("tork", "new_value");
 
     // This modified decl should not be present
-    expectDeclIsPresentInFile(decl, decl->getBlockSyntax().fileInfo.fullPath(), false);
+    expectDeclIsPresentInFile(decl, decl->getBlockSyntax().getFileInfo().fullPath(), false);
 
     // Save, it should be there now
     GlobalDeclarationManager().saveDeclaration(decl);
-    expectDeclIsPresentInFile(decl, decl->getBlockSyntax().fileInfo.fullPath(), true);
+    expectDeclIsPresentInFile(decl, decl->getBlockSyntax().getFileInfo().fullPath(), true);
 
     // The test fixture will restore the original file contents in TearDown
 }
@@ -1416,30 +1417,30 @@ TEST_F(DeclManagerTest, SaveExistingDeclToNewFileOverridingPk4)
     decl->setKeyValue("tork", "new_value");
 
     // The overriding file should not be present
-    auto outputPath = _context.getTestProjectPath() + decl->getBlockSyntax().fileInfo.fullPath();
+    auto outputPath = _context.getTestProjectPath() + decl->getBlockSyntax().getFileInfo().fullPath();
 
     // Let the file be deleted when we're done here
     TemporaryFile outputFile(outputPath);
     EXPECT_FALSE(fs::exists(outputPath));
 
-    expectDeclIsPresentInFile(decl, decl->getBlockSyntax().fileInfo.fullPath(), false);
+    expectDeclIsPresentInFile(decl, decl->getBlockSyntax().getFileInfo().fullPath(), false);
 
     // Save, it should be there now
     GlobalDeclarationManager().saveDeclaration(decl);
-    expectDeclIsPresentInFile(decl, decl->getBlockSyntax().fileInfo.fullPath(), true);
+    expectDeclIsPresentInFile(decl, decl->getBlockSyntax().getFileInfo().fullPath(), true);
 
     // Check if the other decl declaration is still intact in the file (use the same path to check)
     auto export2Decl = std::static_pointer_cast<ITestDeclaration>(
         GlobalDeclarationManager().findDeclaration(decl::Type::TestDecl, "decl/export/2"));
     EXPECT_EQ(export2Decl->getDeclFilePath(), decl->getDeclFilePath()) << "The decls should be in the same .decl file";
-    expectDeclIsPresentInFile(export2Decl, decl->getBlockSyntax().fileInfo.fullPath(), true);
+    expectDeclIsPresentInFile(export2Decl, decl->getBlockSyntax().getFileInfo().fullPath(), true);
 
     auto export0Decl = std::static_pointer_cast<ITestDeclaration>(
         GlobalDeclarationManager().findDeclaration(decl::Type::TestDecl, "decl/export/0"));
     EXPECT_EQ(export0Decl->getDeclFilePath(), decl->getDeclFilePath()) << "The decls should be in the same .decl file";
-    expectDeclIsPresentInFile(export0Decl, decl->getBlockSyntax().fileInfo.fullPath(), true);
+    expectDeclIsPresentInFile(export0Decl, decl->getBlockSyntax().getFileInfo().fullPath(), true);
 
-    auto contents = algorithm::loadTextFromVfsFile(decl->getBlockSyntax().fileInfo.fullPath());
+    auto contents = algorithm::loadTextFromVfsFile(decl->getBlockSyntax().getFileInfo().fullPath());
 
     // Comments need to be left untouched
     EXPECT_NE(contents.find("Some comment before the declaration decl/export/0"), std::string::npos) << "Comments should be left intact";
@@ -1477,7 +1478,7 @@ TEST_F(DeclManagerTest, SaveExistingDeclLackingTypename)
     // Save, then it should be present in the file
     GlobalDeclarationManager().saveDeclaration(decl);
 
-    expectDeclIsPresentInFile(decl, decl->getBlockSyntax().fileInfo.fullPath(), true);
+    expectDeclIsPresentInFile(decl, decl->getBlockSyntax().getFileInfo().fullPath(), true);
 
     // The test fixture will restore the original file contents in TearDown
 }
@@ -1497,7 +1498,7 @@ TEST_F(DeclManagerTest, SaveExistingDeclWithMatchingTypename)
     // Save, then it should be present in the file
     GlobalDeclarationManager().saveDeclaration(decl);
 
-    expectDeclIsPresentInFile(decl, decl->getBlockSyntax().fileInfo.fullPath(), true);
+    expectDeclIsPresentInFile(decl, decl->getBlockSyntax().getFileInfo().fullPath(), true);
 
     // The test fixture will restore the original file contents in TearDown
 }
@@ -1517,7 +1518,7 @@ TEST_F(DeclManagerTest, SaveExistingDeclWithMixedCaseTypename)
     // Save, then it should be present in the file
     GlobalDeclarationManager().saveDeclaration(decl);
 
-    expectDeclIsPresentInFile(decl, decl->getBlockSyntax().fileInfo.fullPath(), true);
+    expectDeclIsPresentInFile(decl, decl->getBlockSyntax().getFileInfo().fullPath(), true);
 
     // The test fixture will restore the original file contents in TearDown
 }
@@ -1537,7 +1538,7 @@ TEST_F(DeclManagerTest, SaveExistingDeclWithCommentInTheSameLine)
     // Save, then it should be present in the file
     GlobalDeclarationManager().saveDeclaration(decl);
 
-    expectDeclIsPresentInFile(decl, decl->getBlockSyntax().fileInfo.fullPath(), true);
+    expectDeclIsPresentInFile(decl, decl->getBlockSyntax().getFileInfo().fullPath(), true);
 
     // The test fixture will restore the original file contents in TearDown
 }
@@ -1558,7 +1559,7 @@ TEST_F(DeclManagerTest, SaveExistingDeclWithEverythingInASingleLine)
     // Save, then it should be present in the file
     GlobalDeclarationManager().saveDeclaration(decl);
 
-    expectDeclIsPresentInFile(decl, decl->getBlockSyntax().fileInfo.fullPath(), true);
+    expectDeclIsPresentInFile(decl, decl->getBlockSyntax().getFileInfo().fullPath(), true);
 
     // The test fixture will restore the original file contents in TearDown
 }
@@ -1628,9 +1629,9 @@ TEST_F(DeclManagerTest, SetDeclFileInfo)
 
     decl->setFileInfo(vfs::FileInfo("materials/", "testfile.mtr", vfs::Visibility::HIDDEN));
 
-    EXPECT_EQ(decl->getBlockSyntax().fileInfo.name, "testfile.mtr");
-    EXPECT_EQ(decl->getBlockSyntax().fileInfo.topDir, "materials/");
-    EXPECT_EQ(decl->getBlockSyntax().fileInfo.visibility, vfs::Visibility::HIDDEN);
+    EXPECT_EQ(decl->getBlockSyntax().getFileInfo().name, "testfile.mtr");
+    EXPECT_EQ(decl->getBlockSyntax().getFileInfo().topDir, "materials/");
+    EXPECT_EQ(decl->getBlockSyntax().getFileInfo().visibility, vfs::Visibility::HIDDEN);
 }
 
 TEST_F(DeclManagerTest, SetDeclName)
@@ -1647,6 +1648,75 @@ TEST_F(DeclManagerTest, SetDeclName)
     EXPECT_EQ(decl->getBlockSyntax().name, newName) << "New name not propagated to the decl block syntax";
 }
 
+// Syntax blocks can be shared between decls, changing one decl must not affect the others
+TEST_F(DeclManagerTest, SharedSyntaxBlockIsNotModified)
+{
+    GlobalDeclarationManager().registerDeclType("testdecl", std::make_shared<TestDeclarationCreator>());
+    GlobalDeclarationManager().registerDeclFolder(decl::Type::TestDecl, TEST_DECL_FOLDER, ".decl");
+
+    auto decl = GlobalDeclarationManager().findDeclaration(decl::Type::TestDecl, "decl/numbers/3");
+    auto otherDecl = GlobalDeclarationManager().findDeclaration(decl::Type::TestDecl, "decl/numbers/2");
+
+    decl::DeclarationBlockSyntax::Ptr block = std::make_shared<decl::DeclarationBlockSyntax>(decl->getBlockSyntax());
+
+    decl->setBlockSyntax(block);
+    otherDecl->setBlockSyntax(block);
+
+    EXPECT_EQ(&decl->getBlockSyntax(), block.get()) << "Block should have been shared, not copied";
+    EXPECT_EQ(&otherDecl->getBlockSyntax(), block.get()) << "Block should have been shared, not copied";
+
+    decl->setFileInfo(vfs::FileInfo("materials/", "testfile.mtr", vfs::Visibility::HIDDEN));
+    decl->setDeclName("decl/changed/3333");
+
+    EXPECT_EQ(decl->getBlockSyntax().getFileInfo().name, "testfile.mtr");
+    EXPECT_EQ(decl->getBlockSyntax().name, "decl/changed/3333");
+
+    // The shared block and the other decl keep their values
+    EXPECT_EQ(block->getFileInfo().name, otherDecl->getBlockSyntax().getFileInfo().name);
+    EXPECT_NE(block->getFileInfo().name, "testfile.mtr");
+    EXPECT_EQ(block->name, "decl/numbers/3");
+    EXPECT_EQ(&otherDecl->getBlockSyntax(), block.get());
+}
+
+TEST_F(DeclManagerTest, ShowDeclMemoryStats)
+{
+    GlobalDeclarationManager().registerDeclType("testdecl", std::make_shared<TestDeclarationCreator>());
+    GlobalDeclarationManager().registerDeclFolder(decl::Type::TestDecl, TEST_DECL_FOLDER, ".decl");
+
+    expectDeclIsPresent(decl::Type::TestDecl, "decl/numbers/3");
+
+    std::set<std::string> declFiles;
+    std::set<const vfs::FileInfo*> fileInfos;
+
+    GlobalDeclarationManager().foreachDeclaration(decl::Type::TestDecl, [&](const decl::IDeclaration::Ptr& decl)
+    {
+        declFiles.insert(decl->getDeclFilePath());
+        fileInfos.insert(&decl->getBlockSyntax().getFileInfo());
+    });
+
+    // The decls of a file share the file info instead of holding their own copies
+    EXPECT_EQ(fileInfos.size(), declFiles.size());
+
+    auto stats = GlobalDeclarationManager().getMemoryStatistics();
+
+    EXPECT_GE(stats.numDeclarations, 10u);
+    EXPECT_GE(stats.numBlocks, stats.numFileOrigins);
+    EXPECT_LT(stats.numFileOrigins, stats.numBlocks / 2) << "Expected far fewer file origins than blocks";
+
+    // The shared file origins take less memory than a copy per block would
+    EXPECT_GT(stats.fileOriginBytes, 0u);
+    EXPECT_LT(stats.fileOriginBytes * 2, stats.unsharedFileOriginBytes);
+
+    // Declarations modified in memory get their own file origin
+    auto decl = GlobalDeclarationManager().findDeclaration(decl::Type::TestDecl, "decl/numbers/3");
+    decl->setFileInfo(vfs::FileInfo(TEST_DECL_FOLDER, "a_file_that_is_not_shared.decl", vfs::Visibility::NORMAL));
+
+    auto statsAfterChange = GlobalDeclarationManager().getMemoryStatistics();
+    EXPECT_EQ(statsAfterChange.numFileOrigins, stats.numFileOrigins + 1);
+
+    EXPECT_NO_THROW(GlobalCommandSystem().executeCommand("ShowDeclMemoryStats"));
+}
+
 // Changed signal should fire on assigning a new syntax block
 TEST_F(DeclManagerTest, ChangedSignalOnSyntaxBlockChange)
 {
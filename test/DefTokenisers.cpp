@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 
 #include "parser/DefTokeniser.h"
+#include "parser/NumericTextReader.h"
 
 namespace test
 {
@@ -128,4 +129,82 @@ TEST(DefTokeniser, EmptyQuotesAtEndOfBlock)
     EXPECT_EQ(keyValuePairs["mins"], "-1 -1 -3");
 }
 
+TEST(NumericTextReader, ParseEmptyString)
+{
+    parser::NumericTextReader reader("");
+    EXPECT_FALSE(reader.hasMoreTokens());
+
+    parser::NumericTextReader whitespaceReader(" \t \r\n\t");
+    EXPECT_FALSE(whitespaceReader.hasMoreTokens());
+}
+
+TEST(NumericTextReader, ParseNumbersAndDelimiters)
+{
+    std::string testString = "planes 2 {\n"
+        "    0 ( 1 0 0 -64.5 )\n"
+        "    1 (-1 0 0 1e3)\n"
+        "}\n";
+    parser::NumericTextReader reader(testString);
+
+    reader.assertNextToken("planes");
+    EXPECT_EQ(reader.nextInteger<std::size_t>(), 2);
+    reader.assertNextToken("{");
+
+    EXPECT_EQ(reader.nextInteger<int>(), 0);
+    reader.assertNextToken("(");
+    EXPECT_EQ(reader.nextDouble(), 1.0);
+    EXPECT_EQ(reader.nextDouble(), 0.0);
+    EXPECT_EQ(reader.nextDouble(), 0.0);
+    EXPECT_EQ(reader.nextDouble(), -64.5);
+    reader.assertNextToken(")");
+
+    // Parentheses are split off the numbers
+    EXPECT_EQ(reader.nextInteger<int>(), 1);
+    reader.assertNextToken("(");
+    EXPECT_EQ(reader.nextInteger<int>(), -1);
+    EXPECT_EQ(reader.nextFloat(), 0.0f);
+    EXPECT_EQ(reader.nextFloat(), 0.0f);
+    EXPECT_EQ(reader.nextFloat(), 1000.0f);
+    reader.assertNextToken(")");
+
+    reader.assertNextToken("}");
+    EXPECT_FALSE(reader.hasMoreTokens());
+}
+
+TEST(NumericTextReader, SkipComments)
+{
+    std::string testString = "// line comment\n1 /* block\ncomment */ 2\n/* unterminated";
+    parser::NumericTextReader reader(testString);
+
+    EXPECT_EQ(reader.nextInteger<int>(), 1);
+    EXPECT_EQ(reader.peek(), "2");
+    EXPECT_EQ(reader.nextInteger<int>(), 2);
+    EXPECT_FALSE(reader.hasMoreTokens());
+}
+
+TEST(NumericTextReader, SkipAndExtractBlocks)
+{
+    std::string testString = "{ 1 { 2 } 3 } { key ( 4 5 ) } end";
+    parser::NumericTextReader reader(testString);
+
+    reader.skipBlock();
+    EXPECT_EQ(reader.nextBlock(), "{ key ( 4 5 ) }");
+    reader.assertNextToken("end");
+
+    parser::NumericTextReader unbalancedReader("{ 1 { 2 }");
+    EXPECT_THROW(unbalancedReader.skipBlock(), parser::ParseException);
+}
+
+TEST(NumericTextReader, InvalidNumbersThrow)
+{
+    parser::NumericTextReader reader("12x 1.5 abc ( -");
+
+    EXPECT_THROW(reader.nextInteger<int>(), parser::ParseException);
+    EXPECT_THROW(reader.nextInteger<int>(), parser::ParseException); // 1.5 is not an integer
+    EXPECT_THROW(reader.nextDouble(), parser::ParseException);
+    EXPECT_THROW(reader.nextDouble(), parser::ParseException);
+    EXPECT_THROW(reader.nextDouble(), parser::ParseException);
+    EXPECT_THROW(reader.nextToken(), parser::ParseException);
+}
+
 }
@@ -159,6 +159,33 @@ TEST_F(EntityTest, EnumerateInheritedSpawnargs)
     EXPECT_EQ(keyValues["noshadows"], "0");
 }
 
+TEST_F(EntityTest, GetInheritedKeyValue)
+{
+    auto light = algorithm::createEntityByClassName("atdm:light_base");
+    auto& spawnArgs = light->getEntity();
+
+    // Inherited values are found regardless of the key case
+    EXPECT_EQ(spawnArgs.getKeyValue("spawnclass"), "idLight");
+    EXPECT_EQ(spawnArgs.getKeyValue("SpawnClass"), "idLight");
+    EXPECT_EQ(spawnArgs.getKeyValue("aiuse"), "AIUSE_LIGHTSOURCE");
+    EXPECT_TRUE(spawnArgs.isInherited("noshadows"));
+
+    // Entity values hide the inherited ones
+    spawnArgs.setKeyValue("noshadows", "1");
+    EXPECT_EQ(spawnArgs.getKeyValue("noshadows"), "1");
+    EXPECT_EQ(spawnArgs.getKeyValue("NoShadows"), "1");
+    EXPECT_FALSE(spawnArgs.isInherited("noshadows"));
+
+    // Removing the entity value reveals the inherited one again
+    spawnArgs.setKeyValue("noshadows", "");
+    EXPECT_EQ(spawnArgs.getKeyValue("noshadows"), "0");
+    EXPECT_TRUE(spawnArgs.isInherited("noshadows"));
+
+    // Keys nobody ever used
+    EXPECT_EQ(spawnArgs.getKeyValue("unknown_key_for_testing"), "");
+    EXPECT_FALSE(spawnArgs.isInherited("unknown_key_for_testing"));
+}
+
 TEST_F(EntityTest, GetKeyValuePairs)
 {
     auto torch = algorithm::createEntityByClassName("atdm:torch_brazier");
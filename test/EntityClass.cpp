@@ -600,7 +600,7 @@ TEST_F(EntityClassTest, FindModelDef)
     auto model = GlobalEntityClassManager().findModel("just_a_model");
     EXPECT_TRUE(model) << "ModelDef lookup failed";
     EXPECT_EQ(model->getMesh(), "just_an_md5.md5mesh");
-    EXPECT_EQ(model->getBlockSyntax().fileInfo.fullPath(), "def/entity_with_model.def");
+    EXPECT_EQ(model->getBlockSyntax().getFileInfo().fullPath(), "def/entity_with_model.def");
 
     EXPECT_TRUE(GlobalEntityClassManager().findModel("some_other_model"));
     EXPECT_TRUE(GlobalEntityClassManager().findModel("a_cooler_model"));
@@ -10,20 +10,34 @@ class FakeClipboardModule :
 {
 private:
     std::string _contents;
+    radiant::IClipboardContent::Ptr _content;
     sigc::signal<void> _changedSignal;
 
 public:
     std::string getString() override
     {
-        return _contents;
+        return _content ? _content->getString() : _contents;
     }
 
     void setString(const std::string& str) override
     {
+        _content.reset();
         _contents = str;
         _changedSignal.emit();
     }
 
+    void setContent(const radiant::IClipboardContent::Ptr& content) override
+    {
+        _content = content;
+        _contents.clear();
+        _changedSignal.emit();
+    }
+
+    radiant::IClipboardContent::Ptr getContent() override
+    {
+        return _content;
+    }
+
     sigc::signal<void>& signal_clipboardContentChanged() override
     {
         return _changedSignal;
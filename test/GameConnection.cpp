@@ -0,0 +1,259 @@
+#include "gtest/gtest.h"
+
+#include "../plugins/dm.gameconnection/ChangeJournal.h"
+
+namespace test
+{
+
+using namespace std::chrono_literals;
+using gameconn::ChangeJournal;
+using gameconn::DiffStatus;
+
+namespace
+{
+
+// Journal with the default timings spelled out, the tests below depend on them
+inline ChangeJournal createJournal()
+{
+    return ChangeJournal(200ms, 500ms, 1s, 4s);
+}
+
+}
+
+TEST(ChangeJournalTest, NothingDueWithoutChanges)
+{
+    auto journal = createJournal();
+    auto start = ChangeJournal::Clock::now();
+
+    EXPECT_FALSE(journal.hasPendingChanges());
+    EXPECT_FALSE(journal.isBatchDue(start));
+    EXPECT_FALSE(journal.isBatchDue(start + 1h));
+}
+
+TEST(ChangeJournalTest, BatchDueAfterQuietPeriod)
+{
+    auto journal = createJournal();
+    auto start = ChangeJournal::Clock::now();
+
+    journal.record("light_1", DiffStatus::modified(), start);
+
+    EXPECT_TRUE(journal.hasPendingChanges());
+    EXPECT_FALSE(journal.isBatchDue(start));
+    EXPECT_FALSE(journal.isBatchDue(start + 199ms));
+    EXPECT_TRUE(journal.isBatchDue(start + 200ms));
+
+    // Another change restarts the quiet period
+    journal.record("light_2", DiffStatus::modified(), start + 100ms);
+
+    EXPECT_FALSE(journal.isBatchDue(start + 250ms));
+    EXPECT_TRUE(journal.isBatchDue(start + 300ms));
+}
+
+TEST(ChangeJournalTest, BatchDueAfterMaxDelay)
+{
+    auto journal = createJournal();
+    auto start = ChangeJournal::Clock::now();
+
+    // A drag operation producing a change every 100 ms, the map is never quiet
+    for (auto offset = 0ms; offset < 500ms; offset += 100ms)
+    {
+        journal.record("func_static_1", DiffStatus::modified(), start + offset);
+        EXPECT_FALSE(journal.isBatchDue(start + offset + 50ms));
+    }
+
+    journal.record("func_static_1", DiffStatus::modified(), start + 500ms);
+
+    // The oldest change waited long enough
+    EXPECT_TRUE(journal.isBatchDue(start + 500ms));
+}
+
+TEST(ChangeJournalTest, ChangesAreMergedPerEntity)
+{
+    auto journal = createJournal();
+    auto start = ChangeJournal::Clock::now();
+
+    journal.record("light_1", DiffStatus::modified(), start);
+    journal.record("light_1", DiffStatus::modified(), start + 10ms);
+    journal.record("speaker_1", DiffStatus::added(), start + 20ms);
+    journal.record("speaker_1", DiffStatus::modified(), start + 30ms);
+    journal.record("func_static_1", DiffStatus::added(), start + 40ms);
+    journal.record("func_static_1", DiffStatus::removed(), start + 50ms);
+
+    const auto& pending = journal.getPendingChanges();
+    EXPECT_EQ(pending.size(), 3);
+    EXPECT_EQ(journal.getStatistics().recordedChanges, 6);
+
+    EXPECT_TRUE(pending.at("light_1").isModified());
+    EXPECT_FALSE(pending.at("light_1").isAdded());
+
+    EXPECT_TRUE(pending.at("speaker_1").isAdded());
+    EXPECT_TRUE(pending.at("speaker_1").isModified());
+
+    // Adding and removing cancel each other out, the entity is still reported as modified
+    EXPECT_FALSE(pending.at("func_static_1").isAdded());
+    EXPECT_FALSE(pending.at("func_static_1").isRemoved());
+    EXPECT_TRUE(pending.at("func_static_1").isModified());
+}
+
+TEST(ChangeJournalTest, OneBatchInFlight)
+{
+    auto journal = createJournal();
+    auto start = ChangeJournal::Clock::now();
+
+    journal.record("light_1", DiffStatus::modified(), start);
+    journal.record("light_2", DiffStatus::added(), start);
+
+    const auto& batch = journal.beginBatch();
+
+    EXPECT_TRUE(journal.isBatchInFlight());
+    EXPECT_EQ(batch.size(), 2);
+    EXPECT_FALSE(journal.hasPendingChanges());
+
+    // Newer changes wait for the game to acknowledge the batch
+    journal.record("light_1", DiffStatus::modified(), start + 100ms);
+
+    EXPECT_EQ(batch.size(), 2);
+    EXPECT_FALSE(journal.isBatchDue(start + 1h));
+
+    journal.commitBatch(start + 300ms);
+
+    EXPECT_FALSE(journal.isBatchInFlight());
+    EXPECT_TRUE(journal.isBatchDue(start + 300ms));
+
+    const auto& stats = journal.getStatistics();
+    EXPECT_EQ(stats.sentBatches, 1);
+    EXPECT_EQ(stats.sentEntities, 2);
+    EXPECT_EQ(stats.failedBatches, 0);
+    EXPECT_EQ(stats.maxLatency, 300ms);
+}
+
+TEST(ChangeJournalTest, AbortedBatchIsMergedInFrontOfNewerChanges)
+{
+    auto journal = createJournal();
+    auto start = ChangeJournal::Clock::now();
+
+    journal.record("light_1", DiffStatus::added(), start);
+    journal.record("light_2", DiffStatus::modified(), start);
+    journal.beginBatch();
+
+    journal.record("light_1", DiffStatus::removed(), start + 100ms);
+    journal.record("light_3", DiffStatus::forceRespawn(), start + 100ms);
+
+    journal.abortBatch(start + 200ms);
+
+    EXPECT_FALSE(journal.isBatchInFlight());
+    EXPECT_EQ(journal.getStatistics().failedBatches, 1);
+
+    const auto& pending = journal.getPendingChanges();
+    EXPECT_EQ(pending.size(), 3);
+
+    // The entity added in the failed batch and removed afterwards never reaches the game
+    EXPECT_FALSE(pending.at("light_1").isAdded());
+    EXPECT_FALSE(pending.at("light_1").isRemoved());
+    EXPECT_TRUE(pending.at("light_1").isModified());
+
+    EXPECT_TRUE(pending.at("light_2").isModified());
+    EXPECT_TRUE(pending.at("light_3").needsRespawn());
+
+    // The next batch contains everything
+    EXPECT_TRUE(journal.isBatchDue(start + 1200ms));
+    EXPECT_EQ(journal.beginBatch().size(), 3);
+}
+
+TEST(ChangeJournalTest, AbortedBatchWithoutNewerChanges)
+{
+    auto journal = createJournal();
+    auto start = ChangeJournal::Clock::now();
+
+    journal.record("light_1", DiffStatus::added(), start);
+    journal.beginBatch();
+    journal.abortBatch(start + 200ms);
+
+    const auto& pending = journal.getPendingChanges();
+    EXPECT_EQ(pending.size(), 1);
+    EXPECT_TRUE(pending.at("light_1").isAdded());
+}
+
+TEST(ChangeJournalTest, FailedBatchesAreRetriedWithBackoff)
+{
+    auto journal = createJournal();
+    auto start = ChangeJournal::Clock::now();
+
+    journal.record("light_1", DiffStatus::modified(), start);
+
+    // Each failure doubles the delay before the next attempt, up to the limit
+    auto now = start + 200ms;
+
+    for (auto expectedDelay : { 1000ms, 2000ms, 4000ms, 4000ms })
+    {
+        ASSERT_TRUE(journal.isBatchDue(now));
+        journal.beginBatch();
+        journal.abortBatch(now);
+
+        // A change recorded meanwhile is not sent earlier either
+        journal.record("light_2", DiffStatus::modified(), now);
+
+        EXPECT_FALSE(journal.isBatchDue(now + expectedDelay - 1ms));
+        EXPECT_TRUE(journal.isBatchDue(now + expectedDelay));
+
+        now += expectedDelay;
+    }
+
+    EXPECT_EQ(journal.getStatistics().failedBatches, 4);
+
+    // A successful batch resets the backoff
+    journal.beginBatch();
+    journal.commitBatch(now);
+    journal.record("light_1", DiffStatus::modified(), now);
+    journal.beginBatch();
+    journal.abortBatch(now);
+
+    EXPECT_FALSE(journal.isBatchDue(now + 999ms));
+    EXPECT_TRUE(journal.isBatchDue(now + 1000ms));
+}
+
+TEST(ChangeJournalTest, ClearWhileBatchInFlight)
+{
+    auto journal = createJournal();
+    auto start = ChangeJournal::Clock::now();
+
+    journal.record("light_1", DiffStatus::modified(), start);
+    journal.beginBatch();
+    journal.record("light_2", DiffStatus::modified(), start + 100ms);
+
+    journal.clear();
+
+    EXPECT_FALSE(journal.isBatchInFlight());
+    EXPECT_FALSE(journal.hasPendingChanges());
+
+    // The response to the dropped batch arrives afterwards, it must not have any effect
+    journal.commitBatch(start + 200ms);
+    journal.abortBatch(start + 200ms);
+
+    EXPECT_FALSE(journal.hasPendingChanges());
+    EXPECT_EQ(journal.getStatistics().sentBatches, 0);
+    EXPECT_EQ(journal.getStatistics().failedBatches, 0);
+
+    // New changes go through as usual
+    journal.record("light_3", DiffStatus::modified(), start + 300ms);
+    EXPECT_TRUE(journal.isBatchDue(start + 500ms));
+    EXPECT_EQ(journal.beginBatch().size(), 1);
+}
+
+TEST(ChangeJournalTest, ClearResetsBackoff)
+{
+    auto journal = createJournal();
+    auto start = ChangeJournal::Clock::now();
+
+    journal.record("light_1", DiffStatus::modified(), start);
+    journal.beginBatch();
+    journal.abortBatch(start + 200ms);
+
+    // The game has been brought in sync by a full reload
+    journal.clear();
+
+    journal.record("light_2", DiffStatus::modified(), start + 300ms);
+    EXPECT_TRUE(journal.isBatchDue(start + 500ms));
+}
+
+}
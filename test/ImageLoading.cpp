@@ -2,6 +2,9 @@
 
 #include "iimage.h"
 #include "RGBAImage.h"
+#include "image/PixelKernels.h"
+#include "os/fs.h"
+#include "string/case_conv.h"
 
 // Helpers for examining pixel data
 using RGB8 = BasicVector3<uint8_t>;
@@ -239,4 +242,70 @@ TEST_F(ImageLoadingTest, LoadDDSCompressedBC5MipMaps)
     EXPECT_EQ(img->getGLFormat(), GL_COMPRESSED_RG_RGTC2);
 }
 
-}
\ No newline at end of file
+// Resamples and mip-reduces every TGA in the test project's texture folder,
+// checking the kernels against a plain box filter
+TEST_F(ImageLoadingTest, ResampleAndMipChain)
+{
+    std::vector<ImagePtr> images;
+
+    for (const auto& entry : fs::recursive_directory_iterator(_context.getTestProjectPath() + "textures/"))
+    {
+        if (entry.is_regular_file() && string::to_lower_copy(entry.path().extension().string()) == ".tga")
+        {
+            auto img = GlobalImageLoader().imageFromFile(entry.path().string());
+
+            if (img && !img->isPrecompressed())
+            {
+                images.push_back(img);
+            }
+        }
+    }
+
+    ASSERT_FALSE(images.empty()) << "No TGA images found";
+
+    for (const auto& img : images)
+    {
+        // Upscale to twice the size, as the texture manager does for non-power-of-two images
+        auto width = img->getWidth() * 2;
+        auto height = img->getHeight() * 2;
+        image::RGBAImage resampled(width, height);
+
+        image::kernels::resample(img->getPixels(), img->getWidth(), img->getHeight(),
+            resampled.getPixels(), width, height, 4);
+
+        // Corner pixels are taken straight from the source
+        EXPECT_EQ(std::memcmp(resampled.getPixels(), img->getPixels(), 4), 0);
+
+        auto chain = image::generateMipChain(resampled.getPixels(), width, height);
+
+        ASSERT_FALSE(chain.empty());
+        EXPECT_EQ(chain.back().width, 1);
+        EXPECT_EQ(chain.back().height, 1);
+
+        // The first level must match a plain 2x2 box filter
+        const auto* src = resampled.getPixels();
+        const auto& level = chain.front();
+
+        for (std::size_t y = 0; y < level.height; ++y)
+        {
+            for (std::size_t x = 0; x < level.width; ++x)
+            {
+                for (std::size_t c = 0; c < 4; ++c)
+                {
+                    auto a = src[((y * 2) * width + x * 2) * 4 + c];
+                    auto b = src[((y * 2) * width + x * 2 + 1) * 4 + c];
+                    auto d = src[((y * 2 + 1) * width + x * 2) * 4 + c];
+                    auto e = src[((y * 2 + 1) * width + x * 2 + 1) * 4 + c];
+
+                    ASSERT_EQ(level.pixels[(y * level.width + x) * 4 + c], (a + b + d + e) >> 2);
+                }
+            }
+        }
+
+        // Kaiser chain needs to end up with the same level sizes
+        auto kaiserChain = image::generateMipChain(resampled.getPixels(), width, height, image::MipFilter::Kaiser);
+        EXPECT_EQ(kaiserChain.size(), chain.size());
+    }
+}
+
+}
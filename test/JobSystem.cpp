@@ -0,0 +1,268 @@
+#include "RadiantTest.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "ijobsystem.h"
+#include "util/ParallelFor.h"
+
+namespace test
+{
+
+using JobSystemTest = RadiantTest;
+
+namespace
+{
+
+// Processes the main thread queue until the given condition is met (or a timeout is hit)
+bool processMainThreadTasksUntil(const std::function<bool()>& condition)
+{
+    auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+    while (!condition())
+    {
+        if (std::chrono::steady_clock::now() > timeout) return false;
+
+        GlobalJobSystem().processMainThreadTasks();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return true;
+}
+
+}
+
+TEST_F(JobSystemTest, WorkersAreRunning)
+{
+    EXPECT_GE(GlobalJobSystem().getNumWorkers(), 2) << "Pool should have at least two workers";
+}
+
+TEST_F(JobSystemTest, RunAndWait)
+{
+    auto group = GlobalJobSystem().createGroup("RunAndWait");
+    EXPECT_EQ(group->getName(), "RunAndWait");
+    EXPECT_TRUE(group->isFinished()) << "Empty group should be finished";
+
+    std::atomic<int> counter(0);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        group->run([&]() { ++counter; });
+    }
+
+    group->wait();
+
+    EXPECT_TRUE(group->isFinished());
+    EXPECT_EQ(counter, 1000);
+}
+
+TEST_F(JobSystemTest, NestedWaitDoesNotDeadlock)
+{
+    auto outer = GlobalJobSystem().createGroup("Outer");
+    std::atomic<int> counter(0);
+
+    // Every outer task blocks the worker running it until its inner tasks are done
+    for (std::size_t i = 0; i < GlobalJobSystem().getNumWorkers() * 4; ++i)
+    {
+        outer->run([&]()
+        {
+            auto inner = GlobalJobSystem().createGroup("Inner");
+
+            for (int j = 0; j < 10; ++j)
+            {
+                inner->run([&]() { ++counter; });
+            }
+
+            inner->wait();
+        });
+    }
+
+    outer->wait();
+
+    EXPECT_EQ(counter, GlobalJobSystem().getNumWorkers() * 4 * 10);
+}
+
+TEST_F(JobSystemTest, DependentGroupRunsAfterDependency)
+{
+    auto first = GlobalJobSystem().createGroup("First");
+    auto second = GlobalJobSystem().createGroup("Second");
+
+    std::atomic<int> firstTasksDone(0);
+    std::atomic<bool> orderViolated(false);
+
+    for (int i = 0; i < 8; ++i)
+    {
+        first->run([&]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            ++firstTasksDone;
+        });
+    }
+
+    second->addDependency(first);
+
+    second->run([&]()
+    {
+        if (firstTasksDone != 8) orderViolated = true;
+    });
+
+    // Waiting for the dependent group includes its dependencies
+    second->wait();
+
+    EXPECT_TRUE(first->isFinished());
+    EXPECT_EQ(firstTasksDone, 8);
+    EXPECT_FALSE(orderViolated) << "Dependent task started before the dependency finished";
+}
+
+TEST_F(JobSystemTest, CancelDiscardsPendingTasks)
+{
+    auto blocker = GlobalJobSystem().createGroup("Blocker");
+    auto cancelled = GlobalJobSystem().createGroup("Cancelled");
+
+    blocker->run([]() { std::this_thread::sleep_for(std::chrono::milliseconds(100)); });
+
+    // Hold back the tasks until the blocker is done
+    cancelled->addDependency(blocker);
+
+    std::atomic<int> counter(0);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        cancelled->run([&]() { ++counter; });
+    }
+
+    cancelled->cancel();
+    EXPECT_TRUE(cancelled->isCancelled());
+
+    // Tasks added after cancelling are discarded too
+    cancelled->run([&]() { ++counter; });
+
+    cancelled->wait();
+    blocker->wait();
+
+    EXPECT_EQ(counter, 0) << "Cancelled tasks have been executed";
+}
+
+TEST_F(JobSystemTest, WaitRethrowsTaskException)
+{
+    auto group = GlobalJobSystem().createGroup("Throwing");
+    std::atomic<int> counter(0);
+
+    group->run([]() { throw std::runtime_error("Task failed"); });
+
+    for (int i = 0; i < 10; ++i)
+    {
+        group->run([&]() { ++counter; });
+    }
+
+    EXPECT_THROW(group->wait(), std::runtime_error);
+    EXPECT_EQ(counter, 10) << "Other tasks should not be affected by the exception";
+
+    // The exception is passed on only once
+    EXPECT_NO_THROW(group->wait());
+}
+
+TEST_F(JobSystemTest, RunWithResult)
+{
+    auto group = GlobalJobSystem().createGroup("Result");
+
+    auto result = jobs::runWithResult(group, []() { return 42; });
+
+    EXPECT_EQ(result.get(), 42);
+    group->wait();
+}
+
+TEST_F(JobSystemTest, ContinueOnMainThread)
+{
+    auto group = GlobalJobSystem().createGroup("Continuation");
+    auto mainThread = std::this_thread::get_id();
+
+    std::atomic<bool> taskDone(false);
+    int continuationCount = 0;
+    bool continuationRanAfterTask = false;
+    bool continuationRanOnMainThread = false;
+
+    group->run([&]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        taskDone = true;
+    });
+
+    group->continueOnMainThread([&]()
+    {
+        ++continuationCount;
+        continuationRanAfterTask = taskDone;
+        continuationRanOnMainThread = std::this_thread::get_id() == mainThread;
+    });
+
+    EXPECT_TRUE(processMainThreadTasksUntil([&]() { return continuationCount > 0; }))
+        << "Continuation has not been invoked";
+
+    EXPECT_EQ(continuationCount, 1);
+    EXPECT_TRUE(continuationRanAfterTask);
+    EXPECT_TRUE(continuationRanOnMainThread);
+
+    // A continuation on a finished group is queued right away
+    group->continueOnMainThread([&]() { ++continuationCount; });
+    GlobalJobSystem().processMainThreadTasks();
+
+    EXPECT_EQ(continuationCount, 2);
+}
+
+TEST_F(JobSystemTest, ParallelForCoversRange)
+{
+    constexpr std::size_t Count = 100000;
+    std::vector<int> visits(Count, 0);
+
+    util::parallelFor(Count, 1000, [&](std::size_t begin, std::size_t end)
+    {
+        for (auto i = begin; i < end; ++i)
+        {
+            ++visits[i];
+        }
+    });
+
+    EXPECT_EQ(std::count(visits.begin(), visits.end(), 1), Count) << "Every index must be visited exactly once";
+}
+
+TEST_F(JobSystemTest, ParallelForPropagatesException)
+{
+    EXPECT_THROW(util::parallelFor(1000, 10, [&](std::size_t begin, std::size_t end)
+    {
+        if (begin <= 500 && 500 < end)
+        {
+            throw std::runtime_error("Batch failed");
+        }
+    }), std::runtime_error);
+}
+
+TEST_F(JobSystemTest, TaskStatistics)
+{
+    auto group = GlobalJobSystem().createGroup("StatisticsTest");
+
+    for (int i = 0; i < 5; ++i)
+    {
+        group->run([]() { std::this_thread::sleep_for(std::chrono::milliseconds(2)); });
+    }
+
+    group->wait();
+
+    jobs::TaskStatistics statistics;
+    bool found = false;
+
+    GlobalJobSystem().foreachTaskStatistics([&](const std::string& name, const jobs::TaskStatistics& candidate)
+    {
+        if (name != "StatisticsTest") return;
+
+        found = true;
+        statistics = candidate;
+    });
+
+    EXPECT_TRUE(found) << "No statistics recorded for the group";
+    EXPECT_EQ(statistics.numTasks, 5);
+    EXPECT_GE(statistics.totalRunTimeMsec, 10);
+    EXPECT_GE(statistics.maxRunTimeMsec, 2);
+    EXPECT_LE(statistics.maxRunTimeMsec, statistics.totalRunTimeMsec);
+}
+
+}
@@ -4,6 +4,8 @@
 #include "imap.h"
 #include "ilayer.h"
 #include "ifilter.h"
+#include "ientity.h"
+#include "ieclass.h"
 #include "scenelib.h"
 #include "algorithm/Primitives.h"
 #include "os/file.h"
@@ -469,6 +471,73 @@ TEST_F(LayerTest, SetLayerVisibilityWorksRecursively)
         "The parent layer visibility should have propagated down to the boards layer";
 }
 
+TEST_F(LayerTest, SetLayerVisibilityAffectsParentEntity)
+{
+    auto& layerManager = GlobalMapModule().getRoot()->getLayerManager();
+    auto testLayerId = layerManager.createLayer("TestLayer");
+    auto otherLayerId = layerManager.createLayer("OtherLayer");
+
+    // Create an entity with a brush, both are moved to the test layer
+    auto entity = GlobalEntityModule().createEntity(GlobalEntityClassManager().findClass("func_static"));
+    scene::addNodeToContainer(entity, GlobalMapModule().getRoot());
+    auto brush = algorithm::createCubicBrush(entity, Vector3(0, 0, 0), "textures/numbers/1");
+
+    Node_setSelected(entity, true);
+    layerManager.moveSelectionToLayer(testLayerId);
+
+    EXPECT_EQ(entity->getLayers(), scene::LayerList{ testLayerId });
+    EXPECT_EQ(brush->getLayers(), scene::LayerList{ testLayerId });
+
+    layerManager.setLayerVisibility(testLayerId, false);
+    EXPECT_FALSE(brush->visible()) << "Brush should be hidden now";
+    EXPECT_FALSE(entity->visible()) << "Entity should be hidden now";
+    EXPECT_FALSE(Node_isSelected(entity)) << "Hidden entity should have been de-selected";
+
+    // Direct membership changes are picked up by the next layer update,
+    // moving the brush to the default layer makes the parent entity visible again
+    brush->moveToLayer(0);
+    layerManager.setLayerVisibility(otherLayerId, false);
+
+    EXPECT_TRUE(brush->visible()) << "Brush should be visible in the default layer";
+    EXPECT_TRUE(entity->visible()) << "Entity should be visible, it has a visible child";
+
+    layerManager.setLayerVisibility(testLayerId, true);
+    EXPECT_TRUE(entity->visible()) << "Entity should be visible again";
+}
+
+TEST_F(LayerTest, MoveSelectionToHiddenLayer)
+{
+    loadMap("general_purpose.mapx");
+
+    auto& layerManager = GlobalMapModule().getRoot()->getLayerManager();
+    auto hiddenLayerId = layerManager.createLayer("HiddenLayer");
+    layerManager.setLayerVisibility(hiddenLayerId, false);
+
+    // This brush is a member of layer 1
+    auto brush = algorithm::findFirstBrushWithMaterial(GlobalMapModule().findOrInsertWorldspawn(), "textures/numbers/4");
+    auto otherBrush = algorithm::findFirstBrushWithMaterial(GlobalMapModule().findOrInsertWorldspawn(), "textures/numbers/1");
+    EXPECT_TRUE(brush->visible()) << "Brush should be visible";
+    EXPECT_TRUE(otherBrush->visible()) << "Brush should be visible";
+
+    Node_setSelected(brush, true);
+    layerManager.moveSelectionToLayer(hiddenLayerId);
+
+    EXPECT_EQ(brush->getLayers(), scene::LayerList{ hiddenLayerId });
+    EXPECT_FALSE(brush->visible()) << "Brush should be hidden after moving it to the hidden layer";
+    EXPECT_FALSE(Node_isSelected(brush)) << "Hidden brush should have been de-selected";
+    EXPECT_TRUE(otherBrush->visible()) << "Other brush should not be affected";
+
+    // Showing the layer brings the brush back
+    layerManager.setLayerVisibility(hiddenLayerId, true);
+    EXPECT_TRUE(brush->visible()) << "Brush should be visible again";
+
+    // Deleting the layer moves the brush back to the default layer
+    layerManager.setLayerVisibility(hiddenLayerId, false);
+    layerManager.deleteLayer("HiddenLayer");
+    EXPECT_EQ(brush->getLayers(), scene::LayerList{ 0 });
+    EXPECT_TRUE(brush->visible()) << "Brush should be visible in the default layer";
+}
+
 TEST_F(LayerTest, GetParentLayer)
 {
     auto& layerManager = GlobalMapModule().getRoot()->getLayerManager();
@@ -1247,4 +1316,57 @@ TEST_F(LayerTest, ParseLayerPropertiesHiddenLayers)
     expectLayersAreVisible({ 0,4,5,9 }, false);
 }
 
+TEST_F(LayerTest, LayerListWithHighLayerIds)
+{
+    scene::LayerList list{ 130, 3, 64, 0, 63 };
+
+    EXPECT_EQ(list.size(), 5u);
+    EXPECT_EQ(std::vector<int>(list.begin(), list.end()), std::vector<int>({ 0, 3, 63, 64, 130 }));
+    EXPECT_EQ(list.count(64), 1u);
+    EXPECT_EQ(list.count(65), 0u);
+    EXPECT_EQ(list.count(-1), 0u);
+    EXPECT_EQ(list.find(200), list.end());
+
+    EXPECT_TRUE(list.intersects(scene::LayerList{ 130 }));
+    EXPECT_FALSE(list.intersects(scene::LayerList{ 1, 129, 500 }));
+
+    // Removing the highest ID must compare equal to a list that never had it
+    EXPECT_EQ(list.erase(130), 1u);
+    EXPECT_EQ(list.erase(130), 0u);
+    EXPECT_EQ(list, scene::LayerList({ 0, 3, 63, 64 }));
+
+    list.insert(scene::LayerList{ 1, 200 });
+    EXPECT_EQ(std::vector<int>(list.begin(), list.end()), std::vector<int>({ 0, 1, 3, 63, 64, 200 }));
+
+    list.clear();
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.begin(), list.end());
+}
+
+// Nodes report their layer changes to the layer manager of the scene they're in now
+TEST_F(LayerTest, LayerChangesAfterMovingNodeToOtherScene)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    auto brush = algorithm::createCubicBrush(worldspawn, Vector3(0, 0, 0), "textures/numbers/1");
+
+    scene::removeNodeFromParent(brush);
+
+    // Changing the layers outside of any scene must not reach the old layer manager
+    brush->moveToLayer(0);
+
+    GlobalCommandSystem().executeCommand("NewMap");
+
+    auto& layerManager = GlobalMapModule().getRoot()->getLayerManager();
+    auto hiddenLayerId = layerManager.createLayer("HiddenLayer");
+    layerManager.setLayerVisibility(hiddenLayerId, false);
+
+    scene::addNodeToContainer(brush, GlobalMapModule().findOrInsertWorldspawn());
+    EXPECT_TRUE(brush->visible()) << "Brush should be visible in the default layer";
+
+    brush->moveToLayer(hiddenLayerId);
+    layerManager.setLayerVisibility(layerManager.createLayer("OtherLayer"), false);
+
+    EXPECT_FALSE(brush->visible()) << "The new layer manager should have picked up the membership change";
+}
+
 }
@@ -4,11 +4,15 @@
 #include "iundo.h"
 #include "imap.h"
 #include "imapformat.h"
+#include "ibrush.h"
+#include "ieclass.h"
+#include "ientity.h"
 #include "iautosaver.h"
 #include "imapresource.h"
 #include "ifilesystem.h"
 #include "iradiant.h"
 #include "iselectiongroup.h"
+#include "iselectionset.h"
 #include "ilightnode.h"
 #include "icommandsystem.h"
 #include "messages/ApplicationShutdownRequest.h"
@@ -25,6 +29,10 @@
 #include "testutil/FileSelectionHelper.h"
 #include "testutil/FileSaveConfirmationHelper.h"
 #include "registry/registry.h"
+#include "scene/BasicRootNode.h"
+#include "scene/ChildPrimitives.h"
+#include "scene/Traverse.h"
+#include "scenelib.h"
 
 using namespace std::chrono_literals;
 
@@ -69,6 +77,68 @@ public:
     }
 };
 
+// Import filter collecting the parsed nodes below a separate root node
+class BasicImportFilter :
+    public map::IMapImportFilter
+{
+private:
+    scene::IMapRootNodePtr _root;
+
+public:
+    std::function<void()> onEntityAdded;
+
+    BasicImportFilter() :
+        _root(std::make_shared<scene::BasicRootNode>())
+    {}
+
+    const scene::IMapRootNodePtr& getRootNode() const override
+    {
+        return _root;
+    }
+
+    bool addEntity(const scene::INodePtr& entity) override
+    {
+        _root->addChildNode(entity);
+
+        if (onEntityAdded) onEntityAdded();
+
+        return true;
+    }
+
+    bool addPrimitiveToEntity(const scene::INodePtr& primitive, const scene::INodePtr& entity) override
+    {
+        if (!Node_getEntity(entity)->isContainer()) return false;
+
+        entity->addChildNode(primitive);
+        return true;
+    }
+};
+
+std::string exportToPortableFormat(const scene::IMapRootNodePtr& root)
+{
+    auto format = GlobalMapFormatManager().getMapFormatByName(map::PORTABLE_MAP_FORMAT_NAME);
+    auto writer = format->getMapWriter();
+
+    std::ostringstream output;
+
+    {
+        auto exporter = GlobalMapModule().createMapExporter(*writer, root, output);
+        exporter->exportMap(root, scene::traverse);
+    }
+
+    return output.str();
+}
+
+void importFromPortableFormat(std::istream& stream, BasicImportFilter& filter)
+{
+    auto format = GlobalMapFormatManager().getMapFormatByName(map::PORTABLE_MAP_FORMAT_NAME);
+
+    format->getMapReader(filter)->readFromStream(stream);
+
+    // Child primitives are stored relative to their entity's origin
+    scene::addOriginToChildPrimitives(filter.getRootNode());
+}
+
 }
 
 class MapFileTestBase :
@@ -454,6 +524,61 @@ TEST_F(MapLoadingTest, loadMapxInResourceOnly)
     checkAltarScene(resource->getRootNode());
 }
 
+TEST_F(MapLoadingTest, portableFormatRoundTrip)
+{
+    GlobalCommandSystem().executeCommand("OpenMap", std::string("maps/altar.map"));
+    checkAltarScene();
+
+    auto exported = exportToPortableFormat(GlobalMapModule().getRoot());
+
+    BasicImportFilter filter;
+    std::istringstream stream(exported);
+    importFromPortableFormat(stream, filter);
+
+    checkAltarScene(filter.getRootNode());
+
+    // Writing the parsed scene again needs to produce the same document
+    EXPECT_EQ(exportToPortableFormat(filter.getRootNode()), exported);
+}
+
+TEST_F(MapLoadingTest, portableFormatIsReadAsStream)
+{
+    GlobalMapModule().findOrInsertWorldspawn();
+
+    for (int i = 0; i < 200; ++i)
+    {
+        auto entity = GlobalEntityModule().createEntity(GlobalEntityClassManager().findOrInsert("func_static", true));
+        GlobalMapModule().getRoot()->addChildNode(entity);
+
+        algorithm::createCubicBrush(entity, Vector3(i * 64, 0, 0), "textures/numbers/1");
+    }
+
+    auto exported = exportToPortableFormat(GlobalMapModule().getRoot());
+    auto totalSize = static_cast<std::streamoff>(exported.size());
+
+    BasicImportFilter filter;
+    std::istringstream stream(exported);
+
+    // Record how much of the stream has been consumed when the first entity arrives
+    std::streamoff consumedAtFirstEntity = -1;
+
+    filter.onEntityAdded = [&]()
+    {
+        if (consumedAtFirstEntity == -1)
+        {
+            consumedAtFirstEntity = stream.tellg();
+        }
+    };
+
+    importFromPortableFormat(stream, filter);
+
+    EXPECT_GT(consumedAtFirstEntity, 0);
+    EXPECT_LT(consumedAtFirstEntity, totalSize / 10) << "Reader consumed too much data before delivering the first entity";
+
+    auto isBrush = [](const scene::INodePtr& node) { return Node_isBrush(node); };
+    EXPECT_EQ(algorithm::getChildCount(filter.getRootNode(), isBrush), 200);
+}
+
 TEST_F(MapSavingTest, saveMapWithoutModification)
 {
     auto tempPath = createMapCopyInTempDataPath("altar.map", "altar_saveMapWithoutModification.map");
@@ -1232,6 +1357,7 @@ TEST_F(MapSavingTest, AutoSaverDoesntChangeSaveCopyAsFilename)
 
     // Now trigger an autosave
     GlobalAutoSaver().performAutosave();
+    GlobalAutoSaver().waitForPendingSave();
 
     // This will (again) ask for a file name, now we check what map file name it remembered and 
     // sent to the request handler as default file name
@@ -1262,6 +1388,7 @@ TEST_F(MapSavingTest, AutoSaveSnapshotsSupportRelativePaths)
 
     // Trigger an auto save now
     GlobalAutoSaver().performAutosave();
+    GlobalAutoSaver().waitForPendingSave();
 
     EXPECT_TRUE(GlobalFileSystem().openTextFile(expectedSnapshotPath)) << "Snapshot should now exist in " << expectedSnapshotPath;
     
@@ -1279,6 +1406,59 @@ TEST_F(MapSavingTest, AutoSaveSnapshotsSupportRelativePaths)
     }
 }
 
+// The auto saver must not export the scene while a regular save is traversing it
+TEST_F(MapSavingTest, AutoSaverSkipsWhileMapIsBeingSaved)
+{
+    auto tempPath = createMapCopyInTempDataPath("altar.map", "altar_autosave_during_save.map");
+
+    GlobalCommandSystem().executeCommand("OpenMap", tempPath.string());
+    checkAltarScene();
+
+    auto snapshotFolder = _context.getTemporaryDataPath() + "snapshots_during_save/";
+    registry::setValue(map::RKEY_AUTOSAVE_SNAPSHOTS_ENABLED, true);
+    registry::setValue(map::RKEY_AUTOSAVE_SNAPSHOTS_FOLDER, snapshotFolder);
+
+    fs::path snapshotPath = snapshotFolder + "altar_autosave_during_save.0.map";
+
+    // Make a change such that an autosave is due
+    {
+        UndoableCommand cmd("modifyWorldspawn");
+        Node_getEntity(GlobalMapModule().findOrInsertWorldspawn())->setKeyValue("autosave_test", "1");
+    }
+
+    EXPECT_TRUE(GlobalAutoSaver().runAutosaveCheck()) << "Autosave should be due after a change";
+
+    bool autosaveCheckDuringSave = true;
+    bool mapSavingEventReceived = false;
+
+    // Try to autosave while the map is in the middle of being saved
+    auto connection = GlobalMapModule().signal_mapEvent().connect([&](IMap::MapEvent ev)
+    {
+        if (ev != IMap::MapSaving) return;
+
+        mapSavingEventReceived = true;
+        autosaveCheckDuringSave = GlobalAutoSaver().runAutosaveCheck();
+
+        GlobalAutoSaver().performAutosave();
+        GlobalAutoSaver().waitForPendingSave();
+    });
+
+    GlobalCommandSystem().executeCommand("SaveMap");
+    connection.disconnect();
+
+    EXPECT_TRUE(mapSavingEventReceived);
+    EXPECT_FALSE(autosaveCheckDuringSave) << "Autosave check should fail while the map is being saved";
+    EXPECT_FALSE(os::fileOrDirExists(snapshotPath)) << "No snapshot should have been written during the save";
+
+    // Once the save is done, the auto saver works again
+    GlobalAutoSaver().performAutosave();
+    GlobalAutoSaver().waitForPendingSave();
+
+    EXPECT_TRUE(os::fileOrDirExists(snapshotPath)) << "Snapshot should exist after the save: " << snapshotPath;
+
+    fs::remove_all(snapshotFolder);
+}
+
 TEST_F(MapSavingTest, AutoSaveSnapshotsSupportAbsolutePaths)
 {
     std::string modRelativePath = "maps/altar.map";
@@ -1297,6 +1477,7 @@ TEST_F(MapSavingTest, AutoSaveSnapshotsSupportAbsolutePaths)
 
     // Trigger an auto save now
     GlobalAutoSaver().performAutosave();
+    GlobalAutoSaver().waitForPendingSave();
 
     EXPECT_TRUE(GlobalFileSystem().openTextFileInAbsolutePath(expectedSnapshotPath)) << "Snapshot should now exist in " << expectedSnapshotPath;
 
@@ -1308,6 +1489,76 @@ TEST_F(MapSavingTest, AutoSaveSnapshotsSupportAbsolutePaths)
     fs::remove(expectedSnapshotPath);
 }
 
+// The auto saver serialises a copy of the scene, which includes the data written to the info file
+TEST_F(MapSavingTest, AutoSaveSnapshotKeepsInfoFileData)
+{
+    std::string modRelativePath = "maps/altar.map";
+    GlobalCommandSystem().executeCommand("OpenMap", modRelativePath);
+    checkAltarScene();
+
+    auto snapshotFolder = _context.getTemporaryDataPath() + "infofilesnapshots/";
+    registry::setValue(map::RKEY_AUTOSAVE_SNAPSHOTS_ENABLED, true);
+    registry::setValue(map::RKEY_AUTOSAVE_SNAPSHOTS_FOLDER, snapshotFolder);
+
+    std::string expectedSnapshotPath = snapshotFolder + "altar.0.map";
+
+    auto root = GlobalMapModule().getRoot();
+    auto& layerManager = root->getLayerManager();
+    auto layerId = layerManager.createLayer("AutosaveLayer");
+
+    auto brush = algorithm::createCubicBrush(GlobalMapModule().findOrInsertWorldspawn(), Vector3(300, 0, 0));
+    brush->moveToLayer(layerId);
+
+    auto group = root->getSelectionGroupManager().createSelectionGroup();
+    group->setName("AutosaveGroup");
+    group->addNode(brush);
+
+    root->getSelectionSetManager().createSelectionSet("AutosaveSet")->addNode(brush);
+
+    GlobalAutoSaver().performAutosave();
+
+    // The scene has been copied already, this change must not end up in the snapshot
+    layerManager.renameLayer(layerId, "RenamedLayer");
+
+    GlobalAutoSaver().waitForPendingSave();
+
+    EXPECT_TRUE(os::fileOrDirExists(expectedSnapshotPath)) << "Snapshot should now exist in " << expectedSnapshotPath;
+
+    GlobalCommandSystem().executeCommand("OpenMap", expectedSnapshotPath);
+
+    root = GlobalMapModule().getRoot();
+    auto loadedLayerId = root->getLayerManager().getLayerID("AutosaveLayer");
+
+    EXPECT_NE(loadedLayerId, -1) << "Layer not found in the snapshot";
+    EXPECT_EQ(root->getLayerManager().getLayerID("RenamedLayer"), -1) << "Change after the snapshot ended up in the file";
+    EXPECT_TRUE(root->getSelectionSetManager().findSelectionSet("AutosaveSet")) << "Selection set not found in the snapshot";
+
+    std::size_t groupSize = 0;
+    root->getSelectionGroupManager().foreachSelectionGroup([&](selection::ISelectionGroup& loadedGroup)
+    {
+        if (loadedGroup.getName() == "AutosaveGroup")
+        {
+            groupSize = loadedGroup.size();
+        }
+    });
+
+    EXPECT_EQ(groupSize, 1u) << "Selection group not restored from the snapshot";
+
+    std::size_t layerMembers = 0;
+    root->foreachNode([&](const scene::INodePtr& node)
+    {
+        if (Node_isBrush(node) && node->getLayers().count(loadedLayerId) > 0)
+        {
+            ++layerMembers;
+        }
+        return true;
+    });
+
+    EXPECT_EQ(layerMembers, 1u) << "Layer assignment not restored from the snapshot";
+
+    fs::remove_all(snapshotFolder);
+}
+
 namespace
 {
 
@@ -1623,4 +1874,43 @@ TEST_F(MapLoadingTest, WarningAboutMissingInfoFile)
         << "Didn't receive a warning about the missing .darkradiant file";
 }
 
+
+TEST_F(MapSavingTest, portableFormatIsWrittenAsStream)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+
+    for (int i = 0; i < 200; ++i)
+    {
+        algorithm::createCubicBrush(worldspawn, Vector3(i * 64, 0, 0), "textures/numbers/1");
+    }
+
+    auto format = GlobalMapFormatManager().getMapFormatByName(map::PORTABLE_MAP_FORMAT_NAME);
+    auto writer = format->getMapWriter();
+    auto root = GlobalMapModule().getRoot();
+    auto entity = std::dynamic_pointer_cast<IEntityNode>(worldspawn);
+
+    std::ostringstream output;
+
+    writer->beginWriteMap(root, output);
+    writer->beginWriteEntity(entity, output);
+
+    worldspawn->foreachNode([&](const scene::INodePtr& child)
+    {
+        auto brush = std::dynamic_pointer_cast<IBrushNode>(child);
+
+        writer->beginWriteBrush(brush, output);
+        writer->endWriteBrush(brush, output);
+        return true;
+    });
+
+    // Most of the brush data must have been passed to the stream already
+    auto sizeBeforeFinish = output.str().size();
+
+    writer->endWriteEntity(entity, output);
+    writer->endWriteMap(root, output);
+
+    EXPECT_GT(sizeBeforeFinish, output.str().size() / 2);
+    algorithm::assertStringIsMapxFile(output.str());
+}
+
 }
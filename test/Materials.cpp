@@ -1,6 +1,7 @@
 #include "RadiantTest.h"
 
 #include "ishaders.h"
+#include "irender.h"
 #include <algorithm>
 
 #include "string/split.h"
@@ -10,6 +11,7 @@
 #include "math/MatrixUtils.h"
 #include "materials/FrobStageSetup.h"
 #include "testutil/TemporaryFile.h"
+#include "registry/registry.h"
 
 namespace test
 {
@@ -2035,4 +2037,96 @@ TEST_F(MaterialsTest, EditorImageUpdatedBeforeMaterialChangedSignalEmission)
     EXPECT_FALSE(material->isEditorImageNoTex()) << "Editor image should have been updated";
 }
 
+// The editor image and description are picked up without parsing the whole material,
+// the results need to be the same as the ones of the full parser
+TEST_F(MaterialsTest, EditorImageAndDescriptionMatchFullParse)
+{
+    auto material = GlobalMaterialManager().getMaterial("textures/editor/visportal");
+
+    EXPECT_EQ(material->getDescription(), "used to divide areas, areas between sealed portal faces are what gives the engine rendering, sound and AI information");
+    EXPECT_EQ(material->getEditorImageExpression()->getExpressionString(), "textures/editor/visportal.tga");
+
+    std::size_t checkedMaterials = 0;
+
+    GlobalMaterialManager().foreachShaderName([&](const std::string& name)
+    {
+        auto material = GlobalMaterialManager().getMaterial(name);
+
+        auto editorImage = material->getEditorImageExpression();
+        auto editorImageString = editorImage ? editorImage->getExpressionString() : std::string();
+        auto description = material->getDescription();
+
+        // Querying the layers triggers the full parse
+        material->getNumLayers();
+
+        auto parsedEditorImage = material->getEditorImageExpression();
+
+        EXPECT_EQ(editorImageString, parsedEditorImage ? parsedEditorImage->getExpressionString() : std::string())
+            << "Editor image mismatch in " << name;
+        EXPECT_EQ(description, material->getDescription()) << "Description mismatch in " << name;
+
+        ++checkedMaterials;
+    });
+
+    EXPECT_GT(checkedMaterials, 0);
+}
+
+// Textures exceeding the memory budget are released and transparently reloaded on the next use
+TEST_F(MaterialsTest, TexturesAreReloadedAfterEviction)
+{
+    // The editor image of this material alone exceeds a budget of 1 MB
+    registry::setValue(shaders::RKEY_TEXTURE_MEMORY_BUDGET, 1);
+
+    auto editorImage = GlobalMaterialManager().getMaterial("textures/a_1024x512")->getEditorImage();
+    EXPECT_NE(editorImage->getGLTexNum(), 0) << "Editor image should have been loaded";
+
+    auto statsBefore = GlobalMaterialManager().getTextureMemoryStatistics();
+    EXPECT_GT(statsBefore.numResident, 0u);
+
+    for (int i = 0; i < 20; ++i)
+    {
+        GlobalMaterialManager().startFrame();
+    }
+
+    auto statsAfterEviction = GlobalMaterialManager().getTextureMemoryStatistics();
+    EXPECT_GT(statsAfterEviction.numEvictions, statsBefore.numEvictions) << "Editor image should have been evicted";
+    EXPECT_LT(statsAfterEviction.numResident, statsBefore.numResident);
+    EXPECT_EQ(statsAfterEviction.numReloads, statsBefore.numReloads);
+
+    EXPECT_NE(editorImage->getGLTexNum(), 0) << "Editor image should have been reloaded";
+    EXPECT_EQ(editorImage->getWidth(), 1024);
+    EXPECT_EQ(editorImage->getHeight(), 512);
+
+    auto statsAfterReload = GlobalMaterialManager().getTextureMemoryStatistics();
+    EXPECT_EQ(statsAfterReload.numReloads, statsBefore.numReloads + 1);
+    EXPECT_EQ(statsAfterReload.numResident, statsAfterEviction.numResident + 1);
+
+    EXPECT_NO_THROW(GlobalCommandSystem().executeCommand("ShowTextureMemoryStats"));
+}
+
+// Realised shaders store the texture numbers in their passes, these textures must stay loaded
+TEST_F(MaterialsTest, TexturesOfRealisedShadersAreNotEvicted)
+{
+    registry::setValue(shaders::RKEY_TEXTURE_MEMORY_BUDGET, 1);
+
+    auto shader = GlobalRenderSystem().capture("textures/a_1024x512");
+    ASSERT_TRUE(shader->isRealised()) << "Shader should have been realised";
+
+    auto statsBefore = GlobalMaterialManager().getTextureMemoryStatistics();
+    EXPECT_GT(statsBefore.numPinned, 0u) << "Textures of the shader passes should be pinned";
+
+    for (int i = 0; i < 20; ++i)
+    {
+        GlobalMaterialManager().startFrame();
+    }
+
+    // Requesting the editor image number must not reload it
+    auto editorImage = shader->getMaterial()->getEditorImage();
+    EXPECT_NE(editorImage->getGLTexNum(), 0);
+
+    auto statsAfter = GlobalMaterialManager().getTextureMemoryStatistics();
+    EXPECT_EQ(statsAfter.numReloads, statsBefore.numReloads) << "Pinned editor image has been evicted";
+    EXPECT_EQ(statsAfter.numPinned, statsBefore.numPinned);
+}
+
 }
@@ -3,14 +3,20 @@
 #include <unordered_set>
 #include "imodelsurface.h"
 #include "imodelcache.h"
+#include "imd5anim.h"
+#include "imd5model.h"
 #include "scenelib.h"
 #include "algorithm/Entity.h"
 #include "algorithm/FileUtils.h"
 #include "algorithm/Scene.h"
 #include "os/file.h"
 
+#include "math/FloatTools.h"
+#include "parser/DefTokeniser.h"
 #include "render/VertexHashing.h"
+#include "string/convert.h"
 #include "string/replace.h"
+#include "testutil/TemporaryFile.h"
 
 namespace test
 {
@@ -710,4 +716,369 @@ TEST_F(ObjImportTest, UseMtlReferencingMaterial)
         << "OBJ Model loader should have taken the material from the usemtl keyword";
 }
 
+namespace
+{
+
+struct ReferenceMD5Weight
+{
+    std::size_t joint;
+    double bias;
+    Vector3 offset;
+};
+
+struct ReferenceMD5Vertex
+{
+    std::size_t firstWeight;
+    std::size_t numWeights;
+};
+
+struct ReferenceMD5Mesh
+{
+    std::vector<ReferenceMD5Vertex> vertices;
+    std::vector<ReferenceMD5Weight> weights;
+};
+
+// Reads the vertices and weights of each mesh in the given md5mesh source
+std::vector<ReferenceMD5Mesh> parseReferenceMD5Meshes(const std::string& source)
+{
+    std::vector<ReferenceMD5Mesh> meshes;
+    parser::BasicDefTokeniser<std::string> tok(source);
+
+    while (tok.hasMoreTokens())
+    {
+        auto token = tok.nextToken();
+
+        if (token == "mesh")
+        {
+            meshes.emplace_back();
+        }
+        else if (token == "vert")
+        {
+            tok.skipTokens(5); // index ( u v )
+
+            ReferenceMD5Vertex vertex;
+            vertex.firstWeight = string::convert<std::size_t>(tok.nextToken());
+            vertex.numWeights = string::convert<std::size_t>(tok.nextToken());
+            meshes.back().vertices.push_back(vertex);
+        }
+        else if (token == "weight")
+        {
+            tok.skipTokens(1); // index
+
+            ReferenceMD5Weight weight;
+            weight.joint = string::convert<std::size_t>(tok.nextToken());
+            // Single precision, like the model loader
+            weight.bias = string::convert<float>(tok.nextToken());
+
+            tok.assertNextToken("(");
+            weight.offset.x() = string::convert<float>(tok.nextToken());
+            weight.offset.y() = string::convert<float>(tok.nextToken());
+            weight.offset.z() = string::convert<float>(tok.nextToken());
+            tok.assertNextToken(")");
+
+            meshes.back().weights.push_back(weight);
+        }
+    }
+
+    return meshes;
+}
+
+Quaternion referenceSlerp(const Quaternion& qa, const Quaternion& qb, float fraction)
+{
+    double cosHalfTheta = qa.w() * qb.w() + qa.x() * qb.x() + qa.y() * qb.y() + qa.z() * qb.z();
+
+    if (std::abs(cosHalfTheta) > 1.0)
+    {
+        return qb;
+    }
+
+    Quaternion temp = qb;
+
+    if (cosHalfTheta < 0.0)
+    {
+        temp = Quaternion(-qb.x(), -qb.y(), -qb.z(), -qb.w());
+        cosHalfTheta = -cosHalfTheta;
+    }
+
+    double halfTheta = acos(cosHalfTheta);
+    double sinHalfTheta = sqrt(1.0 - cosHalfTheta * cosHalfTheta);
+
+    if (fabs(sinHalfTheta) < 0.006)
+    {
+        return Quaternion(
+            qa.x() * (1 - fraction) + temp.x() * fraction,
+            qa.y() * (1 - fraction) + temp.y() * fraction,
+            qa.z() * (1 - fraction) + temp.z() * fraction,
+            qa.w() * (1 - fraction) + temp.w() * fraction);
+    }
+
+    double ratioA = sin((1 - fraction) * halfTheta) / sinHalfTheta;
+    double ratioB = sin(fraction * halfTheta) / sinHalfTheta;
+
+    return Quaternion(
+        qa.x() * ratioA + temp.x() * ratioB,
+        qa.y() * ratioA + temp.y() * ratioB,
+        qa.z() * ratioA + temp.z() * ratioB,
+        qa.w() * ratioA + temp.w() * ratioB);
+}
+
+void applyParentJoint(const md5::IMD5Anim& anim, std::vector<md5::IMD5Anim::Key>& skeleton, std::size_t jointId)
+{
+    const auto& joint = anim.getJoint(jointId);
+
+    if (joint.parentId >= 0)
+    {
+        const auto& parent = skeleton[joint.parentId];
+
+        skeleton[joint.id].orientation.preMultiplyBy(parent.orientation);
+        skeleton[joint.id].origin = parent.orientation.transformPoint(skeleton[joint.id].origin) + parent.origin;
+    }
+
+    for (auto child : joint.children)
+    {
+        applyParentJoint(anim, skeleton, child);
+    }
+}
+
+// The per-joint quaternion evaluation of the given anim time, as done before the
+// skinning used joint matrices and shared frame poses
+std::vector<md5::IMD5Anim::Key> evaluateReferenceSkeleton(const md5::IMD5Anim& anim, std::size_t time)
+{
+    std::vector<md5::IMD5Anim::Key> skeleton(anim.getNumJoints());
+
+    float timePerFrameMsec = 1000 / static_cast<float>(anim.getFrameRate());
+    float frameTime = time / timePerFrameMsec;
+
+    float nextFrameFrac = float_mod(frameTime, 1.0f);
+    float curFrameFrac = 1.0f - nextFrameFrac;
+
+    std::size_t curFrame = static_cast<std::size_t>(std::floor(frameTime)) % anim.getNumFrames();
+    std::size_t nextFrame = curFrame == anim.getNumFrames() - 1 ? curFrame : (curFrame + 1) % anim.getNumFrames();
+
+    const auto& cur = anim.getFrameKeys(curFrame);
+    const auto& next = anim.getFrameKeys(nextFrame);
+
+    for (std::size_t i = 0; i < skeleton.size(); ++i)
+    {
+        const auto& joint = anim.getJoint(i);
+        const auto& baseKey = anim.getBaseFrameKey(joint.id);
+
+        skeleton[i] = baseKey;
+
+        auto key = joint.firstKey;
+        auto& orientation = skeleton[i].orientation;
+        auto nextOrientation = baseKey.orientation;
+
+        if (joint.animComponents & md5::Joint::X) { skeleton[i].origin.x() = cur[key] * curFrameFrac + next[key] * nextFrameFrac; ++key; }
+        if (joint.animComponents & md5::Joint::Y) { skeleton[i].origin.y() = cur[key] * curFrameFrac + next[key] * nextFrameFrac; ++key; }
+        if (joint.animComponents & md5::Joint::Z) { skeleton[i].origin.z() = cur[key] * curFrameFrac + next[key] * nextFrameFrac; ++key; }
+        if (joint.animComponents & md5::Joint::YAW) { orientation.x() = cur[key]; nextOrientation.x() = next[key]; ++key; }
+        if (joint.animComponents & md5::Joint::PITCH) { orientation.y() = cur[key]; nextOrientation.y() = next[key]; ++key; }
+        if (joint.animComponents & md5::Joint::ROLL) { orientation.z() = cur[key]; nextOrientation.z() = next[key]; ++key; }
+
+        if (joint.animComponents & (md5::Joint::YAW | md5::Joint::PITCH | md5::Joint::ROLL))
+        {
+            auto w = -sqrt(1.0 - orientation.getVector3().getLengthSquared());
+            orientation.w() = isNaN(w) ? 0 : w;
+
+            w = -sqrt(1.0f - nextOrientation.getVector3().getLengthSquared());
+            nextOrientation.w() = isNaN(w) ? 0 : w;
+
+            orientation = referenceSlerp(orientation, nextOrientation, nextFrameFrac).getNormalised();
+        }
+    }
+
+    for (std::size_t i = 0; i < skeleton.size(); ++i)
+    {
+        if (anim.getJoint(i).parentId == -1)
+        {
+            applyParentJoint(anim, skeleton, i);
+        }
+    }
+
+    return skeleton;
+}
+
+// Compares the skinned vertices of the model to the quaternion-based reference skinning
+void expectReferenceSkinning(const model::IModel& model, const std::vector<ReferenceMD5Mesh>& meshes,
+    const md5::IMD5Anim& anim, std::size_t time)
+{
+    auto skeleton = evaluateReferenceSkeleton(anim, time);
+
+    ASSERT_EQ(model.getSurfaceCount(), static_cast<int>(meshes.size()));
+
+    for (std::size_t m = 0; m < meshes.size(); ++m)
+    {
+        const auto& surface = model.getSurface(static_cast<unsigned>(m));
+        const auto& mesh = meshes[m];
+
+        ASSERT_EQ(surface.getNumVertices(), static_cast<int>(mesh.vertices.size()));
+
+        for (std::size_t v = 0; v < mesh.vertices.size(); ++v)
+        {
+            Vector3 skinned(0, 0, 0);
+
+            for (auto w = mesh.vertices[v].firstWeight; w < mesh.vertices[v].firstWeight + mesh.vertices[v].numWeights; ++w)
+            {
+                const auto& weight = mesh.weights[w];
+                const auto& key = skeleton[weight.joint];
+
+                skinned += (key.orientation.transformPoint(weight.offset) + key.origin) * weight.bias;
+            }
+
+            const auto& vertex = surface.getVertex(static_cast<int>(v)).vertex;
+
+            ASSERT_TRUE(math::isNear(vertex, skinned, 1e-6))
+                << "Mesh " << m << ", vertex " << v << " at time " << time << ": " << vertex << " != " << skinned;
+        }
+    }
+}
+
+// Generates an md5mesh using the flag01 skeleton with a finely subdivided cloth,
+// large enough for the skinning to be split into several batches
+std::string generateDenseFlagMesh(const std::string& flagSource)
+{
+    constexpr std::size_t Columns = 100;
+    constexpr std::size_t Rows = 96;
+
+    auto jointsStart = flagSource.find("joints {");
+    auto jointsEnd = flagSource.find("}", jointsStart);
+
+    std::ostringstream stream;
+    stream << "MD5Version 10\ncommandline \"\"\n\nnumJoints 14\nnumMeshes 1\n\n";
+    stream << flagSource.substr(jointsStart, jointsEnd + 1 - jointsStart) << "\n\n";
+    stream << "mesh {\n\tshader \"flag_pirate\"\n\n\tnumverts " << Columns * Rows << "\n";
+
+    // Each vertex is weighted between the upper and lower joint of its column segment
+    for (std::size_t row = 0; row < Rows; ++row)
+    {
+        for (std::size_t col = 0; col < Columns; ++col)
+        {
+            auto index = row * Columns + col;
+            stream << "\tvert " << index << " ( " << col / (Columns - 1.0) << " " << row / (Rows - 1.0) << " ) "
+                << index * 2 << " 2\n";
+        }
+    }
+
+    stream << "\n\tnumtris " << (Columns - 1) * (Rows - 1) * 2 << "\n";
+
+    std::size_t tri = 0;
+
+    for (std::size_t row = 0; row + 1 < Rows; ++row)
+    {
+        for (std::size_t col = 0; col + 1 < Columns; ++col)
+        {
+            auto index = row * Columns + col;
+            stream << "\ttri " << tri++ << " " << index << " " << index + Columns << " " << index + 1 << "\n";
+            stream << "\ttri " << tri++ << " " << index + 1 << " " << index + Columns << " " << index + Columns + 1 << "\n";
+        }
+    }
+
+    stream << "\n\tnumweights " << Columns * Rows * 2 << "\n";
+
+    for (std::size_t row = 0; row < Rows; ++row)
+    {
+        for (std::size_t col = 0; col < Columns; ++col)
+        {
+            auto index = row * Columns + col;
+            auto segment = col * 5 / Columns; // up1..up5 and do1..do5
+            auto bias = row / (Rows - 1.0);
+            auto x = (col % (Columns / 5)) * 0.75;
+            auto z = row * 0.625 - 30;
+
+            stream << "\tweight " << index * 2 << " " << 3 + segment << " " << 1.0 - bias
+                << " ( " << x << " " << -z << " 0.5 )\n";
+            stream << "\tweight " << index * 2 + 1 << " " << 9 + segment << " " << bias
+                << " ( " << x << " " << z << " -0.5 )\n";
+        }
+    }
+
+    stream << "}\n";
+
+    return stream.str();
+}
+
+md5::IMD5Model& getMD5Model(const model::ModelNodePtr& modelNode)
+{
+    return dynamic_cast<md5::IMD5Model&>(modelNode->getIModel());
+}
+
+}
+
+TEST_F(ModelTest, MD5SkinningMatchesReference)
+{
+    auto anim = GlobalAnimationCache().getAnim("models/md5/flag01_wave.md5anim");
+    ASSERT_TRUE(anim);
+    ASSERT_EQ(anim->getFrameRate(), 25);
+
+    auto flagSource = algorithm::loadTextFromVfsFile("models/md5/flag01.md5mesh");
+    auto denseSource = generateDenseFlagMesh(flagSource);
+    TemporaryFile denseMesh(_context.getTestProjectPath() + "models/md5/flag01_dense.md5mesh", denseSource);
+
+    // The small flag is skinned in one go, the dense one is split across threads
+    for (const auto& [path, source] : std::map<std::string, std::string>{
+        { "models/md5/flag01.md5mesh", flagSource },
+        { "models/md5/flag01_dense.md5mesh", denseSource } })
+    {
+        auto meshes = parseReferenceMD5Meshes(source);
+        auto modelNode = Node_getModel(GlobalModelCache().getModelNode(path));
+        ASSERT_TRUE(modelNode) << "Failed to load " << path;
+
+        auto& md5Model = getMD5Model(modelNode);
+        md5Model.setAnim(anim);
+
+        // 40 msec per frame: exactly at frame 2, between frame 2 and 3, and in the last frame
+        for (std::size_t time : { 80, 100, 227 })
+        {
+            md5Model.updateAnim(time);
+            expectReferenceSkinning(modelNode->getIModel(), meshes, *anim, time);
+        }
+    }
+}
+
+TEST_F(ModelTest, MD5FramePoseIsSharedBetweenModels)
+{
+    auto anim = GlobalAnimationCache().getAnim("models/md5/flag01_wave.md5anim");
+    ASSERT_TRUE(anim);
+
+    auto meshes = parseReferenceMD5Meshes(algorithm::loadTextFromVfsFile("models/md5/flag01.md5mesh"));
+
+    // Each model node owns a separate model with its own skeleton
+    auto first = Node_getModel(GlobalModelCache().getModelNode("models/md5/flag01.md5mesh"));
+    auto second = Node_getModel(GlobalModelCache().getModelNode("models/md5/flag01.md5mesh"));
+
+    ASSERT_TRUE(first && second);
+    ASSERT_NE(&first->getIModel(), &second->getIModel());
+
+    getMD5Model(first).setAnim(anim);
+    getMD5Model(second).setAnim(anim);
+
+    // The first model evaluates frame 3 and stores its pose in the anim
+    getMD5Model(first).updateAnim(120);
+    expectReferenceSkinning(first->getIModel(), meshes, *anim, 120);
+
+    // The second model starts from an interpolated pose, then picks up the stored frame
+    getMD5Model(second).updateAnim(130);
+    expectReferenceSkinning(second->getIModel(), meshes, *anim, 130);
+
+    getMD5Model(second).updateAnim(120);
+    expectReferenceSkinning(second->getIModel(), meshes, *anim, 120);
+
+    // Both skeletons are now in the same pose, the vertices need to be identical
+    const auto& firstModel = first->getIModel();
+    const auto& secondModel = second->getIModel();
+
+    for (int s = 0; s < firstModel.getSurfaceCount(); ++s)
+    {
+        const auto& firstSurface = firstModel.getSurface(s);
+        const auto& secondSurface = secondModel.getSurface(s);
+
+        for (int v = 0; v < firstSurface.getNumVertices(); ++v)
+        {
+            EXPECT_EQ(firstSurface.getVertex(v).vertex, secondSurface.getVertex(v).vertex)
+                << "Surface " << s << ", vertex " << v;
+        }
+    }
+}
+
 }
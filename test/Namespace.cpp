@@ -0,0 +1,113 @@
+#include "RadiantTest.h"
+
+#include "inamespace.h"
+#include "ientity.h"
+#include "scene/BasicRootNode.h"
+#include "scenelib.h"
+#include "string/convert.h"
+#include "algorithm/Entity.h"
+
+namespace test
+{
+
+using NamespaceTest = RadiantTest;
+
+TEST_F(NamespaceTest, AddUniqueNameUsesLowestFreeNumber)
+{
+    auto nspace = GlobalNamespaceFactory().createNamespace();
+
+    nspace->insert("func_static_1");
+    nspace->insert("func_static_2");
+    nspace->insert("func_static_3");
+    nspace->insert("func_static_5");
+    nspace->insert("func_static_04"); // leading zeros don't occupy the number 4
+
+    EXPECT_EQ(nspace->addUniqueName("func_static_1"), "func_static_4");
+    EXPECT_EQ(nspace->addUniqueName("func_static_2"), "func_static_6");
+
+    // Non-conflicting names are kept as they are
+    EXPECT_EQ(nspace->addUniqueName("func_static_10"), "func_static_10");
+    EXPECT_EQ(nspace->addUniqueName("func_static_"), "func_static_");
+
+    // The name without number is taken now
+    EXPECT_EQ(nspace->addUniqueName("func_static_"), "func_static_7");
+}
+
+TEST_F(NamespaceTest, AddUniqueNameReusesErasedNumbers)
+{
+    auto nspace = GlobalNamespaceFactory().createNamespace();
+
+    for (int i = 1; i <= 10; ++i)
+    {
+        nspace->insert("light_" + string::to_string(i));
+    }
+
+    EXPECT_TRUE(nspace->erase("light_4"));
+    EXPECT_TRUE(nspace->erase("light_1"));
+    EXPECT_FALSE(nspace->erase("light_1")) << "Name has already been erased";
+
+    EXPECT_EQ(nspace->addUniqueName("light_5"), "light_1");
+    EXPECT_EQ(nspace->addUniqueName("light_5"), "light_4");
+    EXPECT_EQ(nspace->addUniqueName("light_5"), "light_11");
+
+    // Renaming releases the old number
+    nspace->nameChanged("light_2", "other_light");
+    EXPECT_FALSE(nspace->nameExists("light_2"));
+    EXPECT_EQ(nspace->addUniqueName("light_1"), "light_2");
+}
+
+// Every imported name conflicts, all of them need to get unique names
+TEST_F(NamespaceTest, EnsureNoConflictsWithManyNames)
+{
+    constexpr std::size_t NumNames = 500;
+
+    auto nspace = GlobalNamespaceFactory().createNamespace();
+    auto foreignRoot = std::make_shared<scene::BasicRootNode>();
+
+    std::vector<IEntityNodePtr> entities;
+
+    for (std::size_t i = 1; i <= NumNames; ++i)
+    {
+        auto name = "func_static_" + string::to_string(i);
+
+        // Every imported name exists in the target namespace already
+        nspace->insert(name);
+
+        auto entity = algorithm::createEntityByClassName("func_static");
+        entity->getEntity().setKeyValue("name", name);
+        scene::addNodeToContainer(entity, foreignRoot);
+
+        entities.push_back(entity);
+    }
+
+    nspace->ensureNoConflicts(foreignRoot);
+
+    std::set<std::string> importedNames;
+    std::size_t conflictingNames = 0;
+
+    for (const auto& entity : entities)
+    {
+        auto name = entity->getEntity().getKeyValue("name");
+
+        if (nspace->nameExists(name))
+        {
+            ++conflictingNames;
+        }
+
+        importedNames.insert(name);
+    }
+
+    EXPECT_EQ(conflictingNames, 0) << "Imported names still conflict with the target namespace";
+    EXPECT_EQ(importedNames.size(), NumNames) << "Imported names are not unique";
+
+    // The renamed entities got the lowest free numbers
+    for (std::size_t i = NumNames + 1; i <= 2 * NumNames; ++i)
+    {
+        if (importedNames.count("func_static_" + string::to_string(i)) == 0)
+        {
+            FAIL() << "Expected the number " << i << " to be used";
+        }
+    }
+}
+
+}
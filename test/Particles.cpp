@@ -252,10 +252,10 @@ inline particles::IParticleDef::Ptr createParticleFromSource(const std::string&
     syntax.typeName = "particle";
     syntax.name = defName;
     syntax.contents = source;
-    syntax.fileInfo = vfs::FileInfo("particles/", "export_particle_test.prt", vfs::Visibility::NORMAL);
+    syntax.setFileInfo(vfs::FileInfo("particles/", "export_particle_test.prt", vfs::Visibility::NORMAL));
     decl->setBlockSyntax(syntax);
     decl->getDepthHack(); // ensure the particle is parsed
-    decl->setFilename(os::getFilename(syntax.fileInfo.fullPath()));
+    decl->setFilename(os::getFilename(syntax.getFileInfo().fullPath()));
 
     return decl;
 }
@@ -313,7 +313,7 @@ TEST_F(ParticlesTest, SaveNewParticleToNewFile)
     auto decl = createParticleFromSource("some_def");
 
     const auto& syntax = decl->getBlockSyntax();
-    auto outputPath = _context.getTestProjectPath() + syntax.fileInfo.fullPath();
+    auto outputPath = _context.getTestProjectPath() + syntax.getFileInfo().fullPath();
     EXPECT_FALSE(fs::exists(outputPath)) << "Output file shouldn't exist yet";
 
     // Auto-remove the file that is going to be written
@@ -323,7 +323,7 @@ TEST_F(ParticlesTest, SaveNewParticleToNewFile)
 
     EXPECT_TRUE(fs::exists(outputPath)) << "Output file should exist now";
 
-    expectParticleIsPresentInFile(decl, decl->getBlockSyntax().fileInfo.fullPath(), true);
+    expectParticleIsPresentInFile(decl, decl->getBlockSyntax().getFileInfo().fullPath(), true);
 }
 
 // Save the particle to a file that already exists (but doesn't contain the def)
@@ -334,11 +334,11 @@ TEST_F(ParticlesTest, SaveNewParticleToExistingFile)
     setParticleFilename(decl, TEST_PARTICLE_FILE);
 
     // Def file should not have that particle def yet
-    expectParticleIsPresentInFile(decl, decl->getBlockSyntax().fileInfo.fullPath(), false);
+    expectParticleIsPresentInFile(decl, decl->getBlockSyntax().getFileInfo().fullPath(), false);
 
     GlobalParticlesManager().saveParticleDef(decl->getDeclName());
 
-    expectParticleIsPresentInFile(decl, decl->getBlockSyntax().fileInfo.fullPath(), true);
+    expectParticleIsPresentInFile(decl, decl->getBlockSyntax().getFileInfo().fullPath(), true);
 }
 
 // Save a particle to the same physical file that originally declared the decl
@@ -353,11 +353,11 @@ TEST_F(ParticlesTest, SaveExistingParticleToExistingFile)
     decl->setBlockSyntax(syntax);
 
     // This modified particle should not be present
-    expectParticleIsPresentInFile(decl, decl->getBlockSyntax().fileInfo.fullPath(), false);
+    expectParticleIsPresentInFile(decl, decl->getBlockSyntax().getFileInfo().fullPath(), false);
 
     // Save, it should be there now
     GlobalParticlesManager().saveParticleDef(decl->getDeclName());
-    expectParticleIsPresentInFile(decl, decl->getBlockSyntax().fileInfo.fullPath(), true);
+    expectParticleIsPresentInFile(decl, decl->getBlockSyntax().getFileInfo().fullPath(), true);
 
     // The test fixture will restore the original file contents in TearDown
 }
@@ -378,11 +378,11 @@ TEST_F(ParticlesTest, SaveChangedParticle)
     EXPECT_NE(blockSyntaxBeforeChange, blockSyntaxAfterChange) << "Syntax block should have changed";
 
     // This modified particle should not be present in the file
-    expectParticleIsPresentInFile(decl, decl->getBlockSyntax().fileInfo.fullPath(), false);
+    expectParticleIsPresentInFile(decl, decl->getBlockSyntax().getFileInfo().fullPath(), false);
 
     // Save, it should be there now
     GlobalParticlesManager().saveParticleDef(decl->getDeclName());
-    expectParticleIsPresentInFile(decl, decl->getBlockSyntax().fileInfo.fullPath(), true);
+    expectParticleIsPresentInFile(decl, decl->getBlockSyntax().getFileInfo().fullPath(), true);
 
     // The test fixture will restore the original file contents in TearDown
 }
@@ -399,22 +399,22 @@ TEST_F(ParticlesTest, SaveExistingParticleToNewFileOverridingPk4)
     decl->setBlockSyntax(syntax);
 
     // The overriding file should not be present
-    auto outputPath = _context.getTestProjectPath() + decl->getBlockSyntax().fileInfo.fullPath();
+    auto outputPath = _context.getTestProjectPath() + decl->getBlockSyntax().getFileInfo().fullPath();
 
     // Let the file be deleted when we're done here
     TemporaryFile outputFile(outputPath);
     EXPECT_FALSE(fs::exists(outputPath));
 
-    expectParticleIsPresentInFile(decl, decl->getBlockSyntax().fileInfo.fullPath(), false);
+    expectParticleIsPresentInFile(decl, decl->getBlockSyntax().getFileInfo().fullPath(), false);
 
     // Save, it should be there now
     GlobalParticlesManager().saveParticleDef(decl->getDeclName());
-    expectParticleIsPresentInFile(decl, decl->getBlockSyntax().fileInfo.fullPath(), true);
+    expectParticleIsPresentInFile(decl, decl->getBlockSyntax().getFileInfo().fullPath(), true);
 
     // Check if the other particle declaration is still intact in the file (use the same path to check)
     auto otherDecl = GlobalParticlesManager().getDefByName("tdm_fire_torch_in_pk4");
     EXPECT_EQ(otherDecl->getDeclFilePath(), decl->getDeclFilePath()) << "The decls should be in the same .prt file";
-    expectParticleIsPresentInFile(otherDecl, decl->getBlockSyntax().fileInfo.fullPath(), true);
+    expectParticleIsPresentInFile(otherDecl, decl->getBlockSyntax().getFileInfo().fullPath(), true);
 }
 
 // Assumes that the syntax changes after performing the given action on the named particle
@@ -17,6 +17,80 @@ using PatchTest = RadiantTest;
 namespace
 {
 
+// Creates a wavy 9x9 terrain-like patch, using fixed subdivisions unless
+// a patchDef2 is requested
+scene::INodePtr createWavyPatch(const scene::INodePtr& parent, const Vector3& origin, patch::PatchDefType type)
+{
+    auto patchNode = GlobalPatchModule().createPatch(type);
+    parent->addChildNode(patchNode);
+
+    auto patch = Node_getIPatch(patchNode);
+    patch->setDims(9, 9);
+
+    if (type == patch::PatchDefType::Def3)
+    {
+        patch->setFixedSubdivisions(true, Subdivisions(4, 3));
+    }
+
+    for (std::size_t row = 0; row < patch->getHeight(); ++row)
+    {
+        for (std::size_t col = 0; col < patch->getWidth(); ++col)
+        {
+            auto& ctrl = patch->ctrlAt(row, col);
+            ctrl.vertex = origin + Vector3(col * 32.0, row * 32.0, ((row * 7 + col * 3) % 5) * 12.0);
+            ctrl.texcoord = Vector2(col / 8.0, row / 8.0);
+        }
+    }
+
+    patch->controlPointsChanged();
+
+    return patchNode;
+}
+
+scene::INodePtr createWavyFixedPatch(const scene::INodePtr& parent)
+{
+    return createWavyPatch(parent, Vector3(0, 0, 0), patch::PatchDefType::Def3);
+}
+
+void expectSameTesselation(const IPatch& patch, const IPatch& other)
+{
+    auto mesh = patch.getTesselatedPatchMesh();
+    auto otherMesh = other.getTesselatedPatchMesh();
+
+    ASSERT_EQ(mesh.width, otherMesh.width);
+    ASSERT_EQ(mesh.height, otherMesh.height);
+    ASSERT_EQ(mesh.vertices.size(), otherMesh.vertices.size());
+
+    for (std::size_t i = 0; i < mesh.vertices.size(); ++i)
+    {
+        EXPECT_EQ(mesh.vertices[i].vertex, otherMesh.vertices[i].vertex) << "Vertex mismatch at index " << i;
+        EXPECT_EQ(mesh.vertices[i].normal, otherMesh.vertices[i].normal) << "Normal mismatch at index " << i;
+        EXPECT_EQ(mesh.vertices[i].texcoord, otherMesh.vertices[i].texcoord) << "Texcoord mismatch at index " << i;
+    }
+
+    ASSERT_EQ(mesh.tangents.size(), mesh.vertices.size());
+    ASSERT_EQ(mesh.bitangents.size(), mesh.vertices.size());
+    ASSERT_EQ(otherMesh.tangents.size(), otherMesh.vertices.size());
+    ASSERT_EQ(otherMesh.bitangents.size(), otherMesh.vertices.size());
+
+    for (std::size_t i = 0; i < mesh.vertices.size(); ++i)
+    {
+        EXPECT_TRUE(math::isNear(mesh.tangents[i], otherMesh.tangents[i], 1e-6)) << "Tangent mismatch at index " << i;
+        EXPECT_TRUE(math::isNear(mesh.bitangents[i], otherMesh.bitangents[i], 1e-6)) << "Bitangent mismatch at index " << i;
+    }
+}
+
+// Compares the patch against a clone, which tesselates its control points from scratch
+void expectSameTesselationAsClone(const scene::INodePtr& patchNode)
+{
+    auto clone = std::dynamic_pointer_cast<scene::Cloneable>(patchNode)->clone();
+    patchNode->getParent()->addChildNode(clone);
+
+    expectSameTesselation(*Node_getIPatch(patchNode), *Node_getIPatch(clone));
+
+    patchNode->getParent()->removeChildNode(clone);
+}
+
 void selectSinglePatchVertexAt(const Vector3& position)
 {
     render::View orthoView(false);
@@ -97,4 +171,115 @@ TEST_F(PatchTest, VertexSnappingIsUndoable)
     EXPECT_TRUE(math::isNear(ctrl.vertex, vertexBeforeSnapping, 0.01)) << "Vertex should be reverted and off-grid again";
 }
 
+// Moving a single control point of a fixed-subdivision patch only re-tesselates
+// the affected spans, the result needs to be the same as a full tesselation
+TEST_F(PatchTest, IncrementalTesselationMatchesFullTesselation)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+    auto patchNode = createWavyFixedPatch(worldspawn);
+    auto patch = Node_getIPatch(patchNode);
+
+    // Generate the initial tesselation, then move one of the inner control points
+    patch->getTesselatedPatchMesh();
+
+    patch->ctrlAt(4, 5).vertex.z() += 40;
+    patch->ctrlAt(4, 5).texcoord.x() += 0.25;
+    patch->controlPointsChanged();
+
+    // A clone tesselates its control points from scratch
+    auto clone = std::dynamic_pointer_cast<scene::Cloneable>(patchNode)->clone();
+    worldspawn->addChildNode(clone);
+
+    expectSameTesselation(*patch, *Node_getIPatch(clone));
+
+    // Move a corner vertex too, which touches the patch border
+    patch->ctrlAt(0, 0).vertex.x() -= 16;
+    patch->controlPointsChanged();
+
+    auto secondClone = std::dynamic_pointer_cast<scene::Cloneable>(patchNode)->clone();
+    worldspawn->addChildNode(secondClone);
+
+    expectSameTesselation(*patch, *Node_getIPatch(secondClone));
+}
+
+// Map loading defers the patch tesselation to the end of the parsing process,
+// where all patches are tesselated at once
+TEST_F(PatchTest, PatchesAreTesselatedAfterMapLoading)
+{
+    loadMap("altar.map");
+
+    std::vector<scene::INodePtr> patches;
+
+    GlobalMapModule().getRoot()->foreachNode([&](const scene::INodePtr& node)
+    {
+        if (Node_isPatch(node))
+        {
+            patches.push_back(node);
+        }
+
+        return true;
+    });
+
+    ASSERT_GT(patches.size(), 16u) << "The map should contain enough patches to be tesselated in parallel";
+
+    for (const auto& patchNode : patches)
+    {
+        EXPECT_FALSE(Node_getIPatch(patchNode)->getTesselatedPatchMesh().vertices.empty());
+        expectSameTesselationAsClone(patchNode);
+    }
+}
+
+// The patches moved by a manipulator are re-tesselated at once at the end of the operation
+TEST_F(PatchTest, PatchesAreTesselatedAfterManipulation)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+
+    std::vector<scene::INodePtr> patches;
+
+    // Fixed and adaptive subdivisions, enough of them to be split across threads
+    for (int i = 0; i < 40; ++i)
+    {
+        auto type = i % 4 == 0 ? patch::PatchDefType::Def2 : patch::PatchDefType::Def3;
+        patches.push_back(createWavyPatch(worldspawn, Vector3((i % 8) * 300.0, (i / 8) * 300.0, 0), type));
+    }
+
+    std::vector<PatchMesh> meshesBefore;
+
+    for (const auto& patchNode : patches)
+    {
+        meshesBefore.push_back(Node_getIPatch(patchNode)->getTesselatedPatchMesh());
+        Node_setSelected(patchNode, true);
+    }
+
+    GlobalSelectionSystem().setActiveManipulator(selection::IManipulator::Translate);
+
+    auto pivot2World = GlobalSelectionSystem().getPivot2World();
+    const auto& manipulator = GlobalSelectionSystem().getActiveManipulator();
+
+    // Grab the translate manipulator at the pivot and drag it
+    render::View view(false);
+    algorithm::constructCenteredOrthoview(view, pivot2World.translation());
+
+    auto test = algorithm::constructOrthoviewSelectionTest(view);
+    manipulator->testSelect(test, pivot2World);
+
+    ASSERT_TRUE(manipulator->isSelected());
+
+    GlobalSelectionSystem().onManipulationStart();
+    manipulator->getActiveComponent()->beginTransformation(pivot2World, view, Vector2(0, 0));
+    manipulator->getActiveComponent()->transform(pivot2World, view, Vector2(0.5, 0.5), false);
+    GlobalSelectionSystem().onManipulationChanged();
+    GlobalSelectionSystem().onManipulationEnd();
+
+    for (std::size_t i = 0; i < patches.size(); ++i)
+    {
+        auto mesh = Node_getIPatch(patches[i])->getTesselatedPatchMesh();
+
+        ASSERT_EQ(mesh.vertices.size(), meshesBefore[i].vertices.size());
+        EXPECT_NE(mesh.vertices.front().vertex, meshesBefore[i].vertices.front().vertex) << "Patch should have been moved";
+
+        expectSameTesselationAsClone(patches[i]);
+    }
+}
+
 }
@@ -42,6 +42,21 @@ TEST_F(PointTraceTest, ConstructPointTraceWithData)
     EXPECT_EQ(ps[4], Vector3(544, 64, 112));
 }
 
+TEST_F(PointTraceTest, ConstructPointTraceStopsAtInvalidData)
+{
+    // Parsing stops at the first invalid number, incomplete points are dropped
+    std::istringstream iss("1 2 3\n4.5 -5 6e2\n7 8 nan9\n10 11 12\n");
+
+    map::PointTrace trace(iss);
+    auto ps = trace.points();
+    ASSERT_EQ(ps.size(), 2);
+    EXPECT_EQ(ps[0], Vector3(1, 2, 3));
+    EXPECT_EQ(ps[1], Vector3(4.5, -5, 600));
+
+    std::istringstream incomplete("1 2 3\n4 5");
+    EXPECT_EQ(map::PointTrace(incomplete).points().size(), 1);
+}
+
 namespace
 {
 
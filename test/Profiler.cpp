@@ -0,0 +1,222 @@
+#include "RadiantTest.h"
+
+#include <regex>
+#include <sstream>
+#include <thread>
+#include "iprofiler.h"
+#include "icommandsystem.h"
+#include "os/file.h"
+#include <fstream>
+
+namespace test
+{
+
+using ProfilerTest = RadiantTest;
+
+namespace
+{
+
+struct TraceZone
+{
+    std::string name;
+    int threadId;
+    double start;
+    double duration;
+};
+
+// Extracts the complete events from the given Chrome trace JSON
+std::vector<TraceZone> parseTraceZones(const std::string& trace)
+{
+    std::vector<TraceZone> zones;
+
+    std::regex zonePattern(R"re(\{"name":"([^"]*)","cat":"zone","ph":"X","pid":1,"tid":(\d+),"ts":([0-9.]+),"dur":([0-9.]+)\})re");
+
+    for (std::sregex_iterator it(trace.begin(), trace.end(), zonePattern); it != std::sregex_iterator(); ++it)
+    {
+        zones.push_back(TraceZone{ (*it)[1], std::stoi((*it)[2]), std::stod((*it)[3]), std::stod((*it)[4]) });
+    }
+
+    return zones;
+}
+
+std::string exportTrace()
+{
+    std::ostringstream stream;
+    GlobalProfiler().exportChromeTrace(stream);
+    return stream.str();
+}
+
+const TraceZone* findZone(const std::vector<TraceZone>& zones, const std::string& name)
+{
+    auto found = std::find_if(zones.begin(), zones.end(), [&](const TraceZone& zone) { return zone.name == name; });
+    return found != zones.end() ? &(*found) : nullptr;
+}
+
+}
+
+TEST_F(ProfilerTest, DisabledByDefault)
+{
+    EXPECT_FALSE(GlobalProfiler().isEnabled());
+
+    {
+        PROFILE_ZONE("DisabledZone");
+    }
+
+    EXPECT_TRUE(parseTraceZones(exportTrace()).empty()) << "No zones should be recorded while disabled";
+}
+
+TEST_F(ProfilerTest, NestedZones)
+{
+    GlobalProfiler().setEnabled(true);
+
+    {
+        PROFILE_ZONE("Outer");
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        {
+            PROFILE_ZONE("Inner");
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+
+    GlobalProfiler().setEnabled(false);
+
+    auto trace = exportTrace();
+    auto zones = parseTraceZones(trace);
+
+    EXPECT_NE(trace.find(R"("name":"thread_name")"), std::string::npos) << "Thread name metadata missing";
+
+    auto outer = findZone(zones, "Outer");
+    auto inner = findZone(zones, "Inner");
+
+    ASSERT_TRUE(outer && inner);
+
+    EXPECT_EQ(outer->threadId, inner->threadId);
+    EXPECT_GE(inner->duration, 2000) << "Durations are in microseconds";
+    EXPECT_GE(inner->start, outer->start);
+    EXPECT_LE(inner->start + inner->duration, outer->start + outer->duration + 0.001);
+}
+
+TEST_F(ProfilerTest, ZonesArePerThread)
+{
+    GlobalProfiler().setEnabled(true);
+
+    {
+        PROFILE_ZONE("MainThreadZone");
+
+        std::thread thread([]()
+        {
+            PROFILE_ZONE("WorkerThreadZone");
+        });
+        thread.join();
+    }
+
+    GlobalProfiler().setEnabled(false);
+
+    auto zones = parseTraceZones(exportTrace());
+
+    auto mainZone = findZone(zones, "MainThreadZone");
+    auto workerZone = findZone(zones, "WorkerThreadZone");
+
+    ASSERT_TRUE(mainZone && workerZone);
+    EXPECT_NE(mainZone->threadId, workerZone->threadId);
+}
+
+TEST_F(ProfilerTest, DisablingKeepsOpenZone)
+{
+    GlobalProfiler().setEnabled(true);
+
+    {
+        PROFILE_ZONE("ClosedAfterDisabling");
+        GlobalProfiler().setEnabled(false);
+
+        // Zones opened now are not recorded
+        PROFILE_ZONE("NotRecorded");
+    }
+
+    auto zones = parseTraceZones(exportTrace());
+
+    EXPECT_TRUE(findZone(zones, "ClosedAfterDisabling"));
+    EXPECT_FALSE(findZone(zones, "NotRecorded"));
+}
+
+TEST_F(ProfilerTest, Clear)
+{
+    GlobalProfiler().setEnabled(true);
+
+    {
+        PROFILE_ZONE("BeforeClear");
+    }
+
+    GlobalProfiler().clear();
+
+    {
+        PROFILE_ZONE("AfterClear");
+    }
+
+    GlobalProfiler().setEnabled(false);
+
+    auto zones = parseTraceZones(exportTrace());
+
+    EXPECT_FALSE(findZone(zones, "BeforeClear"));
+    EXPECT_TRUE(findZone(zones, "AfterClear"));
+}
+
+TEST_F(ProfilerTest, RingBufferKeepsNewestZones)
+{
+    GlobalProfiler().setEnabled(true);
+
+    // Overflow the buffer by one zone, the first one should be gone
+    {
+        PROFILE_ZONE("OldestZone");
+    }
+
+    for (int i = 0; i < (1 << 16); ++i)
+    {
+        PROFILE_ZONE("FillerZone");
+    }
+
+    GlobalProfiler().setEnabled(false);
+
+    auto zones = parseTraceZones(exportTrace());
+
+    EXPECT_EQ(std::count_if(zones.begin(), zones.end(), [](const TraceZone& zone) { return zone.name == "FillerZone"; }), 1 << 16);
+    EXPECT_FALSE(findZone(zones, "OldestZone"));
+}
+
+TEST_F(ProfilerTest, MapLoadIsInstrumented)
+{
+    GlobalCommandSystem().executeCommand("StartProfiling");
+    GlobalCommandSystem().executeCommand("OpenMap", std::string("maps/altar.map"));
+    GlobalCommandSystem().executeCommand("StopProfiling");
+
+    auto zones = parseTraceZones(exportTrace());
+
+    EXPECT_TRUE(findZone(zones, "Map::loadMapResourceFromLocation"));
+    EXPECT_TRUE(findZone(zones, "MapResourceLoader::load"));
+}
+
+TEST_F(ProfilerTest, ExportCommandWritesTraceFile)
+{
+    GlobalProfiler().setEnabled(true);
+
+    {
+        PROFILE_ZONE("ExportedZone");
+    }
+
+    GlobalProfiler().setEnabled(false);
+
+    auto path = _context.getTemporaryDataPath() + "profile_trace.json";
+    GlobalCommandSystem().executeCommand("ExportProfilingTrace", cmd::Argument(path));
+
+    EXPECT_TRUE(os::fileOrDirExists(path));
+
+    std::ifstream stream(path);
+    std::stringstream contents;
+    contents << stream.rdbuf();
+
+    EXPECT_EQ(contents.str().find(R"({"traceEvents":[)"), 0);
+    EXPECT_TRUE(findZone(parseTraceZones(contents.str()), "ExportedZone"));
+}
+
+}
@@ -109,7 +109,7 @@ protected:
 			abort();
 		}
 
-		_glContextModule->createContext();
+		createGLContext();
 
         GlobalMapModule().createNewMap();
 	}
@@ -158,6 +158,12 @@ protected:
 	virtual void setupGameFolder()
 	{}
 
+    // Sets up the shared OpenGL context used by the render system
+    virtual void createGLContext()
+    {
+        _glContextModule->createContext();
+    }
+
 	virtual void setupTestModules()
 	{
 		_glContextModule = std::make_shared<gl::HeadlessOpenGLContextModule>();
@@ -0,0 +1,56 @@
+#include "RadiantTest.h"
+
+#include "registry/registry.h"
+#include "registry/CachedKey.h"
+
+namespace test
+{
+
+using RegistryTest = RadiantTest;
+
+namespace
+{
+    const char* const RKEY_TEST_BOOL = "user/ui/test/cachedBoolKey";
+    const char* const RKEY_TEST_FLOAT = "user/ui/test/cachedFloatKey";
+}
+
+TEST_F(RegistryTest, CachedKeyFollowsValueChanges)
+{
+    registry::setValue(RKEY_TEST_BOOL, false);
+    registry::setValue(RKEY_TEST_FLOAT, 1.5f);
+
+    registry::CachedKey<bool> boolKey(RKEY_TEST_BOOL);
+    registry::CachedKey<float> floatKey(RKEY_TEST_FLOAT);
+
+    EXPECT_EQ(boolKey.get(), false);
+    EXPECT_EQ(floatKey.get(), 1.5f);
+
+    registry::setValue(RKEY_TEST_BOOL, true);
+    registry::setValue(RKEY_TEST_FLOAT, 0.25f);
+
+    EXPECT_EQ(boolKey.get(), true) << "Cached value didn't pick up the change";
+    EXPECT_EQ(floatKey.get(), 0.25f) << "Cached value didn't pick up the change";
+}
+
+// Values written as strings through the registry interface reach the cached keys too
+TEST_F(RegistryTest, CachedKeyFollowsRegistrySet)
+{
+    GlobalRegistry().set(RKEY_TEST_BOOL, "0");
+    GlobalRegistry().set(RKEY_TEST_FLOAT, "2.5");
+
+    registry::CachedKey<bool> boolKey(RKEY_TEST_BOOL);
+    registry::CachedKey<float> floatKey(RKEY_TEST_FLOAT);
+
+    EXPECT_EQ(boolKey.get(), false);
+    EXPECT_EQ(floatKey.get(), 2.5f);
+
+    GlobalRegistry().set(RKEY_TEST_BOOL, "1");
+    GlobalRegistry().set(RKEY_TEST_FLOAT, "-0.75");
+
+    EXPECT_EQ(boolKey.get(), true) << "Cached value didn't pick up the change";
+    EXPECT_EQ(floatKey.get(), -0.75f) << "Cached value didn't pick up the change";
+    EXPECT_EQ(boolKey.get(), registry::getValue<bool>(RKEY_TEST_BOOL));
+    EXPECT_EQ(floatKey.get(), registry::getValue<float>(RKEY_TEST_FLOAT));
+}
+
+}
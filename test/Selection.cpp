@@ -392,6 +392,159 @@ TEST_F(SelectionTest, DeselectCommandLeavesFocus)
     EXPECT_EQ(GlobalSelectionSystem().countSelected(), 0);
 }
 
+namespace
+{
+
+class SelectionObserver :
+    public selection::SelectionSystem::Observer
+{
+public:
+    std::size_t singleChanges = 0;
+    std::vector<selection::SelectionChangeSet> batches;
+
+    void selectionChanged(const scene::INodePtr& node, bool isComponent) override
+    {
+        ++singleChanges;
+    }
+
+    void selectionBatchChanged(const selection::SelectionChangeSet& changes) override
+    {
+        batches.push_back(changes);
+    }
+};
+
+}
+
+TEST_F(SelectionTest, SelectionTransactionDeliversSingleNotification)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+
+    std::vector<scene::INodePtr> brushes;
+
+    for (int i = 0; i < 50; ++i)
+    {
+        brushes.push_back(algorithm::createCubicBrush(worldspawn, Vector3(i * 64, 0, 0), "textures/numbers/1"));
+    }
+
+    SelectionObserver observer;
+    GlobalSelectionSystem().addObserver(&observer);
+
+    std::size_t signalCount = 0;
+    sigc::connection conn = GlobalSelectionSystem().signal_selectionChanged().connect(
+        [&](const ISelectable&) { ++signalCount; });
+
+    {
+        selection::SelectionTransaction transaction;
+
+        for (const auto& brush : brushes)
+        {
+            Node_setSelected(brush, true);
+        }
+
+        // Nested transactions don't deliver anything on their own
+        {
+            selection::SelectionTransaction nested;
+            Node_setSelected(brushes[0], false);
+        }
+
+        // Selecting and deselecting a node again cancels out
+        Node_setSelected(brushes[1], false);
+        Node_setSelected(brushes[1], true);
+
+        // The selection state is up to date during the transaction
+        EXPECT_EQ(GlobalSelectionSystem().countSelected(), brushes.size() - 1);
+        EXPECT_EQ(GlobalSelectionSystem().ultimateSelected(), brushes[1]);
+
+        EXPECT_EQ(signalCount, 0) << "No signal expected during the transaction";
+        EXPECT_TRUE(observer.batches.empty()) << "No notification expected during the transaction";
+    }
+
+    EXPECT_EQ(signalCount, 1) << "Expected a single signal after the transaction";
+    EXPECT_EQ(observer.singleChanges, 0) << "Expected no per-node notification";
+    ASSERT_EQ(observer.batches.size(), 1) << "Expected a single batch notification";
+
+    // brushes[0] has been selected and deselected, it's not part of the change set
+    const auto& changes = observer.batches.front();
+    EXPECT_EQ(changes.selected.size(), brushes.size() - 1);
+    EXPECT_TRUE(changes.deselected.empty());
+    EXPECT_EQ(std::find(changes.selected.begin(), changes.selected.end(), brushes[0]), changes.selected.end());
+
+    // Deselecting everything is batched too
+    observer.batches.clear();
+    GlobalSelectionSystem().setSelectedAll(false);
+
+    EXPECT_EQ(signalCount, 2);
+    ASSERT_EQ(observer.batches.size(), 1);
+    EXPECT_EQ(observer.batches.front().deselected.size(), brushes.size() - 1);
+    EXPECT_EQ(GlobalSelectionSystem().countSelected(), 0);
+
+    // Outside a transaction, every change is delivered right away
+    Node_setSelected(brushes[0], true);
+    EXPECT_EQ(signalCount, 3);
+    EXPECT_EQ(observer.singleChanges, 1);
+
+    conn.disconnect();
+    GlobalSelectionSystem().removeObserver(&observer);
+}
+
+TEST_F(SelectionTest, SelectionOrderIsPreserved)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+
+    std::vector<scene::INodePtr> brushes;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        brushes.push_back(algorithm::createCubicBrush(worldspawn, Vector3(i * 64, 0, 0), "textures/numbers/1"));
+    }
+
+    // Select in reverse order, deselect every other one
+    for (auto i = brushes.rbegin(); i != brushes.rend(); ++i)
+    {
+        Node_setSelected(*i, true);
+    }
+
+    for (std::size_t i = 0; i < brushes.size(); i += 2)
+    {
+        Node_setSelected(brushes[i], false);
+    }
+
+    EXPECT_EQ(GlobalSelectionSystem().ultimateSelected(), brushes[1]);
+    EXPECT_EQ(GlobalSelectionSystem().penultimateSelected(), brushes[3]);
+
+    // Re-selecting moves the node to the end
+    Node_setSelected(brushes[99], false);
+    Node_setSelected(brushes[99], true);
+    EXPECT_EQ(GlobalSelectionSystem().ultimateSelected(), brushes[99]);
+    EXPECT_EQ(GlobalSelectionSystem().penultimateSelected(), brushes[1]);
+
+    std::vector<scene::INodePtr> visited;
+    GlobalSelectionSystem().foreachSelected([&](const scene::INodePtr& node)
+    {
+        visited.push_back(node);
+    });
+
+    std::vector<scene::INodePtr> expected;
+
+    for (auto i = 97; i > 1; i -= 2)
+    {
+        expected.push_back(brushes[i]);
+    }
+
+    expected.push_back(brushes[1]);
+    expected.push_back(brushes[99]);
+
+    EXPECT_EQ(visited, expected) << "Nodes should be visited in selection order";
+
+    // Deselecting nodes during traversal is allowed
+    GlobalSelectionSystem().foreachSelected([&](const scene::INodePtr& node)
+    {
+        Node_setSelected(node, false);
+    });
+
+    EXPECT_EQ(GlobalSelectionSystem().countSelected(), 0);
+}
+
 class ViewSelectionTest :
     public SelectionTest
 {
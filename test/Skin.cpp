@@ -431,8 +431,8 @@ TEST_F(ModelSkinTest, CopySkin)
     EXPECT_EQ(skin->getBlockSyntax().contents, originalSkin->getBlockSyntax().contents) << "Contents not copied";
     EXPECT_TRUE(skin->isModified()) << "Copied skin should be set to modified";
     EXPECT_TRUE(skinManager.skinCanBeModified(skin->getDeclName()));
-    EXPECT_EQ(skin->getBlockSyntax().fileInfo.name, "");
-    EXPECT_EQ(skin->getBlockSyntax().fileInfo.topDir, "");
+    EXPECT_EQ(skin->getBlockSyntax().getFileInfo().name, "");
+    EXPECT_EQ(skin->getBlockSyntax().getFileInfo().topDir, "");
     EXPECT_EQ(skin->getBlockSyntax().getModName(), GlobalGameManager().currentGame()->getName())
         << "Copy should have the current game name set, since we don't have a mod in the unit tests";
 
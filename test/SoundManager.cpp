@@ -63,7 +63,7 @@ TEST_F(SoundManagerTest, GetNonExistingSoundShader)
     // This shader is defined nowhere
     auto nonexisting = GlobalSoundManager().getSoundShader("nonexisting_shader_1242");
     EXPECT_TRUE(nonexisting) << "SoundManager should always return a non-empty reference";
-    EXPECT_EQ(nonexisting->getBlockSyntax().fileInfo.visibility, vfs::Visibility::HIDDEN)
+    EXPECT_EQ(nonexisting->getBlockSyntax().getFileInfo().visibility, vfs::Visibility::HIDDEN)
         << "Non-existing shader's VFS visibility should be hidden";
     EXPECT_TRUE(nonexisting->getBlockSyntax().contents.empty())
         << "Non-existing shader's content should be empty";
@@ -872,4 +872,112 @@ TEST_F(UndoTest, OperationTracking)
     EXPECT_EQ(tracker.receivedOperationName, "") << "Nothing should fire, already detached";
 }
 
+namespace
+{
+
+std::vector<scene::INodePtr> getChildNodes(const scene::INodePtr& parent)
+{
+    std::vector<scene::INodePtr> children;
+
+    parent->foreachNode([&](const scene::INodePtr& child)
+    {
+        children.push_back(child);
+        return true;
+    });
+
+    return children;
+}
+
+}
+
+// Undoing the removal of scattered nodes needs to restore the child order
+TEST_F(UndoTest, MassDeletionOfChildNodes)
+{
+    constexpr std::size_t NumBrushes = 60;
+    constexpr std::size_t NumDeletedBrushes = 10;
+
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+
+    for (std::size_t i = 0; i < NumBrushes; ++i)
+    {
+        scene::addNodeToContainer(GlobalBrushCreator().createBrush(), worldspawn);
+    }
+
+    auto childrenBefore = getChildNodes(worldspawn);
+    EXPECT_EQ(childrenBefore.size(), NumBrushes);
+
+    {
+        UndoableCommand cmd("deleteBrushes");
+
+        // Remove every sixth brush, scattered across the whole list
+        for (std::size_t i = 0; i < NumDeletedBrushes; ++i)
+        {
+            scene::removeNodeFromParent(childrenBefore[i * NumBrushes / NumDeletedBrushes]);
+        }
+    }
+
+    EXPECT_EQ(getChildNodes(worldspawn).size(), NumBrushes - NumDeletedBrushes);
+
+    GlobalUndoSystem().undo();
+
+    // All nodes are back in their previous order
+    EXPECT_EQ(getChildNodes(worldspawn), childrenBefore) << "Child order not restored after undo";
+
+    GlobalUndoSystem().redo();
+    EXPECT_EQ(getChildNodes(worldspawn).size(), NumBrushes - NumDeletedBrushes);
+
+    GlobalUndoSystem().undo();
+    EXPECT_EQ(getChildNodes(worldspawn), childrenBefore) << "Child order not restored after redo and undo";
+}
+
+// Undo needs to restore the child order after a mix of insertions and removals
+TEST_F(UndoTest, ChildOrderAfterMixedChanges)
+{
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+
+    for (int i = 0; i < 10; ++i)
+    {
+        scene::addNodeToContainer(GlobalBrushCreator().createBrush(), worldspawn);
+    }
+
+    auto childrenBefore = getChildNodes(worldspawn);
+    std::vector<scene::INodePtr> childrenAfter;
+
+    {
+        UndoableCommand cmd("mixedChanges");
+
+        // Remove the first, the last and two adjacent ones
+        scene::removeNodeFromParent(childrenBefore[0]);
+        scene::removeNodeFromParent(childrenBefore[9]);
+        scene::removeNodeFromParent(childrenBefore[4]);
+        scene::removeNodeFromParent(childrenBefore[5]);
+
+        // Re-add a removed node, it ends up at the end
+        scene::addNodeToContainer(childrenBefore[4], worldspawn);
+
+        // Add a new one and remove it again
+        auto brush = GlobalBrushCreator().createBrush();
+        scene::addNodeToContainer(brush, worldspawn);
+        scene::addNodeToContainer(GlobalBrushCreator().createBrush(), worldspawn);
+        scene::removeNodeFromParent(brush);
+
+        childrenAfter = getChildNodes(worldspawn);
+    }
+
+    EXPECT_EQ(childrenAfter.size(), 8);
+
+    GlobalUndoSystem().undo();
+    EXPECT_EQ(getChildNodes(worldspawn), childrenBefore) << "Child order not restored after undo";
+
+    for (const auto& child : childrenBefore)
+    {
+        EXPECT_TRUE(child->inScene()) << "Child should be in the scene after undo";
+    }
+
+    GlobalUndoSystem().redo();
+    EXPECT_EQ(getChildNodes(worldspawn), childrenAfter) << "Child order not restored after redo";
+    EXPECT_FALSE(childrenBefore[0]->inScene()) << "Removed child should be out of the scene after redo";
+    EXPECT_TRUE(childrenBefore[4]->inScene()) << "Re-added child should be in the scene after redo";
+}
+
 }
@@ -0,0 +1,257 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <numeric>
+#include <thread>
+#include <fmt/format.h>
+
+namespace benchmark
+{
+
+namespace
+{
+    std::string escapeJsonString(const std::string& input)
+    {
+        std::string result;
+
+        for (auto c : input)
+        {
+            if (c == '"' || c == '\\') result += '\\';
+            result += c;
+        }
+
+        return result;
+    }
+
+    double getMedian(std::vector<double> samples)
+    {
+        std::sort(samples.begin(), samples.end());
+
+        auto middle = samples.size() / 2;
+        return samples.size() % 2 == 0 ? (samples[middle - 1] + samples[middle]) / 2 : samples[middle];
+    }
+}
+
+ResultCollector::ResultCollector() :
+    _repetitions(5),
+    _scale(1.0),
+    _hasGLContext(false)
+{}
+
+ResultCollector& ResultCollector::Instance()
+{
+    static ResultCollector _instance;
+    return _instance;
+}
+
+std::size_t ResultCollector::getRepetitions() const
+{
+    return _repetitions;
+}
+
+void ResultCollector::setRepetitions(std::size_t repetitions)
+{
+    _repetitions = std::max<std::size_t>(repetitions, 1);
+}
+
+double ResultCollector::getScale() const
+{
+    return _scale;
+}
+
+void ResultCollector::setScale(double scale)
+{
+    _scale = scale > 0 ? scale : 1.0;
+}
+
+std::size_t ResultCollector::getScaled(std::size_t size) const
+{
+    return std::max<std::size_t>(static_cast<std::size_t>(size * _scale), 1);
+}
+
+void ResultCollector::setHasGLContext(bool hasContext)
+{
+    _hasGLContext = hasContext;
+}
+
+void ResultCollector::addResult(Result&& result)
+{
+    _results.emplace_back(std::move(result));
+}
+
+void ResultCollector::writeJson(std::ostream& stream) const
+{
+    auto now = std::time(nullptr);
+    char date[32];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::gmtime(&now));
+
+    stream << "{\n";
+    stream << "  \"context\": {\n";
+    stream << fmt::format("    \"date\": \"{0}\",\n", date);
+    stream << fmt::format("    \"num_cpus\": {0},\n", std::thread::hardware_concurrency());
+    stream << fmt::format("    \"repetitions\": {0},\n", _repetitions);
+    stream << fmt::format("    \"scale\": {0},\n", _scale);
+    stream << fmt::format("    \"gl_context\": {0}\n", _hasGLContext ? "true" : "false");
+    stream << "  },\n";
+    stream << "  \"benchmarks\": [";
+
+    for (auto result = _results.begin(); result != _results.end(); ++result)
+    {
+        const auto& samples = result->samplesMsec;
+
+        stream << (result == _results.begin() ? "\n" : ",\n");
+        stream << "    {\n";
+        stream << fmt::format("      \"name\": \"{0}\",\n", escapeJsonString(result->name));
+
+        stream << "      \"parameters\": {";
+
+        for (auto param = result->parameters.begin(); param != result->parameters.end(); ++param)
+        {
+            stream << (param == result->parameters.begin() ? " " : ", ");
+            stream << fmt::format("\"{0}\": {1}", escapeJsonString(param->first), param->second);
+        }
+
+        stream << " },\n";
+
+        if (!samples.empty())
+        {
+            stream << fmt::format("      \"min_ms\": {0:.3f},\n", *std::min_element(samples.begin(), samples.end()));
+            stream << fmt::format("      \"median_ms\": {0:.3f},\n", getMedian(samples));
+            stream << fmt::format("      \"mean_ms\": {0:.3f},\n", std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size());
+            stream << fmt::format("      \"max_ms\": {0:.3f},\n", *std::max_element(samples.begin(), samples.end()));
+        }
+
+        stream << "      \"samples_ms\": [";
+
+        for (auto sample = samples.begin(); sample != samples.end(); ++sample)
+        {
+            stream << (sample == samples.begin() ? "" : ", ") << fmt::format("{0:.3f}", *sample);
+        }
+
+        stream << "]\n";
+        stream << "    }";
+    }
+
+    stream << "\n  ]\n";
+    stream << "}\n";
+}
+
+void BenchmarkTest::createGLContext()
+{
+    auto display = std::getenv("DISPLAY");
+
+    // Without X display the render system is left without context
+    if (display == nullptr || *display == '\0')
+    {
+        rWarning() << "No X display available, running benchmarks without OpenGL context" << std::endl;
+        ResultCollector::Instance().setHasGLContext(false);
+        return;
+    }
+
+    RadiantTest::createGLContext();
+    ResultCollector::Instance().setHasGLContext(true);
+}
+
+void BenchmarkTest::measure(const std::map<std::string, std::size_t>& parameters,
+    const std::function<void()>& run, const std::function<void()>& prepare)
+{
+    auto testInfo = ::testing::UnitTest::GetInstance()->current_test_info();
+
+    Result result;
+    result.name = std::string(testInfo->test_suite_name()) + "." + testInfo->name();
+    result.parameters = parameters;
+
+    for (std::size_t i = 0; i < ResultCollector::Instance().getRepetitions(); ++i)
+    {
+        if (prepare)
+        {
+            prepare();
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        run();
+
+        auto end = std::chrono::steady_clock::now();
+
+        result.samplesMsec.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    ResultCollector::Instance().addResult(std::move(result));
+}
+
+}
+
+namespace
+{
+    // Returns true and stores the value if the argument starts with the given option
+    bool parseOption(const std::string& argument, const std::string& option, std::string& value)
+    {
+        if (argument.rfind(option + "=", 0) != 0) return false;
+
+        value = argument.substr(option.length() + 1);
+        return true;
+    }
+}
+
+// Benchmark options:
+//   --benchmark-out=<file>          write the JSON results to the given file instead of stdout
+//   --benchmark-repetitions=<n>     timed runs per benchmark (default 5)
+//   --benchmark-scale=<factor>      multiplier for the synthetic workload sizes (default 1.0)
+// All other arguments are passed to googletest (e.g. --gtest_filter).
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+
+    std::string outputPath;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string value;
+
+        if (parseOption(argv[i], "--benchmark-out", value))
+        {
+            outputPath = value;
+        }
+        else if (parseOption(argv[i], "--benchmark-repetitions", value))
+        {
+            benchmark::ResultCollector::Instance().setRepetitions(std::strtoul(value.c_str(), nullptr, 10));
+        }
+        else if (parseOption(argv[i], "--benchmark-scale", value))
+        {
+            benchmark::ResultCollector::Instance().setScale(std::strtod(value.c_str(), nullptr));
+        }
+    }
+
+    // Keep stdout clean for the JSON document if there's no output file
+    if (outputPath.empty())
+    {
+        auto& listeners = ::testing::UnitTest::GetInstance()->listeners();
+        delete listeners.Release(listeners.default_result_printer());
+    }
+
+    auto result = RUN_ALL_TESTS();
+
+    if (outputPath.empty())
+    {
+        benchmark::ResultCollector::Instance().writeJson(std::cout);
+    }
+    else
+    {
+        std::ofstream stream(outputPath);
+
+        if (!stream.is_open())
+        {
+            std::cerr << "Cannot open " << outputPath << " for writing" << std::endl;
+            return 1;
+        }
+
+        benchmark::ResultCollector::Instance().writeJson(stream);
+    }
+
+    return result;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "RadiantTest.h"
+
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace benchmark
+{
+
+// The timings of a single benchmark
+struct Result
+{
+    std::string name;
+
+    // The size of the workload (number of brushes, iterations, etc.)
+    std::map<std::string, std::size_t> parameters;
+
+    // Wall clock time of each repetition
+    std::vector<double> samplesMsec;
+};
+
+/**
+ * Collects the results of all benchmarks run by this executable,
+ * to write them as JSON document once all of them are done.
+ */
+class ResultCollector
+{
+private:
+    std::vector<Result> _results;
+
+    std::size_t _repetitions;
+    double _scale;
+    bool _hasGLContext;
+
+    ResultCollector();
+
+public:
+    static ResultCollector& Instance();
+
+    // Number of timed runs per benchmark
+    std::size_t getRepetitions() const;
+    void setRepetitions(std::size_t repetitions);
+
+    // Multiplier applied to the workload sizes
+    double getScale() const;
+    void setScale(double scale);
+
+    // Scales the given workload size by the configured factor
+    std::size_t getScaled(std::size_t size) const;
+
+    // Set by the fixture, false if the benchmarks ran without OpenGL context
+    void setHasGLContext(bool hasContext);
+
+    void addResult(Result&& result);
+
+    void writeJson(std::ostream& stream) const;
+};
+
+/**
+ * Fixture for benchmarks, setting up the same headless module environment
+ * the unit tests are using.
+ *
+ * Without an X display (e.g. on a GPU-less build machine) the fixture doesn't
+ * create an OpenGL context. The render system stays unrealised in this case,
+ * all other modules are working as usual.
+ */
+class BenchmarkTest :
+    public test::RadiantTest
+{
+protected:
+    void createGLContext() override;
+
+    // Invokes prepare() and run() for each repetition, recording the time spent in run().
+    // The result is stored under the name of the running test.
+    void measure(const std::map<std::string, std::size_t>& parameters,
+        const std::function<void()>& run, const std::function<void()>& prepare = {});
+};
+
+}
@@ -0,0 +1,23 @@
+#include "Benchmark.h"
+
+#include "ideclmanager.h"
+#include "ishaders.h"
+
+namespace benchmark
+{
+
+using DeclarationBenchmark = BenchmarkTest;
+
+// Re-parses all declaration files of the test resources (materials, entityDefs, skins, etc.)
+TEST_F(DeclarationBenchmark, ReloadDeclarations)
+{
+    std::size_t numMaterials = 0;
+    GlobalMaterialManager().foreachShaderName([&](const std::string&) { ++numMaterials; });
+
+    measure({ { "materials", numMaterials } }, []()
+    {
+        GlobalDeclarationManager().reloadDeclarations();
+    });
+}
+
+}
@@ -0,0 +1,52 @@
+#include "Benchmark.h"
+
+#include "ientity.h"
+#include "string/convert.h"
+#include "algorithm/Entity.h"
+
+namespace benchmark
+{
+
+using EntityBenchmark = BenchmarkTest;
+
+// The kind of spawnarg lookups performed by renderers, filters and the map exporter
+TEST_F(EntityBenchmark, KeyValueLookup)
+{
+    auto numEntities = ResultCollector::Instance().getScaled(200);
+    constexpr std::size_t NumRounds = 500;
+
+    std::vector<IEntityNodePtr> entities;
+
+    for (std::size_t i = 0; i < numEntities; ++i)
+    {
+        auto entity = test::algorithm::createEntityByClassName("atdm:torch_brazier");
+        entity->getEntity().setKeyValue("origin", string::to_string(Vector3(i, 0, 0)));
+        entities.push_back(entity);
+    }
+
+    // Entity keys, inherited keys and keys which are not present at all
+    const std::vector<std::string> keys
+    {
+        "classname", "name", "origin", "spawnclass", "noshadows", "model", "editor_color", "unknown_key_for_testing"
+    };
+
+    std::size_t totalLength = 0;
+
+    measure({ { "entities", numEntities }, { "lookups", NumRounds * numEntities * keys.size() } }, [&]()
+    {
+        for (std::size_t round = 0; round < NumRounds; ++round)
+        {
+            for (const auto& entity : entities)
+            {
+                for (const auto& key : keys)
+                {
+                    totalLength += entity->getEntity().getKeyValue(key).length();
+                }
+            }
+        }
+    });
+
+    EXPECT_GT(totalLength, 0u);
+}
+
+}
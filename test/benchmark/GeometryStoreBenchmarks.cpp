@@ -0,0 +1,91 @@
+#include "Benchmark.h"
+#include "SyntheticMap.h"
+
+#include "render/GeometryStore.h"
+#include "testutil/TestBufferObjectProvider.h"
+#include "testutil/TestSyncObjectProvider.h"
+#include "testutil/RenderUtils.h"
+
+namespace benchmark
+{
+
+using GeometryStoreBenchmark = BenchmarkTest;
+
+namespace
+{
+
+constexpr std::size_t NumFrames = 100;
+
+test::TestBufferObjectProvider _bufferObjectProvider;
+
+}
+
+// Simulates a scene being edited: each frame some of the slots are
+// updated, freed and re-allocated, like the renderables of moving objects
+TEST_F(GeometryStoreBenchmark, FrameChurn)
+{
+    auto numSlots = ResultCollector::Instance().getScaled(5000);
+
+    measure({ { "slots", numSlots }, { "frames", NumFrames } }, [&]()
+    {
+        render::GeometryStore store(test::TestSyncObjectProvider::Instance(), _bufferObjectProvider);
+        Random random(42);
+
+        std::vector<render::IGeometryStore::Slot> slots;
+        std::vector<std::size_t> slotSizes;
+        slots.reserve(numSlots);
+        slotSizes.reserve(numSlots);
+
+        for (std::size_t frame = 0; frame < NumFrames; ++frame)
+        {
+            store.onFrameStart();
+
+            // Fill up the store during the first frame, churn 5% of the slots after that
+            auto numChanges = frame == 0 ? numSlots : numSlots / 20;
+
+            for (std::size_t i = 0; i < numChanges; ++i)
+            {
+                if (slots.size() < numSlots)
+                {
+                    auto vertices = test::generateVertices(static_cast<int>(i), 4 + random.nextIndex(60));
+                    auto indices = test::generateIndices(vertices);
+
+                    slots.push_back(store.allocateSlot(vertices.size(), indices.size()));
+                    slotSizes.push_back(vertices.size());
+                    store.updateData(slots.back(), vertices, indices);
+                    continue;
+                }
+
+                auto index = random.nextIndex(slots.size());
+
+                if (i % 2 == 0)
+                {
+                    // Same-sized update of the existing geometry
+                    auto vertices = test::generateVertices(static_cast<int>(i), slotSizes[index]);
+                    store.updateData(slots[index], vertices, test::generateIndices(vertices));
+                }
+                else
+                {
+                    // Replace the geometry by one of a different size
+                    auto vertices = test::generateVertices(static_cast<int>(i), 4 + random.nextIndex(60));
+                    auto indices = test::generateIndices(vertices);
+
+                    store.deallocateSlot(slots[index]);
+                    slots[index] = store.allocateSlot(vertices.size(), indices.size());
+                    slotSizes[index] = vertices.size();
+                    store.updateData(slots[index], vertices, indices);
+                }
+            }
+
+            store.syncToBufferObjects();
+            store.onFrameFinished();
+        }
+
+        for (auto slot : slots)
+        {
+            store.deallocateSlot(slot);
+        }
+    });
+}
+
+}
@@ -0,0 +1,102 @@
+#include "Benchmark.h"
+
+#include "iimage.h"
+#include "RGBAImage.h"
+#include "image/PixelKernels.h"
+#include "os/fs.h"
+#include "string/case_conv.h"
+
+namespace benchmark
+{
+
+using ImageBenchmark = BenchmarkTest;
+
+namespace
+{
+
+// Loads all uncompressed TGAs of the test project's texture folder
+std::vector<ImagePtr> loadTestImages(const std::string& testProjectPath)
+{
+    std::vector<ImagePtr> images;
+
+    for (const auto& entry : fs::recursive_directory_iterator(testProjectPath + "textures/"))
+    {
+        if (entry.is_regular_file() && string::to_lower_copy(entry.path().extension().string()) == ".tga")
+        {
+            auto img = GlobalImageLoader().imageFromFile(entry.path().string());
+
+            if (img && !img->isPrecompressed())
+            {
+                images.push_back(img);
+            }
+        }
+    }
+
+    return images;
+}
+
+// Each image is processed this many times per repetition
+std::size_t getIterations()
+{
+    return ResultCollector::Instance().getScaled(10);
+}
+
+}
+
+// Upscales the images to twice their size, as the texture manager does for non-power-of-two images
+TEST_F(ImageBenchmark, Resample)
+{
+    auto images = loadTestImages(_context.getTestProjectPath());
+    ASSERT_FALSE(images.empty()) << "No TGA images found";
+
+    auto iterations = getIterations();
+    std::size_t pixels = 0;
+
+    for (const auto& img : images)
+    {
+        pixels += img->getWidth() * img->getHeight() * 4 * iterations;
+    }
+
+    measure({ { "images", images.size() }, { "iterations", iterations }, { "pixels", pixels } }, [&]()
+    {
+        for (const auto& img : images)
+        {
+            auto width = img->getWidth() * 2;
+            auto height = img->getHeight() * 2;
+            image::RGBAImage resampled(width, height);
+
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                image::kernels::resample(img->getPixels(), img->getWidth(), img->getHeight(),
+                    resampled.getPixels(), width, height, 4);
+            }
+        }
+    });
+}
+
+TEST_F(ImageBenchmark, MipChain)
+{
+    auto images = loadTestImages(_context.getTestProjectPath());
+    ASSERT_FALSE(images.empty()) << "No TGA images found";
+
+    auto iterations = getIterations();
+    std::size_t pixels = 0;
+
+    for (const auto& img : images)
+    {
+        pixels += img->getWidth() * img->getHeight() * iterations;
+    }
+
+    measure({ { "images", images.size() }, { "iterations", iterations }, { "pixels", pixels } }, [&]()
+    {
+        for (const auto& img : images)
+        {
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                image::generateMipChain(img->getPixels(), img->getWidth(), img->getHeight());
+            }
+        }
+    });
+}
+
+}
@@ -0,0 +1,102 @@
+#include "Benchmark.h"
+#include "SyntheticMap.h"
+
+#include <fstream>
+#include <sstream>
+#include "imapformat.h"
+#include "imapresource.h"
+#include "scene/Traverse.h"
+
+namespace benchmark
+{
+
+using MapBenchmark = BenchmarkTest;
+
+namespace
+{
+
+SyntheticMapSize getMapSize()
+{
+    auto& collector = ResultCollector::Instance();
+
+    SyntheticMapSize size;
+    size.numBrushes = collector.getScaled(size.numBrushes);
+    size.numPatches = collector.getScaled(size.numPatches);
+    size.numEntities = collector.getScaled(size.numEntities);
+
+    return size;
+}
+
+std::map<std::string, std::size_t> getParameters(const SyntheticMapSize& size)
+{
+    return
+    {
+        { "brushes", size.numBrushes },
+        { "patches", size.numPatches },
+        { "entities", size.numEntities },
+    };
+}
+
+std::string exportMap(const std::string& formatName)
+{
+    auto format = GlobalMapFormatManager().getMapFormatByName(formatName);
+    auto writer = format->getMapWriter();
+    auto root = GlobalMapModule().getRoot();
+
+    std::ostringstream output;
+
+    {
+        auto exporter = GlobalMapModule().createMapExporter(*writer, root, output);
+        exporter->exportMap(root, scene::traverse);
+    }
+
+    return output.str();
+}
+
+std::string getDoom3FormatName()
+{
+    return GlobalMapFormatManager().getMapFormatForFilename("synthetic.map")->getMapFormatName();
+}
+
+}
+
+TEST_F(MapBenchmark, ExportDoom3Format)
+{
+    auto size = getMapSize();
+    generateSyntheticMap(size);
+
+    auto formatName = getDoom3FormatName();
+
+    measure(getParameters(size), [&]() { exportMap(formatName); });
+}
+
+TEST_F(MapBenchmark, ExportPortableFormat)
+{
+    auto size = getMapSize();
+    generateSyntheticMap(size);
+
+    measure(getParameters(size), [&]() { exportMap(map::PORTABLE_MAP_FORMAT_NAME); });
+}
+
+TEST_F(MapBenchmark, LoadDoom3Format)
+{
+    auto size = getMapSize();
+    generateSyntheticMap(size);
+
+    auto path = _context.getTemporaryDataPath() + "synthetic.map";
+
+    {
+        std::ofstream stream(path);
+        stream << exportMap(getDoom3FormatName());
+    }
+
+    measure(getParameters(size), [&]()
+    {
+        auto resource = GlobalMapResourceManager().createFromPath(path);
+        EXPECT_TRUE(resource->load());
+    });
+
+    fs::remove(path);
+}
+
+}
@@ -0,0 +1,45 @@
+#include "Benchmark.h"
+
+#include "inamespace.h"
+#include "ientity.h"
+#include "scene/BasicRootNode.h"
+#include "scenelib.h"
+#include "string/convert.h"
+#include "algorithm/Entity.h"
+
+namespace benchmark
+{
+
+using NamespaceBenchmark = BenchmarkTest;
+
+// Imports a set of entities whose names all exist in the target namespace already
+TEST_F(NamespaceBenchmark, EnsureNoConflicts)
+{
+    auto numNames = ResultCollector::Instance().getScaled(10000);
+
+    INamespacePtr nspace;
+    scene::IMapRootNodePtr foreignRoot;
+
+    measure({ { "names", numNames } }, [&]()
+    {
+        nspace->ensureNoConflicts(foreignRoot);
+    },
+    [&]()
+    {
+        // Every run starts with the original names
+        nspace = GlobalNamespaceFactory().createNamespace();
+        foreignRoot = std::make_shared<scene::BasicRootNode>();
+
+        for (std::size_t i = 1; i <= numNames; ++i)
+        {
+            auto name = "func_static_" + string::to_string(i);
+            nspace->insert(name);
+
+            auto entity = test::algorithm::createEntityByClassName("func_static");
+            entity->getEntity().setKeyValue("name", name);
+            scene::addNodeToContainer(entity, foreignRoot);
+        }
+    });
+}
+
+}
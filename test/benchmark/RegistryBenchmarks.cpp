@@ -0,0 +1,60 @@
+#include "Benchmark.h"
+
+#include "registry/registry.h"
+#include "registry/CachedKey.h"
+
+namespace benchmark
+{
+
+using RegistryBenchmark = BenchmarkTest;
+
+namespace
+{
+    const char* const RKEY_BENCHMARK_BOOL = "user/ui/benchmark/boolKey";
+
+    std::size_t getNumLookups()
+    {
+        return ResultCollector::Instance().getScaled(100000);
+    }
+}
+
+// Reads a key through the XPath lookup every time
+TEST_F(RegistryBenchmark, ValueLookup)
+{
+    registry::setValue(RKEY_BENCHMARK_BOOL, true);
+
+    auto numLookups = getNumLookups();
+    std::size_t trueCount = 0;
+
+    measure({ { "lookups", numLookups } }, [&]()
+    {
+        for (std::size_t i = 0; i < numLookups; ++i)
+        {
+            if (registry::getValue<bool>(RKEY_BENCHMARK_BOOL)) ++trueCount;
+        }
+    });
+
+    EXPECT_GT(trueCount, 0u);
+}
+
+// Reads the same key through a CachedKey
+TEST_F(RegistryBenchmark, CachedKeyRead)
+{
+    registry::setValue(RKEY_BENCHMARK_BOOL, true);
+    registry::CachedKey<bool> cachedKey(RKEY_BENCHMARK_BOOL);
+
+    auto numLookups = getNumLookups();
+    std::size_t trueCount = 0;
+
+    measure({ { "lookups", numLookups } }, [&]()
+    {
+        for (std::size_t i = 0; i < numLookups; ++i)
+        {
+            if (cachedKey.get()) ++trueCount;
+        }
+    });
+
+    EXPECT_GT(trueCount, 0u);
+}
+
+}
@@ -0,0 +1,148 @@
+#include "Benchmark.h"
+#include "SyntheticMap.h"
+
+#include "icommandsystem.h"
+#include "iselection.h"
+#include "ibrush.h"
+#include "iundo.h"
+#include "algorithm/View.h"
+#include "scenelib.h"
+
+namespace benchmark
+{
+
+using SceneBenchmark = BenchmarkTest;
+
+namespace
+{
+
+constexpr std::size_t NumSelectionTests = 200;
+
+SyntheticMapSize generateScene()
+{
+    auto& collector = ResultCollector::Instance();
+
+    SyntheticMapSize size;
+    size.numBrushes = collector.getScaled(size.numBrushes);
+    size.numPatches = collector.getScaled(size.numPatches);
+    size.numEntities = collector.getScaled(size.numEntities);
+
+    generateSyntheticMap(size);
+
+    return size;
+}
+
+// Orthoviews centered at reproducible random positions
+std::vector<render::View> createRandomOrthoviews(std::size_t count)
+{
+    Random random(4711);
+    std::vector<render::View> views(count);
+
+    for (auto& view : views)
+    {
+        test::algorithm::constructCenteredOrthoview(view,
+            Vector3(random.next(-detail::WorldExtent, detail::WorldExtent), random.next(-detail::WorldExtent, detail::WorldExtent), 0));
+    }
+
+    return views;
+}
+
+}
+
+TEST_F(SceneBenchmark, SelectAll)
+{
+    auto size = generateScene();
+
+    measure({ { "brushes", size.numBrushes }, { "patches", size.numPatches }, { "entities", size.numEntities } }, []()
+    {
+        GlobalSelectionSystem().setSelectedAll(true);
+        GlobalSelectionSystem().setSelectedAll(false);
+    });
+}
+
+TEST_F(SceneBenchmark, SelectPointInOrthoview)
+{
+    auto size = generateScene();
+    auto views = createRandomOrthoviews(NumSelectionTests);
+
+    measure({ { "brushes", size.numBrushes }, { "tests", views.size() } }, [&]()
+    {
+        for (const auto& view : views)
+        {
+            auto test = test::algorithm::constructOrthoviewSelectionTest(view);
+            GlobalSelectionSystem().selectPoint(test, selection::SelectionSystem::eReplace, false);
+        }
+    },
+    []() { GlobalSelectionSystem().setSelectedAll(false); });
+}
+
+TEST_F(SceneBenchmark, SelectAreaInOrthoview)
+{
+    auto size = generateScene();
+    auto views = createRandomOrthoviews(NumSelectionTests);
+
+    measure({ { "brushes", size.numBrushes }, { "tests", views.size() } }, [&]()
+    {
+        for (const auto& view : views)
+        {
+            SelectionVolume test(view);
+            GlobalSelectionSystem().selectArea(test, selection::SelectionSystem::eToggle, false);
+        }
+    },
+    []() { GlobalSelectionSystem().setSelectedAll(false); });
+}
+
+TEST_F(SceneBenchmark, CSGSubtract)
+{
+    auto size = generateScene();
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+
+    constexpr std::size_t SubtractEveryNthBrush = 40;
+    bool subtracted = false;
+
+    measure({ { "brushes", size.numBrushes }, { "subtracted", size.numBrushes / SubtractEveryNthBrush } }, []()
+    {
+        GlobalCommandSystem().executeCommand("CSGSubtract");
+    },
+    [&]()
+    {
+        // Restore the original scene before the next run
+        if (subtracted)
+        {
+            GlobalUndoSystem().undo();
+        }
+
+        subtracted = true;
+
+        GlobalSelectionSystem().setSelectedAll(false);
+
+        std::size_t index = 0;
+
+        worldspawn->foreachNode([&](const scene::INodePtr& node)
+        {
+            if (Node_isBrush(node) && index++ % SubtractEveryNthBrush == 0)
+            {
+                Node_setSelected(node, true);
+            }
+
+            return true;
+        });
+    });
+}
+
+TEST_F(SceneBenchmark, UndoRedoTranslation)
+{
+    auto size = generateScene();
+
+    GlobalSelectionSystem().setSelectedAll(true);
+
+    GlobalCommandSystem().executeCommand("MoveSelection", Vector3(16, 16, 0));
+
+    measure({ { "brushes", size.numBrushes }, { "patches", size.numPatches }, { "entities", size.numEntities } }, []()
+    {
+        GlobalUndoSystem().undo();
+        GlobalUndoSystem().redo();
+    });
+}
+
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <random>
+#include "ientity.h"
+#include "ieclass.h"
+#include "imap.h"
+#include "algorithm/Entity.h"
+#include "algorithm/Primitives.h"
+#include "string/convert.h"
+
+namespace benchmark
+{
+
+// Number of primitives created by generateSyntheticMap()
+struct SyntheticMapSize
+{
+    std::size_t numBrushes = 4000;
+    std::size_t numPatches = 1000;
+
+    // Half of the entities are func_statics owning two brushes each, the other half are lights
+    std::size_t numEntities = 500;
+};
+
+/**
+ * Pseudo random numbers producing the same sequence on every platform
+ * (the distributions of the standard library are implementation-defined,
+ * only the engine is specified).
+ */
+class Random
+{
+private:
+    std::mt19937 _engine;
+
+public:
+    Random(std::uint32_t seed) :
+        _engine(seed)
+    {}
+
+    // Returns a value in the range [min, max), snapped to the given grid size
+    double next(double min, double max, double gridSize = 1.0)
+    {
+        auto value = min + (max - min) * (_engine() / 4294967296.0);
+        return std::floor(value / gridSize) * gridSize;
+    }
+
+    std::size_t nextIndex(std::size_t count)
+    {
+        return _engine() % count;
+    }
+};
+
+namespace detail
+{
+
+constexpr double WorldExtent = 8192;
+constexpr double GridSize = 8;
+
+inline AABB createRandomBounds(Random& random, double minExtent, double maxExtent)
+{
+    Vector3 origin(random.next(-WorldExtent, WorldExtent, GridSize),
+        random.next(-WorldExtent, WorldExtent, GridSize),
+        random.next(-WorldExtent / 4, WorldExtent / 4, GridSize));
+
+    Vector3 extents(random.next(minExtent, maxExtent, GridSize),
+        random.next(minExtent, maxExtent, GridSize),
+        random.next(minExtent, maxExtent, GridSize));
+
+    return AABB(origin, extents);
+}
+
+inline std::string getRandomMaterial(Random& random)
+{
+    return "textures/numbers/" + string::to_string(random.nextIndex(10));
+}
+
+}
+
+/**
+ * Populates the current map with a reproducible set of brushes, patches
+ * and entities. The same seed and size always result in the same scene.
+ */
+inline void generateSyntheticMap(const SyntheticMapSize& size, std::uint32_t seed = 0x5eed)
+{
+    Random random(seed);
+
+    auto worldspawn = GlobalMapModule().findOrInsertWorldspawn();
+
+    for (std::size_t i = 0; i < size.numBrushes; ++i)
+    {
+        test::algorithm::createCuboidBrush(worldspawn, detail::createRandomBounds(random, 8, 256),
+            detail::getRandomMaterial(random));
+    }
+
+    for (std::size_t i = 0; i < size.numPatches; ++i)
+    {
+        test::algorithm::createPatchFromBounds(worldspawn, detail::createRandomBounds(random, 16, 128),
+            detail::getRandomMaterial(random));
+    }
+
+    for (std::size_t i = 0; i < size.numEntities; ++i)
+    {
+        auto bounds = detail::createRandomBounds(random, 16, 64);
+
+        if (i % 2 == 0)
+        {
+            auto entity = test::algorithm::createEntityByClassName("func_static");
+            GlobalMapModule().getRoot()->addChildNode(entity);
+
+            entity->getEntity().setKeyValue("origin", string::to_string(bounds.getOrigin()));
+
+            test::algorithm::createCuboidBrush(entity, bounds, detail::getRandomMaterial(random));
+            test::algorithm::createCuboidBrush(entity, AABB(bounds.getOrigin() + Vector3(0, 0, bounds.getExtents().z() * 2), bounds.getExtents()),
+                detail::getRandomMaterial(random));
+        }
+        else
+        {
+            auto entity = test::algorithm::createEntityByClassName("light");
+            GlobalMapModule().getRoot()->addChildNode(entity);
+
+            entity->getEntity().setKeyValue("origin", string::to_string(bounds.getOrigin()));
+            entity->getEntity().setKeyValue("light_radius", string::to_string(bounds.getExtents() * 4));
+        }
+    }
+}
+
+}
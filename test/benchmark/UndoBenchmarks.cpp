@@ -0,0 +1,85 @@
+#include "Benchmark.h"
+
+#include "ibrush.h"
+#include "imap.h"
+#include "iundo.h"
+#include "scenelib.h"
+
+namespace benchmark
+{
+
+using UndoBenchmark = BenchmarkTest;
+
+namespace
+{
+
+struct ChildNodeDeletion
+{
+    std::size_t numBrushes;
+    std::size_t numDeletedBrushes;
+    scene::INodePtr worldspawn;
+    std::vector<scene::INodePtr> children;
+
+    ChildNodeDeletion() :
+        numBrushes(ResultCollector::Instance().getScaled(30000)),
+        numDeletedBrushes(numBrushes / 6),
+        worldspawn(GlobalMapModule().findOrInsertWorldspawn())
+    {
+        for (std::size_t i = 0; i < numBrushes; ++i)
+        {
+            auto brush = GlobalBrushCreator().createBrush();
+            scene::addNodeToContainer(brush, worldspawn);
+            children.push_back(brush);
+        }
+    }
+
+    // Removes every sixth brush, scattered across the whole container
+    void run()
+    {
+        UndoableCommand cmd("deleteBrushes");
+
+        for (std::size_t i = 0; i < numDeletedBrushes; ++i)
+        {
+            scene::removeNodeFromParent(children[i * numBrushes / numDeletedBrushes]);
+        }
+    }
+};
+
+}
+
+TEST_F(UndoBenchmark, DeleteChildNodes)
+{
+    ChildNodeDeletion deletion;
+    bool deleted = false;
+
+    measure({ { "brushes", deletion.numBrushes }, { "deleted", deletion.numDeletedBrushes } }, [&]()
+    {
+        deletion.run();
+    },
+    [&]()
+    {
+        // Restore the brushes before the next run
+        if (deleted)
+        {
+            GlobalUndoSystem().undo();
+        }
+
+        deleted = true;
+    });
+}
+
+TEST_F(UndoBenchmark, UndoChildNodeDeletion)
+{
+    ChildNodeDeletion deletion;
+
+    measure({ { "brushes", deletion.numBrushes }, { "deleted", deletion.numDeletedBrushes } }, []()
+    {
+        GlobalUndoSystem().undo();
+    },
+    [&]()
+    {
+        deletion.run();
+    });
+}
+
+}
@@ -0,0 +1,139 @@
+#include "gtest/gtest.h"
+
+#include <random>
+#include "math/Frustum.h"
+#include "math/AABBBatch.h"
+#include "math/Matrix4.h"
+
+namespace test
+{
+
+namespace
+{
+
+// The cube [0..10] in all three dimensions, with the plane normals pointing inwards
+Frustum createCubeFrustum()
+{
+    return Frustum(
+        Plane3(-1, 0, 0, -10), // right
+        Plane3(1, 0, 0, 0),    // left
+        Plane3(0, 1, 0, 0),    // bottom
+        Plane3(0, -1, 0, -10), // top
+        Plane3(0, 0, -1, -10), // back
+        Plane3(0, 0, 1, 0)     // front
+    );
+}
+
+// A perspective frustum looking down the negative z axis, placed by the given modelview
+Frustum createPerspectiveFrustum(const Matrix4& modelView)
+{
+    const double near = 1;
+    const double far = 4096;
+
+    auto projection = Matrix4::byColumns(
+        1, 0, 0, 0,
+        0, 1, 0, 0,
+        0, 0, -(far + near) / (far - near), -1,
+        0, 0, -2 * far * near / (far - near), 0
+    );
+
+    return Frustum::createFromViewproj(projection.getMultipliedBy(modelView));
+}
+
+void expectBatchMatchesSingleTests(const Frustum& frustum, const AABBBatch& boxes)
+{
+    std::vector<VolumeIntersectionValue> results(boxes.size());
+    frustum.testIntersection(boxes, results.data());
+
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+    {
+        EXPECT_EQ(results[i], frustum.testIntersection(boxes.get(i))) << "Box " << i << " classified differently";
+    }
+}
+
+}
+
+TEST(FrustumTest, AABBIntersection)
+{
+    auto frustum = createCubeFrustum();
+
+    EXPECT_EQ(frustum.testIntersection(AABB(Vector3(5, 5, 5), Vector3(1, 1, 1))), VOLUME_INSIDE);
+    EXPECT_EQ(frustum.testIntersection(AABB(Vector3(5, 5, 5), Vector3(5, 5, 5))), VOLUME_INSIDE);
+    EXPECT_EQ(frustum.testIntersection(AABB(Vector3(5, 5, 5), Vector3(20, 1, 1))), VOLUME_PARTIAL);
+    EXPECT_EQ(frustum.testIntersection(AABB(Vector3(10, 5, 5), Vector3(1, 1, 1))), VOLUME_PARTIAL);
+    EXPECT_EQ(frustum.testIntersection(AABB(Vector3(20, 5, 5), Vector3(1, 1, 1))), VOLUME_OUTSIDE);
+    EXPECT_EQ(frustum.testIntersection(AABB(Vector3(5, -5, 5), Vector3(1, 1, 1))), VOLUME_OUTSIDE);
+    EXPECT_EQ(frustum.testIntersection(AABB(Vector3(5, 5, 12), Vector3(1, 1, 1))), VOLUME_OUTSIDE);
+
+    // A box touching the boundary from the outside is still intersecting
+    EXPECT_EQ(frustum.testIntersection(AABB(Vector3(11, 5, 5), Vector3(1, 1, 1))), VOLUME_PARTIAL);
+}
+
+TEST(FrustumTest, AABBBatchIntersection)
+{
+    auto frustum = createCubeFrustum();
+
+    AABBBatch boxes;
+    boxes.add(AABB(Vector3(5, 5, 5), Vector3(1, 1, 1)));
+    boxes.add(AABB(Vector3(20, 5, 5), Vector3(1, 1, 1)));
+    boxes.add(AABB(Vector3(10, 5, 5), Vector3(1, 1, 1)));
+    boxes.add(AABB(Vector3(5, 5, 12), Vector3(1, 1, 1)));
+    boxes.add(AABB(Vector3(11, 5, 5), Vector3(1, 1, 1))); // odd count, last box is processed on its own
+
+    std::vector<VolumeIntersectionValue> results(boxes.size());
+    frustum.testIntersection(boxes, results.data());
+
+    EXPECT_EQ(results[0], VOLUME_INSIDE);
+    EXPECT_EQ(results[1], VOLUME_OUTSIDE);
+    EXPECT_EQ(results[2], VOLUME_PARTIAL);
+    EXPECT_EQ(results[3], VOLUME_OUTSIDE);
+    EXPECT_EQ(results[4], VOLUME_PARTIAL);
+
+    // Boxes sliding along the x axis, covering the boundary cases on both sides
+    AABBBatch slidingBoxes;
+
+    for (int x = -3; x <= 13; ++x)
+    {
+        slidingBoxes.add(AABB(Vector3(x, 5, 5), Vector3(1, 1, 1)));
+    }
+
+    expectBatchMatchesSingleTests(frustum, slidingBoxes);
+}
+
+TEST(FrustumTest, AABBBatchMatchesSingleTests)
+{
+    std::mt19937 generator(1337);
+    std::uniform_real_distribution<double> coord(-2000, 2000);
+    std::uniform_real_distribution<double> size(0, 400);
+    std::uniform_real_distribution<double> angle(-180, 180);
+
+    for (int i = 0; i < 50; ++i)
+    {
+        auto modelView = Matrix4::getRotationForEulerXYZDegrees(Vector3(angle(generator), angle(generator), angle(generator)));
+        modelView.translateBy(Vector3(coord(generator), coord(generator), coord(generator)));
+
+        auto frustum = createPerspectiveFrustum(modelView);
+
+        // Both normalised and unnormalised planes are in use
+        if (i % 2 == 0)
+        {
+            frustum.normalisePlanes();
+        }
+
+        AABBBatch boxes;
+
+        for (int b = 0; b < 64 + i; ++b)
+        {
+            boxes.add(AABB(Vector3(coord(generator), coord(generator), coord(generator)),
+                Vector3(size(generator), size(generator), size(generator))));
+        }
+
+        // Invalid and degenerate boxes must be classified the same way, too
+        boxes.add(AABB());
+        boxes.add(AABB(Vector3(coord(generator), 0, 0), Vector3(0, 0, 0)));
+
+        expectBatchMatchesSingleTests(frustum, boxes);
+    }
+}
+
+}